@@ -2,6 +2,8 @@
 #include "AbstractWrapper.h"
 #include <fstream>
 #include <sstream>
+#include "Cancellation.h"
+#include "exceptions.h"
 
 // implementation code of WrapperFactory - do NOT modify the next 5 lines
 AbstractWrapper* WrapperFactory::wrapper = 0;
@@ -38,5 +40,12 @@ void TestWrapper::parse(std::string filename) {
 
 // method to evaluating a query
 void TestWrapper::evaluate(std::string query, std::list<std::string>& results) {
-    qps.evaluate(query, results, &pkb);
+    // the autotester sets GlobalStop once the time limit of the query is up, which stops the evaluation.
+    CancellationToken token;
+    token.watch(&AbstractWrapper::GlobalStop);
+    try {
+        qps.evaluate(query, results, &pkb, &token);
+    } catch (const exceptions::QueryStoppedException&) {
+        results.clear();
+    }
 }
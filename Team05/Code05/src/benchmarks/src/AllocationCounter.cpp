@@ -0,0 +1,154 @@
+#include <malloc.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#include "AllocationCounter.h"
+
+// The replacement allocation functions live in a file of their own, so that the compiler never sees them inlined
+// next to the allocations of the standard library that they pair with.
+
+namespace {
+std::atomic<bool> isCounting = false;
+std::atomic<std::int64_t> allocations = 0;
+std::atomic<std::int64_t> allocatedBytes = 0;
+std::atomic<std::int64_t> liveBytes = 0;
+std::atomic<std::int64_t> peakBytes = 0;
+
+void recordAllocation(void* ptr) {
+    if (!isCounting.load(std::memory_order_relaxed)) return;
+    auto size = static_cast<std::int64_t>(malloc_usable_size(ptr));
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    auto live = liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+    auto peak = peakBytes.load(std::memory_order_relaxed);
+    while (live > peak && !peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+}
+
+void recordDeallocation(void* ptr) {
+    if (!isCounting.load(std::memory_order_relaxed) || !ptr) return;
+    liveBytes.fetch_sub(static_cast<std::int64_t>(malloc_usable_size(ptr)), std::memory_order_relaxed);
+}
+
+void* allocate(std::size_t size) noexcept {
+    void* ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr) recordAllocation(ptr);
+    return ptr;
+}
+
+void* allocateAligned(std::size_t size, std::align_val_t alignment) noexcept {
+    // aligned_alloc wants the size to be a multiple of the alignment
+    auto align = static_cast<std::size_t>(alignment);
+    std::size_t rounded = size == 0 ? align : (size + align - 1) / align * align;
+    void* ptr = std::aligned_alloc(align, rounded);
+    if (ptr) recordAllocation(ptr);
+    return ptr;
+}
+
+void deallocate(void* ptr) noexcept {
+    recordDeallocation(ptr);
+    std::free(ptr);
+}
+}  // namespace
+
+void AllocationCounter::Start() {
+    allocations = 0;
+    allocatedBytes = 0;
+    liveBytes = 0;
+    peakBytes = 0;
+    isCounting = true;
+}
+
+void AllocationCounter::Stop(Result* result) {
+    isCounting = false;
+    result->num_allocs = allocations;
+    result->max_bytes_used = peakBytes;
+    result->total_allocated_bytes = allocatedBytes;
+    result->net_heap_growth = liveBytes;
+}
+
+// Every form of the global allocation functions is replaced, so that nothing allocated by the benchmarks bypasses
+// the counter and every pointer is freed by the allocator that made it.
+void* operator new(std::size_t size) {
+    if (void* ptr = allocate(size)) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    if (void* ptr = allocateAligned(size, alignment)) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return operator new(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateAligned(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateAligned(size, alignment);
+}
+
+void operator delete(void* ptr) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept {
+    deallocate(ptr);
+}
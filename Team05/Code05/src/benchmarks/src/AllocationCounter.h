@@ -0,0 +1,13 @@
+#pragma once
+
+#include "benchmark/benchmark.h"
+
+/**
+ * Counts the allocations made while a benchmark runs through the global operator new, which is replaced in
+ * AllocationCounter.cpp, and reports them as the memory usage of the benchmark.
+ */
+class AllocationCounter : public benchmark::MemoryManager {
+public:
+    void Start() override;
+    void Stop(Result* result) override;
+};
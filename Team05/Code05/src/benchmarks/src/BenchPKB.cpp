@@ -0,0 +1,153 @@
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "Benchmarks.h"
+#include "PKB.h"
+#include "PKB/PKBRelationshipTables.h"
+
+namespace {
+struct Relationship {
+    std::string name;
+    PKBRelationship type;
+    PKBEntityType firstType;
+    PKBEntityType secondType;
+};
+
+const std::vector<Relationship> relationships {
+    { "Follows", PKBRelationship::FOLLOWS, PKBEntityType::STATEMENT, PKBEntityType::STATEMENT },
+    { "Follows*", PKBRelationship::FOLLOWST, PKBEntityType::STATEMENT, PKBEntityType::STATEMENT },
+    { "Parent", PKBRelationship::PARENT, PKBEntityType::STATEMENT, PKBEntityType::STATEMENT },
+    { "Parent*", PKBRelationship::PARENTT, PKBEntityType::STATEMENT, PKBEntityType::STATEMENT },
+    { "Modifies", PKBRelationship::MODIFIES, PKBEntityType::STATEMENT, PKBEntityType::VARIABLE },
+    { "Uses", PKBRelationship::USES, PKBEntityType::STATEMENT, PKBEntityType::VARIABLE },
+    { "Calls", PKBRelationship::CALLS, PKBEntityType::PROCEDURE, PKBEntityType::PROCEDURE },
+    { "Calls*", PKBRelationship::CALLST, PKBEntityType::PROCEDURE, PKBEntityType::PROCEDURE },
+    { "Next", PKBRelationship::NEXT, PKBEntityType::STATEMENT, PKBEntityType::STATEMENT },
+    { "Next*", PKBRelationship::NEXTT, PKBEntityType::STATEMENT, PKBEntityType::STATEMENT },
+    { "Affects", PKBRelationship::AFFECTS, PKBEntityType::STATEMENT, PKBEntityType::STATEMENT },
+    { "Affects*", PKBRelationship::AFFECTST, PKBEntityType::STATEMENT, PKBEntityType::STATEMENT },
+};
+
+PKBField declaration(PKBEntityType type) {
+    return type == PKBEntityType::STATEMENT ? PKBField::createDeclaration(StatementType::All)
+                                            : PKBField::createDeclaration(type);
+}
+
+// a pair of concrete fields from the middle of the relationship, so that the concrete lookups find something.
+std::pair<PKBField, PKBField> samplePair(PKB* pkb, const Relationship& rs) {
+    PKBResponse all = pkb->getRelationship(declaration(rs.firstType), declaration(rs.secondType), rs.type);
+    auto *rows = all.getResponse<FieldRowResponse>();
+    if (!rows || rows->empty()) {
+        return { PKBField::createConcrete(STMT_LO(1)), PKBField::createConcrete(STMT_LO(2)) };
+    }
+    auto it = rows->begin();
+    std::advance(it, rows->size() / 2);
+    return { PKBField::createConcrete((*it)[0].content), PKBField::createConcrete((*it)[1].content) };
+}
+
+void getRelationship(benchmark::State& state, generator::ProgramConfig shape, Relationship rs, bool isFirstSyn,
+                     bool isSecondSyn) {
+    PKB* pkb = getProcessedProgram(shape);
+    auto [firstValue, secondValue] = samplePair(pkb, rs);
+    pkb->clearCache();
+    PKBField first = isFirstSyn ? declaration(rs.firstType) : firstValue;
+    PKBField second = isSecondSyn ? declaration(rs.secondType) : secondValue;
+    std::size_t rows = 0;
+    for (auto _ : state) {
+        PKBResponse response = pkb->getRelationship(first, second, rs.type);
+        rows = response.hasResult;
+        if (auto *ptr = response.getResponse<FieldRowResponse>()) rows = ptr->size();
+        benchmark::DoNotOptimize(response);
+    }
+    pkb->clearCache();
+    state.counters["rows"] = static_cast<double>(rows);
+    state.SetItemsProcessed(state.iterations());
+}
+
+void evalAffects(benchmark::State& state, generator::ProgramConfig shape) {
+    PKB* pkb = getProcessedProgram(shape);
+    PKBField stmt = PKBField::createDeclaration(StatementType::All);
+    for (auto _ : state) {
+        // the Affects cache is dropped every time, so every iteration extracts Affects from the CFG again.
+        benchmark::DoNotOptimize(pkb->getRelationship(stmt, stmt, PKBRelationship::AFFECTS));
+        pkb->clearCache();
+    }
+    state.SetItemsProcessed(state.iterations() * shape.statements);
+}
+
+void match(benchmark::State& state, generator::ProgramConfig shape, bool isFull) {
+    using sp::design_extractor::PatternParam;
+    PKB* pkb = getProcessedProgram(shape);
+    // a full match against one of the simplest expressions the generator writes, and a partial match on a variable
+    PatternParam rhs = isFull ? PatternParam("v1 + v2", true) : PatternParam("v1", false);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(pkb->match(StatementType::Assignment, PatternParam(std::nullopt), rhs));
+    }
+    state.SetItemsProcessed(state.iterations() * shape.statements);
+}
+
+Graph<STMT_LO> chain(int length) {
+    Graph<STMT_LO> graph(PKBRelationship::FOLLOWS);
+    for (int i = 1; i < length; i++) {
+        graph.addEdge(STMT_LO(i, StatementType::Assignment), STMT_LO(i + 1, StatementType::Assignment));
+    }
+    return graph;
+}
+
+void graphContainsT(benchmark::State& state) {
+    int length = static_cast<int>(state.range(0));
+    Graph<STMT_LO> graph = chain(length);
+    PKBField first = PKBField::createConcrete(STMT_LO(1, StatementType::Assignment));
+    PKBField last = PKBField::createConcrete(STMT_LO(length, StatementType::Assignment));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(graph.containsT(first, last));
+    }
+    state.SetItemsProcessed(state.iterations() * length);
+}
+
+void graphRetrieveT(benchmark::State& state) {
+    int length = static_cast<int>(state.range(0));
+    bool isFirstSyn = state.range(1) != 0;
+    Graph<STMT_LO> graph = chain(length);
+    PKBField first = isFirstSyn ? PKBField::createDeclaration(StatementType::All)
+                                : PKBField::createConcrete(STMT_LO(1, StatementType::Assignment));
+    PKBField second = PKBField::createDeclaration(StatementType::All);
+    std::size_t rows = 0;
+    for (auto _ : state) {
+        auto result = graph.retrieveT(first, second);
+        rows = result.size();
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * rows);
+}
+}  // namespace
+
+void registerPKBBenchmarks(const BenchmarkConfig& config) {
+    for (int size : config.sizes) {
+        generator::ProgramConfig shape = config.shape;
+        shape.statements = size;
+        std::string suffix = "/" + std::to_string(size);
+        for (auto& rs : relationships) {
+            for (int fields = 0; fields < 4; fields++) {
+                bool isFirstSyn = fields & 2;
+                bool isSecondSyn = fields & 1;
+                std::string name = "PKB/getRelationship/" + rs.name + "(" + (isFirstSyn ? "syn" : "concrete") + "," +
+                                   (isSecondSyn ? "syn" : "concrete") + ")" + suffix;
+                benchmark::RegisterBenchmark(name.c_str(), getRelationship, shape, rs, isFirstSyn, isSecondSyn);
+            }
+        }
+        benchmark::RegisterBenchmark(("PKB/evalAffects" + suffix).c_str(), evalAffects, shape)
+            ->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark(("PKB/match/partial" + suffix).c_str(), match, shape, false);
+        benchmark::RegisterBenchmark(("PKB/match/full" + suffix).c_str(), match, shape, true);
+    }
+    benchmark::RegisterBenchmark("Graph/containsT", graphContainsT)->RangeMultiplier(8)->Range(64, 4096);
+    // retrieving every pair walks the whole chain from every node, so it is kept to short chains
+    benchmark::RegisterBenchmark("Graph/retrieveT", graphRetrieveT)
+        ->ArgsProduct({ benchmark::CreateRange(64, 1024, 4), { 0 } })
+        ->ArgsProduct({ benchmark::CreateRange(16, 128, 2), { 1 } })
+        ->ArgNames({ "length", "syn" });
+}
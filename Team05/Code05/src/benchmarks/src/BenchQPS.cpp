@@ -0,0 +1,47 @@
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "Benchmarks.h"
+#include "QPS/ResultTable.h"
+
+namespace {
+using qps::evaluator::ResultTable;
+using qps::evaluator::VectorResponse;
+
+// a table of rows (i, i % keys) over the given synonyms, so every key is shared by rows / keys rows.
+ResultTable makeTable(int rows, int keys, bool isKeyFirst, const std::vector<qps::query::SynonymId>& synonyms) {
+    VectorResponse res;
+    for (int i = 0; i < rows; i++) {
+        PKBField value = PKBField::createConcrete(STMT_LO(i + 1));
+        PKBField key = PKBField::createConcrete(STMT_LO(i % keys + 1));
+        res.insert(isKeyFirst ? std::vector<PKBField>{key, value} : std::vector<PKBField>{value, key});
+    }
+    return ResultTable::transToResultTable(PKBResponse{!res.empty(), Response{res}}, synonyms);
+}
+
+void resultTableJoin(benchmark::State& state) {
+    int rows = static_cast<int>(state.range(0));
+    int keys = static_cast<int>(state.range(1));
+    // joins (a, b) with (b, c) on b
+    ResultTable lhs = makeTable(rows, keys, false, { 1, 2 });
+    ResultTable rhs = makeTable(rows, keys, true, { 2, 3 });
+    std::size_t joined = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        ResultTable table = lhs;
+        state.ResumeTiming();
+        table.join(rhs);
+        joined = table.getTable().size();
+    }
+    state.counters["rows"] = static_cast<double>(joined);
+    state.SetItemsProcessed(state.iterations() * rows * 2);
+}
+}  // namespace
+
+void registerQPSBenchmarks(const BenchmarkConfig&) {
+    // the join compares every pair of rows, so the tables are kept small enough to finish
+    benchmark::RegisterBenchmark("ResultTable/join", resultTableJoin)
+        ->ArgsProduct({ benchmark::CreateRange(32, 512, 4), { 16, 256 } })
+        ->ArgNames({ "rows", "keys" })
+        ->Unit(benchmark::kMicrosecond);
+}
@@ -0,0 +1,28 @@
+#include <string>
+
+#include "benchmark/benchmark.h"
+#include "Benchmarks.h"
+#include "PKB.h"
+#include "SourceProcessor.h"
+
+namespace {
+void processSimple(benchmark::State& state, generator::ProgramConfig shape) {
+    std::string source = generator::ProgramGenerator(shape).generate();
+    for (auto _ : state) {
+        PKB pkb;
+        benchmark::DoNotOptimize(SourceProcessor().processSimple(source, &pkb));
+    }
+    state.SetItemsProcessed(state.iterations() * shape.statements);
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(source.size()));
+}
+}  // namespace
+
+void registerSPBenchmarks(const BenchmarkConfig& config) {
+    for (int size : config.sizes) {
+        generator::ProgramConfig shape = config.shape;
+        shape.statements = size;
+        benchmark::RegisterBenchmark(("SourceProcessor/processSimple/" + std::to_string(size)).c_str(),
+                                     processSimple, shape)
+            ->Unit(benchmark::kMillisecond);
+    }
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <vector>
+
+#include "PKB.h"
+#include "ProgramGenerator.h"
+
+/**
+ * The programs the benchmarks run on, set from the command line.
+ */
+struct BenchmarkConfig {
+    std::vector<int> sizes {1000, 10000};  // the number of statements of each program
+    generator::ProgramConfig shape;  // the rest of the shape of the programs
+};
+
+/**
+ * Retrieves the PKB of a synthetic program of the given shape, processing the program the first time it is asked
+ * for, so that the PKB benchmarks do not pay for source processing.
+ *
+ * @param shape the shape of the program
+ * @return the PKB of the program
+ */
+PKB* getProcessedProgram(const generator::ProgramConfig& shape);
+
+void registerPKBBenchmarks(const BenchmarkConfig& config);
+void registerQPSBenchmarks(const BenchmarkConfig& config);
+void registerSPBenchmarks(const BenchmarkConfig& config);
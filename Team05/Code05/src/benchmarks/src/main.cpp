@@ -0,0 +1,79 @@
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <tuple>
+
+#include "AllocationCounter.h"
+#include "benchmark/benchmark.h"
+#include "Benchmarks.h"
+#include "SourceProcessor.h"
+
+/*
+ * Usage: benchmarks [benchmark flags] [--statements=1000,10000] [--procedures=10] [--call-depth=3] [--fan-out=2]
+ *                   [--nesting=3] [--variables=20] [--seed=3203]
+ *
+ * Every benchmark also reports the allocations made by one of its iterations, counted by the global operator new.
+ */
+
+namespace {
+bool parseFlag(const std::string& arg, BenchmarkConfig& config) {
+    auto separator = arg.find('=');
+    if (arg.rfind("--", 0) != 0 || separator == std::string::npos) return false;
+    std::string name = arg.substr(2, separator - 2);
+    std::istringstream value(arg.substr(separator + 1));
+    if (name == "statements") {
+        config.sizes.clear();
+        std::string size;
+        while (std::getline(value, size, ',')) config.sizes.push_back(std::stoi(size));
+        return !config.sizes.empty();
+    }
+    if (name == "procedures") return static_cast<bool>(value >> config.shape.procedures);
+    if (name == "call-depth") return static_cast<bool>(value >> config.shape.callDepth);
+    if (name == "fan-out") return static_cast<bool>(value >> config.shape.fanOut);
+    if (name == "nesting") return static_cast<bool>(value >> config.shape.nestingDepth);
+    if (name == "variables") return static_cast<bool>(value >> config.shape.variables);
+    if (name == "seed") return static_cast<bool>(value >> config.shape.seed);
+    return false;
+}
+}  // namespace
+
+PKB* getProcessedProgram(const generator::ProgramConfig& shape) {
+    // the programs only differ in the parameters that can be set from the command line
+    static std::map<std::tuple<int, int, int, int, int, int, unsigned int>, std::unique_ptr<PKB>> programs;
+    auto key = std::make_tuple(shape.statements, shape.procedures, shape.callDepth, shape.fanOut, shape.nestingDepth,
+                               shape.variables, shape.seed);
+    auto& pkb = programs[key];
+    if (!pkb) {
+        pkb = std::make_unique<PKB>();
+        SourceProcessor().processSimple(generator::ProgramGenerator(shape).generate(), pkb.get());
+    }
+    return pkb.get();
+}
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    BenchmarkConfig config;
+    for (int i = 1; i < argc; i++) {
+        bool isParsed = false;
+        try {
+            isParsed = parseFlag(argv[i], config);
+        } catch (const std::exception&) {}
+        if (!isParsed) {
+            std::cerr << "Unrecognised argument " << argv[i] << std::endl;
+            return 1;
+        }
+    }
+
+    registerPKBBenchmarks(config);
+    registerQPSBenchmarks(config);
+    registerSPBenchmarks(config);
+
+    AllocationCounter counter;
+    benchmark::RegisterMemoryManager(&counter);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::RegisterMemoryManager(nullptr);
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,193 @@
+#include <algorithm>
+#include <numeric>
+#include <sstream>
+#include <utility>
+
+#include "ProgramGenerator.h"
+
+namespace generator {
+ProgramGenerator::ProgramGenerator(ProgramConfig config) : config(std::move(config)), rng(this->config.seed) {}
+
+int ProgramGenerator::pick(int bound) {
+    return std::uniform_int_distribution<int>(0, std::max(bound, 1) - 1)(rng);
+}
+
+int ProgramGenerator::pick(int low, int high) {
+    return std::uniform_int_distribution<int>(low, std::max(low, high))(rng);
+}
+
+bool ProgramGenerator::chance(double probability) {
+    return std::uniform_real_distribution<double>(0, 1)(rng) < probability;
+}
+
+void ProgramGenerator::planCalls() {
+    int procedures = static_cast<int>(info.procedures.size());
+    int levels = std::min(std::max(config.callDepth, 0) + 1, procedures);
+    auto levelOf = [&](int proc) { return static_cast<int>(static_cast<long long>(proc) * levels / procedures); };
+
+    callees.assign(procedures, {});
+    int levelStart = 0;
+    for (int proc = 0; proc < procedures; proc++) {
+        if (proc > 0 && levelOf(proc) != levelOf(proc - 1)) levelStart = proc;
+        // the procedures of the next level are the ones right after the end of this level
+        int nextStart = levelStart;
+        while (nextStart < procedures && levelOf(nextStart) == levelOf(proc)) nextStart++;
+        int nextEnd = nextStart;
+        while (nextEnd < procedures && levelOf(nextEnd) == levelOf(proc) + 1) nextEnd++;
+
+        std::vector<int> candidates(nextEnd - nextStart);
+        std::iota(candidates.begin(), candidates.end(), nextStart);
+        std::shuffle(candidates.begin(), candidates.end(), rng);
+        candidates.resize(std::min(candidates.size(), static_cast<std::size_t>(std::max(config.fanOut, 0))));
+        callees[proc] = std::move(candidates);
+    }
+}
+
+std::string ProgramGenerator::variable() {
+    return info.variables[pick(static_cast<int>(info.variables.size()))];
+}
+
+std::string ProgramGenerator::constant() {
+    int value = pick(100);
+    auto it = std::lower_bound(info.constants.begin(), info.constants.end(), value);
+    if (it == info.constants.end() || *it != value) info.constants.insert(it, value);
+    return std::to_string(value);
+}
+
+std::string ProgramGenerator::expression(int operands) {
+    if (operands <= 1) return pick(3) == 0 ? constant() : variable();
+    static constexpr char OPERATORS[] = { '+', '-', '*', '/', '%' };
+    int left = pick(1, operands - 1);
+    std::string lhs = expression(left);
+    std::string rhs = expression(operands - left);
+    // only the right operand is ever parenthesised, so that a relational expression never starts with a bracket
+    if (operands - left > 1) rhs = "(" + rhs + ")";
+    return lhs + " " + OPERATORS[pick(5)] + " " + rhs;
+}
+
+std::string ProgramGenerator::condition(int operands) {
+    static constexpr const char* RELATIONS[] = { ">", ">=", "<", "<=", "==", "!=" };
+    int kind = operands >= 2 ? pick(4) : 2;
+    if (kind == 0) {
+        return "!(" + condition(operands - 1) + ")";
+    } else if (kind == 1) {
+        int left = pick(1, operands - 1);
+        return "(" + condition(left) + ") " + (pick(2) == 0 ? "&&" : "||") + " (" + condition(operands - left) + ")";
+    }
+    int left = operands >= 2 ? pick(1, operands - 1) : 1;
+    return expression(left) + " " + RELATIONS[pick(6)] + " " + expression(std::max(operands - left, 1));
+}
+
+void ProgramGenerator::indent(int depth) {
+    *out << std::string(depth * 4, ' ');
+}
+
+void ProgramGenerator::writeCall(int depth, int callee) {
+    indent(depth);
+    *out << "call " << info.procedures[callee] << ";\n";
+    pending.erase(std::remove(pending.begin(), pending.end(), callee), pending.end());
+}
+
+void ProgramGenerator::writeSimple(int depth) {
+    indent(depth);
+    int kind = pick(10);
+    if (kind == 0) {
+        *out << "read " << variable() << ";\n";
+    } else if (kind == 1) {
+        *out << "print " << variable() << ";\n";
+    } else {
+        std::string rhs = expression(pick(1, config.expressionSize));
+        *out << variable() << " = " << rhs << ";\n";
+        // keeps a uniform sample of the expressions for the pattern queries
+        assignments++;
+        if (info.expressions.size() < MAX_EXPRESSIONS) {
+            info.expressions.push_back(rhs);
+        } else {
+            std::size_t slot = std::uniform_int_distribution<std::size_t>(0, assignments - 1)(rng);
+            if (slot < MAX_EXPRESSIONS) info.expressions[slot] = rhs;
+        }
+    }
+}
+
+int ProgramGenerator::writeContainer(int depth, int available) {
+    if (depth > config.nestingDepth) return 0;
+    double roll = std::uniform_real_distribution<double>(0, 1)(rng);
+    if (roll < config.loopDensity && available >= 2) {
+        int body = pick(1, std::min(available - 1, config.bodySize));
+        indent(depth);
+        *out << "while (" << condition(pick(1, config.expressionSize)) << ") {\n";
+        writeBlock(depth + 1, body);
+        indent(depth);
+        *out << "}\n";
+        return 1 + body;
+    }
+    if (roll < config.loopDensity + config.branchDensity && available >= 3) {
+        int thenBody = pick(1, std::min(available - 2, config.bodySize));
+        int elseBody = pick(1, std::min(available - 1 - thenBody, config.bodySize));
+        indent(depth);
+        *out << "if (" << condition(pick(1, config.expressionSize)) << ") then {\n";
+        writeBlock(depth + 1, thenBody);
+        indent(depth);
+        *out << "} else {\n";
+        writeBlock(depth + 1, elseBody);
+        indent(depth);
+        *out << "}\n";
+        return 1 + thenBody + elseBody;
+    }
+    return 0;
+}
+
+void ProgramGenerator::writeBlock(int depth, int count) {
+    int remaining = count;
+    while (remaining > 0) {
+        // the top level keeps one statement for every callee that has not been called yet
+        int reserved = depth == 1 ? static_cast<int>(pending.size()) : 0;
+        int available = remaining - reserved;
+        if (available <= 0) {
+            writeCall(depth, pending.back());
+            remaining--;
+            continue;
+        }
+        int written = writeContainer(depth, available);
+        if (written == 0) {
+            auto& targets = callees[procedure];
+            if (!targets.empty() && chance(config.callDensity)) {
+                writeCall(depth, targets[pick(static_cast<int>(targets.size()))]);
+            } else {
+                writeSimple(depth);
+            }
+            written = 1;
+        }
+        remaining -= written;
+    }
+}
+
+ProgramInfo ProgramGenerator::generate(std::ostream& stream) {
+    out = &stream;
+    info = ProgramInfo();
+    assignments = 0;
+    int procedures = std::max(config.procedures, 1);
+    for (int i = 0; i < procedures; i++) info.procedures.push_back("proc" + std::to_string(i));
+    for (int i = 0; i < std::max(config.variables, 1); i++) info.variables.push_back("v" + std::to_string(i));
+    planCalls();
+
+    int perProcedure = config.statements / procedures;
+    int extra = config.statements % procedures;
+    for (procedure = 0; procedure < procedures; procedure++) {
+        int count = std::max(perProcedure + (procedure < extra ? 1 : 0), 1);
+        pending = callees[procedure];
+        *out << "procedure " << info.procedures[procedure] << " {\n";
+        writeBlock(1, count);
+        *out << "}\n";
+        info.statements += count;
+    }
+    out = nullptr;
+    return info;
+}
+
+std::string ProgramGenerator::generate() {
+    std::ostringstream source;
+    generate(source);
+    return source.str();
+}
+}  // namespace generator
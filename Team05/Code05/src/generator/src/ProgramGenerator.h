@@ -0,0 +1,93 @@
+#pragma once
+
+#include <ostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace generator {
+/**
+ * The parameters of a generated SIMPLE program. The densities are the chances that a statement is of that kind,
+ * and every other statement is an assignment, a read or a print.
+ */
+struct ProgramConfig {
+    int statements = 1000;  // the total number of statements, spread evenly across the procedures
+    int procedures = 10;
+    int callDepth = 3;  // the length of the longest chain of calls
+    int fanOut = 2;  // the number of different procedures each procedure calls
+    int nestingDepth = 3;
+    int bodySize = 8;  // the largest number of statements directly in a while, then or else block
+    double loopDensity = 0.1;
+    double branchDensity = 0.1;
+    double callDensity = 0.05;
+    int variables = 20;
+    int expressionSize = 4;  // the largest number of operands in an expression
+    unsigned int seed = 3203;
+};
+
+/**
+ * The entities of a generated program, which the generated queries refer to.
+ */
+struct ProgramInfo {
+    int statements = 0;
+    std::vector<std::string> procedures;
+    std::vector<std::string> variables;
+    std::vector<int> constants;
+    std::vector<std::string> expressions;  // a sample of the right hand sides of the assignments
+};
+
+/**
+ * Generates valid SIMPLE programs with a controllable shape.
+ *
+ * The procedures are split into callDepth + 1 levels, and a procedure only calls procedures of the next level, so
+ * the call graph is acyclic and no chain of calls is longer than callDepth. Every procedure calls each of its
+ * callees at least once, as long as it has enough statements to do so. The same config always generates the same
+ * program.
+ */
+class ProgramGenerator {
+public:
+    explicit ProgramGenerator(ProgramConfig config);
+
+    /**
+     * Writes the program to the stream, so that very large programs never have to be held in memory.
+     *
+     * @param out the stream to write to
+     * @return the entities of the program
+     */
+    ProgramInfo generate(std::ostream& out);
+
+    /**
+     * Generates the program as a string.
+     *
+     * @return the source of the program
+     */
+    std::string generate();
+
+private:
+    static constexpr std::size_t MAX_EXPRESSIONS = 64;
+
+    ProgramConfig config;
+    std::mt19937 rng;
+    std::ostream* out = nullptr;
+    ProgramInfo info;
+    std::vector<std::vector<int>> callees;
+    std::vector<int> pending;  // the callees that the current procedure has not called yet
+    int procedure = 0;
+    std::size_t assignments = 0;
+
+    int pick(int bound);
+    int pick(int low, int high);
+    bool chance(double probability);
+
+    void planCalls();
+    std::string variable();
+    std::string constant();
+    std::string expression(int operands);
+    std::string condition(int operands);
+    void indent(int depth);
+    void writeCall(int depth, int callee);
+    void writeSimple(int depth);
+    int writeContainer(int depth, int available);
+    void writeBlock(int depth, int count);
+};
+}  // namespace generator
@@ -0,0 +1,171 @@
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "QueryGenerator.h"
+
+namespace generator {
+namespace {
+struct Template {
+    std::string declarations;
+    std::string select;
+};
+
+// {stmt}, {var}, {proc}, {const} and {expr} are replaced by an entity of the program.
+const std::map<std::string, std::vector<Template>> TEMPLATES {
+    { "follows", {
+        { "stmt s;", "Select s such that Follows({stmt}, s)" },
+        { "stmt s;", "Select s such that Follows*(s, {stmt})" },
+        { "stmt s1, s2;", "Select <s1, s2> such that Follows(s1, s2)" },
+        { "assign a; while w;", "Select a such that Follows*(w, a)" },
+    } },
+    { "parent", {
+        { "stmt s;", "Select s such that Parent({stmt}, s)" },
+        { "while w; assign a;", "Select a such that Parent*(w, a)" },
+        { "if ifs; stmt s;", "Select ifs such that Parent(ifs, s)" },
+        { "stmt s;", "Select BOOLEAN such that Parent*(s, {stmt})" },
+    } },
+    { "modifies", {
+        { "variable v;", "Select v such that Modifies({stmt}, v)" },
+        { "assign a;", "Select a such that Modifies(a, \"{var}\")" },
+        { "procedure p; variable v;", "Select <p, v> such that Modifies(p, v)" },
+        { "stmt s;", "Select s such that Modifies(s, \"{var}\")" },
+    } },
+    { "uses", {
+        { "variable v;", "Select v such that Uses(\"{proc}\", v)" },
+        { "print pn; variable v;", "Select pn such that Uses(pn, v) with v.varName = \"{var}\"" },
+        { "while w; variable v;", "Select <w, v> such that Uses(w, v)" },
+        { "stmt s;", "Select s such that Uses(s, \"{var}\")" },
+    } },
+    { "calls", {
+        { "procedure p;", "Select p such that Calls(\"{proc}\", p)" },
+        { "procedure p, q;", "Select <p, q> such that Calls*(p, q)" },
+        { "call c;", "Select c with c.procName = \"{proc}\"" },
+        { "procedure p;", "Select p such that Calls*(p, \"{proc}\")" },
+    } },
+    { "next", {
+        { "stmt s;", "Select s such that Next({stmt}, s)" },
+        { "stmt s;", "Select s such that Next*({stmt}, s)" },
+        { "assign a; while w;", "Select a such that Next*(w, a)" },
+        { "stmt s;", "Select BOOLEAN such that Next*(s, {stmt})" },
+    } },
+    { "affects", {
+        { "assign a;", "Select a such that Affects({stmt}, a)" },
+        { "assign a1, a2;", "Select <a1, a2> such that Affects(a1, a2)" },
+        { "assign a;", "Select a such that Affects*(a, {stmt})" },
+        { "assign a;", "Select BOOLEAN such that Affects*({stmt}, a)" },
+    } },
+    { "pattern", {
+        { "assign a;", "Select a pattern a(\"{var}\", _)" },
+        { "assign a; variable v;", "Select <a, v> pattern a(v, _\"{var}\"_)" },
+        { "assign a;", "Select a pattern a(_, \"{expr}\")" },
+        { "while w; variable v;", "Select w pattern w(v, _)" },
+        { "if ifs;", "Select ifs pattern ifs(\"{var}\", _, _)" },
+    } },
+    { "with", {
+        { "stmt s;", "Select s with s.stmt# = {stmt}" },
+        { "constant c; stmt s;", "Select s with s.stmt# = c.value" },
+        { "read r; print pn;", "Select <r, pn> with r.varName = pn.varName" },
+        { "constant c;", "Select c with c.value = {const}" },
+    } },
+    { "multi", {
+        { "assign a; while w; variable v;", "Select a such that Parent*(w, a) and Modifies(a, v) pattern a(v, _)" },
+        { "stmt s1, s2, s3;", "Select <s1, s3> such that Next(s1, s2) and Next(s2, s3) and Follows*(s1, s3)" },
+        { "procedure p; call c; variable v;",
+          "Select <p, c> such that Calls(p, _) and Modifies(p, v) with c.procName = p.procName" },
+        { "assign a1, a2; variable v;",
+          "Select BOOLEAN such that Affects(a1, a2) and Uses(a2, v) and Modifies(a1, v)" },
+        { "stmt s; assign a; variable v;",
+          "Select s such that Follows*(s, a) and Uses(a, v) pattern a(v, _) with v.varName = \"{var}\"" },
+    } },
+};
+
+class QueryWriter {
+public:
+    QueryWriter(const ProgramInfo& program, unsigned int seed) : program(program), rng(seed) {}
+
+    std::string fill(const std::string& text) {
+        std::string filled;
+        std::size_t pos = 0;
+        while (pos < text.size()) {
+            std::size_t open = text.find('{', pos);
+            std::size_t close = open == std::string::npos ? open : text.find('}', open);
+            if (close == std::string::npos) {
+                filled += text.substr(pos);
+                break;
+            }
+            filled += text.substr(pos, open - pos) + entity(text.substr(open + 1, close - open - 1));
+            pos = close + 1;
+        }
+        return filled;
+    }
+
+    std::size_t pick(std::size_t bound) {
+        return std::uniform_int_distribution<std::size_t>(0, std::max<std::size_t>(bound, 1) - 1)(rng);
+    }
+
+private:
+    const ProgramInfo& program;
+    std::mt19937 rng;
+
+    template <typename T>
+    std::string pickFrom(const std::vector<T>& values, const std::string& fallback) {
+        if (values.empty()) return fallback;
+        if constexpr (std::is_same_v<T, std::string>) {
+            return values[pick(values.size())];
+        } else {
+            return std::to_string(values[pick(values.size())]);
+        }
+    }
+
+    std::string entity(const std::string& kind) {
+        if (kind == "stmt") return std::to_string(1 + pick(static_cast<std::size_t>(program.statements)));
+        if (kind == "var") return pickFrom(program.variables, "v0");
+        if (kind == "proc") return pickFrom(program.procedures, "proc0");
+        if (kind == "const") return pickFrom(program.constants, "0");
+        if (kind == "expr") return pickFrom(program.expressions, pickFrom(program.variables, "v0"));
+        throw std::invalid_argument("Unknown entity in query template: " + kind);
+    }
+};
+}  // namespace
+
+std::vector<GeneratedQuery> generateQueries(const ProgramInfo& program, const QueryConfig& config) {
+    std::vector<std::string> categories;
+    std::vector<int> weights;
+    for (auto& [category, weight] : config.mix) {
+        if (TEMPLATES.find(category) == TEMPLATES.end()) {
+            throw std::invalid_argument("Unknown query category: " + category);
+        }
+        if (weight > 0) {
+            categories.push_back(category);
+            weights.push_back(weight);
+        }
+    }
+    if (categories.empty()) throw std::invalid_argument("The query mix has no positive weight");
+
+    QueryWriter writer(program, config.seed);
+    std::mt19937 rng(config.seed);
+    std::discrete_distribution<std::size_t> categoryOf(weights.begin(), weights.end());
+    std::vector<GeneratedQuery> queries;
+    for (int i = 0; i < config.count; i++) {
+        const std::string& category = categories[categoryOf(rng)];
+        auto& templates = TEMPLATES.at(category);
+        const Template& chosen = templates[writer.pick(templates.size())];
+        queries.push_back(GeneratedQuery{category, chosen.declarations, writer.fill(chosen.select)});
+    }
+    return queries;
+}
+
+void writeQueries(std::ostream& out, const std::vector<GeneratedQuery>& queries,
+                  const std::vector<std::string>& answers, int timeout) {
+    for (std::size_t i = 0; i < queries.size(); i++) {
+        out << i + 1 << " - " << queries[i].category << "\n"
+            << queries[i].declarations << "\n"
+            << queries[i].select << "\n"
+            << (i < answers.size() ? answers[i] : "") << "\n"
+            << timeout << "\n";
+    }
+}
+}  // namespace generator
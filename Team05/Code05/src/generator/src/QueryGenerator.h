@@ -0,0 +1,55 @@
+#pragma once
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "ProgramGenerator.h"
+
+namespace generator {
+/**
+ * The parameters of a generated mix of queries. The mix weighs each category of queries, and the categories are
+ * follows, parent, modifies, uses, calls, next, affects, pattern, with and multi (several clauses together).
+ */
+struct QueryConfig {
+    int count = 100;
+    std::map<std::string, int> mix {
+        { "follows", 1 }, { "parent", 1 }, { "modifies", 1 }, { "uses", 1 }, { "calls", 1 },
+        { "next", 1 }, { "affects", 1 }, { "pattern", 1 }, { "with", 1 }, { "multi", 1 },
+    };
+    unsigned int seed = 3203;
+};
+
+/**
+ * A generated PQL query.
+ */
+struct GeneratedQuery {
+    std::string category;
+    std::string declarations;
+    std::string select;
+
+    std::string getQuery() const { return declarations + " " + select; }
+};
+
+/**
+ * Generates a mix of valid PQL queries on the entities of a generated program.
+ *
+ * @param program the entities of the program
+ * @param config the parameters of the mix
+ * @return the queries
+ * @throws std::invalid_argument if the mix names an unknown category or has no positive weight
+ */
+std::vector<GeneratedQuery> generateQueries(const ProgramInfo& program, const QueryConfig& config);
+
+/**
+ * Writes the queries in the format of the autotester query files, with the given answers if there are any.
+ *
+ * @param out the stream to write to
+ * @param queries the queries
+ * @param answers the expected answers of every query, or empty to leave them blank
+ * @param timeout the time limit of every query in milliseconds
+ */
+void writeQueries(std::ostream& out, const std::vector<GeneratedQuery>& queries,
+                  const std::vector<std::string>& answers = {}, int timeout = 5000);
+}  // namespace generator
@@ -0,0 +1,142 @@
+#include <fstream>
+#include <iostream>
+#include <list>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "ProgramGenerator.h"
+#include "QueryGenerator.h"
+#include "PKB.h"
+#include "QPS/QPS.h"
+#include "SourceProcessor.h"
+
+/*
+ * Usage: generator [--statements=1000] [--procedures=10] [--call-depth=3] [--fan-out=2] [--nesting=3]
+ *                  [--body-size=8] [--loop-density=0.1] [--branch-density=0.1] [--call-density=0.05]
+ *                  [--variables=20] [--expression-size=4] [--seed=3203]
+ *                  [--queries=100] [--mix=follows:2,next:1,...] [--output=prefix] [--answers]
+ *
+ * Writes the program to <prefix>_source.txt and the queries to <prefix>_queries.txt, in the format of the
+ * autotester. Without an output prefix, the program is written to stdout and no queries are generated. With
+ * --answers, the program is processed and every query is evaluated to fill in its expected answer.
+ */
+
+namespace {
+struct Options {
+    generator::ProgramConfig program;
+    generator::QueryConfig queries;
+    std::string output;
+    bool hasAnswers = false;
+};
+
+template <typename T>
+bool read(const std::string& value, T& field) {
+    std::istringstream in(value);
+    return static_cast<bool>(in >> field) && in.eof();
+}
+
+bool readMix(const std::string& value, std::map<std::string, int>& mix) {
+    mix.clear();
+    std::istringstream in(value);
+    std::string entry;
+    while (std::getline(in, entry, ',')) {
+        auto separator = entry.find(':');
+        int weight = 1;
+        if (separator != std::string::npos && !read(entry.substr(separator + 1), weight)) return false;
+        mix[entry.substr(0, separator)] = weight;
+    }
+    return !mix.empty();
+}
+
+bool parseFlag(const std::string& arg, Options& options) {
+    if (arg == "--answers") {
+        options.hasAnswers = true;
+        return true;
+    }
+    auto separator = arg.find('=');
+    if (arg.rfind("--", 0) != 0 || separator == std::string::npos) return false;
+    std::string name = arg.substr(2, separator - 2);
+    std::string value = arg.substr(separator + 1);
+    auto& program = options.program;
+    if (name == "statements") return read(value, program.statements);
+    if (name == "procedures") return read(value, program.procedures);
+    if (name == "call-depth") return read(value, program.callDepth);
+    if (name == "fan-out") return read(value, program.fanOut);
+    if (name == "nesting") return read(value, program.nestingDepth);
+    if (name == "body-size") return read(value, program.bodySize);
+    if (name == "loop-density") return read(value, program.loopDensity);
+    if (name == "branch-density") return read(value, program.branchDensity);
+    if (name == "call-density") return read(value, program.callDensity);
+    if (name == "variables") return read(value, program.variables);
+    if (name == "expression-size") return read(value, program.expressionSize);
+    if (name == "seed") return read(value, program.seed) && read(value, options.queries.seed);
+    if (name == "queries") return read(value, options.queries.count);
+    if (name == "mix") return readMix(value, options.queries.mix);
+    if (name == "output") {
+        options.output = value;
+        return !value.empty();
+    }
+    return false;
+}
+
+std::vector<std::string> evaluate(const std::string& source, const std::vector<generator::GeneratedQuery>& queries) {
+    PKB pkb;
+    if (!SourceProcessor().processSimple(source, &pkb)) {
+        throw std::runtime_error("The generated program could not be processed");
+    }
+    qps::QPS qps;
+    std::vector<std::string> answers;
+    for (auto& query : queries) {
+        std::list<std::string> results;
+        qps.evaluate(query.getQuery(), results, &pkb);
+        std::string answer;
+        for (auto& result : results) {
+            answer += (answer.empty() ? "" : ", ") + result;
+        }
+        answers.push_back(answer);
+    }
+    return answers;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        if (!parseFlag(argv[i], options)) {
+            std::cerr << "Unrecognised argument " << argv[i] << std::endl;
+            return 1;
+        }
+    }
+
+    generator::ProgramGenerator programGenerator(options.program);
+    if (options.output.empty()) {
+        programGenerator.generate(std::cout);
+        return 0;
+    }
+
+    try {
+        std::ofstream sourceFile(options.output + "_source.txt");
+        generator::ProgramInfo info = programGenerator.generate(sourceFile);
+        sourceFile.close();
+
+        auto queries = generator::generateQueries(info, options.queries);
+        std::vector<std::string> answers;
+        if (options.hasAnswers) {
+            std::ifstream in(options.output + "_source.txt");
+            std::stringstream source;
+            source << in.rdbuf();
+            answers = evaluate(source.str(), queries);
+        }
+        std::ofstream queryFile(options.output + "_queries.txt");
+        generator::writeQueries(queryFile, queries, answers);
+        std::cout << "Wrote " << info.statements << " statements in " << info.procedures.size() << " procedures and "
+                  << queries.size() << " queries" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,95 @@
+#include <list>
+#include <string>
+#include <vector>
+
+#include "catch.hpp"
+
+#include "Cancellation.h"
+#include "exceptions.h"
+#include "PKB.h"
+#include "QPS/QPS.h"
+#include "SourceProcessor.h"
+
+namespace {
+std::vector<std::list<std::string>> sorted(std::vector<std::list<std::string>> results) {
+    for (auto& result : results) {
+        result.sort();
+    }
+    return results;
+}
+}  // namespace
+
+TEST_CASE("Batch queries") {
+    std::string source = R"(
+        procedure main {
+            x = 1;
+            y = x + 2;
+            while (y > 0) {
+                x = y;
+                y = x - 1;
+            }
+            call sub;
+        }
+        procedure sub {
+            print y;
+            x = y;
+        }
+    )";
+    PKB pkb;
+    SourceProcessor sp;
+    sp.processSimple(source, &pkb);
+    qps::QPS qps;
+
+    std::vector<std::string> queries {
+        "assign a; Select a such that Affects(a, _)",
+        "assign a; variable v; Select <a, v> such that Affects(a, _) and Modifies(a, v)",
+        "assign a1, a2; Select <a1, a2> such that Affects*(a1, a2)",
+        "stmt s; Select s such that Follows(1, 2) and Parent(s, _)",
+        "stmt s; Select s such that Follows(1, 3) and Parent(s, _)",
+        "assign a; Select a such that Affects(a, _)",
+        "stmt a; Select a such that Affects(a, _)",
+        "assign a; Select a pattern a(\"x\", _) such that Uses(a, \"y\")",
+        "Select BOOLEAN such that Calls(\"main\", \"sub\")",
+        "stmt s; Select v such that Modifies(s, v)",
+    };
+
+    std::vector<std::list<std::string>> expected;
+    for (auto& query : queries) {
+        std::list<std::string> results;
+        qps.evaluate(query, results, &pkb);
+        expected.push_back(results);
+    }
+    expected = sorted(expected);
+    REQUIRE(expected[0] == std::list<std::string>{"1", "2", "4", "5"});
+    REQUIRE(expected[4].empty());
+    REQUIRE(expected[9].empty());
+
+    SECTION("Sequential batch") {
+        REQUIRE(sorted(qps.evaluateBatch(queries, &pkb, false)) == expected);
+    }
+
+    SECTION("Parallel batch") {
+        for (int i = 0; i < 5; i++) {
+            REQUIRE(sorted(qps.evaluateBatch(queries, &pkb)) == expected);
+        }
+    }
+
+    SECTION("Queries after a batch") {
+        qps.evaluateBatch(queries, &pkb);
+        std::list<std::string> results;
+        qps.evaluate(queries[2], results, &pkb);
+        results.sort();
+        REQUIRE(results == expected[2]);
+    }
+
+    SECTION("Stopped batch") {
+        CancellationToken token;
+        token.cancel();
+        REQUIRE_THROWS_AS(qps.evaluateBatch(queries, &pkb, true, &token), exceptions::QueryStoppedException);
+        REQUIRE(sorted(qps.evaluateBatch(queries, &pkb)) == expected);
+    }
+
+    SECTION("Empty batch") {
+        REQUIRE(qps.evaluateBatch({}, &pkb).empty());
+    }
+}
@@ -0,0 +1,87 @@
+#include <chrono>
+#include <list>
+#include <string>
+#include <thread>
+
+#include "catch.hpp"
+
+#include "Cancellation.h"
+#include "exceptions.h"
+#include "PKB.h"
+#include "ProgramGenerator.h"
+#include "QPS/QPS.h"
+#include "SourceProcessor.h"
+
+namespace {
+using Reason = exceptions::QueryStoppedException::Reason;
+
+Reason getStopReason(const std::string& query, PKB* pkb, const CancellationToken& token) {
+    std::list<std::string> results;
+    try {
+        qps::QPS().evaluate(query, results, pkb, &token);
+    } catch (const exceptions::QueryStoppedException& e) {
+        REQUIRE(results.empty());
+        return e.reason;
+    }
+    FAIL("the query was not stopped");
+    return Reason::CANCELLED;
+}
+}  // namespace
+
+TEST_CASE("Stopping the evaluation of a query") {
+    generator::ProgramConfig config;
+    config.statements = 400;
+    config.procedures = 3;
+    PKB pkb;
+    REQUIRE(SourceProcessor().processSimple(generator::ProgramGenerator(config).generate(), &pkb));
+    // takes seconds to run to completion, and builds a table of every pair of statements.
+    std::string slow = "stmt s1, s2; Select <s1, s2> such that Next*(s1, s2)";
+    using Clock = std::chrono::steady_clock;
+
+    SECTION("Past its deadline") {
+        CancellationToken token;
+        token.setTimeout(std::chrono::milliseconds(20));
+        auto start = Clock::now();
+        REQUIRE(getStopReason(slow, &pkb, token) == Reason::DEADLINE);
+        REQUIRE(Clock::now() - start < std::chrono::seconds(1));
+    }
+
+    SECTION("Cancelled from another thread") {
+        CancellationToken token;
+        std::thread canceller([&token]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            token.cancel();
+        });
+        auto start = Clock::now();
+        Reason reason = getStopReason(slow, &pkb, token);
+        canceller.join();
+        REQUIRE(reason == Reason::CANCELLED);
+        REQUIRE(Clock::now() - start < std::chrono::seconds(1));
+    }
+
+    SECTION("Watching a stop flag") {
+        volatile bool isStopped = true;
+        CancellationToken token;
+        token.watch(&isStopped);
+        REQUIRE(getStopReason(slow, &pkb, token) == Reason::CANCELLED);
+    }
+
+    SECTION("Over its memory budget") {
+        CancellationToken token;
+        token.setMemoryBudget(64 * 1024);
+        std::string crossProduct = "stmt s1, s2; variable v; Select <s1, s2, v>";
+        REQUIRE(getStopReason(crossProduct, &pkb, token) == Reason::MEMORY);
+    }
+
+    SECTION("Within its limits") {
+        CancellationToken token;
+        token.setTimeout(std::chrono::seconds(60));
+        token.setMemoryBudget(64 * 1024 * 1024);
+        std::string query = "stmt s; Select s such that Follows(s, _)";
+        std::list<std::string> results, expected;
+        qps::QPS().evaluate(query, results, &pkb, &token);
+        qps::QPS().evaluate(query, expected, &pkb);
+        REQUIRE(results == expected);
+        REQUIRE_FALSE(results.empty());
+    }
+}
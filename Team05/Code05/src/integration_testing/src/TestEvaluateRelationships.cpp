@@ -100,13 +100,12 @@ TEST_CASE("Test get Modifies") {
 
     TEST_LOG << "select a such that Modifies(a, 'variable')";
     qps::query::Query query;
+    query.addDeclaration("a", qps::query::DesignEntity::ASSIGN);
     std::shared_ptr<qps::query::ModifiesS> mPtr = std::make_shared<qps::query::ModifiesS>();
-    mPtr->modifiesStmt = qps::query::StmtRef::ofDeclaration( Declaration { "a", qps::query::DesignEntity::ASSIGN });
+    mPtr->modifiesStmt = qps::query::StmtRef::ofDeclaration( query.getDeclaration("a"));
     mPtr->modified = qps::query::EntRef::ofVarName("variable");
 
-    query.addDeclaration("a", qps::query::DesignEntity::ASSIGN);
-
-    qps::query::Declaration d = qps::query::Declaration { "a", qps::query::DesignEntity::ASSIGN };
+    qps::query::Declaration d = query.getDeclaration("a");
     std::vector<qps::query::Elem> tuple { qps::query::Elem::ofDeclaration(d) };
     qps::query::ResultCl r = qps::query::ResultCl::ofTuple(tuple);
     query.addResultCl(r);
@@ -121,14 +120,13 @@ TEST_CASE("Test get Modifies") {
 
     TEST_LOG << "stmt s; assign a; select s such that Modifies(a, 'variable')";
     qps::query::Query query1;
-    std::shared_ptr<qps::query::ModifiesS> mPtr1 = std::make_shared<qps::query::ModifiesS>();
-    mPtr1->modifiesStmt = qps::query::StmtRef::ofDeclaration( Declaration { "a", qps::query::DesignEntity::ASSIGN });
-    mPtr1->modified = qps::query::EntRef::ofVarName("variable");
-
     query1.addDeclaration("a", qps::query::DesignEntity::ASSIGN);
     query1.addDeclaration("s", qps::query::DesignEntity::STMT);
+    std::shared_ptr<qps::query::ModifiesS> mPtr1 = std::make_shared<qps::query::ModifiesS>();
+    mPtr1->modifiesStmt = qps::query::StmtRef::ofDeclaration( query1.getDeclaration("a"));
+    mPtr1->modified = qps::query::EntRef::ofVarName("variable");
 
-    qps::query::Declaration d1 = qps::query::Declaration { "s", qps::query::DesignEntity::STMT };
+    qps::query::Declaration d1 = query1.getDeclaration("s");
     std::vector<qps::query::Elem> tuple1 { qps::query::Elem::ofDeclaration(d1) };
     qps::query::ResultCl r1 = qps::query::ResultCl::ofTuple(tuple1);
     query1.addResultCl(r1);
@@ -145,14 +143,14 @@ TEST_CASE("Test get Modifies") {
 
     query2.addDeclaration("v", qps::query::DesignEntity::VARIABLE);
 
-    qps::query::Declaration d2 = qps::query::Declaration { "v", qps::query::DesignEntity::VARIABLE };
+    qps::query::Declaration d2 = query2.getDeclaration("v");
     std::vector<qps::query::Elem> tuple2 { qps::query::Elem::ofDeclaration(d2) };
     qps::query::ResultCl r2 = qps::query::ResultCl::ofTuple(tuple2);
     query2.addResultCl(r2);
 
     std::shared_ptr<qps::query::ModifiesS> mPtr2 = std::make_shared<qps::query::ModifiesS>();
     mPtr2->modifiesStmt = qps::query::StmtRef::ofLineNo(5);
-    mPtr2->modified = qps::query::EntRef::ofDeclaration( Declaration { "v", qps::query::DesignEntity::VARIABLE });
+    mPtr2->modified = qps::query::EntRef::ofDeclaration( query2.getDeclaration("v"));
     query2.addSuchthat(mPtr2);
     qps::evaluator::Evaluator evaluator2 = qps::evaluator::Evaluator{pkbPtr};
     std::list<std::string> result2 = evaluator2.evaluate(query2);
@@ -164,13 +162,13 @@ TEST_CASE("Test get Modifies") {
     qps::query::Query query3;
     query3.addDeclaration("s", qps::query::DesignEntity::STMT);
 
-    qps::query::Declaration d3 = qps::query::Declaration { "s", qps::query::DesignEntity::STMT };
+    qps::query::Declaration d3 = query3.getDeclaration("s");
     std::vector<qps::query::Elem> tuple3 { qps::query::Elem::ofDeclaration(d3) };
     qps::query::ResultCl r3 = qps::query::ResultCl::ofTuple(tuple3);
     query3.addResultCl(r3);
 
     std::shared_ptr<qps::query::ModifiesS> mPtr3 = std::make_shared<qps::query::ModifiesS>();
-    mPtr3->modifiesStmt = qps::query::StmtRef::ofDeclaration( Declaration { "s", qps::query::DesignEntity::STMT });
+    mPtr3->modifiesStmt = qps::query::StmtRef::ofDeclaration( query3.getDeclaration("s"));
     mPtr3->modified = qps::query::EntRef::ofWildcard();
     query3.addSuchthat(mPtr3);
     qps::evaluator::Evaluator evaluator3 = qps::evaluator::Evaluator{pkbPtr};
@@ -183,14 +181,14 @@ TEST_CASE("Test get Modifies") {
     qps::query::Query query4;
     query4.addDeclaration("v", qps::query::DesignEntity::VARIABLE);
 
-    qps::query::Declaration d4 = qps::query::Declaration { "v", qps::query::DesignEntity::VARIABLE };
+    qps::query::Declaration d4 = query4.getDeclaration("v");
     std::vector<qps::query::Elem> tuple4 { qps::query::Elem::ofDeclaration(d4) };
     qps::query::ResultCl r4 = qps::query::ResultCl::ofTuple(tuple4);
     query4.addResultCl(r4);
 
     std::shared_ptr<qps::query::ModifiesS> mPtr4 = std::make_shared<qps::query::ModifiesS>();
     mPtr4->modifiesStmt = qps::query::StmtRef::ofLineNo(3);
-    mPtr4->modified = qps::query::EntRef::ofDeclaration( Declaration { "v", qps::query::DesignEntity::VARIABLE });
+    mPtr4->modified = qps::query::EntRef::ofDeclaration( query4.getDeclaration("v"));
     query4.addSuchthat(mPtr4);
     qps::evaluator::Evaluator evaluator4 = qps::evaluator::Evaluator{pkbPtr};
     std::list<std::string> result4 = evaluator4.evaluate(query4);
@@ -200,13 +198,12 @@ TEST_CASE("Test get Modifies") {
 
     TEST_LOG << "select p such that ModifiesP(p, 'variable')";
     qps::query::Query query5;
+    query5.addDeclaration("p", qps::query::DesignEntity::PROCEDURE);
     std::shared_ptr<qps::query::ModifiesP> mPtr5 = std::make_shared<qps::query::ModifiesP>();
-    mPtr5->modifiesProc = qps::query::EntRef::ofDeclaration( Declaration { "p", qps::query::DesignEntity::PROCEDURE });
+    mPtr5->modifiesProc = qps::query::EntRef::ofDeclaration( query5.getDeclaration("p"));
     mPtr5->modified = qps::query::EntRef::ofVarName("variable");
 
-    query5.addDeclaration("p", qps::query::DesignEntity::PROCEDURE);
-
-    qps::query::Declaration d5 = qps::query::Declaration { "p", qps::query::DesignEntity::PROCEDURE };
+    qps::query::Declaration d5 = query5.getDeclaration("p");
     std::vector<qps::query::Elem> tuple5 { qps::query::Elem::ofDeclaration(d5) };
     qps::query::ResultCl r5 = qps::query::ResultCl::ofTuple(tuple5);
     query5.addResultCl(r5);
@@ -221,13 +218,12 @@ TEST_CASE("Test get Modifies") {
 
     TEST_LOG << "select v such that ModifiesP('proc1', v)";
     qps::query::Query query6;
+    query6.addDeclaration("v", qps::query::DesignEntity::VARIABLE);
     std::shared_ptr<qps::query::ModifiesP> mPtr6 = std::make_shared<qps::query::ModifiesP>();
     mPtr6->modifiesProc = qps::query::EntRef::ofVarName("proc1");
-    mPtr6->modified = qps::query::EntRef::ofDeclaration( Declaration { "v", qps::query::DesignEntity::VARIABLE });
+    mPtr6->modified = qps::query::EntRef::ofDeclaration( query6.getDeclaration("v"));
 
-    query6.addDeclaration("v", qps::query::DesignEntity::VARIABLE);
-
-    qps::query::Declaration d6 = qps::query::Declaration { "v", qps::query::DesignEntity::VARIABLE };
+    qps::query::Declaration d6 = query6.getDeclaration("v");
     std::vector<qps::query::Elem> tuple6 { qps::query::Elem::ofDeclaration(d6) };
     qps::query::ResultCl r6 = qps::query::ResultCl::ofTuple(tuple6);
     query6.addResultCl(r6);
@@ -249,13 +245,13 @@ TEST_CASE("Test get Uses") {
     qps::query::Query query1;
     query1.addDeclaration("s", qps::query::DesignEntity::STMT);
 
-    qps::query::Declaration d1 = qps::query::Declaration { "s", qps::query::DesignEntity::STMT };
+    qps::query::Declaration d1 = query1.getDeclaration("s");
     std::vector<qps::query::Elem> tuple1 { qps::query::Elem::ofDeclaration(d1) };
     qps::query::ResultCl r1 = qps::query::ResultCl::ofTuple(tuple1);
     query1.addResultCl(r1);
 
     std::shared_ptr<qps::query::UsesS> mPtr1 = std::make_shared<qps::query::UsesS>();
-    mPtr1->useStmt = qps::query::StmtRef::ofDeclaration( Declaration { "s", qps::query::DesignEntity::STMT });
+    mPtr1->useStmt = qps::query::StmtRef::ofDeclaration( query1.getDeclaration("s"));
     mPtr1->used = qps::query::EntRef::ofVarName("x");
     query1.addSuchthat(mPtr1);
     qps::evaluator::Evaluator e1 = qps::evaluator::Evaluator{pkbPtr};
@@ -268,13 +264,13 @@ TEST_CASE("Test get Uses") {
     qps::query::Query query2;
     query2.addDeclaration("p", qps::query::DesignEntity::PRINT);
 
-    qps::query::Declaration d2 = qps::query::Declaration { "p", qps::query::DesignEntity::PRINT };
+    qps::query::Declaration d2 = query2.getDeclaration("p");
     std::vector<qps::query::Elem> tuple2 { qps::query::Elem::ofDeclaration(d2) };
     qps::query::ResultCl r2 = qps::query::ResultCl::ofTuple(tuple2);
     query2.addResultCl(r2);
 
     std::shared_ptr<qps::query::UsesS> mPtr2 = std::make_shared<qps::query::UsesS>();
-    mPtr2->useStmt = qps::query::StmtRef::ofDeclaration( Declaration { "p", qps::query::DesignEntity::PRINT });
+    mPtr2->useStmt = qps::query::StmtRef::ofDeclaration( query2.getDeclaration("p"));
     mPtr2->used = qps::query::EntRef::ofWildcard();
     query2.addSuchthat(mPtr2);
     qps::evaluator::Evaluator e2 = qps::evaluator::Evaluator{pkbPtr};
@@ -288,14 +284,14 @@ TEST_CASE("Test get Uses") {
     query3.addDeclaration("v", qps::query::DesignEntity::VARIABLE);
     query3.addDeclaration("s", qps::query::DesignEntity::STMT);
 
-    qps::query::Declaration d3 = qps::query::Declaration { "v", qps::query::DesignEntity::VARIABLE };
+    qps::query::Declaration d3 = query3.getDeclaration("v");
     std::vector<qps::query::Elem> tuple3 { qps::query::Elem::ofDeclaration(d3) };
     qps::query::ResultCl r3 = qps::query::ResultCl::ofTuple(tuple3);
     query3.addResultCl(r3);
 
     std::shared_ptr<qps::query::UsesS> mPtr3 = std::make_shared<qps::query::UsesS>();
-    mPtr3->useStmt = qps::query::StmtRef::ofDeclaration( Declaration { "s", qps::query::DesignEntity::STMT });
-    mPtr3->used = qps::query::EntRef::ofDeclaration( Declaration { "v", qps::query::DesignEntity::VARIABLE });
+    mPtr3->useStmt = qps::query::StmtRef::ofDeclaration( query3.getDeclaration("s"));
+    mPtr3->used = qps::query::EntRef::ofDeclaration( query3.getDeclaration("v"));
     query3.addSuchthat(mPtr3);
     qps::evaluator::Evaluator e3 = qps::evaluator::Evaluator{pkbPtr};
     std::list<std::string> result3 = e3.evaluate(query3);
@@ -307,14 +303,14 @@ TEST_CASE("Test get Uses") {
     qps::query::Query query4;
     query4.addDeclaration("v", qps::query::DesignEntity::VARIABLE);
 
-    qps::query::Declaration d4 = qps::query::Declaration { "v", qps::query::DesignEntity::VARIABLE };
+    qps::query::Declaration d4 = query4.getDeclaration("v");
     std::vector<qps::query::Elem> tuple4 { qps::query::Elem::ofDeclaration(d4) };
     qps::query::ResultCl r4 = qps::query::ResultCl::ofTuple(tuple4);
     query4.addResultCl(r4);
 
     std::shared_ptr<qps::query::UsesP> mPtr4 = std::make_shared<qps::query::UsesP>();
     mPtr4->useProc = qps::query::EntRef::ofVarName("proc1");
-    mPtr4->used = qps::query::EntRef::ofDeclaration( Declaration { "v", qps::query::DesignEntity::VARIABLE });
+    mPtr4->used = qps::query::EntRef::ofDeclaration( query4.getDeclaration("v"));
     query4.addSuchthat(mPtr4);
     qps::evaluator::Evaluator evaluator4 = qps::evaluator::Evaluator{pkbPtr};
     std::list<std::string> result4 = evaluator4.evaluate(query4);
@@ -324,13 +320,12 @@ TEST_CASE("Test get Uses") {
 
     TEST_LOG << "select p such that UsesP(p, 'variable')";
     qps::query::Query query5;
+    query5.addDeclaration("p", qps::query::DesignEntity::PROCEDURE);
     std::shared_ptr<qps::query::UsesP> mPtr5 = std::make_shared<qps::query::UsesP>();
-    mPtr5->useProc = qps::query::EntRef::ofDeclaration( Declaration { "p", qps::query::DesignEntity::PROCEDURE });
+    mPtr5->useProc = qps::query::EntRef::ofDeclaration( query5.getDeclaration("p"));
     mPtr5->used = qps::query::EntRef::ofVarName("variable");
 
-    query5.addDeclaration("p", qps::query::DesignEntity::PROCEDURE);
-
-    qps::query::Declaration d5 = qps::query::Declaration { "p", qps::query::DesignEntity::PROCEDURE };
+    qps::query::Declaration d5 = query5.getDeclaration("p");
     std::vector<qps::query::Elem> tuple5 { qps::query::Elem::ofDeclaration(d5) };
     qps::query::ResultCl r5 = qps::query::ResultCl::ofTuple(tuple5);
     query5.addResultCl(r5);
@@ -345,13 +340,12 @@ TEST_CASE("Test get Uses") {
 
     TEST_LOG << "select p such that ModifiesP(p, _)";
     qps::query::Query query6;
+    query6.addDeclaration("p", qps::query::DesignEntity::PROCEDURE);
     std::shared_ptr<qps::query::UsesP> mPtr6 = std::make_shared<qps::query::UsesP>();
-    mPtr6->useProc = qps::query::EntRef::ofDeclaration( Declaration { "p", qps::query::DesignEntity::PROCEDURE });
+    mPtr6->useProc = qps::query::EntRef::ofDeclaration( query6.getDeclaration("p"));
     mPtr6->used = qps::query::EntRef::ofWildcard();
 
-    query6.addDeclaration("p", qps::query::DesignEntity::PROCEDURE);
-
-    qps::query::Declaration d6 = qps::query::Declaration { "p", qps::query::DesignEntity::PROCEDURE };
+    qps::query::Declaration d6 = query6.getDeclaration("p");
     std::vector<qps::query::Elem> tuple6 { qps::query::Elem::ofDeclaration(d6) };
     qps::query::ResultCl r6 = qps::query::ResultCl::ofTuple(tuple6);
     query6.addResultCl(r6);
@@ -373,13 +367,13 @@ TEST_CASE("Test get Follows FollowsT") {
     qps::query::Query query1;
     query1.addDeclaration("s", qps::query::DesignEntity::STMT);
 
-    qps::query::Declaration d1 = qps::query::Declaration { "s", qps::query::DesignEntity::STMT };
+    qps::query::Declaration d1 = query1.getDeclaration("s");
     std::vector<qps::query::Elem> tuple1 { qps::query::Elem::ofDeclaration(d1) };
     qps::query::ResultCl r1 = qps::query::ResultCl::ofTuple(tuple1);
     query1.addResultCl(r1);
 
     std::shared_ptr<qps::query::Follows> mPtr1 = std::make_shared<qps::query::Follows>();
-    mPtr1->follower = qps::query::StmtRef::ofDeclaration( Declaration { "s", qps::query::DesignEntity::STMT });
+    mPtr1->follower = qps::query::StmtRef::ofDeclaration( query1.getDeclaration("s"));
     mPtr1->followed = qps::query::StmtRef::ofLineNo(3);
     query1.addSuchthat(mPtr1);
     qps::evaluator::Evaluator e1 = qps::evaluator::Evaluator{pkbPtr};
@@ -392,15 +386,14 @@ TEST_CASE("Test get Follows FollowsT") {
     qps::query::Query query2;
     query2.addDeclaration("s", qps::query::DesignEntity::STMT);
 
-    qps::query::Declaration d2 = qps::query::Declaration { "s", qps::query::DesignEntity::STMT };
+    qps::query::Declaration d2 = query2.getDeclaration("s");
     std::vector<qps::query::Elem> tuple2 { qps::query::Elem::ofDeclaration(d2) };
     qps::query::ResultCl r2 = qps::query::ResultCl::ofTuple(tuple2);
     query2.addResultCl(r2);
 
     std::shared_ptr<qps::query::FollowsT> mPtr2 = std::make_shared<qps::query::FollowsT>();
     mPtr2->follower = qps::query::StmtRef::ofLineNo(3);
-    mPtr2->transitiveFollowed = qps::query::StmtRef::ofDeclaration( Declaration { "s",
-                                                                                  qps::query::DesignEntity::STMT });
+    mPtr2->transitiveFollowed = qps::query::StmtRef::ofDeclaration( query2.getDeclaration("s"));
     query2.addSuchthat(mPtr2);
     qps::evaluator::Evaluator e2 = qps::evaluator::Evaluator{pkbPtr};
     std::list<std::string> result2 = e2.evaluate(query2);
@@ -412,7 +405,7 @@ TEST_CASE("Test get Follows FollowsT") {
     qps::query::Query query3;
     query3.addDeclaration("s", qps::query::DesignEntity::STMT);
 
-    qps::query::Declaration d3 = qps::query::Declaration { "s", qps::query::DesignEntity::STMT };
+    qps::query::Declaration d3 = query3.getDeclaration("s");
     std::vector<qps::query::Elem> tuple3 { qps::query::Elem::ofDeclaration(d3) };
     qps::query::ResultCl r3 = qps::query::ResultCl::ofTuple(tuple3);
     query3.addResultCl(r3);
@@ -420,7 +413,7 @@ TEST_CASE("Test get Follows FollowsT") {
     std::shared_ptr<qps::query::FollowsT> mPtr3 = std::make_shared<qps::query::FollowsT>();
     mPtr3->follower = qps::query::StmtRef::ofWildcard();
     mPtr3->transitiveFollowed = qps::query::StmtRef::ofDeclaration(
-            Declaration { "s", qps::query::DesignEntity::STMT });
+            query3.getDeclaration("s"));
     query3.addSuchthat(mPtr3);
     qps::evaluator::Evaluator e3 = qps::evaluator::Evaluator{pkbPtr};
     std::list<std::string> result3 = e3.evaluate(query3);
@@ -432,14 +425,14 @@ TEST_CASE("Test get Follows FollowsT") {
     qps::query::Query query4;
     query4.addDeclaration("s", qps::query::DesignEntity::STMT);
 
-    qps::query::Declaration d4 = qps::query::Declaration { "s", qps::query::DesignEntity::STMT };
+    qps::query::Declaration d4 = query4.getDeclaration("s");
     std::vector<qps::query::Elem> tuple4 { qps::query::Elem::ofDeclaration(d4) };
     qps::query::ResultCl r4 = qps::query::ResultCl::ofTuple(tuple4);
     query4.addResultCl(r4);
 
     std::shared_ptr<qps::query::Follows> mPtr4 = std::make_shared<qps::query::Follows>();
-    mPtr4->follower = qps::query::StmtRef::ofDeclaration( Declaration { "s", qps::query::DesignEntity::STMT });
-    mPtr4->followed = qps::query::StmtRef::ofDeclaration( Declaration { "s", qps::query::DesignEntity::STMT });
+    mPtr4->follower = qps::query::StmtRef::ofDeclaration( query4.getDeclaration("s"));
+    mPtr4->followed = qps::query::StmtRef::ofDeclaration( query4.getDeclaration("s"));
     query4.addSuchthat(mPtr4);
     qps::evaluator::Evaluator e4 = qps::evaluator::Evaluator{pkbPtr};
     std::list<std::string> result4 = e3.evaluate(query4);
@@ -456,14 +449,14 @@ TEST_CASE("Test Parent") {
     qps::query::Query query1;
     query1.addDeclaration("a", qps::query::DesignEntity::ASSIGN);
 
-    qps::query::Declaration d1 = qps::query::Declaration { "a", qps::query::DesignEntity::ASSIGN };
+    qps::query::Declaration d1 = query1.getDeclaration("a");
     std::vector<qps::query::Elem> tuple1 { qps::query::Elem::ofDeclaration(d1) };
     qps::query::ResultCl r1 = qps::query::ResultCl::ofTuple(tuple1);
     query1.addResultCl(r1);
 
     std::shared_ptr<qps::query::Parent> mPtr1 = std::make_shared<qps::query::Parent>();
     mPtr1->parent = qps::query::StmtRef::ofLineNo(3);
-    mPtr1->child = qps::query::StmtRef::ofDeclaration( Declaration { "a", qps::query::DesignEntity::ASSIGN });
+    mPtr1->child = qps::query::StmtRef::ofDeclaration( query1.getDeclaration("a"));
     query1.addSuchthat(mPtr1);
     qps::evaluator::Evaluator e1 = qps::evaluator::Evaluator{pkbPtr};
     std::list<std::string> result1 = e1.evaluate(query1);
@@ -475,14 +468,14 @@ TEST_CASE("Test Parent") {
     qps::query::Query query2;
     query2.addDeclaration("a", qps::query::DesignEntity::ASSIGN);
 
-    qps::query::Declaration d2 = qps::query::Declaration { "a", qps::query::DesignEntity::ASSIGN };
+    qps::query::Declaration d2 = query2.getDeclaration("a");
     std::vector<qps::query::Elem> tuple2 { qps::query::Elem::ofDeclaration(d2) };
     qps::query::ResultCl r2 = qps::query::ResultCl::ofTuple(tuple2);
     query2.addResultCl(r2);
 
     std::shared_ptr<qps::query::Parent> mPtr2 = std::make_shared<qps::query::Parent>();
-    mPtr2->parent = qps::query::StmtRef::ofDeclaration( Declaration { "a", qps::query::DesignEntity::ASSIGN });
-    mPtr2->child = qps::query::StmtRef::ofDeclaration( Declaration { "a", qps::query::DesignEntity::ASSIGN });
+    mPtr2->parent = qps::query::StmtRef::ofDeclaration( query2.getDeclaration("a"));
+    mPtr2->child = qps::query::StmtRef::ofDeclaration( query2.getDeclaration("a"));
     query2.addSuchthat(mPtr2);
     qps::evaluator::Evaluator e2 = qps::evaluator::Evaluator{pkbPtr};
     std::list<std::string> result2 = e2.evaluate(query2);
@@ -498,14 +491,14 @@ TEST_CASE("Test Next and NextT") {
     qps::query::Query query1;
     query1.addDeclaration("s", qps::query::DesignEntity::STMT);
 
-    qps::query::Declaration d1 = qps::query::Declaration { "s", qps::query::DesignEntity::STMT };
+    qps::query::Declaration d1 = query1.getDeclaration("s");
     std::vector<qps::query::Elem> tuple1 { qps::query::Elem::ofDeclaration(d1) };
     qps::query::ResultCl r1 = qps::query::ResultCl::ofTuple(tuple1);
     query1.addResultCl(r1);
 
     std::shared_ptr<qps::query::Next> mPtr1 = std::make_shared<qps::query::Next>();
     mPtr1->before = qps::query::StmtRef::ofLineNo(1);
-    mPtr1->after = qps::query::StmtRef::ofDeclaration( Declaration { "s", qps::query::DesignEntity::STMT });
+    mPtr1->after = qps::query::StmtRef::ofDeclaration( query1.getDeclaration("s"));
     query1.addSuchthat(mPtr1);
     qps::evaluator::Evaluator e1 = qps::evaluator::Evaluator{pkbPtr};
     std::list<std::string> result1 = e1.evaluate(query1);
@@ -517,14 +510,14 @@ TEST_CASE("Test Next and NextT") {
     qps::query::Query query2;
     query2.addDeclaration("s", qps::query::DesignEntity::STMT);
 
-    qps::query::Declaration d2 = qps::query::Declaration { "s", qps::query::DesignEntity::STMT };
+    qps::query::Declaration d2 = query2.getDeclaration("s");
     std::vector<qps::query::Elem> tuple2 { qps::query::Elem::ofDeclaration(d2) };
     qps::query::ResultCl r2 = qps::query::ResultCl::ofTuple(tuple2);
     query2.addResultCl(r2);
 
     std::shared_ptr<qps::query::NextT> mPtr2 = std::make_shared<qps::query::NextT>();
     mPtr2->before = qps::query::StmtRef::ofLineNo(2);
-    mPtr2->transitiveAfter = qps::query::StmtRef::ofDeclaration( Declaration { "s", qps::query::DesignEntity::STMT });
+    mPtr2->transitiveAfter = qps::query::StmtRef::ofDeclaration( query2.getDeclaration("s"));
     query2.addSuchthat(mPtr2);
     qps::evaluator::Evaluator e2 = qps::evaluator::Evaluator{pkbPtr};
     std::list<std::string> result2 = e2.evaluate(query2);
@@ -536,13 +529,13 @@ TEST_CASE("Test Next and NextT") {
     qps::query::Query query3;
     query3.addDeclaration("a", qps::query::DesignEntity::ASSIGN);
 
-    qps::query::Declaration d3 = qps::query::Declaration { "a", qps::query::DesignEntity::ASSIGN };
+    qps::query::Declaration d3 = query3.getDeclaration("a");
     std::vector<qps::query::Elem> tuple3 { qps::query::Elem::ofDeclaration(d3) };
     qps::query::ResultCl r3 = qps::query::ResultCl::ofTuple(tuple3);
     query3.addResultCl(r3);
 
     std::shared_ptr<qps::query::NextT> mPtr3 = std::make_shared<qps::query::NextT>();
-    mPtr3->before = qps::query::StmtRef::ofDeclaration( Declaration { "a", qps::query::DesignEntity::ASSIGN });
+    mPtr3->before = qps::query::StmtRef::ofDeclaration( query3.getDeclaration("a"));
     mPtr3->transitiveAfter = qps::query::StmtRef::ofWildcard();
     query3.addSuchthat(mPtr3);
     qps::evaluator::Evaluator e3 = qps::evaluator::Evaluator{pkbPtr};
@@ -560,13 +553,13 @@ TEST_CASE("Test get Calls and CallsT") {
     qps::query::Query query1;
     query1.addDeclaration("p", qps::query::DesignEntity::PROCEDURE);
 
-    qps::query::Declaration d1 = qps::query::Declaration { "p", qps::query::DesignEntity::PROCEDURE };
+    qps::query::Declaration d1 = query1.getDeclaration("p");
     std::vector<qps::query::Elem> tuple1 { qps::query::Elem::ofDeclaration(d1) };
     qps::query::ResultCl r1 = qps::query::ResultCl::ofTuple(tuple1);
     query1.addResultCl(r1);
 
     std::shared_ptr<qps::query::Calls> mPtr1 = std::make_shared<qps::query::Calls>();
-    mPtr1->caller = qps::query::EntRef::ofDeclaration( Declaration { "p", qps::query::DesignEntity::PROCEDURE });
+    mPtr1->caller = qps::query::EntRef::ofDeclaration( query1.getDeclaration("p"));
     mPtr1->callee = qps::query::EntRef::ofVarName("proc2");
     query1.addSuchthat(mPtr1);
     qps::evaluator::Evaluator e1 = qps::evaluator::Evaluator{pkbPtr};
@@ -579,15 +572,14 @@ TEST_CASE("Test get Calls and CallsT") {
     qps::query::Query query2;
     query2.addDeclaration("p", qps::query::DesignEntity::PROCEDURE);
 
-    qps::query::Declaration d2 = qps::query::Declaration { "p", qps::query::DesignEntity::PROCEDURE };
+    qps::query::Declaration d2 = query2.getDeclaration("p");
     std::vector<qps::query::Elem> tuple2 { qps::query::Elem::ofDeclaration(d2) };
     qps::query::ResultCl r2 = qps::query::ResultCl::ofTuple(tuple2);
     query2.addResultCl(r2);
 
     std::shared_ptr<qps::query::CallsT> mPtr2 = std::make_shared<qps::query::CallsT>();
     mPtr2->caller = qps::query::EntRef::ofVarName("proc1");
-    mPtr2->transitiveCallee = qps::query::EntRef::ofDeclaration( Declaration { "p",
-                                                                               qps::query::DesignEntity::PROCEDURE });
+    mPtr2->transitiveCallee = qps::query::EntRef::ofDeclaration( query2.getDeclaration("p"));
     query2.addSuchthat(mPtr2);
     qps::evaluator::Evaluator e2 = qps::evaluator::Evaluator{pkbPtr};
     std::list<std::string> result2 = e2.evaluate(query2);
@@ -599,13 +591,13 @@ TEST_CASE("Test get Calls and CallsT") {
     qps::query::Query query3;
     query3.addDeclaration("p", qps::query::DesignEntity::PROCEDURE);
 
-    qps::query::Declaration d3 = qps::query::Declaration { "p", qps::query::DesignEntity::PROCEDURE };
+    qps::query::Declaration d3 = query3.getDeclaration("p");
     std::vector<qps::query::Elem> tuple3 { qps::query::Elem::ofDeclaration(d3) };
     qps::query::ResultCl r3 = qps::query::ResultCl::ofTuple(tuple3);
     query3.addResultCl(r3);
 
     std::shared_ptr<qps::query::CallsT> mPtr3 = std::make_shared<qps::query::CallsT>();
-    mPtr3->caller = qps::query::EntRef::ofDeclaration( Declaration { "p", qps::query::DesignEntity::PROCEDURE });
+    mPtr3->caller = qps::query::EntRef::ofDeclaration( query3.getDeclaration("p"));
     mPtr3->transitiveCallee = qps::query::EntRef::ofWildcard();
     query3.addSuchthat(mPtr3);
     qps::evaluator::Evaluator e3 = qps::evaluator::Evaluator{pkbPtr};
@@ -623,7 +615,7 @@ TEST_CASE("Test isRelationshipPresent") {
     qps::query::Query query1;
     query1.addDeclaration("a", qps::query::DesignEntity::ASSIGN);
 
-    qps::query::Declaration d1 = qps::query::Declaration { "a", qps::query::DesignEntity::ASSIGN };
+    qps::query::Declaration d1 = query1.getDeclaration("a");
     std::vector<qps::query::Elem> tuple1 { qps::query::Elem::ofDeclaration(d1) };
     qps::query::ResultCl r1 = qps::query::ResultCl::ofTuple(tuple1);
     query1.addResultCl(r1);
@@ -642,7 +634,7 @@ TEST_CASE("Test isRelationshipPresent") {
     qps::query::Query query2;
     query2.addDeclaration("s", qps::query::DesignEntity::STMT);
 
-    qps::query::Declaration d2 = qps::query::Declaration { "s", qps::query::DesignEntity::STMT};
+    qps::query::Declaration d2 = query2.getDeclaration("s");
     std::vector<qps::query::Elem> tuple2 { qps::query::Elem::ofDeclaration(d2) };
     qps::query::ResultCl r2 = qps::query::ResultCl::ofTuple(tuple2);
     query2.addResultCl(r2);
@@ -661,7 +653,7 @@ TEST_CASE("Test isRelationshipPresent") {
     qps::query::Query query3;
     query3.addDeclaration("v", qps::query::DesignEntity::VARIABLE);
 
-    qps::query::Declaration d3 = qps::query::Declaration { "v", qps::query::DesignEntity::VARIABLE };
+    qps::query::Declaration d3 = query3.getDeclaration("v");
     std::vector<qps::query::Elem> tuple3 { qps::query::Elem::ofDeclaration(d3) };
     qps::query::ResultCl r3 = qps::query::ResultCl::ofTuple(tuple3);
     query3.addResultCl(r3);
@@ -680,7 +672,7 @@ TEST_CASE("Test isRelationshipPresent") {
     qps::query::Query query4;
     query4.addDeclaration("s", qps::query::DesignEntity::STMT);
 
-    qps::query::Declaration d4 = qps::query::Declaration { "s", qps::query::DesignEntity::STMT };
+    qps::query::Declaration d4 = query4.getDeclaration("s");
     std::vector<qps::query::Elem> tuple4 { qps::query::Elem::ofDeclaration(d4) };
     qps::query::ResultCl r4 = qps::query::ResultCl::ofTuple(tuple4);
     query4.addResultCl(r4);
@@ -699,7 +691,7 @@ TEST_CASE("Test isRelationshipPresent") {
     qps::query::Query query5;
     query5.addDeclaration("s", qps::query::DesignEntity::STMT);
 
-    qps::query::Declaration d5 = qps::query::Declaration { "s", qps::query::DesignEntity::STMT };
+    qps::query::Declaration d5 = query5.getDeclaration("s");
     std::vector<qps::query::Elem> tuple5 { qps::query::Elem::ofDeclaration(d5) };
     qps::query::ResultCl r5 = qps::query::ResultCl::ofTuple(tuple5);
     query5.addResultCl(r5);
@@ -723,18 +715,18 @@ TEST_CASE("multiple relationship clauses") {
     query1.addDeclaration("a", qps::query::DesignEntity::ASSIGN);
     query1.addDeclaration("v", qps::query::DesignEntity::VARIABLE);
 
-    qps::query::Declaration d1 = qps::query::Declaration { "v", qps::query::DesignEntity::VARIABLE };
+    qps::query::Declaration d1 = query1.getDeclaration("v");
     std::vector<qps::query::Elem> tuple1 { qps::query::Elem::ofDeclaration(d1) };
     qps::query::ResultCl r1 = qps::query::ResultCl::ofTuple(tuple1);
     query1.addResultCl(r1);
 
     std::shared_ptr<qps::query::Parent> mPtr11 = std::make_shared<qps::query::Parent>();
     mPtr11->parent = qps::query::StmtRef::ofLineNo(3);
-    mPtr11->child = qps::query::StmtRef::ofDeclaration( Declaration { "a", qps::query::DesignEntity::ASSIGN });
+    mPtr11->child = qps::query::StmtRef::ofDeclaration( query1.getDeclaration("a"));
     query1.addSuchthat(mPtr11);
     std::shared_ptr<qps::query::ModifiesS> mPtr12 = std::make_shared<qps::query::ModifiesS>();
-    mPtr12->modifiesStmt = qps::query::StmtRef::ofDeclaration( Declaration { "a", qps::query::DesignEntity::ASSIGN });
-    mPtr12->modified = qps::query::EntRef::ofDeclaration( Declaration { "v", qps::query::DesignEntity::VARIABLE });
+    mPtr12->modifiesStmt = qps::query::StmtRef::ofDeclaration( query1.getDeclaration("a"));
+    mPtr12->modified = qps::query::EntRef::ofDeclaration( query1.getDeclaration("v"));
     query1.addSuchthat(mPtr12);
     qps::evaluator::Evaluator e1 = qps::evaluator::Evaluator{pkbPtr};
     std::list<std::string> result1 = e1.evaluate(query1);
@@ -748,23 +740,22 @@ TEST_CASE("multiple relationship clauses") {
     query2.addDeclaration("v", qps::query::DesignEntity::VARIABLE);
     query2.addDeclaration("s", qps::query::DesignEntity::STMT);
 
-    qps::query::Declaration d2 = qps::query::Declaration { "s", qps::query::DesignEntity::STMT };
+    qps::query::Declaration d2 = query2.getDeclaration("s");
     std::vector<qps::query::Elem> tuple2 { qps::query::Elem::ofDeclaration(d2) };
     qps::query::ResultCl r2 = qps::query::ResultCl::ofTuple(tuple2);
     query2.addResultCl(r2);
 
     std::shared_ptr<qps::query::CallsT> mPtr21 = std::make_shared<qps::query::CallsT>();
     mPtr21->caller = qps::query::EntRef::ofVarName("proc1");
-    mPtr21->transitiveCallee = qps::query::EntRef::ofDeclaration( Declaration { "p",
-                                                                                qps::query::DesignEntity::PROCEDURE });
+    mPtr21->transitiveCallee = qps::query::EntRef::ofDeclaration( query2.getDeclaration("p"));
     query2.addSuchthat(mPtr21);
     std::shared_ptr<qps::query::UsesP> mPtr22 = std::make_shared<qps::query::UsesP>();
-    mPtr22->useProc = qps::query::EntRef::ofDeclaration( Declaration { "p", qps::query::DesignEntity::PROCEDURE });
-    mPtr22->used = qps::query::EntRef::ofDeclaration( Declaration { "v", qps::query::DesignEntity::VARIABLE });
+    mPtr22->useProc = qps::query::EntRef::ofDeclaration( query2.getDeclaration("p"));
+    mPtr22->used = qps::query::EntRef::ofDeclaration( query2.getDeclaration("v"));
     query2.addSuchthat(mPtr22);
     std::shared_ptr<qps::query::UsesS> mPtr23 = std::make_shared<qps::query::UsesS>();
-    mPtr23->useStmt = qps::query::StmtRef::ofDeclaration( Declaration { "s", qps::query::DesignEntity::STMT });
-    mPtr23->used = qps::query::EntRef::ofDeclaration( Declaration { "v", qps::query::DesignEntity::VARIABLE });
+    mPtr23->useStmt = qps::query::StmtRef::ofDeclaration( query2.getDeclaration("s"));
+    mPtr23->used = qps::query::EntRef::ofDeclaration( query2.getDeclaration("v"));
     query2.addSuchthat(mPtr23);
     qps::evaluator::Evaluator e2 = qps::evaluator::Evaluator{pkbPtr};
     std::list<std::string> result2 = e2.evaluate(query2);
@@ -0,0 +1,121 @@
+#include <algorithm>
+#include <functional>
+#include <list>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "catch.hpp"
+
+#include "PKB.h"
+#include "ProgramGenerator.h"
+#include "QPS/QPS.h"
+#include "QueryGenerator.h"
+#include "SourceProcessor.h"
+
+namespace {
+std::vector<std::vector<PKBField>> getPairs(PKB& pkb, PKBRelationship rs, PKBField field) {
+    PKBResponse response = pkb.getRelationship(field, field, rs);
+    auto *rows = response.getResponse<FieldRowResponse>();
+    return rows ? std::vector<std::vector<PKBField>>(rows->begin(), rows->end())
+                : std::vector<std::vector<PKBField>>{};
+}
+
+// the length of the longest chain of calls
+int getCallDepth(PKB& pkb) {
+    std::map<std::string, std::vector<std::string>> callees;
+    for (auto& pair : getPairs(pkb, PKBRelationship::CALLS, PKBField::createDeclaration(PKBEntityType::PROCEDURE))) {
+        callees[pair[0].getContent<PROC_NAME>()->name].push_back(pair[1].getContent<PROC_NAME>()->name);
+    }
+    std::map<std::string, int> depth;
+    std::function<int(const std::string&)> getDepth = [&](const std::string& proc) {
+        if (depth.count(proc)) return depth[proc];
+        int longest = 0;
+        for (auto& callee : callees[proc]) longest = std::max(longest, 1 + getDepth(callee));
+        return depth[proc] = longest;
+    };
+    int longest = 0;
+    for (auto& [proc, _] : callees) longest = std::max(longest, getDepth(proc));
+    return longest;
+}
+
+// the largest number of containers around a statement
+int getNestingDepth(PKB& pkb) {
+    std::map<int, int> ancestors;
+    for (auto& pair : getPairs(pkb, PKBRelationship::PARENTT, PKBField::createDeclaration(StatementType::All))) {
+        ancestors[pair[1].getContent<STMT_LO>()->statementNum]++;
+    }
+    int deepest = 0;
+    for (auto& [_, count] : ancestors) deepest = std::max(deepest, count);
+    return deepest;
+}
+}  // namespace
+
+TEST_CASE("Generated programs") {
+    generator::ProgramConfig config;
+    SECTION("Default shape") {}
+    SECTION("Deep nesting and long call chains") {
+        config.statements = 600;
+        config.procedures = 12;
+        config.callDepth = 5;
+        config.fanOut = 3;
+        config.nestingDepth = 6;
+        config.loopDensity = 0.3;
+        config.branchDensity = 0.3;
+    }
+    SECTION("Flat program with large expressions") {
+        config.statements = 300;
+        config.procedures = 3;
+        config.callDepth = 1;
+        config.nestingDepth = 0;
+        config.variables = 3;
+        config.expressionSize = 12;
+    }
+    SECTION("More procedures than statements") {
+        config.statements = 3;
+        config.procedures = 5;
+    }
+
+    generator::ProgramGenerator programGenerator(config);
+    std::string source = programGenerator.generate();
+    REQUIRE(generator::ProgramGenerator(config).generate() == source);
+
+    std::ostringstream stream;
+    generator::ProgramInfo info = generator::ProgramGenerator(config).generate(stream);
+    REQUIRE(stream.str() == source);
+
+    PKB pkb;
+    REQUIRE(SourceProcessor().processSimple(source, &pkb));
+
+    PKBResponse statements = pkb.getStatements();
+    REQUIRE(statements.getResponse<FieldResponse>()->size() == static_cast<std::size_t>(info.statements));
+    REQUIRE(info.statements == std::max(config.statements, config.procedures));
+    REQUIRE(pkb.getProcedures().getResponse<FieldResponse>()->size() == info.procedures.size());
+    REQUIRE(getNestingDepth(pkb) <= config.nestingDepth);
+    int callDepth = getCallDepth(pkb);
+    REQUIRE(callDepth <= config.callDepth);
+    if (config.statements >= config.procedures * (config.fanOut + 1)) {
+        REQUIRE(callDepth == std::min(config.callDepth, config.procedures - 1));
+    }
+
+    generator::QueryConfig queryConfig;
+    queryConfig.count = 50;
+    auto queries = generator::generateQueries(info, queryConfig);
+    REQUIRE(queries.size() == 50);
+    qps::QPS qps;
+    for (auto& query : queries) {
+        INFO(query.getQuery());
+        REQUIRE(qps.prepare(query.getQuery()).isValid());
+        std::list<std::string> results;
+        REQUIRE_NOTHROW(qps.evaluate(query.getQuery(), results, &pkb));
+    }
+
+    queryConfig.mix = { { "next", 1 }, { "with", 0 } };
+    for (auto& query : generator::generateQueries(info, queryConfig)) {
+        REQUIRE(query.category == "next");
+    }
+    queryConfig.mix = { { "unknown", 1 } };
+    REQUIRE_THROWS_AS(generator::generateQueries(info, queryConfig), std::invalid_argument);
+}
@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <list>
+#include <string>
+#include <vector>
+
+#include "catch.hpp"
+
+#include "PhaseProfile.h"
+#include "PKB.h"
+#include "QPS/QPS.h"
+#include "SourceProcessor.h"
+
+namespace {
+const char* SOURCE = R"(
+procedure main {
+    read x;
+    call middle;
+    while (x > 0) {
+        x = x - 1;
+        call leaf;
+    }
+    print y;
+}
+procedure middle {
+    y = x + 1;
+    call leaf;
+}
+procedure leaf {
+    z = y * 2;
+}
+procedure other {
+    w = 5;
+    if (w == 5) then {
+        print w;
+    } else {
+        w = w + 1;
+    }
+})";
+
+std::string replace(std::string source, const std::string& from, const std::string& to) {
+    auto pos = source.find(from);
+    REQUIRE(pos != std::string::npos);
+    return source.replace(pos, from.size(), to);
+}
+
+std::list<std::string> evaluate(PKB& pkb, const std::string& query) {
+    std::list<std::string> results;
+    qps::QPS().evaluate(query, results, &pkb);
+    results.sort();
+    return results;
+}
+
+/**
+ * Processes the source incrementally and from scratch, and checks that both give the same PKB.
+ */
+std::vector<std::string> requireSameAsFullProcessing(SourceProcessor& incremental, const std::string& source) {
+    PKB expected;
+    REQUIRE(SourceProcessor().processSimple(source, &expected));
+    PKB actual;
+    REQUIRE(incremental.processIncremental(source, &actual));
+    REQUIRE(actual.isFrozen());
+
+    REQUIRE(expected.getStatements() == actual.getStatements());
+    REQUIRE(expected.getVariables() == actual.getVariables());
+    REQUIRE(expected.getProcedures() == actual.getProcedures());
+    REQUIRE(expected.getConstants() == actual.getConstants());
+
+    auto stmt = PKBField::createDeclaration(StatementType::All);
+    auto var = PKBField::createDeclaration(PKBEntityType::VARIABLE);
+    auto proc = PKBField::createDeclaration(PKBEntityType::PROCEDURE);
+    for (auto rs : { PKBRelationship::FOLLOWS, PKBRelationship::FOLLOWST, PKBRelationship::PARENT,
+                     PKBRelationship::PARENTT, PKBRelationship::NEXT, PKBRelationship::NEXTT,
+                     PKBRelationship::AFFECTS, PKBRelationship::AFFECTST }) {
+        REQUIRE(expected.getRelationship(stmt, stmt, rs) == actual.getRelationship(stmt, stmt, rs));
+    }
+    for (auto rs : { PKBRelationship::CALLS, PKBRelationship::CALLST }) {
+        REQUIRE(expected.getRelationship(proc, proc, rs) == actual.getRelationship(proc, proc, rs));
+    }
+    for (auto rs : { PKBRelationship::MODIFIES, PKBRelationship::USES }) {
+        REQUIRE(expected.getRelationship(stmt, var, rs) == actual.getRelationship(stmt, var, rs));
+        REQUIRE(expected.getRelationship(proc, var, rs) == actual.getRelationship(proc, var, rs));
+    }
+    for (auto query : { "assign a; variable v; Select <a, v> pattern a(v, _\"x\"_)",
+                        "call c; Select <c, c.procName>",
+                        "stmt s; Select s such that Next*(s, s)" }) {
+        INFO(query);
+        REQUIRE(evaluate(expected, query) == evaluate(actual, query));
+    }
+
+    auto extracted = incremental.getExtractedProcedures();
+    std::sort(extracted.begin(), extracted.end());
+    return extracted;
+}
+}  // namespace
+
+TEST_CASE("Processing successive versions of a source incrementally") {
+    using Procedures = std::vector<std::string>;
+    SourceProcessor processor;
+    REQUIRE(requireSameAsFullProcessing(processor, SOURCE) == Procedures{ "leaf", "main", "middle", "other" });
+
+    SECTION("Unchanged source") {
+        REQUIRE(requireSameAsFullProcessing(processor, std::string(SOURCE) + "\n\n").empty());
+    }
+    SECTION("Edit that keeps the variables of the procedure") {
+        auto edited = replace(SOURCE, "z = y * 2;", "z = y * 3 + 1;");
+        REQUIRE(requireSameAsFullProcessing(processor, edited) == Procedures{ "leaf" });
+    }
+    SECTION("Edit that changes the variables of the procedure") {
+        auto edited = replace(SOURCE, "z = y * 2;", "z = y * v;");
+        REQUIRE(requireSameAsFullProcessing(processor, edited) == Procedures{ "leaf", "main", "middle" });
+    }
+    SECTION("Edit that renumbers the procedures after it") {
+        auto edited = replace(SOURCE, "read x;", "read x;\n    read v;\n    x = x + v;");
+        REQUIRE(requireSameAsFullProcessing(processor, edited) == Procedures{ "main" });
+        // back to the original numbering
+        REQUIRE(requireSameAsFullProcessing(processor, SOURCE) == Procedures{ "main" });
+    }
+    SECTION("Procedures added and renamed") {
+        auto edited = replace(SOURCE, "procedure other {", "procedure extra {\n    read q;\n}\nprocedure other {");
+        REQUIRE(requireSameAsFullProcessing(processor, edited) == Procedures{ "extra" });
+        edited = replace(edited, "call leaf;\n    }", "call extra;\n    }");
+        edited = replace(edited, "procedure leaf {", "procedure leaf2 {");
+        edited = replace(edited, "call leaf;\n}", "call leaf2;\n}");
+        REQUIRE(requireSameAsFullProcessing(processor, edited) == Procedures{ "leaf2", "main", "middle" });
+    }
+    SECTION("Invalid versions are skipped") {
+        PKB pkb;
+        REQUIRE_FALSE(processor.processIncremental("procedure main { call missing; }", &pkb));
+        auto edited = replace(SOURCE, "w = 5;", "w = 6;");
+        REQUIRE(requireSameAsFullProcessing(processor, edited) == Procedures{ "other" });
+    }
+}
+
+TEST_CASE("Incremental processing records the diff phase") {
+    SourceProcessor processor;
+    PKB pkb;
+    sp::PhaseProfile profile;
+    REQUIRE(processor.processIncremental(SOURCE, &pkb, &profile));
+    std::vector<std::string> phases;
+    for (auto& [phase, _] : profile.getPhases()) {
+        phases.push_back(phase);
+    }
+    REQUIRE(phases == std::vector<std::string>{
+        "lex", "parse", "diff", "fused extractor", "cfg", "next extractor", "pkb load"
+    });
+}
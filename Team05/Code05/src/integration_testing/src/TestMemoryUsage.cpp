@@ -0,0 +1,83 @@
+#include <list>
+#include <string>
+
+#include "catch.hpp"
+
+#include "Cancellation.h"
+#include "exceptions.h"
+#include "PKB.h"
+#include "ProgramGenerator.h"
+#include "QPS/QPS.h"
+#include "SourceProcessor.h"
+
+TEST_CASE("Reporting the memory held by a processed source") {
+    generator::ProgramConfig config;
+    config.statements = 300;
+    config.procedures = 3;
+    std::string source = generator::ProgramGenerator(config).generate();
+    PKB pkb;
+    REQUIRE(SourceProcessor().processSimple(source, &pkb));
+
+    auto report = pkb.getMemoryReport();
+    for (const char* component : { "statements", "variables", "procedures", "Modifies", "Uses", "Follows",
+                                   "Parent", "Next", "AST", "CFG" }) {
+        INFO(component);
+        REQUIRE(report.getBytes(component) > 0);
+    }
+    // every statement is at least as big as its statement number.
+    REQUIRE(report.getBytes("statements") >= config.statements * sizeof(int));
+
+    SECTION("The Affects cache is only counted while it is populated") {
+        auto wildcard = PKBField::createDeclaration(StatementType::Assignment);
+        REQUIRE(pkb.getRelationship(wildcard, wildcard, PKBRelationship::AFFECTST).hasResult);
+        auto populated = pkb.getMemoryReport();
+        REQUIRE(populated.getBytes("Affects") > report.getBytes("Affects"));
+        REQUIRE(populated.getBytes("Affects*") > report.getBytes("Affects*"));
+        REQUIRE(populated.getBytes("Follows") == report.getBytes("Follows"));
+
+        pkb.clearCache();
+        auto cleared = pkb.getMemoryReport();
+        REQUIRE(cleared.getBytes("Affects") == report.getBytes("Affects"));
+        REQUIRE(cleared.getBytes("Affects*") == report.getBytes("Affects*"));
+        REQUIRE(cleared.getTotal() == report.getTotal());
+    }
+}
+
+TEST_CASE("Reporting the peak memory of a query") {
+    generator::ProgramConfig config;
+    config.statements = 100;
+    config.procedures = 3;
+    PKB pkb;
+    REQUIRE(SourceProcessor().processSimple(generator::ProgramGenerator(config).generate(), &pkb));
+    qps::QPS qps;
+    std::string small = "stmt s; Select s such that Follows(s, _)";
+    std::string big = "stmt s1, s2; Select <s1, s2> such that Next*(s1, s2)";
+
+    std::list<std::string> results;
+    auto smallProfile = qps.explain(small, results, &pkb);
+    results.clear();
+    auto bigProfile = qps.explain(big, results, &pkb);
+    REQUIRE(smallProfile.peakBytes > 0);
+    REQUIRE(bigProfile.peakBytes > smallProfile.peakBytes);
+    REQUIRE(bigProfile.toJson().find("\"peakBytes\":" + std::to_string(bigProfile.peakBytes)) != std::string::npos);
+
+    SECTION("The peak is the same with a token of its own") {
+        CancellationToken token;
+        results.clear();
+        qps.evaluate(big, results, &pkb, &token);
+        REQUIRE(token.getPeakMemory() == bigProfile.peakBytes);
+    }
+
+    SECTION("A query over its memory budget is stopped, and one within it is not") {
+        CancellationToken over;
+        over.setMemoryBudget(bigProfile.peakBytes - 1);
+        results.clear();
+        REQUIRE_THROWS_AS(qps.evaluate(big, results, &pkb, &over), exceptions::QueryStoppedException);
+
+        CancellationToken within;
+        within.setMemoryBudget(bigProfile.peakBytes);
+        results.clear();
+        qps.evaluate(big, results, &pkb, &within);
+        REQUIRE(results.size() == bigProfile.resultCount);
+    }
+}
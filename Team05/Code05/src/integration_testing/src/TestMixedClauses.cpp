@@ -64,16 +64,16 @@ TEST_CASE("test simple source code") {
     query1.addDeclaration("a", qps::query::DesignEntity::ASSIGN);
     query1.addDeclaration("s", qps::query::DesignEntity::STMT);
 
-    qps::query::Declaration d1 = qps::query::Declaration { "s", qps::query::DesignEntity::STMT };
+    qps::query::Declaration d1 = query1.getDeclaration("s");
     std::vector<qps::query::Elem> tuple1 { qps::query::Elem::ofDeclaration(d1) };
     qps::query::ResultCl r1 = qps::query::ResultCl::ofTuple(tuple1);
     query1.addResultCl(r1);
 
     std::shared_ptr<qps::query::Parent> ptr1 = std::make_shared<qps::query::Parent>();
-    ptr1->parent = qps::query::StmtRef::ofDeclaration( Declaration { "s", qps::query::DesignEntity::STMT });
+    ptr1->parent = qps::query::StmtRef::ofDeclaration( query1.getDeclaration("s"));
     ptr1->child = qps::query::StmtRef::ofLineNo(10);
     query1.addSuchthat(ptr1);
-    query1.addPattern(qps::query::Pattern::ofAssignPattern("a",
+    query1.addPattern(qps::query::Pattern::ofAssignPattern(query1.getDeclaration("a"),
                                           qps::query::EntRef::ofVarName("x"),
                                           qps::query::ExpSpec::ofWildcard()));
 
@@ -89,18 +89,17 @@ TEST_CASE("test simple source code") {
     query2.addDeclaration("s", qps::query::DesignEntity::STMT);
     query2.addDeclaration("v", qps::query::DesignEntity::VARIABLE);
 
-    qps::query::Declaration d2 = qps::query::Declaration { "s", qps::query::DesignEntity::STMT };
+    qps::query::Declaration d2 = query2.getDeclaration("s");
     std::vector<qps::query::Elem> tuple2 { qps::query::Elem::ofDeclaration(d2) };
     qps::query::ResultCl r2 = qps::query::ResultCl::ofTuple(tuple2);
     query2.addResultCl(r2);
 
     std::shared_ptr<qps::query::UsesS> ptr2 = std::make_shared<qps::query::UsesS>();
-    ptr2->useStmt = qps::query::StmtRef::ofDeclaration( Declaration { "s", qps::query::DesignEntity::STMT });
-    ptr2->used = qps::query::EntRef::ofDeclaration( Declaration { "v", qps::query::DesignEntity::VARIABLE });
+    ptr2->useStmt = qps::query::StmtRef::ofDeclaration( query2.getDeclaration("s"));
+    ptr2->used = qps::query::EntRef::ofDeclaration( query2.getDeclaration("v"));
     query2.addSuchthat(ptr2);
-    query2.addPattern(qps::query::Pattern::ofAssignPattern("a",
-                                          qps::query::EntRef::ofDeclaration( Declaration {
-                                              "v", qps::query::DesignEntity::VARIABLE }),
+    query2.addPattern(qps::query::Pattern::ofAssignPattern(query2.getDeclaration("a"),
+                                          qps::query::EntRef::ofDeclaration( query2.getDeclaration("v")),
                                               qps::query::ExpSpec::ofWildcard()));
     std::list<std::string> result2 = evaluator2.evaluate(query2);
     result2.sort();
@@ -113,14 +112,14 @@ TEST_CASE("test simple source code") {
     query3.addDeclaration("a", qps::query::DesignEntity::ASSIGN);
     query3.addDeclaration("v", qps::query::DesignEntity::VARIABLE);
 
-    qps::query::Declaration d3 = qps::query::Declaration { "a", qps::query::DesignEntity::ASSIGN };
+    qps::query::Declaration d3 = query3.getDeclaration("a");
     std::vector<qps::query::Elem> tuple3 { qps::query::Elem::ofDeclaration(d3) };
     qps::query::ResultCl r3 = qps::query::ResultCl::ofTuple(tuple3);
     query3.addResultCl(r3);
 
     query3.addPattern(qps::query::Pattern::ofAssignPattern(
-            "a",
-            qps::query::EntRef::ofDeclaration( Declaration { "v", qps::query::DesignEntity::VARIABLE }),
+            query3.getDeclaration("a"),
+            qps::query::EntRef::ofDeclaration( query3.getDeclaration("v")),
             qps::query::ExpSpec::ofFullMatch("x + 1")));
     std::list<std::string> result3 = evaluator3.evaluate(query3);
     result3.sort();
@@ -140,12 +139,12 @@ TEST_CASE("test evaluate pattern") {
     query1.addDeclaration("a", qps::query::DesignEntity::ASSIGN);
     query1.addDeclaration("s", qps::query::DesignEntity::STMT);
 
-    qps::query::Declaration d1 = qps::query::Declaration { "s", qps::query::DesignEntity::STMT };
+    qps::query::Declaration d1 = query1.getDeclaration("s");
     std::vector<qps::query::Elem> tuple1 { qps::query::Elem::ofDeclaration(d1) };
     qps::query::ResultCl r1 = qps::query::ResultCl::ofTuple(tuple1);
     query1.addResultCl(r1);
 
-    query1.addPattern(qps::query::Pattern::ofAssignPattern("a",
+    query1.addPattern(qps::query::Pattern::ofAssignPattern(query1.getDeclaration("a"),
                                           qps::query::EntRef::ofVarName("sum"),
                                           qps::query::ExpSpec::ofWildcard()));
     std::list<std::string> result1 = evaluator1.evaluate(query1);
@@ -160,14 +159,13 @@ TEST_CASE("test evaluate pattern") {
     query2.addDeclaration("s", qps::query::DesignEntity::STMT);
     query2.addDeclaration("v", qps::query::DesignEntity::VARIABLE);
 
-    qps::query::Declaration d2 = qps::query::Declaration { "s", qps::query::DesignEntity::STMT };
+    qps::query::Declaration d2 = query2.getDeclaration("s");
     std::vector<qps::query::Elem> tuple2 { qps::query::Elem::ofDeclaration(d2) };
     qps::query::ResultCl r2 = qps::query::ResultCl::ofTuple(tuple2);
     query2.addResultCl(r2);
 
-    query2.addPattern(qps::query::Pattern::ofAssignPattern("a",
-                                          qps::query::EntRef::ofDeclaration( Declaration {
-                                              "v", qps::query::DesignEntity::VARIABLE }),
+    query2.addPattern(qps::query::Pattern::ofAssignPattern(query2.getDeclaration("a"),
+                                          qps::query::EntRef::ofDeclaration( query2.getDeclaration("v")),
                                               qps::query::ExpSpec::ofWildcard()));
     std::list<std::string> result2 = evaluator2.evaluate(query2);
     result2.sort();
@@ -180,12 +178,12 @@ TEST_CASE("test evaluate pattern") {
     query3.addDeclaration("a", qps::query::DesignEntity::ASSIGN);
     query3.addDeclaration("s", qps::query::DesignEntity::STMT);
 
-    qps::query::Declaration d3 = qps::query::Declaration { "a", qps::query::DesignEntity::ASSIGN };
+    qps::query::Declaration d3 = query3.getDeclaration("a");
     std::vector<qps::query::Elem> tuple3 { qps::query::Elem::ofDeclaration(d3) };
     qps::query::ResultCl r3 = qps::query::ResultCl::ofTuple(tuple3);
     query3.addResultCl(r3);
 
-    query3.addPattern(qps::query::Pattern::ofAssignPattern("a",
+    query3.addPattern(qps::query::Pattern::ofAssignPattern(query3.getDeclaration("a"),
                                           qps::query::EntRef::ofWildcard(),
                                           qps::query::ExpSpec::ofWildcard()));
     std::list<std::string> result3 = evaluator3.evaluate(query3);
@@ -198,12 +196,12 @@ TEST_CASE("test evaluate pattern") {
     qps::query::Query query4{};
     query4.addDeclaration("a", qps::query::DesignEntity::ASSIGN);
 
-    qps::query::Declaration d4 = qps::query::Declaration { "a", qps::query::DesignEntity::ASSIGN };
+    qps::query::Declaration d4 = query4.getDeclaration("a");
     std::vector<qps::query::Elem> tuple4 { qps::query::Elem::ofDeclaration(d4) };
     qps::query::ResultCl r4 = qps::query::ResultCl::ofTuple(tuple4);
     query4.addResultCl(r4);
 
-    query4.addPattern(qps::query::Pattern::ofAssignPattern("a",
+    query4.addPattern(qps::query::Pattern::ofAssignPattern(query4.getDeclaration("a"),
                                           qps::query::EntRef::ofWildcard(),
                                           qps::query::ExpSpec::ofPartialMatch("number")));
     std::list<std::string> result4 = evaluator4.evaluate(query4);
@@ -216,12 +214,12 @@ TEST_CASE("test evaluate pattern") {
     qps::query::Query query5{};
     query5.addDeclaration("a", qps::query::DesignEntity::ASSIGN);
 
-    qps::query::Declaration d5 = qps::query::Declaration { "a", qps::query::DesignEntity::ASSIGN };
+    qps::query::Declaration d5 = query5.getDeclaration("a");
     std::vector<qps::query::Elem> tuple5 { qps::query::Elem::ofDeclaration(d5) };
     qps::query::ResultCl r5 = qps::query::ResultCl::ofTuple(tuple5);
     query5.addResultCl(r5);
 
-    query5.addPattern(qps::query::Pattern::ofAssignPattern("a",
+    query5.addPattern(qps::query::Pattern::ofAssignPattern(query5.getDeclaration("a"),
                                           qps::query::EntRef::ofVarName("x"),
                                           qps::query::ExpSpec::ofPartialMatch("number")));
     std::list<std::string> result5 = evaluator5.evaluate(query5);
@@ -235,12 +233,12 @@ TEST_CASE("test evaluate pattern") {
     query6.addDeclaration("a", qps::query::DesignEntity::ASSIGN);
     query6.addDeclaration("v", qps::query::DesignEntity::VARIABLE);
 
-    qps::query::Declaration d6 = qps::query::Declaration { "v", qps::query::DesignEntity::VARIABLE };
+    qps::query::Declaration d6 = query6.getDeclaration("v");
     std::vector<qps::query::Elem> tuple6 { qps::query::Elem::ofDeclaration(d6) };
     qps::query::ResultCl r6 = qps::query::ResultCl::ofTuple(tuple6);
     query6.addResultCl(r6);
 
-    query6.addPattern(qps::query::Pattern::ofAssignPattern("a",
+    query6.addPattern(qps::query::Pattern::ofAssignPattern(query6.getDeclaration("a"),
                                           qps::query::EntRef::ofVarName("digit"),
                                           qps::query::ExpSpec::ofPartialMatch("number")));
     std::list<std::string> result6 = evaluator6.evaluate(query6);
@@ -254,16 +252,16 @@ TEST_CASE("test evaluate pattern") {
     query7.addDeclaration("a", qps::query::DesignEntity::ASSIGN);
     query7.addDeclaration("s", qps::query::DesignEntity::STMT);
 
-    qps::query::Declaration d7 = qps::query::Declaration { "s", qps::query::DesignEntity::STMT };
+    qps::query::Declaration d7 = query7.getDeclaration("s");
     std::vector<qps::query::Elem> tuple7 { qps::query::Elem::ofDeclaration(d7) };
     qps::query::ResultCl r7 = qps::query::ResultCl::ofTuple(tuple7);
     query7.addResultCl(r7);
 
     std::shared_ptr<qps::query::FollowsT> ptr7 = std::make_shared<qps::query::FollowsT>();
     ptr7->follower = qps::query::StmtRef::ofLineNo(1);
-    ptr7->transitiveFollowed = qps::query::StmtRef::ofDeclaration( Declaration { "s", qps::query::DesignEntity::STMT });
+    ptr7->transitiveFollowed = qps::query::StmtRef::ofDeclaration( query7.getDeclaration("s"));
     query7.addSuchthat(ptr7);
-    query7.addPattern(qps::query::Pattern::ofAssignPattern("a",
+    query7.addPattern(qps::query::Pattern::ofAssignPattern(query7.getDeclaration("a"),
                                           qps::query::EntRef::ofVarName("sum"),
                                           qps::query::ExpSpec::ofWildcard()));
     std::list<std::string> result7 = evaluator7.evaluate(query7);
@@ -278,16 +276,16 @@ TEST_CASE("test evaluate pattern") {
     query8.addDeclaration("a", qps::query::DesignEntity::ASSIGN);
     query8.addDeclaration("s", qps::query::DesignEntity::STMT);
 
-    qps::query::Declaration d8 = qps::query::Declaration { "s", qps::query::DesignEntity::STMT };
+    qps::query::Declaration d8 = query8.getDeclaration("s");
     std::vector<qps::query::Elem> tuple8 { qps::query::Elem::ofDeclaration(d8) };
     qps::query::ResultCl r8 = qps::query::ResultCl::ofTuple(tuple8);
     query8.addResultCl(r8);
 
     std::shared_ptr<qps::query::Parent> ptr8 = std::make_shared<qps::query::Parent>();
-    ptr8->parent = qps::query::StmtRef::ofDeclaration( Declaration { "s", qps::query::DesignEntity::STMT });
-    ptr8->child = qps::query::StmtRef::ofDeclaration( Declaration { "a", qps::query::DesignEntity::ASSIGN });
+    ptr8->parent = qps::query::StmtRef::ofDeclaration( query8.getDeclaration("s"));
+    ptr8->child = qps::query::StmtRef::ofDeclaration( query8.getDeclaration("a"));
     query8.addSuchthat(ptr8);
-    query8.addPattern(qps::query::Pattern::ofAssignPattern("a",
+    query8.addPattern(qps::query::Pattern::ofAssignPattern(query8.getDeclaration("a"),
                                           qps::query::EntRef::ofVarName("digit"),
                                           qps::query::ExpSpec::ofWildcard()));
     std::list<std::string> result8 = evaluator8.evaluate(query8);
@@ -301,21 +299,20 @@ TEST_CASE("test evaluate pattern") {
     query9.addDeclaration("a", qps::query::DesignEntity::ASSIGN);
     query9.addDeclaration("a1", qps::query::DesignEntity::ASSIGN);
 
-    qps::query::Declaration d9 = qps::query::Declaration { "a", qps::query::DesignEntity::ASSIGN };
+    qps::query::Declaration d9 = query9.getDeclaration("a");
     std::vector<qps::query::Elem> tuple9 { qps::query::Elem::ofDeclaration(d9) };
     qps::query::ResultCl r9 = qps::query::ResultCl::ofTuple(tuple9);
     query9.addResultCl(r9);
 
-    query9.addPattern(qps::query::Pattern::ofAssignPattern("a",
+    query9.addPattern(qps::query::Pattern::ofAssignPattern(query9.getDeclaration("a"),
                                                            qps::query::EntRef::ofWildcard(),
                                                            qps::query::ExpSpec::ofWildcard()));
-    query9.addPattern(qps::query::Pattern::ofAssignPattern("a1",
+    query9.addPattern(qps::query::Pattern::ofAssignPattern(query9.getDeclaration("a1"),
                                                            qps::query::EntRef::ofVarName("number"),
                                                            qps::query::ExpSpec::ofWildcard()));
     std::shared_ptr<qps::query::FollowsT> ptr9 = std::make_shared<qps::query::FollowsT>();
-    ptr9->follower = qps::query::StmtRef::ofDeclaration( Declaration { "a", qps::query::DesignEntity::ASSIGN });
-    ptr9->transitiveFollowed = qps::query::StmtRef::ofDeclaration( Declaration {
-        "a1", qps::query::DesignEntity::ASSIGN });
+    ptr9->follower = qps::query::StmtRef::ofDeclaration( query9.getDeclaration("a"));
+    ptr9->transitiveFollowed = qps::query::StmtRef::ofDeclaration( query9.getDeclaration("a1"));
 
     query9.addSuchthat(ptr9);
     std::list<std::string> result9 = evaluator9.evaluate(query9);
@@ -330,19 +327,19 @@ TEST_CASE("test evaluate pattern") {
     query10.addDeclaration("pr", qps::query::DesignEntity::PRINT);
     query10.addDeclaration("v", qps::query::DesignEntity::VARIABLE);
 
-    qps::query::Declaration d10 = qps::query::Declaration { "a", qps::query::DesignEntity::ASSIGN };
+    qps::query::Declaration d10 = query10.getDeclaration("a");
     std::vector<qps::query::Elem> tuple10 { qps::query::Elem::ofDeclaration(d10) };
     qps::query::ResultCl r10 = qps::query::ResultCl::ofTuple(tuple10);
     query10.addResultCl(r10);
 
     query10.addPattern(qps::query::Pattern::ofAssignPattern(
-            "a",
-            qps::query::EntRef::ofDeclaration( Declaration { "v", qps::query::DesignEntity::VARIABLE }),
+            query10.getDeclaration("a"),
+            qps::query::EntRef::ofDeclaration( query10.getDeclaration("v")),
             qps::query::ExpSpec::ofWildcard()));
     qps::query::AttrRef attrl = qps::query::AttrRef{qps::query::AttrName::VARNAME,
-                                                    Declaration { "pr", qps::query::DesignEntity::PRINT }};
+                                                    query10.getDeclaration("pr")};
     qps::query::AttrRef attrr = qps::query::AttrRef{qps::query::AttrName::VARNAME,
-                                                    Declaration { "v", qps::query::DesignEntity::VARIABLE }};
+                                                    query10.getDeclaration("v")};
     qps::query::AttrCompareRef lhs = qps::query::AttrCompareRef::ofAttrRef(attrl);
     qps::query::AttrCompareRef rhs = qps::query::AttrCompareRef::ofAttrRef(attrr);
     qps::query::AttrCompare with = qps::query::AttrCompare{lhs, rhs};
@@ -358,19 +355,19 @@ TEST_CASE("test evaluate pattern") {
     query11.addDeclaration("a", qps::query::DesignEntity::ASSIGN);
     query11.addDeclaration("s", qps::query::DesignEntity::STMT);
 
-    qps::query::Declaration d11 = qps::query::Declaration { "s", qps::query::DesignEntity::STMT };
+    qps::query::Declaration d11 = query11.getDeclaration("s");
     std::vector<qps::query::Elem> tuple11 { qps::query::Elem::ofDeclaration(d11) };
     qps::query::ResultCl r11 = qps::query::ResultCl::ofTuple(tuple11);
     query11.addResultCl(r11);
 
-    query11.addPattern(qps::query::Pattern::ofAssignPattern("a", qps::query::EntRef::ofWildcard(),
+    query11.addPattern(qps::query::Pattern::ofAssignPattern(query11.getDeclaration("a"), qps::query::EntRef::ofWildcard(),
                                                             qps::query::ExpSpec::ofFullMatch("number % 10")));
-    query11.addPattern(qps::query::Pattern::ofAssignPattern("a",
+    query11.addPattern(qps::query::Pattern::ofAssignPattern(query11.getDeclaration("a"),
                                                             qps::query::EntRef::ofVarName("digit"),
                                                             qps::query::ExpSpec::ofWildcard()));
     std::shared_ptr<qps::query::NextT> ptr11 = std::make_shared<qps::query::NextT>();
-    ptr11->before = qps::query::StmtRef::ofDeclaration( Declaration { "a", qps::query::DesignEntity::ASSIGN });
-    ptr11->transitiveAfter = qps::query::StmtRef::ofDeclaration( Declaration { "s", qps::query::DesignEntity::STMT });
+    ptr11->before = qps::query::StmtRef::ofDeclaration( query11.getDeclaration("a"));
+    ptr11->transitiveAfter = qps::query::StmtRef::ofDeclaration( query11.getDeclaration("s"));
     query11.addSuchthat(ptr11);
     std::list<std::string> result11 = evaluator11.evaluate(query11);
     result11.sort();
@@ -383,14 +380,14 @@ TEST_CASE("test evaluate pattern") {
     query12.addDeclaration("a", qps::query::DesignEntity::ASSIGN);
     query12.addDeclaration("s", qps::query::DesignEntity::STMT);
 
-    qps::query::Declaration d12_1 = qps::query::Declaration { "s", qps::query::DesignEntity::STMT };
-    qps::query::Declaration d12_2 = qps::query::Declaration { "a", qps::query::DesignEntity::ASSIGN };
+    qps::query::Declaration d12_1 = query12.getDeclaration("s");
+    qps::query::Declaration d12_2 = query12.getDeclaration("a");
     std::vector<qps::query::Elem> tuple12 { qps::query::Elem::ofDeclaration(d12_2),
                                             qps::query::Elem::ofDeclaration(d12_1) };
     qps::query::ResultCl r12 = qps::query::ResultCl::ofTuple(tuple12);
     query12.addResultCl(r12);
 
-    query12.addPattern(qps::query::Pattern::ofAssignPattern("a",
+    query12.addPattern(qps::query::Pattern::ofAssignPattern(query12.getDeclaration("a"),
                                                            qps::query::EntRef::ofVarName("sum"),
                                                            qps::query::ExpSpec::ofWildcard()));
     std::list<std::string> result12 = evaluator12.evaluate(query12);
@@ -405,16 +402,15 @@ TEST_CASE("test evaluate pattern") {
     query13.addDeclaration("w", qps::query::DesignEntity::WHILE);
     query13.addDeclaration("v", qps::query::DesignEntity::VARIABLE);
 
-    qps::query::Declaration d131 = qps::query::Declaration { "w", qps::query::DesignEntity::WHILE };
-    qps::query::Declaration d132 = qps::query::Declaration { "v", qps::query::DesignEntity::VARIABLE };
+    qps::query::Declaration d131 = query13.getDeclaration("w");
+    qps::query::Declaration d132 = query13.getDeclaration("v");
     std::vector<qps::query::Elem> tuple13 { qps::query::Elem::ofDeclaration(d131),
                                             qps::query::Elem::ofDeclaration(d132) };
     qps::query::ResultCl r13 = qps::query::ResultCl::ofTuple(tuple13);
     query13.addResultCl(r13);
 
-    query13.addPattern(qps::query::Pattern::ofWhilePattern("w",
-                                                           qps::query::EntRef::ofDeclaration( Declaration {
-                                                                   "v", qps::query::DesignEntity::VARIABLE })));
+    query13.addPattern(qps::query::Pattern::ofWhilePattern(query13.getDeclaration("w"),
+                                                           qps::query::EntRef::ofDeclaration( query13.getDeclaration("v"))));
     std::list<std::string> result13 = evaluator13.evaluate(query13);
     result13.sort();
     printEvaluatorResult(result13);
@@ -426,12 +422,12 @@ TEST_CASE("test evaluate pattern") {
     query14.addDeclaration("ifs", qps::query::DesignEntity::IF);
     query14.addDeclaration("v", qps::query::DesignEntity::VARIABLE);
 
-    qps::query::Declaration d14 = qps::query::Declaration { "v", qps::query::DesignEntity::VARIABLE };
+    qps::query::Declaration d14 = query14.getDeclaration("v");
     std::vector<qps::query::Elem> tuple14 { qps::query::Elem::ofDeclaration(d14) };
     qps::query::ResultCl r14 = qps::query::ResultCl::ofTuple(tuple14);
     query14.addResultCl(r14);
 
-    query14.addPattern(qps::query::Pattern::ofIfPattern("ifs", qps::query::EntRef::ofWildcard()));
+    query14.addPattern(qps::query::Pattern::ofIfPattern(query14.getDeclaration("ifs"), qps::query::EntRef::ofWildcard()));
     std::list<std::string> result14 = evaluator14.evaluate(query14);
     result14.sort();
     printEvaluatorResult(result14);
@@ -440,11 +436,11 @@ TEST_CASE("test evaluate pattern") {
     TEST_LOG << "stmt s, s1; Select <s, s1> such that affects*(6, s) and affects*(s1, s)";
     qps::evaluator::Evaluator evaluator15 = qps::evaluator::Evaluator(&pkb);
     qps::query::Query query15{};
-    query15.addDeclaration("ifs", qps::query::DesignEntity::IF);
-    query15.addDeclaration("v", qps::query::DesignEntity::VARIABLE);
+    query15.addDeclaration("s", qps::query::DesignEntity::STMT);
+    query15.addDeclaration("s1", qps::query::DesignEntity::STMT);
 
-    qps::query::Declaration d151 = qps::query::Declaration { "s", qps::query::DesignEntity::STMT };
-    qps::query::Declaration d152 = qps::query::Declaration { "s1", qps::query::DesignEntity::STMT };
+    qps::query::Declaration d151 = query15.getDeclaration("s");
+    qps::query::Declaration d152 = query15.getDeclaration("s1");
     std::vector<qps::query::Elem> tuple15 { qps::query::Elem::ofDeclaration(d151),
                                             qps::query::Elem::ofDeclaration(d152) };
     qps::query::ResultCl r15 = qps::query::ResultCl::ofTuple(tuple15);
@@ -453,14 +449,14 @@ TEST_CASE("test evaluate pattern") {
     std::shared_ptr<qps::query::AffectsT> ptr151 = std::make_shared<qps::query::AffectsT>();
     ptr151->affectingStmt = qps::query::StmtRef::ofLineNo(6);
     ptr151->transitiveAffected = qps::query::StmtRef::ofDeclaration( 
-        Declaration { "s", qps::query::DesignEntity::STMT }
+        query15.getDeclaration("s")
     );
     query15.addSuchthat(ptr151);
 
     std::shared_ptr<qps::query::AffectsT> ptr152 = std::make_shared<qps::query::AffectsT>();
-    ptr152->affectingStmt = qps::query::StmtRef::ofDeclaration(Declaration{"s1", qps::query::DesignEntity::STMT});
+    ptr152->affectingStmt = qps::query::StmtRef::ofDeclaration(query15.getDeclaration("s1"));
     ptr152->transitiveAffected = qps::query::StmtRef::ofDeclaration(
-        Declaration { "s", qps::query::DesignEntity::STMT }
+        query15.getDeclaration("s")
     );
     query15.addSuchthat(ptr152);
     std::list<std::string> result15 = evaluator15.evaluate(query15);
@@ -0,0 +1,81 @@
+#include <list>
+#include <string>
+#include <vector>
+
+#include "catch.hpp"
+
+#include "exceptions.h"
+#include "PKB.h"
+#include "QPS/QPS.h"
+#include "SourceProcessor.h"
+
+namespace {
+std::list<std::string> execute(qps::QPS& qps, const qps::PreparedQuery& prepared,
+                               const std::vector<qps::query::Literal>& params, PKB* pkb) {
+    std::list<std::string> results;
+    qps.execute(prepared, params, results, pkb);
+    results.sort();
+    return results;
+}
+}  // namespace
+
+TEST_CASE("Prepared queries") {
+    std::string source = R"(
+        procedure main {
+            x = 1;
+            y = x + 2;
+            read z;
+            call sub;
+        }
+        procedure sub {
+            print y;
+            x = y;
+        }
+    )";
+    PKB pkb;
+    SourceProcessor sp;
+    sp.processSimple(source, &pkb);
+    qps::QPS qps;
+
+    SECTION("Placeholder as a name") {
+        qps::PreparedQuery prepared = qps.prepare("stmt s; Select s such that Modifies(s, ?)");
+        REQUIRE(prepared.isValid());
+        REQUIRE(prepared.getParameterCount() == 1);
+
+        REQUIRE(execute(qps, prepared, { std::string("x") }, &pkb) == std::list<std::string>{"1", "4", "6"});
+        REQUIRE(execute(qps, prepared, { std::string("z") }, &pkb) == std::list<std::string>{"3"});
+        REQUIRE(execute(qps, prepared, { std::string("w") }, &pkb).empty());
+    }
+
+    SECTION("Placeholder as a statement or a procedure") {
+        qps::PreparedQuery prepared = qps.prepare("variable v; Select v such that Uses(?, v)");
+        REQUIRE(execute(qps, prepared, { 2 }, &pkb) == std::list<std::string>{"x"});
+        REQUIRE(execute(qps, prepared, { std::string("sub") }, &pkb) == std::list<std::string>{"y"});
+    }
+
+    SECTION("Placeholders in with and pattern clauses") {
+        qps::PreparedQuery prepared = qps.prepare("assign a; Select a pattern a(?, _) with a.stmt# = ?");
+        REQUIRE(prepared.getParameterCount() == 2);
+        REQUIRE(execute(qps, prepared, { std::string("x"), 6 }, &pkb) == std::list<std::string>{"6"});
+        REQUIRE(execute(qps, prepared, { std::string("y"), 6 }, &pkb).empty());
+
+        qps::PreparedQuery boolean = qps.prepare("Select BOOLEAN such that Follows(?, ?)");
+        REQUIRE(execute(qps, boolean, { 1, 2 }, &pkb) == std::list<std::string>{"TRUE"});
+        REQUIRE(execute(qps, boolean, { 1, 3 }, &pkb) == std::list<std::string>{"FALSE"});
+    }
+
+    SECTION("Values that cannot be bound") {
+        qps::PreparedQuery prepared = qps.prepare("stmt s; Select s such that Follows(s, ?)");
+        REQUIRE_THROWS_AS(execute(qps, prepared, {}, &pkb), exceptions::PqlSemanticException);
+        REQUIRE_THROWS_AS(execute(qps, prepared, { 1, 2 }, &pkb), exceptions::PqlSemanticException);
+        REQUIRE(execute(qps, prepared, { std::string("x") }, &pkb).empty());
+        REQUIRE(execute(qps, prepared, { 2 }, &pkb) == std::list<std::string>{"1"});
+
+        qps::PreparedQuery with = qps.prepare("stmt s; Select s with s.stmt# = ?");
+        REQUIRE(execute(qps, with, { std::string("x") }, &pkb).empty());
+    }
+
+    SECTION("Invalid query") {
+        REQUIRE_FALSE(qps.prepare("stmt s; Select v such that Modifies(s, ?)").isValid());
+    }
+}
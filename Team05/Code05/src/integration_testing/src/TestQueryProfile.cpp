@@ -0,0 +1,98 @@
+#include <list>
+#include <string>
+
+#include "catch.hpp"
+
+#include "PKB.h"
+#include "QPS/QPS.h"
+#include "SourceProcessor.h"
+
+TEST_CASE("Query profiles") {
+    std::string source = R"(
+        procedure main {
+            x = 1;
+            y = x + 2;
+            while (y > 0) {
+                x = y;
+                y = x - 1;
+            }
+            call sub;
+        }
+        procedure sub {
+            print y;
+            x = y;
+        }
+    )";
+    PKB pkb;
+    SourceProcessor sp;
+    sp.processSimple(source, &pkb);
+    qps::QPS qps;
+
+    SECTION("Clauses are recorded in evaluation order with their row counts") {
+        std::string query = "assign a; variable v; stmt s; "
+                            "Select a such that Modifies(a, v) pattern a(\"x\", _) such that Follows(s, a)";
+        std::list<std::string> results;
+        auto profile = qps.explain(query, results, &pkb);
+        REQUIRE(results == std::list<std::string>{"8"});
+
+        std::list<std::string> expected;
+        qps.evaluate(query, expected, &pkb);
+        REQUIRE(results == expected);
+
+        REQUIRE(profile.isValid);
+        REQUIRE(profile.resultCount == 1);
+        REQUIRE(profile.groups.size() == 1);
+        auto& group = profile.groups[0];
+        REQUIRE(group.hasResult);
+        REQUIRE_FALSE(group.noSyn);
+        REQUIRE(group.clauses.size() == 3);
+
+        // the pattern only restricts a, so it comes first and has no table to join into.
+        auto& pattern = group.clauses[0];
+        REQUIRE(pattern.clause == "pattern assign");
+        REQUIRE(pattern.rows == 3);
+        REQUIRE_FALSE(pattern.rowsBefore.has_value());
+        REQUIRE(pattern.rowsAfter == 3);
+
+        for (std::size_t i = 1; i < group.clauses.size(); i++) {
+            auto& clause = group.clauses[i];
+            REQUIRE(clause.clause.rfind("such that ", 0) == 0);
+            REQUIRE(clause.rowsBefore.has_value());
+            REQUIRE(clause.rowsAfter.has_value());
+            REQUIRE_FALSE(clause.isCached);
+            REQUIRE(clause.lookupMs >= 0);
+        }
+        REQUIRE(group.clauses[1].rowsBefore == 0);
+        REQUIRE(group.clauses[2].rowsBefore == group.clauses[1].rowsAfter);
+        REQUIRE(group.clauses[2].rowsAfter == group.rows);
+
+        std::string json = profile.toJson();
+        REQUIRE(json.rfind("{\"query\":\"assign a; variable v; stmt s; Select a such that Modifies(a, v) pattern "
+                           "a(\\\"x\\\", _)", 0) == 0);
+        REQUIRE(json.find("\"clause\":\"pattern assign\",\"synonyms\":[\"a\"]") != std::string::npos);
+        REQUIRE(json.find("\"rowsBefore\":null,\"rowsAfter\":3") != std::string::npos);
+        REQUIRE(json.find("\"resultCount\":1") != std::string::npos);
+    }
+
+    SECTION("Clauses without synonyms") {
+        std::list<std::string> results;
+        auto profile = qps.explain("Select BOOLEAN such that Follows(1, 2) and Follows(2, 1)", results, &pkb);
+        REQUIRE(results == std::list<std::string>{"FALSE"});
+        REQUIRE(profile.groups.size() == 1);
+        REQUIRE(profile.groups[0].noSyn);
+        REQUIRE_FALSE(profile.groups[0].hasResult);
+        REQUIRE(profile.groups[0].clauses.size() == 2);
+        REQUIRE(profile.groups[0].clauses[0].clause == "such that Follows");
+        REQUIRE(profile.groups[0].clauses[0].rows == 1);
+        REQUIRE(profile.groups[0].clauses[1].rows == 0);
+        REQUIRE_FALSE(profile.groups[0].clauses[1].rowsAfter.has_value());
+    }
+
+    SECTION("Invalid query") {
+        std::list<std::string> results;
+        auto profile = qps.explain("stmt s; Select v", results, &pkb);
+        REQUIRE_FALSE(profile.isValid);
+        REQUIRE(profile.groups.empty());
+        REQUIRE(profile.toJson().find("\"valid\":false") != std::string::npos);
+    }
+}
@@ -0,0 +1,313 @@
+// the server is tested over Unix domain sockets, so the tests are only built where there are such sockets
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <list>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "catch.hpp"
+
+#include "messages.h"
+#include "PKB.h"
+#include "ProgramGenerator.h"
+#include "QPS/QPS.h"
+#include "QueryServer.h"
+#include "SourceProcessor.h"
+
+namespace {
+const char* SOURCE = R"(
+procedure main {
+    read x;
+    while (x > 0) {
+        x = x - 1;
+        call helper;
+    }
+}
+procedure helper {
+    y = x + 1;
+    print y;
+})";
+
+std::string getPath(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / ("spa_server_test_" + name)).string();
+}
+
+void writeFile(const std::string& path, const std::string& contents) {
+    std::ofstream(path) << contents;
+}
+
+void writeAll(int fd, const std::string& data) {
+    REQUIRE(::write(fd, data.data(), data.size()) == static_cast<ssize_t>(data.size()));
+}
+
+std::string readAll(int fd) {
+    std::string data;
+    char chunk[4096];
+    ssize_t n;
+    while ((n = ::read(fd, chunk, sizeof(chunk))) > 0) {
+        data.append(chunk, static_cast<std::size_t>(n));
+    }
+    return data;
+}
+
+/**
+ * Sends the requests to the server over a socket pair in a single write, and returns the answers by id.
+ */
+std::map<std::string, std::string> send(server::QueryServer& queryServer, const std::string& requests) {
+    int fds[2];
+    REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+    std::thread serving([&queryServer, fd = fds[1]]() {
+        queryServer.serve(fd, fd);
+        ::close(fd);
+    });
+    writeAll(fds[0], requests);
+    ::shutdown(fds[0], SHUT_WR);
+    std::string answers = readAll(fds[0]);
+    serving.join();
+    ::close(fds[0]);
+
+    std::map<std::string, std::string> byId;
+    std::istringstream in(answers);
+    for (std::string line; std::getline(in, line);) {
+        auto separator = line.find(' ');
+        REQUIRE(separator != std::string::npos);
+        REQUIRE(byId.emplace(line.substr(0, separator), line.substr(separator + 1)).second);
+    }
+    return byId;
+}
+
+std::string evaluate(const std::string& source, const std::string& query) {
+    PKB pkb;
+    REQUIRE(SourceProcessor().processSimple(source, &pkb));
+    std::list<std::string> results;
+    qps::QPS().evaluate(query, results, &pkb);
+    std::string answer = "ok " + std::to_string(results.size());
+    char separator = ' ';
+    for (auto& result : results) {
+        answer += separator + result;
+        separator = ',';
+    }
+    return answer;
+}
+
+/**
+ * @return the results of an answer in order, since the order of the results of a query is not specified.
+ */
+std::vector<std::string> sortedResults(const std::string& answer) {
+    std::vector<std::string> results;
+    auto start = answer.find(' ', answer.find(' ') + 1);
+    if (start == std::string::npos) return results;
+    std::istringstream in(answer.substr(start + 1));
+    for (std::string result; std::getline(in, result, ',');) {
+        results.push_back(result);
+    }
+    std::sort(results.begin(), results.end());
+    return results;
+}
+}  // namespace
+
+TEST_CASE("Serving pipelined requests") {
+    std::string sourcePath = getPath("pipelined.txt");
+    writeFile(sourcePath, SOURCE);
+    server::ServerConfig config;
+    config.workers = 3;
+    server::QueryServer queryServer(sourcePath, config);
+    REQUIRE(queryServer.load());
+
+    const char* queries[] = {
+        "stmt s; Select s such that Next*(s, s)",
+        "variable v; Select v such that Modifies(\"main\", v)",
+        "assign a; variable v; Select <a, v> such that Uses(a, v)",
+        "stmt s; Select s such that Follows(s, 100)",
+        "stmt s; Select t",
+    };
+    std::string requests;
+    for (std::size_t i = 0; i < std::size(queries); i++) {
+        requests += "q" + std::to_string(i) + " query " + queries[i] + "\n";
+    }
+    requests += "\n";
+    requests += "unknown frobnicate\n";
+    requests += "missing\r\n";
+    requests += "last query stmt s; Select BOOLEAN such that Parent(2, 3)";  // no newline before the end
+
+    auto answers = send(queryServer, requests);
+    REQUIRE(answers.size() == std::size(queries) + 3);
+    for (std::size_t i = 0; i < std::size(queries); i++) {
+        INFO(queries[i]);
+        REQUIRE(answers.at("q" + std::to_string(i)) == evaluate(SOURCE, queries[i]));
+    }
+    REQUIRE(answers.at("unknown") == "error Unrecognised command frobnicate");
+    REQUIRE(answers.at("missing") == "error Missing command");
+    REQUIRE(answers.at("last") == "ok 1 TRUE");
+
+    std::remove(sourcePath.c_str());
+}
+
+TEST_CASE("Reloading the source of the server") {
+    std::string sourcePath = getPath("reload.txt");
+    writeFile(sourcePath, SOURCE);
+    server::QueryServer queryServer(sourcePath, server::ServerConfig());
+    std::vector<std::string> extracted;
+    REQUIRE(queryServer.load(&extracted));
+    REQUIRE(extracted.size() == 2);
+
+    std::string query = "variable v; Select v such that Uses(\"main\", v)";
+    std::string edited = std::string(SOURCE).replace(std::string(SOURCE).find("x + 1"), 5, "x + z");
+    writeFile(sourcePath, edited);
+    auto answers = send(queryServer, "r reload\nafter query " + query + "\n");
+    REQUIRE(answers.at("r") == "ok 2 helper,main");
+    REQUIRE(answers.at("after") == evaluate(edited, query));
+
+    writeFile(sourcePath, "procedure main { call missing; }");
+    answers = send(queryServer, "r reload\nafter query " + query + "\n");
+    REQUIRE(answers.at("r") == "error Cannot process " + sourcePath);
+    REQUIRE(answers.at("after") == evaluate(edited, query));
+
+    std::remove(sourcePath.c_str());
+}
+
+TEST_CASE("Serving concurrent Affects queries") {
+    generator::ProgramConfig programConfig;
+    programConfig.statements = 200;
+    programConfig.procedures = 4;
+    std::string source = generator::ProgramGenerator(programConfig).generate();
+    std::string sourcePath = getPath("affects.txt");
+    writeFile(sourcePath, source);
+    server::ServerConfig config;
+    config.workers = 4;
+    server::QueryServer queryServer(sourcePath, config);
+    REQUIRE(queryServer.load());
+
+    // every query populates the Affects cache that the others read, and must not clear it once it is done.
+    const char* queries[] = {
+        "assign a1, a2; Select <a1, a2> such that Affects*(a1, a2)",
+        "assign a; Select a such that Affects*(a, _)",
+        "assign a; Select a such that Affects*(_, a)",
+        "assign a1, a2; Select <a1, a2> such that Affects(a1, a2)",
+        "assign a; Select BOOLEAN such that Affects*(a, a)",
+    };
+    constexpr int rounds = 8;
+    std::string requests;
+    for (int round = 0; round < rounds; round++) {
+        for (std::size_t i = 0; i < std::size(queries); i++) {
+            requests += "q" + std::to_string(round) + "_" + std::to_string(i) + " query " + queries[i] + "\n";
+        }
+    }
+
+    auto answers = send(queryServer, requests);
+    REQUIRE(answers.size() == rounds * std::size(queries));
+    for (std::size_t i = 0; i < std::size(queries); i++) {
+        INFO(queries[i]);
+        auto expected = sortedResults(evaluate(source, queries[i]));
+        for (int round = 0; round < rounds; round++) {
+            REQUIRE(sortedResults(answers.at("q" + std::to_string(round) + "_" + std::to_string(i))) == expected);
+        }
+    }
+
+    std::remove(sourcePath.c_str());
+}
+
+TEST_CASE("Answering a query that takes too long with a timeout") {
+    generator::ProgramConfig programConfig;
+    programConfig.statements = 200;
+    programConfig.procedures = 3;
+    std::string sourcePath = getPath("timeout.txt");
+    writeFile(sourcePath, generator::ProgramGenerator(programConfig).generate());
+
+    server::ServerConfig config;
+    config.workers = 1;
+    config.timeoutMs = 1;
+    server::QueryServer queryServer(sourcePath, config);
+    REQUIRE(queryServer.load());
+    auto answers = send(queryServer, "slow query stmt s1, s2; Select <s1, s2> such that Next*(s1, s2)\n");
+    REQUIRE(answers.at("slow") == "timeout");
+
+    std::remove(sourcePath.c_str());
+}
+
+TEST_CASE("Serving the connections of a socket") {
+    std::string sourcePath = getPath("socket.txt");
+    std::string socketPath = getPath("socket.sock");
+    writeFile(sourcePath, SOURCE);
+    server::QueryServer queryServer(sourcePath, server::ServerConfig());
+    REQUIRE(queryServer.load());
+    std::thread listening([&]() { queryServer.listen(socketPath); });
+
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+    std::string query = "stmt s; Select s such that Parent(s, _)";
+    for (int client = 0; client < 2; client++) {
+        int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        REQUIRE(fd >= 0);
+        bool isConnected = false;
+        for (int attempt = 0; attempt < 200 && !isConnected; attempt++) {
+            isConnected = ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0;
+            if (!isConnected) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        REQUIRE(isConnected);
+        writeAll(fd, "1 query " + query + "\n");
+        ::shutdown(fd, SHUT_WR);
+        REQUIRE(readAll(fd) == "1 " + evaluate(SOURCE, query) + "\n");
+        ::close(fd);
+    }
+
+    queryServer.stop();
+    listening.join();
+    REQUIRE_FALSE(std::filesystem::exists(socketPath));
+    std::remove(sourcePath.c_str());
+}
+
+TEST_CASE("Answering a query that outgrows the memory budget with an error") {
+    std::string sourcePath = getPath("memory.txt");
+    writeFile(sourcePath, SOURCE);
+    server::ServerConfig config;
+    config.memoryBudgetBytes = 1;
+    server::QueryServer queryServer(sourcePath, config);
+    REQUIRE(queryServer.load());
+    auto answers = send(queryServer, "big query stmt s1, s2; Select <s1, s2>\nsmall query stmt s; Select BOOLEAN\n");
+    REQUIRE(answers.at("big") == std::string("error ") + messages::qps::evaluator::memoryBudgetExceededMessage);
+    REQUIRE(answers.at("small") == "ok 1 TRUE");
+
+    std::remove(sourcePath.c_str());
+}
+
+TEST_CASE("Reporting the memory held by the source of the server") {
+    std::string sourcePath = getPath("memory_report.txt");
+    writeFile(sourcePath, SOURCE);
+    server::QueryServer queryServer(sourcePath, server::ServerConfig());
+    REQUIRE(queryServer.load());
+
+    std::string answer = send(queryServer, "m memory\n").at("m");
+    std::istringstream in(answer);
+    std::string status, component;
+    std::size_t count;
+    REQUIRE(in >> status >> count);
+    REQUIRE(status == "ok");
+    std::map<std::string, std::size_t> bytesOf;
+    while (std::getline(in >> std::ws, component, ',')) {
+        auto separator = component.find('=');
+        REQUIRE(separator != std::string::npos);
+        bytesOf[component.substr(0, separator)] = std::stoul(component.substr(separator + 1));
+    }
+    REQUIRE(bytesOf.size() == count);
+    REQUIRE(count == PKB().getMemoryReport().getComponents().size());
+    REQUIRE(bytesOf.at("statements") > 0);
+    REQUIRE(bytesOf.at("AST") > 0);
+    REQUIRE(bytesOf.at("CFG") > 0);
+
+    std::remove(sourcePath.c_str());
+}
+#endif
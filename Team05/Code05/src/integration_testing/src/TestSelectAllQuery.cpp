@@ -26,12 +26,12 @@ TEST_CASE("Test get statements") {
     PKBField p1 = PKBField::createConcrete(STMT_LO{ 7, StatementType::Print });
 
     qps::query::Query query1;
-    qps::query::Declaration d1 = qps::query::Declaration { "s", qps::query::DesignEntity::STMT };
+    query1.addDeclaration("s", qps::query::DesignEntity::STMT);
+    qps::query::Declaration d1 = query1.getDeclaration("s");
     std::vector<qps::query::Elem> tuple1 { qps::query::Elem::ofDeclaration(d1) };
     qps::query::ResultCl r1 = qps::query::ResultCl::ofTuple(tuple1);
     query1.addResultCl(r1);
 
-    query1.addDeclaration("s", qps::query::DesignEntity::STMT);
     std::list<std::string> resAll = evaluator.evaluate(query1);
     resAll.sort();
     REQUIRE(resAll == std::list<std::string>{"2", "3", "4", "5", "6", "7", "8"});
@@ -39,7 +39,7 @@ TEST_CASE("Test get statements") {
     qps::query::Query query2;
     query2.addDeclaration("a", qps::query::DesignEntity::ASSIGN);
 
-    qps::query::Declaration d2 = qps::query::Declaration { "a", qps::query::DesignEntity::ASSIGN };
+    qps::query::Declaration d2 = query2.getDeclaration("a");
     std::vector<qps::query::Elem> tuple2 { qps::query::Elem::ofDeclaration(d2) };
     qps::query::ResultCl r2 = qps::query::ResultCl::ofTuple(tuple2);
     query2.addResultCl(r2);
@@ -51,7 +51,7 @@ TEST_CASE("Test get statements") {
     qps::query::Query query3;
     query3.addDeclaration("w", qps::query::DesignEntity::WHILE);
 
-    qps::query::Declaration d3 = qps::query::Declaration { "w", qps::query::DesignEntity::WHILE };
+    qps::query::Declaration d3 = query3.getDeclaration("w");
     std::vector<qps::query::Elem> tuple3 { qps::query::Elem::ofDeclaration(d3) };
     qps::query::ResultCl r3 = qps::query::ResultCl::ofTuple(tuple3);
     query3.addResultCl(r3);
@@ -61,34 +61,34 @@ TEST_CASE("Test get statements") {
     REQUIRE(resWhile == std::list<std::string>{"3"});
 
     qps::query::Query query4;
-    qps::query::Declaration d4 = qps::query::Declaration { "ifs", qps::query::DesignEntity::IF };
+    query4.addDeclaration("ifs", qps::query::DesignEntity::IF);
+    qps::query::Declaration d4 = query4.getDeclaration("ifs");
     std::vector<qps::query::Elem> tuple4 { qps::query::Elem::ofDeclaration(d4) };
     qps::query::ResultCl r4 = qps::query::ResultCl::ofTuple(tuple4);
     query4.addResultCl(r4);
 
-    query4.addDeclaration("ifs", qps::query::DesignEntity::IF);
     std::list<std::string> resIf = evaluator.evaluate(query4);
     resIf.sort();
     REQUIRE(resIf == std::list<std::string>{"4", "6"});
 
     qps::query::Query query5;
-    qps::query::Declaration d5 = qps::query::Declaration { "pr", qps::query::DesignEntity::PRINT };
+    query5.addDeclaration("pr", qps::query::DesignEntity::PRINT);
+    qps::query::Declaration d5 = query5.getDeclaration("pr");
     std::vector<qps::query::Elem> tuple5 { qps::query::Elem::ofDeclaration(d5) };
     qps::query::ResultCl r5 = qps::query::ResultCl::ofTuple(tuple5);
     query5.addResultCl(r5);
 
-    query5.addDeclaration("pr", qps::query::DesignEntity::PRINT);
     std::list<std::string> resPrint = evaluator.evaluate(query5);
     resPrint.sort();
     REQUIRE(resPrint == std::list<std::string>{"7"});
 
     qps::query::Query query6;
-    qps::query::Declaration d6 = qps::query::Declaration { "r", qps::query::DesignEntity::READ };
+    query6.addDeclaration("r", qps::query::DesignEntity::READ);
+    qps::query::Declaration d6 = query6.getDeclaration("r");
     std::vector<qps::query::Elem> tuple6 { qps::query::Elem::ofDeclaration(d6) };
     qps::query::ResultCl r6 = qps::query::ResultCl::ofTuple(tuple6);
     query6.addResultCl(r6);
 
-    query6.addDeclaration("r", qps::query::DesignEntity::READ);
     std::list<std::string> resRead = evaluator.evaluate(query6);
     resRead.sort();
     REQUIRE(resRead.empty());
@@ -101,12 +101,12 @@ TEST_CASE("Test get variables") {
     qps::evaluator::Evaluator evaluator = qps::evaluator::Evaluator(ptr);
 
     qps::query::Query query1;
-    qps::query::Declaration d1 = qps::query::Declaration { "v", qps::query::DesignEntity::VARIABLE };
+    query1.addDeclaration("v", qps::query::DesignEntity::VARIABLE);
+    qps::query::Declaration d1 = query1.getDeclaration("v");
     std::vector<qps::query::Elem> tuple1 { qps::query::Elem::ofDeclaration(d1) };
     qps::query::ResultCl r1 = qps::query::ResultCl::ofTuple(tuple1);
     query1.addResultCl(r1);
 
-    query1.addDeclaration("v", qps::query::DesignEntity::VARIABLE);
     REQUIRE(evaluator.evaluate(query1).empty());
 
     pkb.insertEntity(VAR_NAME{ "x" });
@@ -130,7 +130,7 @@ TEST_CASE("Test evaluate select s") {
     q.addDeclaration("v", qps::query::DesignEntity::VARIABLE);
     q.addDeclaration("w", qps::query::DesignEntity::WHILE);
 
-    qps::query::Declaration d1 = qps::query::Declaration { "s", qps::query::DesignEntity::STMT };
+    qps::query::Declaration d1 = q.getDeclaration("s");
     std::vector<qps::query::Elem> tuple1 { qps::query::Elem::ofDeclaration(d1) };
     qps::query::ResultCl r1 = qps::query::ResultCl::ofTuple(tuple1);
     q.addResultCl(r1);
@@ -157,7 +157,7 @@ TEST_CASE("Test evaluate select c") {
     qps::query::Query q = qps::query::Query();
     q.addDeclaration("c", qps::query::DesignEntity::CONSTANT);
 
-    qps::query::Declaration d1 = qps::query::Declaration { "c", qps::query::DesignEntity::CONSTANT };
+    qps::query::Declaration d1 = q.getDeclaration("c");
     std::vector<qps::query::Elem> tuple1 { qps::query::Elem::ofDeclaration(d1) };
     qps::query::ResultCl r1 = qps::query::ResultCl::ofTuple(tuple1);
     q.addResultCl(r1);
@@ -179,7 +179,7 @@ TEST_CASE("Test evaluate select a") {
     qps::query::Query q = qps::query::Query();
     q.addDeclaration("a", qps::query::DesignEntity::ASSIGN);
 
-    qps::query::Declaration d1 = qps::query::Declaration { "a", qps::query::DesignEntity::ASSIGN };
+    qps::query::Declaration d1 = q.getDeclaration("a");
     std::vector<qps::query::Elem> tuple1 { qps::query::Elem::ofDeclaration(d1) };
     qps::query::ResultCl r1 = qps::query::ResultCl::ofTuple(tuple1);
     q.addResultCl(r1);
@@ -206,7 +206,7 @@ TEST_CASE("Test evaluate select v") {
     qps::query::Query q = qps::query::Query();
     q.addDeclaration("v", qps::query::DesignEntity::VARIABLE);
 
-    qps::query::Declaration d1 = qps::query::Declaration { "v", qps::query::DesignEntity::VARIABLE };
+    qps::query::Declaration d1 = q.getDeclaration("v");
     std::vector<qps::query::Elem> tuple1 { qps::query::Elem::ofDeclaration(d1) };
     qps::query::ResultCl r1 = qps::query::ResultCl::ofTuple(tuple1);
     q.addResultCl(r1);
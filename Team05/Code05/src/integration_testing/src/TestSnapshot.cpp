@@ -0,0 +1,196 @@
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <list>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "catch.hpp"
+
+#include "PhaseProfile.h"
+#include "PKB.h"
+#include "ProgramGenerator.h"
+#include "QPS/QPS.h"
+#include "QueryGenerator.h"
+#include "SourceProcessor.h"
+
+namespace {
+const char* SOURCE = R"(
+procedure main {
+    read x;
+    while ((x < 10) && (!(y == x))) {
+        y = x * 2 + y % 3;
+        if (y > 4) then {
+            x = y - 1;
+            call helper;
+        } else {
+            print y;
+        }
+    }
+    z = (x + y) / 2;
+}
+procedure helper {
+    x = x + 1;
+    print x;
+})";
+
+std::string getSnapshotPath(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / ("spa_test_" + name + ".pkb")).string();
+}
+
+std::list<std::string> evaluate(PKB& pkb, const std::string& query) {
+    std::list<std::string> results;
+    qps::QPS().evaluate(query, results, &pkb);
+    results.sort();
+    return results;
+}
+
+void requireSameRelationships(PKB& processed, PKB& loaded) {
+    auto stmt = PKBField::createDeclaration(StatementType::All);
+    auto var = PKBField::createDeclaration(PKBEntityType::VARIABLE);
+    auto proc = PKBField::createDeclaration(PKBEntityType::PROCEDURE);
+    for (auto rs : { PKBRelationship::FOLLOWS, PKBRelationship::FOLLOWST, PKBRelationship::PARENT,
+                     PKBRelationship::PARENTT, PKBRelationship::NEXT, PKBRelationship::NEXTT,
+                     PKBRelationship::AFFECTS, PKBRelationship::AFFECTST }) {
+        REQUIRE(processed.getRelationship(stmt, stmt, rs) == loaded.getRelationship(stmt, stmt, rs));
+    }
+    for (auto rs : { PKBRelationship::CALLS, PKBRelationship::CALLST }) {
+        REQUIRE(processed.getRelationship(proc, proc, rs) == loaded.getRelationship(proc, proc, rs));
+    }
+    for (auto rs : { PKBRelationship::MODIFIES, PKBRelationship::USES }) {
+        REQUIRE(processed.getRelationship(stmt, var, rs) == loaded.getRelationship(stmt, var, rs));
+        REQUIRE(processed.getRelationship(proc, var, rs) == loaded.getRelationship(proc, var, rs));
+    }
+}
+}  // namespace
+
+TEST_CASE("Loading a snapshot of a processed source") {
+    std::string source = SOURCE;
+    SECTION("Small program") {}
+    SECTION("Generated program") {
+        generator::ProgramConfig config;
+        config.statements = 300;
+        config.procedures = 6;
+        source = generator::ProgramGenerator(config).generate();
+    }
+    std::string path = getSnapshotPath("load");
+
+    PKB processed;
+    REQUIRE(SourceProcessor().processSimple(source, &processed));
+    REQUIRE(processed.saveSnapshot(path, source));
+
+    PKB loaded;
+    REQUIRE(loaded.loadSnapshot(path, source));
+    REQUIRE(loaded.isFrozen());
+
+    REQUIRE(processed.getStatements() == loaded.getStatements());
+    REQUIRE(processed.getVariables() == loaded.getVariables());
+    REQUIRE(processed.getProcedures() == loaded.getProcedures());
+    REQUIRE(processed.getConstants() == loaded.getConstants());
+    requireSameRelationships(processed, loaded);
+
+    using sp::design_extractor::PatternParam;
+    PatternParam any(std::nullopt);
+    REQUIRE(processed.match(StatementType::Assignment, any, PatternParam("x")) ==
+            loaded.match(StatementType::Assignment, any, PatternParam("x")));
+    REQUIRE(processed.match(StatementType::While, any) == loaded.match(StatementType::While, any));
+    REQUIRE(processed.match(StatementType::If, any) == loaded.match(StatementType::If, any));
+
+    for (auto query : { "assign a; Select a such that Affects*(a, _)",
+                        "stmt s1, s2; Select <s1, s2> such that Next*(s1, s2)",
+                        "assign a; variable v; Select <a, v> pattern a(v, _\"x\"_)",
+                        "call c; Select c.procName such that Follows*(_, c)" }) {
+        INFO(query);
+        REQUIRE(evaluate(processed, query) == evaluate(loaded, query));
+    }
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Generated queries on a loaded snapshot") {
+    generator::ProgramConfig config;
+    config.statements = 200;
+    config.procedures = 4;
+    generator::ProgramGenerator programGenerator(config);
+    std::ostringstream stream;
+    generator::ProgramInfo info = programGenerator.generate(stream);
+    std::string source = stream.str();
+    std::string path = getSnapshotPath("queries");
+
+    PKB processed;
+    REQUIRE(SourceProcessor().processSimple(source, &processed));
+    REQUIRE(processed.saveSnapshot(path, source));
+    PKB loaded;
+    REQUIRE(loaded.loadSnapshot(path, source));
+
+    generator::QueryConfig queryConfig;
+    queryConfig.count = 100;
+    for (auto& query : generator::generateQueries(info, queryConfig)) {
+        INFO(query.getQuery());
+        REQUIRE(evaluate(processed, query.getQuery()) == evaluate(loaded, query.getQuery()));
+    }
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Rejecting a snapshot that does not match") {
+    std::string path = getSnapshotPath("reject");
+    PKB processed;
+    REQUIRE(SourceProcessor().processSimple(SOURCE, &processed));
+    REQUIRE(processed.saveSnapshot(path, SOURCE));
+
+    SECTION("Another source") {
+        PKB pkb;
+        REQUIRE_FALSE(pkb.loadSnapshot(path, std::string(SOURCE) + "\n"));
+        REQUIRE_FALSE(pkb.isFrozen());
+        REQUIRE_FALSE(pkb.getStatements().hasResult);
+    }
+    SECTION("Corrupted snapshot") {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(-5, std::ios::end);
+        file.put('\x7f');
+        file.close();
+        PKB pkb;
+        REQUIRE_FALSE(pkb.loadSnapshot(path, SOURCE));
+        REQUIRE_FALSE(pkb.getStatements().hasResult);
+    }
+    SECTION("Truncated snapshot") {
+        std::filesystem::resize_file(path, 20);
+        PKB pkb;
+        REQUIRE_FALSE(pkb.loadSnapshot(path, SOURCE));
+    }
+    SECTION("Missing snapshot") {
+        std::remove(path.c_str());
+        PKB pkb;
+        REQUIRE_FALSE(pkb.loadSnapshot(path, SOURCE));
+    }
+    SECTION("Frozen PKB") {
+        REQUIRE_FALSE(processed.loadSnapshot(path, SOURCE));
+    }
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Processing a source through its snapshot") {
+    std::string path = getSnapshotPath("cached");
+    std::remove(path.c_str());
+
+    PKB first;
+    sp::PhaseProfile firstProfile;
+    REQUIRE(SourceProcessor().processCached(SOURCE, &first, path, &firstProfile));
+    REQUIRE(std::filesystem::exists(path));
+    REQUIRE(firstProfile.getPhases().front().first == "snapshot load");
+    REQUIRE(firstProfile.getPhases().back().first == "snapshot save");
+
+    PKB second;
+    sp::PhaseProfile secondProfile;
+    REQUIRE(SourceProcessor().processCached(SOURCE, &second, path, &secondProfile));
+    REQUIRE(secondProfile.getPhases().size() == 1);
+    requireSameRelationships(first, second);
+
+    PKB invalid;
+    REQUIRE_FALSE(SourceProcessor().processCached("procedure {", &invalid, path));
+
+    std::remove(path.c_str());
+}
@@ -0,0 +1,147 @@
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "catch.hpp"
+
+#include "Baseline.h"
+#include "PhaseProfile.h"
+#include "PKB.h"
+#include "SourceProcessor.h"
+#include "SystemBenchmark.h"
+
+namespace {
+const char* SOURCE = R"(
+procedure main {
+    x = 1;
+    while (x < 10) {
+        y = x + 2;
+        x = y;
+    }
+    call helper;
+}
+procedure helper {
+    print x;
+})";
+
+const char* QUERIES = R"(1 - follows
+stmt s;
+Select s such that Follows(1, s)
+2
+5000
+2 - affects
+assign a1, a2;
+Select <a1, a2> such that Affects(a1, a2)
+1 3, 3 4, 4 3
+5000
+)";
+}  // namespace
+
+TEST_CASE("Processing the source records every phase") {
+    PKB pkb;
+    sp::PhaseProfile profile;
+    REQUIRE(SourceProcessor().processSimple(SOURCE, &pkb, &profile));
+
+    std::vector<std::string> phases;
+    for (auto& [phase, ms] : profile.getPhases()) {
+        phases.push_back(phase);
+        REQUIRE(ms >= 0);
+    }
+    REQUIRE(phases == std::vector<std::string>{
+        "lex", "parse", "fused extractor", "pkb load", "cfg", "next extractor"
+    });
+    REQUIRE(profile.getMs("unknown") == 0);
+}
+
+TEST_CASE("Replaying the queries of a source") {
+    std::istringstream queryFile(QUERIES);
+    auto queries = runner::readQueries(queryFile);
+    REQUIRE(queries.size() == 2);
+    REQUIRE(queries[1].id == "2");
+    REQUIRE(queries[1].comment == "affects");
+    REQUIRE(queries[1].query == "assign a1, a2; Select <a1, a2> such that Affects(a1, a2)");
+
+    runner::RunnerConfig config;
+    config.repetitions = 3;
+    SECTION("Sequentially") {}
+    SECTION("Concurrently") {
+        config.threads = 2;
+    }
+    auto report = runner::runSource("small", SOURCE, queries, config);
+    REQUIRE(report.isProcessed);
+    REQUIRE(report.phases.size() == 6);
+#if defined(__unix__) || defined(__APPLE__)
+    REQUIRE(report.peakRssKb > 0);
+#endif
+    REQUIRE(report.memory.getBytes("CFG") > 0);
+    REQUIRE(report.queries.size() == 2);
+    REQUIRE(report.queries[0].resultCount == 1);
+    REQUIRE(report.queries[1].resultCount == 3);
+    REQUIRE(report.queries[1].peakKb > 0);
+    for (auto& query : report.queries) {
+        REQUIRE(query.latency.count == 3);
+        REQUIRE(query.latency.p50Ms <= query.latency.p99Ms);
+        REQUIRE(query.latency.p99Ms <= query.latency.maxMs);
+    }
+
+    REQUIRE_FALSE(runner::runSource("invalid", "procedure {", queries, config).isProcessed);
+}
+
+TEST_CASE("Latency percentiles") {
+    std::vector<double> samples;
+    for (int i = 100; i >= 1; i--) samples.push_back(i);
+    auto summary = runner::summarize(samples);
+    REQUIRE(summary.count == 100);
+    REQUIRE(summary.meanMs == 50.5);
+    REQUIRE(summary.p50Ms == 50);
+    REQUIRE(summary.p95Ms == 95);
+    REQUIRE(summary.p99Ms == 99);
+    REQUIRE(summary.maxMs == 100);
+
+    REQUIRE(runner::summarize({ 7 }).p50Ms == 7);
+    REQUIRE(runner::summarize({}).count == 0);
+}
+
+TEST_CASE("Comparing a report against a baseline") {
+    runner::BenchmarkReport report;
+    runner::SourceReport source;
+    source.name = "Sample";
+    source.isProcessed = true;
+    source.processMs = 10;
+    source.phases = { { "lex", 1 }, { "parse", 2 } };
+    source.memory.add("Follows", 2048);
+    source.queries.push_back(runner::QueryReport{ { "1", "a \"quoted\" comment", "stmt s; Select s" }, 3,
+                                                  runner::summarize({ 1, 2, 3 }) });
+    report.sources.push_back(source);
+    report.peakRssKb = 20000;
+
+    auto baseline = runner::readMetrics(report.toJson());
+    REQUIRE(baseline.at("sources/Sample/processMs") == 10);
+    REQUIRE(baseline.at("sources/Sample/phases/parse") == 2);
+    REQUIRE(baseline.at("sources/Sample/queries/1/p50Ms") == 2);
+    REQUIRE(baseline.at("sources/Sample/memoryBytes/Follows") == 2048);
+    REQUIRE(baseline.at("sources/Sample/pkbKb") == 2);
+    REQUIRE(baseline.at("peakRssKb") == 20000);
+    REQUIRE(runner::compare(baseline, baseline).empty());
+
+    auto current = baseline;
+    current["sources/Sample/processMs"] = 13;  // slower by more than the threshold
+    current["sources/Sample/queries/1/p95Ms"] = 3.3;  // slower by less than the threshold
+    current["sources/Sample/queries/1/p50Ms"] = 2.4;  // slower by less than the absolute difference
+    current["sources/Sample/phases/parse"] = 20;  // phases are not compared
+    current["peakRssKb"] = 30000;
+    auto regressions = runner::compare(baseline, current);
+    REQUIRE(regressions.size() == 2);
+    REQUIRE(regressions[0].metric == "peakRssKb");
+    REQUIRE(regressions[1].metric == "sources/Sample/processMs");
+    REQUIRE(regressions[1].baseline == 10);
+    REQUIRE(regressions[1].current == 13);
+
+    runner::ComparisonConfig strict;
+    strict.threshold = 0.05;
+    strict.minDeltaMs = 0.1;
+    REQUIRE(runner::compare(baseline, current, strict).size() == 4);
+
+    REQUIRE_THROWS_AS(runner::readMetrics("{\"a\": }"), std::invalid_argument);
+}
@@ -42,7 +42,7 @@ TEST_CASE("test concrete with clause") {
     query.addWith(with);
     query.addDeclaration("s", qps::query::DesignEntity::STMT);
 
-    qps::query::Declaration d1 = qps::query::Declaration { "s", qps::query::DesignEntity::STMT };
+    qps::query::Declaration d1 = query.getDeclaration("s");
     std::vector<qps::query::Elem> tuple1 { qps::query::Elem::ofDeclaration(d1) };
     qps::query::ResultCl r1 = qps::query::ResultCl::ofTuple(tuple1);
     query.addResultCl(r1);
@@ -60,7 +60,7 @@ TEST_CASE("test concrete with clause") {
     query2.addWith(with2);
     query2.addDeclaration("s", qps::query::DesignEntity::STMT);
 
-    qps::query::Declaration d2 = qps::query::Declaration { "s", qps::query::DesignEntity::STMT };
+    qps::query::Declaration d2 = query2.getDeclaration("s");
     std::vector<qps::query::Elem> tuple2 { qps::query::Elem::ofDeclaration(d2) };
     qps::query::ResultCl r2 = qps::query::ResultCl::ofTuple(tuple2);
     query2.addResultCl(r2);
@@ -78,7 +78,7 @@ TEST_CASE("test concrete with clause") {
     query3.addWith(with3);
     query3.addDeclaration("s", qps::query::DesignEntity::STMT);
 
-    qps::query::Declaration d3 = qps::query::Declaration { "s", qps::query::DesignEntity::STMT };
+    qps::query::Declaration d3 = query3.getDeclaration("s");
     std::vector<qps::query::Elem> tuple3 { qps::query::Elem::ofDeclaration(d3) };
     qps::query::ResultCl r3 = qps::query::ResultCl::ofTuple(tuple3);
     query3.addResultCl(r3);
@@ -97,7 +97,7 @@ TEST_CASE("test concrete with clause") {
     query4.addWith(with3);
     query4.addDeclaration("s", qps::query::DesignEntity::STMT);
 
-    qps::query::Declaration d4 = qps::query::Declaration { "s", qps::query::DesignEntity::STMT };
+    qps::query::Declaration d4 = query4.getDeclaration("s");
     std::vector<qps::query::Elem> tuple4 { qps::query::Elem::ofDeclaration(d4) };
     qps::query::ResultCl r4 = qps::query::ResultCl::ofTuple(tuple4);
     query4.addResultCl(r4);
@@ -113,15 +113,15 @@ TEST_CASE("Test with clause with one attrRef") {
 
     TEST_LOG << "select c with c.procName = 'proc2'";
     qps::query::Query query;
+    query.addDeclaration("c", qps::query::DesignEntity::CALL);
     qps::query::AttrRef attr = qps::query::AttrRef{qps::query::AttrName::PROCNAME,
-                                                   Declaration { "c", qps::query::DesignEntity::CALL }};
+                                                   query.getDeclaration("c")};
     qps::query::AttrCompareRef lhs = qps::query::AttrCompareRef::ofAttrRef(attr);
     qps::query::AttrCompareRef rhs = qps::query::AttrCompareRef::ofString("proc2");
     qps::query::AttrCompare with = qps::query::AttrCompare{lhs, rhs};
     query.addWith(with);
-    query.addDeclaration("c", qps::query::DesignEntity::CALL);
 
-    qps::query::Declaration d1 = qps::query::Declaration { "c", qps::query::DesignEntity::CALL };
+    qps::query::Declaration d1 = query.getDeclaration("c");
     std::vector<qps::query::Elem> tuple1 { qps::query::Elem::ofDeclaration(d1) };
     qps::query::ResultCl r1 = qps::query::ResultCl::ofTuple(tuple1);
     query.addResultCl(r1);
@@ -133,15 +133,15 @@ TEST_CASE("Test with clause with one attrRef") {
 
     TEST_LOG << "select pr with pr.varName = 'y'";
     qps::query::Query query2;
+    query2.addDeclaration("pr", qps::query::DesignEntity::PRINT);
     qps::query::AttrRef attr2 = qps::query::AttrRef{qps::query::AttrName::VARNAME,
-                                                    Declaration { "pr", qps::query::DesignEntity::PRINT }};
+                                                    query2.getDeclaration("pr")};
     qps::query::AttrCompareRef lhs2 = qps::query::AttrCompareRef::ofAttrRef(attr2);
     qps::query::AttrCompareRef rhs2 = qps::query::AttrCompareRef::ofString("y");
     qps::query::AttrCompare with2 = qps::query::AttrCompare{lhs2, rhs2};
     query2.addWith(with2);
-    query2.addDeclaration("pr", qps::query::DesignEntity::PRINT);
 
-    qps::query::Declaration d2 = qps::query::Declaration { "pr", qps::query::DesignEntity::PRINT };
+    qps::query::Declaration d2 = query2.getDeclaration("pr");
     std::vector<qps::query::Elem> tuple2 { qps::query::Elem::ofDeclaration(d2) };
     qps::query::ResultCl r2 = qps::query::ResultCl::ofTuple(tuple2);
     query2.addResultCl(r2);
@@ -153,15 +153,15 @@ TEST_CASE("Test with clause with one attrRef") {
 
     TEST_LOG << "select r with r.varName = 'variable'";
     qps::query::Query query3;
+    query3.addDeclaration("r", qps::query::DesignEntity::READ);
     qps::query::AttrRef attr3 = qps::query::AttrRef{qps::query::AttrName::VARNAME,
-                                                    Declaration { "r", qps::query::DesignEntity::READ }};
+                                                    query3.getDeclaration("r")};
     qps::query::AttrCompareRef lhs3 = qps::query::AttrCompareRef::ofAttrRef(attr3);
     qps::query::AttrCompareRef rhs3 = qps::query::AttrCompareRef::ofString("variable");
     qps::query::AttrCompare with3 = qps::query::AttrCompare{lhs3, rhs3};
     query3.addWith(with3);
-    query3.addDeclaration("r", qps::query::DesignEntity::READ);
 
-    qps::query::Declaration d3 = qps::query::Declaration { "r", qps::query::DesignEntity::READ };
+    qps::query::Declaration d3 = query3.getDeclaration("r");
     std::vector<qps::query::Elem> tuple3 { qps::query::Elem::ofDeclaration(d3) };
     qps::query::ResultCl r3 = qps::query::ResultCl::ofTuple(tuple3);
     query3.addResultCl(r3);
@@ -173,15 +173,15 @@ TEST_CASE("Test with clause with one attrRef") {
 
     TEST_LOG << "select p with p.procName = 'proc2'";
     qps::query::Query query4;
+    query4.addDeclaration("p", qps::query::DesignEntity::PROCEDURE);
     qps::query::AttrRef attr4 = qps::query::AttrRef{qps::query::AttrName::PROCNAME,
-                                                    Declaration { "p", qps::query::DesignEntity::PROCEDURE }};
+                                                    query4.getDeclaration("p")};
     qps::query::AttrCompareRef lhs4 = qps::query::AttrCompareRef::ofAttrRef(attr4);
     qps::query::AttrCompareRef rhs4 = qps::query::AttrCompareRef::ofString("proc2");
     qps::query::AttrCompare with4 = qps::query::AttrCompare{lhs4, rhs4};
     query4.addWith(with4);
-    query4.addDeclaration("p", qps::query::DesignEntity::PROCEDURE);
 
-    qps::query::Declaration d4 = qps::query::Declaration { "p", qps::query::DesignEntity::PROCEDURE };
+    qps::query::Declaration d4 = query4.getDeclaration("p");
     std::vector<qps::query::Elem> tuple4 { qps::query::Elem::ofDeclaration(d4) };
     qps::query::ResultCl r4 = qps::query::ResultCl::ofTuple(tuple4);
     query4.addResultCl(r4);
@@ -193,15 +193,15 @@ TEST_CASE("Test with clause with one attrRef") {
 
     TEST_LOG << "select a with a.Stmt# = 4";
     qps::query::Query query5;
+    query5.addDeclaration("a", qps::query::DesignEntity::ASSIGN);
     qps::query::AttrRef attr5 = qps::query::AttrRef{qps::query::AttrName::STMTNUM,
-                                                    Declaration { "a", qps::query::DesignEntity::ASSIGN }};
+                                                    query5.getDeclaration("a")};
     qps::query::AttrCompareRef lhs5 = qps::query::AttrCompareRef::ofAttrRef(attr5);
     qps::query::AttrCompareRef rhs5 = qps::query::AttrCompareRef::ofNumber(4);
     qps::query::AttrCompare with5 = qps::query::AttrCompare{lhs5, rhs5};
     query5.addWith(with5);
-    query5.addDeclaration("a", qps::query::DesignEntity::ASSIGN);
 
-    qps::query::Declaration d5 = qps::query::Declaration { "a", qps::query::DesignEntity::ASSIGN };
+    qps::query::Declaration d5 = query5.getDeclaration("a");
     std::vector<qps::query::Elem> tuple5 { qps::query::Elem::ofDeclaration(d5) };
     qps::query::ResultCl r5 = qps::query::ResultCl::ofTuple(tuple5);
     query5.addResultCl(r5);
@@ -213,15 +213,15 @@ TEST_CASE("Test with clause with one attrRef") {
 
     TEST_LOG << "select w with w.Stmt# = 4";
     qps::query::Query query6;
+    query6.addDeclaration("w", qps::query::DesignEntity::WHILE);
     qps::query::AttrRef attr6 = qps::query::AttrRef{qps::query::AttrName::STMTNUM,
-                                                    Declaration { "w", qps::query::DesignEntity::WHILE }};
+                                                    query6.getDeclaration("w")};
     qps::query::AttrCompareRef lhs6 = qps::query::AttrCompareRef::ofAttrRef(attr6);
     qps::query::AttrCompareRef rhs6 = qps::query::AttrCompareRef::ofNumber(4);
     qps::query::AttrCompare with6 = qps::query::AttrCompare{rhs6, lhs6};
     query6.addWith(with6);
-    query6.addDeclaration("w", qps::query::DesignEntity::WHILE);
 
-    qps::query::Declaration d6 = qps::query::Declaration { "w", qps::query::DesignEntity::WHILE };
+    qps::query::Declaration d6 = query6.getDeclaration("w");
     std::vector<qps::query::Elem> tuple6 { qps::query::Elem::ofDeclaration(d6) };
     qps::query::ResultCl r6 = qps::query::ResultCl::ofTuple(tuple6);
     query6.addResultCl(r6);
@@ -237,18 +237,18 @@ TEST_CASE("test with clauses with two attrRefs") {
 
     TEST_LOG << "select c with c.procName = p.procName";
     qps::query::Query query;
+    query.addDeclaration("c", qps::query::DesignEntity::CALL);
+    query.addDeclaration("p", qps::query::DesignEntity::PROCEDURE);
     qps::query::AttrRef attrl = qps::query::AttrRef{qps::query::AttrName::PROCNAME,
-                                                    Declaration { "c", qps::query::DesignEntity::CALL }};
+                                                    query.getDeclaration("c")};
     qps::query::AttrRef attrr = qps::query::AttrRef{ qps::query::AttrName::PROCNAME,
-                                                     Declaration { "p", qps::query::DesignEntity::PROCEDURE }};
+                                                     query.getDeclaration("p")};
     qps::query::AttrCompareRef lhs = qps::query::AttrCompareRef::ofAttrRef(attrl);
     qps::query::AttrCompareRef rhs = qps::query::AttrCompareRef::ofAttrRef(attrr);
     qps::query::AttrCompare with = qps::query::AttrCompare{lhs, rhs};
     query.addWith(with);
-    query.addDeclaration("c", qps::query::DesignEntity::CALL);
-    query.addDeclaration("p", qps::query::DesignEntity::PROCEDURE);
 
-    qps::query::Declaration d = qps::query::Declaration { "c", qps::query::DesignEntity::CALL };
+    qps::query::Declaration d = query.getDeclaration("c");
     std::vector<qps::query::Elem> tuple { qps::query::Elem::ofDeclaration(d) };
     qps::query::ResultCl r = qps::query::ResultCl::ofTuple(tuple);
     query.addResultCl(r);
@@ -260,18 +260,18 @@ TEST_CASE("test with clauses with two attrRefs") {
 
     TEST_LOG << "select s with c.procName = c.procName";
     qps::query::Query query1;
+    query1.addDeclaration("c", qps::query::DesignEntity::CALL);
+    query1.addDeclaration("s", qps::query::DesignEntity::STMT);
     qps::query::AttrRef attrl1 = qps::query::AttrRef{qps::query::AttrName::PROCNAME,
-                                                     Declaration { "c", qps::query::DesignEntity::CALL }};
+                                                     query1.getDeclaration("c")};
     qps::query::AttrRef attrr1 = qps::query::AttrRef{qps::query::AttrName::PROCNAME,
-                                                     Declaration { "c", qps::query::DesignEntity::CALL }};
+                                                     query1.getDeclaration("c")};
     qps::query::AttrCompareRef lhs1 = qps::query::AttrCompareRef::ofAttrRef(attrl1);
     qps::query::AttrCompareRef rhs1 = qps::query::AttrCompareRef::ofAttrRef(attrr1);
     qps::query::AttrCompare with1 = qps::query::AttrCompare{lhs1, rhs1};
     query1.addWith(with1);
-    query1.addDeclaration("c", qps::query::DesignEntity::CALL);
-    query1.addDeclaration("s", qps::query::DesignEntity::STMT);
 
-    qps::query::Declaration d1 = qps::query::Declaration { "s", qps::query::DesignEntity::STMT };
+    qps::query::Declaration d1 = query1.getDeclaration("s");
     std::vector<qps::query::Elem> tuple1 { qps::query::Elem::ofDeclaration(d1) };
     qps::query::ResultCl r1 = qps::query::ResultCl::ofTuple(tuple1);
     query1.addResultCl(r1);
@@ -283,18 +283,18 @@ TEST_CASE("test with clauses with two attrRefs") {
 
     TEST_LOG << "select v with pr.varName = v.varName";
     qps::query::Query query2;
+    query2.addDeclaration("pr", qps::query::DesignEntity::PRINT);
+    query2.addDeclaration("v", qps::query::DesignEntity::VARIABLE);
     qps::query::AttrRef attrl2 = qps::query::AttrRef{qps::query::AttrName::VARNAME,
-                                                     Declaration { "pr", qps::query::DesignEntity::PRINT }};
+                                                     query2.getDeclaration("pr")};
     qps::query::AttrRef attrr2 = qps::query::AttrRef{qps::query::AttrName::VARNAME,
-                                                     Declaration { "v", qps::query::DesignEntity::VARIABLE }};
+                                                     query2.getDeclaration("v")};
     qps::query::AttrCompareRef lhs2 = qps::query::AttrCompareRef::ofAttrRef(attrl2);
     qps::query::AttrCompareRef rhs2 = qps::query::AttrCompareRef::ofAttrRef(attrr2);
     qps::query::AttrCompare with2 = qps::query::AttrCompare{lhs2, rhs2};
     query2.addWith(with2);
-    query2.addDeclaration("pr", qps::query::DesignEntity::PRINT);
-    query2.addDeclaration("v", qps::query::DesignEntity::VARIABLE);
 
-    qps::query::Declaration d2 = qps::query::Declaration { "v", qps::query::DesignEntity::VARIABLE };
+    qps::query::Declaration d2 = query2.getDeclaration("v");
     std::vector<qps::query::Elem> tuple2 { qps::query::Elem::ofDeclaration(d2) };
     qps::query::ResultCl r2 = qps::query::ResultCl::ofTuple(tuple2);
     query2.addResultCl(r2);
@@ -306,18 +306,18 @@ TEST_CASE("test with clauses with two attrRefs") {
 
     TEST_LOG << "select r with r.varName = pr.varName";
     qps::query::Query query3;
+    query3.addDeclaration("r", qps::query::DesignEntity::READ);
+    query3.addDeclaration("pr", qps::query::DesignEntity::PRINT);
     qps::query::AttrRef attrl3 = qps::query::AttrRef{qps::query::AttrName::VARNAME,
-                                                     Declaration { "r", qps::query::DesignEntity::READ }};
+                                                     query3.getDeclaration("r")};
     qps::query::AttrRef attrr3 = qps::query::AttrRef{qps::query::AttrName::VARNAME,
-                                                     Declaration { "pr", qps::query::DesignEntity::PRINT }};
+                                                     query3.getDeclaration("pr")};
     qps::query::AttrCompareRef lhs3 = qps::query::AttrCompareRef::ofAttrRef(attrl3);
     qps::query::AttrCompareRef rhs3 = qps::query::AttrCompareRef::ofAttrRef(attrr3);
     qps::query::AttrCompare with3 = qps::query::AttrCompare{lhs3, rhs3};
     query3.addWith(with3);
-    query3.addDeclaration("r", qps::query::DesignEntity::READ);
-    query3.addDeclaration("pr", qps::query::DesignEntity::PRINT);
 
-    qps::query::Declaration d3 = qps::query::Declaration { "r", qps::query::DesignEntity::READ };
+    qps::query::Declaration d3 = query3.getDeclaration("r");
     std::vector<qps::query::Elem> tuple3 { qps::query::Elem::ofDeclaration(d3) };
     qps::query::ResultCl r3 = qps::query::ResultCl::ofTuple(tuple3);
     query3.addResultCl(r3);
@@ -329,18 +329,18 @@ TEST_CASE("test with clauses with two attrRefs") {
 
     TEST_LOG << "select c with a.stmt# = c.value";
     qps::query::Query query4;
+    query4.addDeclaration("a", qps::query::DesignEntity::ASSIGN);
+    query4.addDeclaration("c", qps::query::DesignEntity::CONSTANT);
     qps::query::AttrRef attrl4 = qps::query::AttrRef{qps::query::AttrName::STMTNUM,
-                                                     Declaration { "a", qps::query::DesignEntity::ASSIGN }};
+                                                     query4.getDeclaration("a")};
     qps::query::AttrRef attrr4 = qps::query::AttrRef{qps::query::AttrName::VALUE,
-                                                     Declaration { "c", qps::query::DesignEntity::CONSTANT }};
+                                                     query4.getDeclaration("c")};
     qps::query::AttrCompareRef lhs4 = qps::query::AttrCompareRef::ofAttrRef(attrl4);
     qps::query::AttrCompareRef rhs4 = qps::query::AttrCompareRef::ofAttrRef(attrr4);
     qps::query::AttrCompare with4 = qps::query::AttrCompare{lhs4, rhs4};
     query4.addWith(with4);
-    query4.addDeclaration("a", qps::query::DesignEntity::ASSIGN);
-    query4.addDeclaration("c", qps::query::DesignEntity::CONSTANT);
 
-    qps::query::Declaration d4 = qps::query::Declaration { "c", qps::query::DesignEntity::CONSTANT };
+    qps::query::Declaration d4 = query4.getDeclaration("c");
     std::vector<qps::query::Elem> tuple4 { qps::query::Elem::ofDeclaration(d4) };
     qps::query::ResultCl r4 = qps::query::ResultCl::ofTuple(tuple4);
     query4.addResultCl(r4);
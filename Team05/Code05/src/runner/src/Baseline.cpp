@@ -0,0 +1,166 @@
+#include <cctype>
+#include <cstdlib>
+#include <set>
+#include <stdexcept>
+
+#include "Baseline.h"
+
+namespace runner {
+namespace {
+const std::set<std::string> TIME_METRICS { "p50Ms", "p95Ms", "p99Ms", "processMs" };
+const std::set<std::string> MEMORY_METRICS { "peakRssKb", "pkbKb", "peakKb" };
+
+/**
+ * A recursive descent reader of JSON that only keeps the numbers.
+ */
+class MetricReader {
+public:
+    MetricReader(const std::string& json, std::map<std::string, double>& metrics) : json(json), metrics(metrics) {}
+
+    void read() {
+        readValue("");
+        skipSpaces();
+        if (pos != json.size()) fail("trailing characters");
+    }
+
+private:
+    const std::string& json;
+    std::map<std::string, double>& metrics;
+    std::size_t pos = 0;
+
+    [[noreturn]] void fail(const std::string& reason) {
+        throw std::invalid_argument("Invalid JSON at offset " + std::to_string(pos) + ": " + reason);
+    }
+
+    void skipSpaces() {
+        while (pos < json.size() && std::isspace(static_cast<unsigned char>(json[pos]))) pos++;
+    }
+
+    bool consume(char c) {
+        skipSpaces();
+        if (pos < json.size() && json[pos] == c) {
+            pos++;
+            return true;
+        }
+        return false;
+    }
+
+    void expect(char c) {
+        if (!consume(c)) fail(std::string("expected '") + c + "'");
+    }
+
+    static std::string join(const std::string& path, const std::string& key) {
+        return path.empty() ? key : path + "/" + key;
+    }
+
+    std::string readString() {
+        expect('"');
+        std::string s;
+        while (pos < json.size() && json[pos] != '"') {
+            char c = json[pos++];
+            if (c != '\\') {
+                s += c;
+                continue;
+            }
+            if (pos >= json.size()) fail("unterminated escape");
+            char escaped = json[pos++];
+            switch (escaped) {
+                case 'n': s += '\n'; break;
+                case 't': s += '\t'; break;
+                case 'r': s += '\r'; break;
+                case 'b': s += '\b'; break;
+                case 'f': s += '\f'; break;
+                case 'u':
+                    // only the control characters the reports escape are expected, anything else is kept as is
+                    if (pos + 4 > json.size()) fail("truncated unicode escape");
+                    s += static_cast<char>(std::strtol(json.substr(pos, 4).c_str(), nullptr, 16));
+                    pos += 4;
+                    break;
+                default: s += escaped;
+            }
+        }
+        expect('"');
+        return s;
+    }
+
+    void readLiteral(const std::string& literal) {
+        if (json.compare(pos, literal.size(), literal) != 0) fail("unexpected value");
+        pos += literal.size();
+    }
+
+    void readValue(const std::string& path) {
+        skipSpaces();
+        if (pos >= json.size()) fail("unexpected end");
+        char c = json[pos];
+        if (c == '{') {
+            pos++;
+            if (consume('}')) return;
+            do {
+                std::string key = readString();
+                expect(':');
+                readValue(join(path, key));
+            } while (consume(','));
+            expect('}');
+        } else if (c == '[') {
+            pos++;
+            if (consume(']')) return;
+            int index = 0;
+            do {
+                readValue(join(path, std::to_string(index++)));
+            } while (consume(','));
+            expect(']');
+        } else if (c == '"') {
+            readString();
+        } else if (c == 't') {
+            readLiteral("true");
+        } else if (c == 'f') {
+            readLiteral("false");
+        } else if (c == 'n') {
+            readLiteral("null");
+        } else {
+            const char* begin = json.c_str() + pos;
+            char* end = nullptr;
+            double value = std::strtod(begin, &end);
+            if (end == begin) fail("unexpected character");
+            pos += end - begin;
+            metrics[path] = value;
+        }
+    }
+};
+
+std::string getMetricName(const std::string& path) {
+    auto separator = path.rfind('/');
+    return separator == std::string::npos ? path : path.substr(separator + 1);
+}
+}  // namespace
+
+std::map<std::string, double> readMetrics(const std::string& json) {
+    std::map<std::string, double> metrics;
+    MetricReader(json, metrics).read();
+    return metrics;
+}
+
+std::vector<Regression> compare(const std::map<std::string, double>& baseline,
+                                const std::map<std::string, double>& current,
+                                const ComparisonConfig& config) {
+    std::vector<Regression> regressions;
+    for (auto& [metric, value] : current) {
+        auto it = baseline.find(metric);
+        if (it == baseline.end()) continue;
+        std::string name = getMetricName(metric);
+        double minDelta;
+        if (TIME_METRICS.count(name)) {
+            minDelta = config.minDeltaMs;
+        } else if (MEMORY_METRICS.count(name)) {
+            minDelta = config.minDeltaKb;
+        } else {
+            continue;
+        }
+        double delta = value - it->second;
+        if (delta > minDelta && value > it->second * (1 + config.threshold)) {
+            regressions.push_back(Regression{metric, it->second, value});
+        }
+    }
+    return regressions;
+}
+}  // namespace runner
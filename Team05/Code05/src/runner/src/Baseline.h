@@ -0,0 +1,46 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace runner {
+/**
+ * Reads every number of a JSON document, keyed by its path from the root, e.g. sources/Sample/queries/3/p95Ms.
+ * Array elements are keyed by their index.
+ *
+ * @param json the JSON document, e.g. a report written by BenchmarkReport::toJson
+ * @return the numbers of the document by path
+ * @throws std::invalid_argument if the document is not valid JSON
+ */
+std::map<std::string, double> readMetrics(const std::string& json);
+
+/**
+ * When a metric counts as a regression: it has to be slower than the baseline by more than the threshold, and by
+ * more than a small absolute difference, so that the timings of very fast queries are not flagged for noise.
+ */
+struct ComparisonConfig {
+    double threshold = 0.2;  // the allowed slowdown, as a fraction of the baseline
+    double minDeltaMs = 0.5;
+    double minDeltaKb = 1024;
+};
+
+struct Regression {
+    std::string metric;
+    double baseline;
+    double current;
+};
+
+/**
+ * Compares the latency percentiles, processing times, peak resident set sizes, memory held by the PKB and peak
+ * memory of the intermediate results of the queries of a report against a baseline.
+ * Metrics that are only in one of the two are not compared.
+ *
+ * @param baseline the metrics of the baseline report
+ * @param current the metrics of the current report
+ * @return the metrics that regressed, in order of path
+ */
+std::vector<Regression> compare(const std::map<std::string, double>& baseline,
+                                const std::map<std::string, double>& current,
+                                const ComparisonConfig& config = {});
+}  // namespace runner
@@ -0,0 +1,273 @@
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <exception>
+#include <list>
+#include <numeric>
+#include <set>
+#include <sstream>
+#include <thread>
+
+#include "Cancellation.h"
+#include "exceptions.h"
+#include "PhaseProfile.h"
+#include "PKB.h"
+#include "QPS/QPS.h"
+#include "QPS/ResultCache.h"
+#include "SourceProcessor.h"
+#include "SystemBenchmark.h"
+
+namespace runner {
+namespace {
+using Clock = std::chrono::steady_clock;
+
+double toMs(Clock::duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+std::string trim(const std::string& line) {
+    auto begin = line.find_first_not_of(" \t\r");
+    auto end = line.find_last_not_of(" \t\r");
+    return begin == std::string::npos ? "" : line.substr(begin, end - begin + 1);
+}
+
+void writeString(std::ostringstream& out, const std::string& s) {
+    out << '"';
+    for (char c : s) {
+        switch (c) {
+            case '"': out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\t': out << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    out << escaped;
+                } else {
+                    out << c;
+                }
+        }
+    }
+    out << '"';
+}
+
+/**
+ * The latency and result count of a single evaluation of a query.
+ */
+struct Sample {
+    std::size_t query;
+    double ms;
+    std::size_t resultCount;
+    std::size_t peakBytes;
+};
+
+// evaluates a query the way the autotester does, which clears the caches of the pkb once the query is done.
+Sample evaluateAlone(qps::QPS& qps, const QueryCase& query, std::size_t index, PKB* pkb) {
+    std::list<std::string> results;
+    CancellationToken token;
+    auto start = Clock::now();
+    qps.evaluate(query.query, results, pkb, &token);
+    return Sample{index, toMs(Clock::now() - start), results.size(), token.getPeakMemory()};
+}
+
+// evaluates a query while others are evaluated against the same pkb, leaving the caches of the pkb to be cleared
+// once they are all done. The query gets a cache of its own, so that no result is shared between queries.
+Sample evaluateShared(qps::QPS& qps, const QueryCase& query, std::size_t index, PKB* pkb) {
+    std::list<std::string> results;
+    CancellationToken token;
+    auto start = Clock::now();
+    qps::evaluator::ResultCache cache;
+    try {
+        qps.execute(qps.prepare(query.query), {}, results, pkb, &cache, &token);
+    } catch (const exceptions::PqlSemanticException&) {
+        // a placeholder left in the query is answered with no results, as evaluate does.
+    }
+    return Sample{index, toMs(Clock::now() - start), results.size(), token.getPeakMemory()};
+}
+
+std::vector<Sample> replay(const std::vector<QueryCase>& queries, int threads, PKB* pkb) {
+    std::vector<Sample> samples;
+    if (threads <= 1) {
+        qps::QPS qps;
+        for (std::size_t i = 0; i < queries.size(); i++) {
+            samples.push_back(evaluateAlone(qps, queries[i], i, pkb));
+        }
+        return samples;
+    }
+
+    std::atomic<std::size_t> next = 0;
+    std::vector<std::vector<Sample>> threadSamples(threads);
+    std::vector<std::exception_ptr> errors(threads);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            qps::QPS qps;
+            try {
+                for (std::size_t i = next++; i < queries.size(); i = next++) {
+                    threadSamples[t].push_back(evaluateShared(qps, queries[i], i, pkb));
+                }
+            } catch (...) {
+                errors[t] = std::current_exception();
+            }
+        });
+    }
+    for (auto& worker : workers) worker.join();
+    pkb->clearCache();
+    for (auto& error : errors) {
+        if (error) std::rethrow_exception(error);
+    }
+    for (auto& perThread : threadSamples) {
+        samples.insert(samples.end(), perThread.begin(), perThread.end());
+    }
+    return samples;
+}
+
+void writeLatency(std::ostringstream& out, const LatencySummary& latency) {
+    out << "\"count\":" << latency.count << ",\"meanMs\":" << latency.meanMs << ",\"p50Ms\":" << latency.p50Ms
+        << ",\"p95Ms\":" << latency.p95Ms << ",\"p99Ms\":" << latency.p99Ms << ",\"maxMs\":" << latency.maxMs;
+}
+
+void writeSource(std::ostringstream& out, const SourceReport& source) {
+    out << "{\"processed\":" << (source.isProcessed ? "true" : "false") << ",\"processMs\":" << source.processMs
+        << ",\"phases\":{";
+    for (std::size_t i = 0; i < source.phases.size(); i++) {
+        if (i > 0) out << ",";
+        writeString(out, source.phases[i].first);
+        out << ":" << source.phases[i].second;
+    }
+    out << "},\"peakRssKb\":" << source.peakRssKb << ",\"pkbKb\":" << source.memory.getTotal() / 1024.0
+        << ",\"memoryBytes\":{";
+    auto& components = source.memory.getComponents();
+    for (std::size_t i = 0; i < components.size(); i++) {
+        if (i > 0) out << ",";
+        writeString(out, components[i].first);
+        out << ":" << components[i].second;
+    }
+    out << "},\"queries\":{";
+    std::set<std::string> ids;
+    for (std::size_t i = 0; i < source.queries.size(); i++) {
+        auto& query = source.queries[i];
+        // repeated ids are told apart by their position in the file
+        std::string id = query.query.id;
+        if (!ids.insert(id).second) id += "#" + std::to_string(i + 1);
+        if (i > 0) out << ",";
+        writeString(out, id);
+        out << ":{\"comment\":";
+        writeString(out, query.query.comment);
+        out << ",\"query\":";
+        writeString(out, query.query.query);
+        out << ",\"results\":" << query.resultCount << ",\"peakKb\":" << query.peakKb << ",";
+        writeLatency(out, query.latency);
+        out << "}";
+    }
+    out << "}}";
+}
+}  // namespace
+
+std::vector<QueryCase> readQueries(std::istream& in) {
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(in, line)) {
+        lines.push_back(trim(line));
+    }
+    while (!lines.empty() && lines.back().empty()) lines.pop_back();
+
+    std::vector<QueryCase> queries;
+    for (std::size_t i = 0; i + 2 < lines.size(); i += 5) {
+        QueryCase query;
+        auto separator = lines[i].find(" - ");
+        query.id = trim(lines[i].substr(0, separator));
+        if (separator != std::string::npos) query.comment = trim(lines[i].substr(separator + 3));
+        query.query = lines[i + 1] + " " + lines[i + 2];
+        queries.push_back(query);
+    }
+    return queries;
+}
+
+LatencySummary summarize(std::vector<double> samplesMs) {
+    LatencySummary summary;
+    if (samplesMs.empty()) return summary;
+    std::sort(samplesMs.begin(), samplesMs.end());
+    auto percentile = [&samplesMs](double p) {
+        auto rank = static_cast<std::size_t>(std::ceil(p / 100 * samplesMs.size()));
+        return samplesMs[std::clamp<std::size_t>(rank, 1, samplesMs.size()) - 1];
+    };
+    summary.count = samplesMs.size();
+    summary.meanMs = std::accumulate(samplesMs.begin(), samplesMs.end(), 0.0) / samplesMs.size();
+    summary.p50Ms = percentile(50);
+    summary.p95Ms = percentile(95);
+    summary.p99Ms = percentile(99);
+    summary.maxMs = samplesMs.back();
+    return summary;
+}
+
+SourceReport runSource(const std::string& name, const std::string& source, const std::vector<QueryCase>& queries,
+                       const RunnerConfig& config) {
+    SourceReport report;
+    report.name = name;
+    PKB pkb;
+    sp::PhaseProfile profile;
+    auto start = Clock::now();
+    report.isProcessed = SourceProcessor().processSimple(source, &pkb, &profile);
+    report.processMs = toMs(Clock::now() - start);
+    report.phases = profile.getPhases();
+    if (!report.isProcessed) {
+        report.peakRssKb = getPeakRssKb();
+        return report;
+    }
+
+    report.memory = pkb.getMemoryReport();
+
+    std::vector<std::vector<double>> latencies(queries.size());
+    std::vector<std::size_t> resultCounts(queries.size());
+    std::vector<std::size_t> peakBytes(queries.size());
+    for (int repetition = 0; repetition < config.warmup + config.repetitions; repetition++) {
+        for (auto& sample : replay(queries, config.threads, &pkb)) {
+            resultCounts[sample.query] = sample.resultCount;
+            peakBytes[sample.query] = std::max(peakBytes[sample.query], sample.peakBytes);
+            if (repetition >= config.warmup) latencies[sample.query].push_back(sample.ms);
+        }
+    }
+    for (std::size_t i = 0; i < queries.size(); i++) {
+        report.queries.push_back(QueryReport{queries[i], resultCounts[i], summarize(std::move(latencies[i])),
+                                             peakBytes[i] / 1024.0});
+    }
+    report.peakRssKb = getPeakRssKb();
+    return report;
+}
+
+long getPeakRssKb() {
+#if defined(__unix__) || defined(__APPLE__)
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;  // in bytes rather than kilobytes on macOS
+#else
+    return usage.ru_maxrss;
+#endif
+#else
+    return 0;
+#endif
+}
+
+std::string BenchmarkReport::toJson() const {
+    std::ostringstream out;
+    out << "{\"config\":{\"repetitions\":" << config.repetitions << ",\"warmup\":" << config.warmup
+        << ",\"threads\":" << config.threads << "},\"peakRssKb\":" << peakRssKb << ",\"sources\":{";
+    for (std::size_t i = 0; i < sources.size(); i++) {
+        if (i > 0) out << ",";
+        writeString(out, sources[i].name);
+        out << ":";
+        writeSource(out, sources[i]);
+    }
+    out << "}}";
+    return out.str();
+}
+}  // namespace runner
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <istream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "MemoryUsage.h"
+
+namespace runner {
+/**
+ * How the queries of a source are replayed. Every repetition evaluates every query once, and the warmup
+ * repetitions are run the same way but left out of the latencies.
+ */
+struct RunnerConfig {
+    int repetitions = 10;
+    int warmup = 1;
+    int threads = 1;  // the number of queries evaluated concurrently
+};
+
+/**
+ * A query read from an autotester query file.
+ */
+struct QueryCase {
+    std::string id;
+    std::string comment;
+    std::string query;  // the declarations and the select clause, as given to the QPS
+};
+
+/**
+ * Reads the queries of an autotester query file, where every query takes five lines: its id and comment, its
+ * declarations, its select clause, its expected answer and its time limit.
+ *
+ * @param in the query file
+ * @return the queries, in the order of the file
+ */
+std::vector<QueryCase> readQueries(std::istream& in);
+
+/**
+ * The distribution of the latencies of a query, in milliseconds. The percentiles are nearest rank percentiles.
+ */
+struct LatencySummary {
+    std::size_t count = 0;
+    double meanMs = 0;
+    double p50Ms = 0;
+    double p95Ms = 0;
+    double p99Ms = 0;
+    double maxMs = 0;
+};
+
+/**
+ * @param samplesMs the latencies of every evaluation of a query, in milliseconds
+ * @return the summary of the latencies, all zero if there are none
+ */
+LatencySummary summarize(std::vector<double> samplesMs);
+
+struct QueryReport {
+    QueryCase query;
+    std::size_t resultCount = 0;
+    LatencySummary latency;
+    double peakKb = 0;  // the most memory the intermediate results held at once, over every evaluation
+};
+
+struct SourceReport {
+    std::string name;
+    bool isProcessed = false;
+    double processMs = 0;  // the wall clock time of processing the source
+    std::vector<std::pair<std::string, double>> phases;  // the time of every phase of processing, see PhaseProfile
+    long peakRssKb = 0;  // the peak resident set size of the whole run once the source is done
+    memory::Report memory;  // the bytes held by the processed source, see PKB::getMemoryReport
+    std::vector<QueryReport> queries;
+};
+
+struct BenchmarkReport {
+    RunnerConfig config;
+    std::vector<SourceReport> sources;
+    long peakRssKb = 0;
+
+    /**
+     * Writes the report as JSON. Sources are keyed by name and queries by id, so that the metrics of two reports
+     * can be matched by their path, e.g. sources/Sample/queries/3/p95Ms.
+     */
+    std::string toJson() const;
+};
+
+/**
+ * Processes the source once, then replays its queries for the configured number of repetitions.
+ *
+ * With a single thread, every query is evaluated exactly as the autotester evaluates it. With more threads, the
+ * queries of a repetition are shared among the threads and evaluated concurrently against the same PKB, which
+ * shares its Affects cache within the repetition the same way a batch of queries does, and is cleared in between
+ * repetitions.
+ *
+ * @param name the name of the source in the report
+ * @param source the SIMPLE source
+ * @param queries the queries to replay
+ * @param config how the queries are replayed
+ * @return the report of the source, without any query if the source could not be processed
+ */
+SourceReport runSource(const std::string& name, const std::string& source, const std::vector<QueryCase>& queries,
+                       const RunnerConfig& config);
+
+/**
+ * @return the peak resident set size of the process so far, in kilobytes, or 0 where it cannot be measured.
+ */
+long getPeakRssKb();
+}  // namespace runner
@@ -0,0 +1,150 @@
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Baseline.h"
+#include "SystemBenchmark.h"
+
+/*
+ * Usage: runner [--repetitions=10] [--warmup=1] [--threads=1] [--output=report.json]
+ *               [--baseline=baseline.json] [--threshold=0.2] [--min-delta-ms=0.5] prefix...
+ *
+ * Processes <prefix>_source.txt once for every prefix and replays the queries of <prefix>_queries.txt, both in the
+ * format of the autotester. Prints the processing time of every phase and the latencies of every query, and writes
+ * them as JSON to the output file. With a baseline report, exits with 1 if any latency percentile, processing time
+ * or peak resident set size got slower or larger than the baseline by more than the threshold.
+ */
+
+namespace {
+struct Options {
+    runner::RunnerConfig runner;
+    runner::ComparisonConfig comparison;
+    std::string output;
+    std::string baseline;
+    std::vector<std::string> prefixes;
+};
+
+template <typename T>
+bool read(const std::string& value, T& field) {
+    std::istringstream in(value);
+    return static_cast<bool>(in >> field) && in.eof();
+}
+
+bool parseArgument(const std::string& arg, Options& options) {
+    if (arg.rfind("--", 0) != 0) {
+        options.prefixes.push_back(arg);
+        return true;
+    }
+    auto separator = arg.find('=');
+    if (separator == std::string::npos) return false;
+    std::string name = arg.substr(2, separator - 2);
+    std::string value = arg.substr(separator + 1);
+    if (name == "repetitions") return read(value, options.runner.repetitions) && options.runner.repetitions > 0;
+    if (name == "warmup") return read(value, options.runner.warmup) && options.runner.warmup >= 0;
+    if (name == "threads") return read(value, options.runner.threads) && options.runner.threads > 0;
+    if (name == "threshold") return read(value, options.comparison.threshold);
+    if (name == "min-delta-ms") return read(value, options.comparison.minDeltaMs);
+    if (name == "output") {
+        options.output = value;
+        return !value.empty();
+    }
+    if (name == "baseline") {
+        options.baseline = value;
+        return !value.empty();
+    }
+    return false;
+}
+
+std::string readFile(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) throw std::runtime_error("Cannot open " + path);
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    return buffer.str();
+}
+
+std::string getName(const std::string& prefix) {
+    auto separator = prefix.find_last_of("/\\");
+    return separator == std::string::npos ? prefix : prefix.substr(separator + 1);
+}
+
+void print(const runner::SourceReport& source) {
+    std::cout << source.name << ": processed in " << source.processMs << " ms";
+    if (!source.isProcessed) std::cout << " (invalid source)";
+    std::cout << "\n";
+    for (auto& [phase, ms] : source.phases) {
+        std::cout << "  " << std::left << std::setw(24) << phase << std::right << std::setw(12) << ms << " ms\n";
+    }
+    if (!source.isProcessed) return;
+    std::cout << "  " << std::left << std::setw(24) << "memory" << std::right << std::setw(12)
+              << source.memory.getTotal() / 1024.0 << " kB\n";
+    for (auto& [component, bytes] : source.memory.getComponents()) {
+        std::cout << "    " << std::left << std::setw(22) << component << std::right << std::setw(12)
+                  << bytes / 1024.0 << " kB\n";
+    }
+    if (source.queries.empty()) return;
+    std::cout << "  " << std::left << std::setw(10) << "query" << std::right << std::setw(10) << "results"
+              << std::setw(12) << "p50 ms" << std::setw(12) << "p95 ms" << std::setw(12) << "p99 ms"
+              << std::setw(12) << "max ms" << std::setw(12) << "peak kB" << "\n";
+    for (auto& query : source.queries) {
+        std::cout << "  " << std::left << std::setw(10) << query.query.id << std::right << std::setw(10)
+                  << query.resultCount << std::setw(12) << query.latency.p50Ms << std::setw(12)
+                  << query.latency.p95Ms << std::setw(12) << query.latency.p99Ms << std::setw(12)
+                  << query.latency.maxMs << std::setw(12) << query.peakKb << "\n";
+    }
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        if (!parseArgument(argv[i], options)) {
+            std::cerr << "Unrecognised argument " << argv[i] << std::endl;
+            return 1;
+        }
+    }
+    if (options.prefixes.empty()) {
+        std::cerr << "No source and query files to run" << std::endl;
+        return 1;
+    }
+
+    try {
+        runner::BenchmarkReport report;
+        report.config = options.runner;
+        for (auto& prefix : options.prefixes) {
+            std::string source = readFile(prefix + "_source.txt");
+            std::istringstream queryFile(readFile(prefix + "_queries.txt"));
+            report.sources.push_back(
+                runner::runSource(getName(prefix), source, runner::readQueries(queryFile), options.runner));
+            print(report.sources.back());
+        }
+        report.peakRssKb = runner::getPeakRssKb();
+        if (report.peakRssKb > 0) {
+            std::cout << "Peak RSS: " << report.peakRssKb << " kB" << std::endl;
+        } else {
+            std::cout << "Peak RSS: unavailable" << std::endl;
+        }
+
+        std::string json = report.toJson();
+        if (!options.output.empty()) {
+            std::ofstream(options.output) << json << "\n";
+        }
+        if (options.baseline.empty()) return 0;
+
+        auto regressions = runner::compare(runner::readMetrics(readFile(options.baseline)),
+                                           runner::readMetrics(json), options.comparison);
+        for (auto& regression : regressions) {
+            std::cout << "Regression in " << regression.metric << ": " << regression.baseline << " -> "
+                      << regression.current << std::endl;
+        }
+        std::cout << regressions.size() << " regressions against " << options.baseline << std::endl;
+        return regressions.empty() ? 0 : 1;
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,369 @@
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <list>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+// the Unix domain socket transport is only built where there are Unix domain sockets, elsewhere only stdin and
+// stdout are served
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#define SERVER_SOCKET 1
+#else
+#include <io.h>
+#endif
+
+#include "Cancellation.h"
+#include "exceptions.h"
+#include "logging.h"
+#include "QPS/QPS.h"
+#include "QueryServer.h"
+
+namespace server {
+namespace {
+/**
+ * @return the bytes read into the data, 0 at the end of the input or a negative number on an error.
+ */
+long readFd(int fd, char* data, std::size_t size) {
+#ifdef SERVER_SOCKET
+    return static_cast<long>(::read(fd, data, size));
+#else
+    return ::_read(fd, data, static_cast<unsigned int>(size));
+#endif
+}
+
+/**
+ * @return the bytes written from the data, or a negative number on an error.
+ */
+long writeFd(int fd, const char* data, std::size_t size) {
+#ifdef SERVER_SOCKET
+    return static_cast<long>(::write(fd, data, size));
+#else
+    return ::_write(fd, data, static_cast<unsigned int>(size));
+#endif
+}
+}  // namespace
+
+/**
+ * The side of a client that the answers are written to, which is kept until every request it sent is answered.
+ */
+struct QueryServer::Connection {
+    int outFd;
+    std::mutex writeMutex;
+    std::mutex pendingMutex;
+    std::condition_variable idle;
+    std::size_t pending = 0;  // the requests that are not answered yet
+
+    void write(const std::string& line) {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        std::size_t written = 0;
+        while (written < line.size()) {
+            long n = writeFd(outFd, line.data() + written, line.size() - written);
+            if (n < 0 && errno == EINTR) continue;
+            // a client that went away does not get the rest of its answers.
+            if (n <= 0) return;
+            written += static_cast<std::size_t>(n);
+        }
+    }
+};
+
+/**
+ * A request that is answered exactly once, by whichever of its worker and the watchdog gets to it first.
+ */
+struct QueryServer::Request {
+    std::string id;
+    std::shared_ptr<Connection> connection;
+    std::atomic<bool> isAnswered = false;
+    CancellationToken token;
+
+    void answer(const std::string& response) {
+        if (isAnswered.exchange(true)) return;
+        connection->write(id + " " + response + "\n");
+        std::lock_guard<std::mutex> lock(connection->pendingMutex);
+        if (--connection->pending == 0) {
+            connection->idle.notify_all();
+        }
+    }
+};
+
+namespace {
+template <typename Container>
+std::string ok(const Container& values) {
+    std::string response = "ok " + std::to_string(values.size());
+    char separator = ' ';
+    for (auto& value : values) {
+        response += separator;
+        response += value;
+        separator = ',';
+    }
+    return response;
+}
+
+#ifdef SERVER_SOCKET
+std::runtime_error socketError(const std::string& what) {
+    return std::runtime_error(what + ": " + std::strerror(errno));
+}
+#endif
+}  // namespace
+
+QueryServer::QueryServer(std::string sourcePath, ServerConfig config)
+    : sourcePath(std::move(sourcePath)), config(std::move(config)), workers(this->config.workers) {
+    if (this->config.timeoutMs > 0) {
+        watchdog = std::thread([this]() { expire(); });
+    }
+}
+
+QueryServer::~QueryServer() {
+    {
+        std::lock_guard<std::mutex> lock(deadlineMutex);
+        isStopping = true;
+    }
+    deadlineChanged.notify_all();
+    if (watchdog.joinable()) {
+        watchdog.join();
+    }
+}
+
+bool QueryServer::load(std::vector<std::string>* extracted) {
+    std::ifstream file(sourcePath);
+    if (!file) {
+        LOG(Level::ERROR) << "Cannot open " << sourcePath;
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+
+    std::lock_guard<std::mutex> lock(loadMutex);
+    auto next = std::make_shared<PKB>();
+    // only the first version can be in the snapshot. Processing it that way keeps nothing to compare the next
+    // version against, so the first reload after it extracts every procedure, and the ones after that only what
+    // changed.
+    bool isProcessed = !config.snapshotPath.empty() && !getPkb()
+        ? sourceProcessor.processCached(buffer.str(), next.get(), config.snapshotPath)
+        : sourceProcessor.processIncremental(buffer.str(), next.get());
+    if (!isProcessed) {
+        LOG(Level::ERROR) << "Cannot process " << sourcePath;
+        return false;
+    }
+    if (extracted) {
+        *extracted = sourceProcessor.getExtractedProcedures();
+    }
+    // the queries share the version, so none of them may clear the Affects cache the others are reading. The
+    // version never changes, so the cache stays valid for as long as it is served.
+    next->retainCache();
+    std::lock_guard<std::mutex> pkbLock(pkbMutex);
+    pkb = std::move(next);
+    return true;
+}
+
+std::shared_ptr<PKB> QueryServer::getPkb() {
+    std::lock_guard<std::mutex> lock(pkbMutex);
+    return pkb;
+}
+
+void QueryServer::serve(int inFd, int outFd) {
+    auto connection = std::make_shared<Connection>();
+    connection->outFd = outFd;
+    std::string buffer;
+    char chunk[4096];
+    while (true) {
+        long n = readFd(inFd, chunk, sizeof(chunk));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        buffer.append(chunk, static_cast<std::size_t>(n));
+        std::size_t start = 0;
+        for (std::size_t end; (end = buffer.find('\n', start)) != std::string::npos; start = end + 1) {
+            handle(buffer.substr(start, end - start), connection);
+        }
+        buffer.erase(0, start);
+    }
+    handle(buffer, connection);
+
+    std::unique_lock<std::mutex> lock(connection->pendingMutex);
+    connection->idle.wait(lock, [&connection]() { return connection->pending == 0; });
+}
+
+void QueryServer::handle(const std::string& line, const std::shared_ptr<Connection>& connection) {
+    std::istringstream in(line);
+    std::string id, command;
+    if (!(in >> id)) return;
+    in >> command;
+
+    auto request = std::make_shared<Request>();
+    request->id = id;
+    request->connection = connection;
+    {
+        std::lock_guard<std::mutex> lock(connection->pendingMutex);
+        connection->pending++;
+    }
+
+    if (command == "query") {
+        std::string pql;
+        std::getline(in >> std::ws, pql);
+        if (!pql.empty() && pql.back() == '\r') pql.pop_back();
+        request->token.setMemoryBudget(config.memoryBudgetBytes);
+        if (config.timeoutMs > 0) {
+            auto deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double, std::milli>(config.timeoutMs));
+            request->token.setDeadline(deadline);
+            std::lock_guard<std::mutex> lock(deadlineMutex);
+            if (deadlines.empty() || deadline < deadlines.begin()->first) {
+                deadlineChanged.notify_one();
+            }
+            deadlines.emplace(deadline, request);
+        }
+        workers.submit([this, request, pql]() { query(request, pql); });
+    } else if (command == "reload") {
+        reload(request);
+    } else if (command == "memory") {
+        reportMemory(request);
+    } else {
+        request->answer(command.empty() ? "error Missing command" : "error Unrecognised command " + command);
+    }
+}
+
+void QueryServer::query(const std::shared_ptr<Request>& request, const std::string& pql) {
+    // the watchdog may already have answered it.
+    if (request->isAnswered) return;
+    auto version = getPkb();
+    if (!version) {
+        request->answer("error No source loaded");
+        return;
+    }
+    try {
+        std::list<std::string> results;
+        qps::QPS().evaluate(pql, results, version.get(), &request->token);
+        request->answer(ok(results));
+    } catch (const exceptions::QueryStoppedException& e) {
+        bool isTimeout = e.reason != exceptions::QueryStoppedException::Reason::MEMORY;
+        request->answer(isTimeout ? "timeout" : std::string("error ") + e.what());
+    } catch (const std::exception& e) {
+        request->answer(std::string("error ") + e.what());
+    }
+}
+
+void QueryServer::reload(const std::shared_ptr<Request>& request) {
+    std::vector<std::string> extracted;
+    if (load(&extracted)) {
+        request->answer(ok(extracted));
+    } else {
+        request->answer("error Cannot process " + sourcePath);
+    }
+}
+
+void QueryServer::reportMemory(const std::shared_ptr<Request>& request) {
+    auto version = getPkb();
+    if (!version) {
+        request->answer("error No source loaded");
+        return;
+    }
+    auto report = version->getMemoryReport();
+    std::vector<std::string> components;
+    for (auto& [name, bytes] : report.getComponents()) {
+        components.push_back(name + "=" + std::to_string(bytes));
+    }
+    request->answer(ok(components));
+}
+
+void QueryServer::expire() {
+    std::unique_lock<std::mutex> lock(deadlineMutex);
+    while (!isStopping) {
+        if (deadlines.empty()) {
+            deadlineChanged.wait(lock);
+        } else {
+            deadlineChanged.wait_until(lock, deadlines.begin()->first);
+        }
+        std::vector<std::shared_ptr<Request>> expired;
+        auto now = Clock::now();
+        while (!deadlines.empty() && deadlines.begin()->first <= now) {
+            if (auto request = deadlines.begin()->second.lock()) {
+                expired.push_back(std::move(request));
+            }
+            deadlines.erase(deadlines.begin());
+        }
+        // answering writes to the client, which must not hold up the queries being scheduled. The evaluation
+        // stops by itself at its deadline, but only at its next check, which may be well after it.
+        lock.unlock();
+        for (auto& request : expired) {
+            request->token.cancel();
+            request->answer("timeout");
+        }
+        lock.lock();
+    }
+}
+
+#ifdef SERVER_SOCKET
+void QueryServer::listen(const std::string& socketPath) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error("Socket path is too long: " + socketPath);
+    }
+    std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) throw socketError("Cannot create socket");
+    ::unlink(socketPath.c_str());
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || ::listen(fd, SOMAXCONN) < 0) {
+        auto error = socketError("Cannot listen on " + socketPath);
+        ::close(fd);
+        throw error;
+    }
+    listenFd = fd;
+    LOG(Level::INFO) << "Listening on " << socketPath;
+
+    std::vector<std::thread> connections;
+    while (!isStopRequested) {
+        int client = ::accept(fd, nullptr, nullptr);
+        if (client < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        {
+            std::lock_guard<std::mutex> lock(clientMutex);
+            clientFds.insert(client);
+        }
+        connections.emplace_back([this, client]() {
+            serve(client, client);
+            std::lock_guard<std::mutex> lock(clientMutex);
+            clientFds.erase(client);
+            ::close(client);
+        });
+    }
+    listenFd = -1;
+
+    // the clients still connected are treated as if they had closed their side.
+    {
+        std::lock_guard<std::mutex> lock(clientMutex);
+        for (int client : clientFds) {
+            ::shutdown(client, SHUT_RD);
+        }
+    }
+    for (auto& connection : connections) {
+        connection.join();
+    }
+    ::close(fd);
+    ::unlink(socketPath.c_str());
+}
+
+void QueryServer::stop() {
+    isStopRequested = true;
+    int fd = listenFd;
+    if (fd >= 0) {
+        ::shutdown(fd, SHUT_RDWR);
+    }
+}
+#else
+void QueryServer::listen(const std::string& socketPath) {
+    throw std::runtime_error("Cannot listen on " + socketPath + ": Unix domain sockets are not supported");
+}
+
+void QueryServer::stop() {
+    isStopRequested = true;
+}
+#endif
+}  // namespace server
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "PKB.h"
+#include "SourceProcessor.h"
+#include "ThreadPool.h"
+
+namespace server {
+/**
+ * How the server evaluates the queries it is sent.
+ */
+struct ServerConfig {
+    std::size_t workers = ThreadPool::defaultThreadCount();  // the number of queries evaluated concurrently
+    double timeoutMs = 0;  // how long a query may take before it is answered with a timeout, or 0 for no limit
+    std::size_t memoryBudgetBytes = 0;  // the memory the intermediate results of a query may hold, or 0 for no limit
+    // if given, the source is first loaded from and saved to this snapshot. The first reload then extracts every
+    // procedure, as the first version was not kept to compare against.
+    std::string snapshotPath;
+};
+
+/**
+ * @brief Processes a SIMPLE source once and answers PQL queries against it until it is stopped, over a line based
+ * protocol on stdin and stdout or on the connections of a Unix domain socket.
+ *
+ * Every request is a line made of an id chosen by the client, a command and its arguments, and is answered by a
+ * single line starting with the same id:
+ *
+ *   <id> query <pql>   ->  <id> ok <number of results> <results separated by ,>
+ *   <id> reload        ->  <id> ok <number of procedures> <procedures extracted again, separated by ,>
+ *   <id> memory        ->  <id> ok <number of components> <component=bytes held by the source, separated by ,>
+ *   anything else      ->  <id> error <message>
+ *
+ * A query that takes longer than the timeout is answered with `<id> timeout` instead and stopped, and a query whose
+ * intermediate results outgrow the memory budget is stopped and answered with an error. Requests may be pipelined:
+ * the queries of a connection are evaluated concurrently on the workers and answered as they finish, so the
+ * answers can come in any order. A reload is run before anything after it on the same connection is read, so the
+ * queries sent after it are evaluated on the new version of the source, while the ones in flight finish on the
+ * version they started on. Only the procedures that changed since the previous version are extracted again.
+ * The memory of the current version is reported per table of its PKB, its AST and its CFG, as described in
+ * PKB::getMemoryReport.
+ *
+ * Example Usage:
+ * server::QueryServer server("source.txt", server::ServerConfig());
+ * if (server.load()) server.serve(STDIN_FILENO, STDOUT_FILENO);
+ */
+class QueryServer {
+public:
+    QueryServer(std::string sourcePath, ServerConfig config);
+    ~QueryServer();
+    QueryServer(const QueryServer&) = delete;
+    QueryServer& operator=(const QueryServer&) = delete;
+
+    /**
+     * Reads and processes the source, and evaluates the queries received after it on the new version.
+     *
+     * @param extracted if given, set to the procedures that were extracted again
+     * @return false if the source cannot be read or is not a valid SIMPLE program, in which case the previous
+     * version is kept.
+     */
+    bool load(std::vector<std::string>* extracted = nullptr);
+
+    /**
+     * Answers the requests read from inFd on outFd until inFd is closed, and returns once all of them have been
+     * answered. Neither file descriptor is closed.
+     */
+    void serve(int inFd, int outFd);
+
+    /**
+     * Accepts connections on a Unix domain socket at the path, replacing any file there, and serves each of them
+     * on a thread of its own until stop is called. The socket file is removed when it returns.
+     *
+     * @throws std::runtime_error if the socket cannot be created, or the platform has no Unix domain sockets
+     */
+    void listen(const std::string& socketPath);
+
+    /**
+     * Makes listen stop accepting connections, and return once the connections it accepted are served.
+     * Safe to call from a signal handler.
+     */
+    void stop();
+
+private:
+    using Clock = std::chrono::steady_clock;
+    struct Connection;
+    struct Request;
+
+    std::string sourcePath;
+    ServerConfig config;
+
+    std::mutex loadMutex;  // held while a version of the source is processed
+    SourceProcessor sourceProcessor;
+    std::mutex pkbMutex;
+    std::shared_ptr<PKB> pkb;
+
+    // the queries with a deadline, in the order they expire. Answered queries are only dropped once they expire.
+    std::mutex deadlineMutex;
+    std::condition_variable deadlineChanged;
+    std::multimap<Clock::time_point, std::weak_ptr<Request>> deadlines;
+    bool isStopping = false;
+    std::thread watchdog;
+
+    std::atomic<bool> isStopRequested = false;
+    std::atomic<int> listenFd = -1;
+    std::mutex clientMutex;
+    std::set<int> clientFds;
+
+    ThreadPool workers;  // last, so that the queries in flight finish before anything else goes away
+
+    std::shared_ptr<PKB> getPkb();
+    void handle(const std::string& line, const std::shared_ptr<Connection>& connection);
+    void query(const std::shared_ptr<Request>& request, const std::string& pql);
+    void reload(const std::shared_ptr<Request>& request);
+    void reportMemory(const std::shared_ptr<Request>& request);
+    void expire();
+};
+}  // namespace server
@@ -0,0 +1,130 @@
+#include <csignal>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#else
+#define STDIN_FILENO 0
+#define STDOUT_FILENO 1
+#endif
+
+#include "logging.h"
+#include "QueryServer.h"
+
+/*
+ * Usage: server [--workers=<hardware threads>] [--timeout-ms=0] [--memory-budget-mb=0] [--snapshot=source.pkb]
+ *               [--socket=spa.sock] source.txt
+ *
+ * Processes the SIMPLE source once and answers PQL queries against it, as described in QueryServer.h, until the
+ * requests end on stdin, or, with a socket, until it is interrupted. A timeout of 0 lets every query run to
+ * completion, and a memory budget of 0 lets their intermediate results grow without limit. With a snapshot, the
+ * first version of the source is loaded from the snapshot when it matches.
+ */
+
+namespace {
+struct Options {
+    server::ServerConfig server;
+    std::string socketPath;
+    std::string sourcePath;
+};
+
+server::QueryServer* running = nullptr;
+
+/**
+ * Writes every log line to stderr, so that stdout only carries the answers.
+ */
+class StderrSink : public logging::Sink {
+public:
+    void write(Level, std::string line) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::cerr << line << std::endl;
+    }
+
+private:
+    std::mutex mutex;
+};
+
+template <typename T>
+bool read(const std::string& value, T& field) {
+    std::istringstream in(value);
+    return static_cast<bool>(in >> field) && in.eof();
+}
+
+bool parseArgument(const std::string& arg, Options& options) {
+    if (arg.rfind("--", 0) != 0) {
+        if (!options.sourcePath.empty()) return false;
+        options.sourcePath = arg;
+        return true;
+    }
+    auto separator = arg.find('=');
+    if (separator == std::string::npos) return false;
+    std::string name = arg.substr(2, separator - 2);
+    std::string value = arg.substr(separator + 1);
+    if (name == "workers") return read(value, options.server.workers) && options.server.workers > 0;
+    if (name == "timeout-ms") return read(value, options.server.timeoutMs) && options.server.timeoutMs >= 0;
+    if (name == "memory-budget-mb") {
+        double megabytes;
+        if (!read(value, megabytes) || megabytes < 0) return false;
+        options.server.memoryBudgetBytes = static_cast<std::size_t>(megabytes * 1024 * 1024);
+        return true;
+    }
+    if (name == "snapshot") {
+        options.server.snapshotPath = value;
+        return !value.empty();
+    }
+    if (name == "socket") {
+        options.socketPath = value;
+        return !value.empty();
+    }
+    return false;
+}
+
+void stop(int) {
+    if (running) running->stop();
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        if (!parseArgument(argv[i], options)) {
+            std::cerr << "Unrecognised argument " << argv[i] << std::endl;
+            return 1;
+        }
+    }
+    if (options.sourcePath.empty()) {
+        std::cerr << "No source to serve" << std::endl;
+        return 1;
+    }
+#ifdef SIGPIPE
+    // a client that goes away should only lose its own answers.
+    std::signal(SIGPIPE, SIG_IGN);
+#endif
+    logging::setSink(std::make_shared<StderrSink>());
+
+    try {
+        server::QueryServer server(options.sourcePath, options.server);
+        if (!server.load()) {
+            std::cerr << "Failed to process " << options.sourcePath << std::endl;
+            return 1;
+        }
+        if (options.socketPath.empty()) {
+            server.serve(STDIN_FILENO, STDOUT_FILENO);
+            return 0;
+        }
+        running = &server;
+        std::signal(SIGINT, stop);
+        std::signal(SIGTERM, stop);
+        server.listen(options.socketPath);
+        running = nullptr;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,158 @@
+/*
+ * Small dynamically sized bitset used for dense sets of small integer ids, e.g. interned variables
+ * or the statements of a procedure.
+ *
+ * Example Usage:
+ * Bitset vars(varCount);
+ * vars.set(3);
+ * vars.forEach([](std::size_t id) { ... });
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+class Bitset {
+public:
+    Bitset() = default;
+    explicit Bitset(std::size_t size) : bits(size), words((size + WORD_BITS - 1) / WORD_BITS, 0) {}
+
+    /**
+     * @brief Rebuilds a bitset of the given size from its words, e.g. the words of a bitset read back from a file.
+     */
+    Bitset(std::size_t size, std::vector<std::uint64_t> words) : bits(size), words(std::move(words)) {
+        this->words.resize((size + WORD_BITS - 1) / WORD_BITS, 0);
+    }
+
+    std::size_t size() const { return bits; }
+    const std::vector<std::uint64_t>& getWords() const { return words; }
+
+    void set(std::size_t i) { words[i / WORD_BITS] |= bit(i); }
+    void reset(std::size_t i) { words[i / WORD_BITS] &= ~bit(i); }
+    bool test(std::size_t i) const { return i < bits && (words[i / WORD_BITS] & bit(i)) != 0; }
+
+    /**
+     * @brief Sets every bit in [begin, end).
+     */
+    void setRange(std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            set(i);
+        }
+    }
+
+    void clear() {
+        for (auto& word : words) {
+            word = 0;
+        }
+    }
+
+    bool any() const {
+        for (auto word : words) {
+            if (word != 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool none() const { return !any(); }
+
+    std::size_t count() const {
+        std::size_t total = 0;
+        for (auto word : words) {
+            total += popcount(word);
+        }
+        return total;
+    }
+
+    /**
+     * @return whether this and the other bitset have a bit in common.
+     */
+    bool intersects(const Bitset& other) const {
+        std::size_t n = std::min(words.size(), other.words.size());
+        for (std::size_t i = 0; i < n; i++) {
+            if ((words[i] & other.words[i]) != 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    Bitset& operator|=(const Bitset& other) {
+        std::size_t n = std::min(words.size(), other.words.size());
+        for (std::size_t i = 0; i < n; i++) {
+            words[i] |= other.words[i];
+        }
+        return *this;
+    }
+
+    Bitset& operator&=(const Bitset& other) {
+        for (std::size_t i = 0; i < words.size(); i++) {
+            words[i] &= i < other.words.size() ? other.words[i] : 0;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Clears every bit that is set in the other bitset.
+     */
+    Bitset& subtract(const Bitset& other) {
+        std::size_t n = std::min(words.size(), other.words.size());
+        for (std::size_t i = 0; i < n; i++) {
+            words[i] &= ~other.words[i];
+        }
+        return *this;
+    }
+
+    bool operator==(const Bitset& other) const { return bits == other.bits && words == other.words; }
+    bool operator!=(const Bitset& other) const { return !(*this == other); }
+
+    /**
+     * @brief Calls f with the index of every set bit, in increasing order.
+     */
+    template <typename F>
+    void forEach(F&& f) const {
+        for (std::size_t w = 0; w < words.size(); w++) {
+            std::uint64_t word = words[w];
+            while (word != 0) {
+                f(w * WORD_BITS + lowestBit(word));
+                word &= word - 1;
+            }
+        }
+    }
+
+private:
+    static constexpr std::size_t WORD_BITS = 64;
+
+    std::size_t bits = 0;
+    std::vector<std::uint64_t> words;
+
+    static std::uint64_t bit(std::size_t i) { return std::uint64_t{1} << (i % WORD_BITS); }
+
+    static std::size_t popcount(std::uint64_t word) {
+#ifdef _MSC_VER
+        return static_cast<std::size_t>(__popcnt64(word));
+#else
+        return static_cast<std::size_t>(__builtin_popcountll(word));
+#endif
+    }
+
+    // the index of the lowest set bit of a word that is not 0.
+    static std::size_t lowestBit(std::uint64_t word) {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward64(&index, word);
+        return index;
+#else
+        return static_cast<std::size_t>(__builtin_ctzll(word));
+#endif
+    }
+};
@@ -0,0 +1,118 @@
+/*
+ * Cooperative cancellation of the evaluation of a query. The evaluator, the joins of its intermediate results and
+ * the long walks of the PKB check the token of the query as they go, and stop by throwing once it is cancelled,
+ * past its deadline or holding more intermediate results than its memory budget allows. The token also keeps the
+ * peak of the memory that the intermediate results held at once, budget or not.
+ *
+ * Example Usage:
+ * CancellationToken token;
+ * token.setTimeout(std::chrono::milliseconds(500));
+ * qps.evaluate(query, results, &pkb, &token);  // throws exceptions::QueryStoppedException after 500 ms
+ * token.getPeakMemory();
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <optional>
+
+#include "exceptions.h"
+
+class CancellationToken {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Reason = exceptions::QueryStoppedException::Reason;
+
+    /**
+     * Stops the evaluation at its next check. Safe to call from any thread while the query is evaluated.
+     */
+    void cancel() { isCancelled.store(true, std::memory_order_relaxed); }
+
+    /**
+     * Stops the evaluation at its next check once the flag is set, e.g. AbstractWrapper::GlobalStop.
+     */
+    void watch(const volatile bool* flag) { stopFlag = flag; }
+
+    void setDeadline(Clock::time_point time) { deadline = time; }
+    void setTimeout(Clock::duration timeout) { deadline = Clock::now() + timeout; }
+
+    /**
+     * @param bytes the most memory the intermediate results of the query may hold, or 0 for no limit
+     */
+    void setMemoryBudget(std::size_t bytes) { memoryBudget = bytes; }
+    std::size_t getMemoryBudget() const { return memoryBudget; }
+
+    bool isStopRequested() const {
+        return isCancelled.load(std::memory_order_relaxed) || (stopFlag && *stopFlag) ||
+            (deadline && Clock::now() >= *deadline);
+    }
+
+    /**
+     * @throws exceptions::QueryStoppedException if the query was cancelled or is past its deadline
+     */
+    void check() const {
+        if (isCancelled.load(std::memory_order_relaxed) || (stopFlag && *stopFlag)) {
+            throw exceptions::QueryStoppedException(Reason::CANCELLED);
+        }
+        if (deadline && Clock::now() >= *deadline) {
+            throw exceptions::QueryStoppedException(Reason::DEADLINE);
+        }
+    }
+
+    /**
+     * Accounts for an intermediate result that is being built, on top of the ones that are retained, in the peak
+     * of the query and against its memory budget.
+     *
+     * @param bytes the memory held by the intermediate result
+     * @throws exceptions::QueryStoppedException if the memory held is more than the memory budget
+     */
+    void checkMemory(std::size_t bytes) const {
+        std::size_t held = retainedBytes.load(std::memory_order_relaxed) + bytes;
+        std::size_t peak = peakBytes.load(std::memory_order_relaxed);
+        while (held > peak && !peakBytes.compare_exchange_weak(peak, held, std::memory_order_relaxed)) {}
+        if (memoryBudget != 0 && held > memoryBudget) {
+            throw exceptions::QueryStoppedException(Reason::MEMORY);
+        }
+    }
+
+    /**
+     * Counts an intermediate result that the evaluation keeps while it builds the next ones, until it is released.
+     * The evaluation only sees the token as const, so the accounting is kept in mutable counters.
+     *
+     * @throws exceptions::QueryStoppedException if the memory held is more than the memory budget, in which case
+     * the result is still counted until it is released
+     */
+    void retain(std::size_t bytes) const {
+        retainedBytes.fetch_add(bytes, std::memory_order_relaxed);
+        checkMemory(0);
+    }
+
+    void release(std::size_t bytes) const { retainedBytes.fetch_sub(bytes, std::memory_order_relaxed); }
+
+    /**
+     * @return the most memory that the intermediate results of the query held at once, as estimated by
+     * ResultTable::estimateBytes
+     */
+    std::size_t getPeakMemory() const { return peakBytes.load(std::memory_order_relaxed); }
+
+    /**
+     * Checks the token if there is one, so that evaluating without a token does not have to check anything.
+     */
+    static void check(const CancellationToken* token) {
+        if (token) token->check();
+    }
+
+    static void checkMemory(const CancellationToken* token, std::size_t bytes) {
+        if (token) token->checkMemory(bytes);
+    }
+
+private:
+    std::atomic<bool> isCancelled = false;
+    const volatile bool* stopFlag = nullptr;
+    std::optional<Clock::time_point> deadline;
+    std::size_t memoryBudget = 0;
+    mutable std::atomic<std::size_t> retainedBytes = 0;
+    mutable std::atomic<std::size_t> peakBytes = 0;
+};
@@ -0,0 +1,528 @@
+#include <algorithm>
+#include <functional>
+#include <set>
+#include <unordered_set>
+
+#include "BlockCFG.h"
+#include "PKB/PKBSnapshot.h"
+#include "ThreadPool.h"
+
+namespace sp {
+namespace cfg {
+
+namespace {
+/**
+ * @brief Follows a chain of dummy nodes down to the first real statement, as a dummy node has at most one child.
+ *
+ * @return the first real node, or a nullptr if the chain ends without one.
+ */
+const CFGNode* skipDummies(const CFGNode* node) {
+    while (node != nullptr && !node->stmt.has_value()) {
+        auto children = node->getChildren();
+        node = children.empty() ? nullptr : children.front().lock().get();
+    }
+    return node;
+}
+
+/**
+ * @brief Calls f with every real node of a procedure's CFGNode graph, its real successors, and whether control can
+ * leave the procedure right after it.
+ */
+template <typename F>
+void forEachStatement(const CFGNode* root, F&& f) {
+    std::unordered_set<const CFGNode*> visited;
+    std::vector<const CFGNode*> stack;
+    if (auto entry = skipDummies(root)) {
+        stack.push_back(entry);
+        visited.insert(entry);
+    }
+    while (!stack.empty()) {
+        auto node = stack.back();
+        stack.pop_back();
+        std::vector<const CFGNode*> successors;
+        auto children = node->getChildren();
+        // a while node only gets a second child if a statement follows it.
+        bool exits = children.size() < (node->stmt->type == StatementType::While ? 2 : 1);
+        for (auto& child : children) {
+            if (auto successor = skipDummies(child.lock().get())) {
+                successors.push_back(successor);
+                if (visited.insert(successor).second) {
+                    stack.push_back(successor);
+                }
+            } else {
+                exits = true;
+            }
+        }
+        f(node, successors, exits);
+    }
+}
+
+/**
+ * @brief Turns per element adjacency lists into an offset array and a value array.
+ */
+void flatten(const std::vector<std::vector<int>>& lists, std::vector<int>* offsets, std::vector<int>* values) {
+    offsets->assign(1, 0);
+    for (auto& list : lists) {
+        values->insert(values->end(), list.begin(), list.end());
+        offsets->push_back(static_cast<int>(values->size()));
+    }
+}
+}  // namespace
+
+VarId VarIndex::intern(const std::string& name) {
+    auto [it, inserted] = ids.try_emplace(name, names.size());
+    if (inserted) {
+        names.push_back(name);
+    }
+    return it->second;
+}
+
+std::optional<VarId> VarIndex::find(const std::string& name) const {
+    auto it = ids.find(name);
+    if (it == ids.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+BlockCFG BlockCFG::build(const std::string& name, const CFGNode* root, const VarIndex& vars,
+    const std::unordered_map<std::string, int>& procIndex) {
+    BlockCFG cfg;
+    cfg.name = name;
+
+    std::vector<std::pair<const CFGNode*, std::vector<const CFGNode*>>> nodes;
+    std::vector<const CFGNode*> exitNodes;
+    forEachStatement(root, [&](const CFGNode* node, std::vector<const CFGNode*>& successors, bool exits) {
+        nodes.emplace_back(node, std::move(successors));
+        if (exits) {
+            exitNodes.push_back(node);
+        }
+    });
+    if (nodes.empty()) {
+        cfg.blockOffsets.assign(1, 0);
+        cfg.succOffsets.assign(1, 0);
+        cfg.predOffsets.assign(1, 0);
+        return cfg;
+    }
+
+    int first = nodes.front().first->stmt->statementNum;
+    int last = first;
+    for (auto& [node, _] : nodes) {
+        first = std::min(first, node->stmt->statementNum);
+        last = std::max(last, node->stmt->statementNum);
+    }
+    cfg.firstStmtNo = first;
+    std::size_t count = last - first + 1;
+
+    // statement level edges, by local index.
+    std::vector<std::vector<int>> next(count), prev(count);
+    cfg.stmts.assign(count, STMT_LO(0));
+    cfg.modifies.assign(count, Bitset(vars.size()));
+    cfg.uses.assign(count, Bitset(vars.size()));
+    cfg.callees.assign(count, -1);
+    std::vector<bool> present(count, false);
+    for (auto& [node, successors] : nodes) {
+        int local = node->stmt->statementNum - first;
+        present[local] = true;
+        cfg.stmts[local] = node->stmt.value();
+        if (node->callee.has_value()) {
+            if (auto callee = procIndex.find(node->callee.value()); callee != procIndex.end()) {
+                cfg.callees[local] = callee->second;
+            }
+        }
+        for (auto& var : node->modifies) {
+            cfg.modifies[local].set(vars.find(var.name).value());
+        }
+        for (auto& var : node->uses) {
+            cfg.uses[local].set(vars.find(var.name).value());
+        }
+        for (auto successor : successors) {
+            next[local].push_back(successor->stmt->statementNum - first);
+        }
+        std::sort(next[local].begin(), next[local].end());
+        next[local].erase(std::unique(next[local].begin(), next[local].end()), next[local].end());
+    }
+    for (std::size_t s = 0; s < count; s++) {
+        for (int n : next[s]) {
+            prev[n].push_back(static_cast<int>(s));
+        }
+    }
+
+    std::vector<bool> exits(count, false);
+    for (auto node : exitNodes) {
+        exits[node->stmt->statementNum - first] = true;
+    }
+
+    // a statement starts a block unless it is the only successor of its only predecessor, and a block ends where
+    // control can leave the procedure.
+    int entry = skipDummies(root)->stmt->statementNum - first;
+    auto isLeader = [&](int s) {
+        return s == entry || prev[s].size() != 1 || next[prev[s].front()].size() != 1 || exits[prev[s].front()];
+    };
+
+    cfg.blockOf.assign(count, -1);
+    cfg.posInBlock.assign(count, -1);
+    std::vector<std::vector<int>> blocks;
+    auto growBlock = [&](int leader) {
+        BlockId id = static_cast<BlockId>(blocks.size());
+        blocks.emplace_back();
+        int current = leader;
+        while (true) {
+            cfg.blockOf[current] = id;
+            cfg.posInBlock[current] = static_cast<int>(blocks.back().size());
+            blocks.back().push_back(current);
+            if (next[current].size() != 1 || exits[current]) {
+                break;
+            }
+            int following = next[current].front();
+            if (isLeader(following) || cfg.blockOf[following] != -1) {
+                break;
+            }
+            current = following;
+        }
+    };
+    for (std::size_t s = 0; s < count; s++) {
+        if (present[s] && isLeader(static_cast<int>(s))) {
+            growBlock(static_cast<int>(s));
+        }
+    }
+    // only reachable if a cycle has no leader, which structured code cannot produce.
+    for (std::size_t s = 0; s < count; s++) {
+        if (present[s] && cfg.blockOf[s] == -1) {
+            growBlock(static_cast<int>(s));
+        }
+    }
+    cfg.entryBlock = cfg.blockOf[entry];
+
+    std::vector<std::vector<int>> blockSuccs(blocks.size()), blockPreds(blocks.size());
+    cfg.exitBlocks = Bitset(blocks.size());
+    for (std::size_t b = 0; b < blocks.size(); b++) {
+        if (exits[blocks[b].back()]) {
+            cfg.exitBlocks.set(b);
+        }
+        for (int n : next[blocks[b].back()]) {
+            blockSuccs[b].push_back(cfg.blockOf[n]);
+            blockPreds[cfg.blockOf[n]].push_back(static_cast<int>(b));
+        }
+    }
+    flatten(blocks, &cfg.blockOffsets, &cfg.blockStmts);
+    flatten(blockSuccs, &cfg.succOffsets, &cfg.succs);
+    flatten(blockPreds, &cfg.predOffsets, &cfg.preds);
+    return cfg;
+}
+
+Bitset BlockCFG::getBlocksReachableFrom(BlockId b) const {
+    Bitset reached(getBlockCount());
+    std::vector<BlockId> stack(getSuccessors(b).begin(), getSuccessors(b).end());
+    while (!stack.empty()) {
+        BlockId current = stack.back();
+        stack.pop_back();
+        if (reached.test(current)) {
+            continue;
+        }
+        reached.set(current);
+        for (auto succ : getSuccessors(current)) {
+            if (!reached.test(succ)) {
+                stack.push_back(succ);
+            }
+        }
+    }
+    return reached;
+}
+
+Bitset BlockCFG::getBlocksReaching(BlockId b) const {
+    Bitset reached(getBlockCount());
+    std::vector<BlockId> stack(getPredecessors(b).begin(), getPredecessors(b).end());
+    while (!stack.empty()) {
+        BlockId current = stack.back();
+        stack.pop_back();
+        if (reached.test(current)) {
+            continue;
+        }
+        reached.set(current);
+        for (auto pred : getPredecessors(current)) {
+            if (!reached.test(pred)) {
+                stack.push_back(pred);
+            }
+        }
+    }
+    return reached;
+}
+
+Bitset BlockCFG::getReachableFrom(StmtIndex i, const Bitset& reachableBlocks) const {
+    Bitset result(getStmtCount());
+    auto own = getBlockStmts(blockOf[i]);
+    for (std::size_t pos = posInBlock[i] + 1; pos < own.size(); pos++) {
+        result.set(own.first[pos]);
+    }
+    reachableBlocks.forEach([&](std::size_t b) {
+        for (auto s : getBlockStmts(static_cast<BlockId>(b))) {
+            result.set(s);
+        }
+    });
+    return result;
+}
+
+Bitset BlockCFG::getReaching(StmtIndex i, const Bitset& reachingBlocks) const {
+    Bitset result(getStmtCount());
+    auto own = getBlockStmts(blockOf[i]);
+    for (int pos = 0; pos < posInBlock[i]; pos++) {
+        result.set(own.first[pos]);
+    }
+    reachingBlocks.forEach([&](std::size_t b) {
+        for (auto s : getBlockStmts(static_cast<BlockId>(b))) {
+            result.set(s);
+        }
+    });
+    return result;
+}
+
+bool BlockCFG::isReachable(StmtIndex from, StmtIndex to) const {
+    if (blockOf[from] == blockOf[to] && posInBlock[to] > posInBlock[from]) {
+        return true;
+    }
+    // entering a block reaches every statement in it, so only the blocks need to be searched.
+    Bitset reached(getBlockCount());
+    std::vector<BlockId> stack(getSuccessors(blockOf[from]).begin(), getSuccessors(blockOf[from]).end());
+    while (!stack.empty()) {
+        BlockId current = stack.back();
+        stack.pop_back();
+        if (current == blockOf[to]) {
+            return true;
+        }
+        if (reached.test(current)) {
+            continue;
+        }
+        reached.set(current);
+        for (auto succ : getSuccessors(current)) {
+            if (!reached.test(succ)) {
+                stack.push_back(succ);
+            }
+        }
+    }
+    return false;
+}
+
+ProcedureSummary BlockCFG::summarize(const std::vector<ProcedureSummary>& summaries, std::size_t varCount) const {
+    ProcedureSummary summary{ Bitset(varCount) };
+    // calls are seen through the summary of their callee.
+    for (std::size_t s = 0; s < getStmtCount(); s++) {
+        if (blockOf[s] != -1) {
+            summary.mayModify |= callees[s] != -1 ? summaries[callees[s]].mayModify : modifies[s];
+        }
+    }
+    return summary;
+}
+
+std::shared_ptr<const ProgramCFG> ProgramCFG::build(const PROC_CFG_MAP& cfgs) {
+    std::vector<std::pair<std::string, const CFGNode*>> roots;
+    for (auto& [name, root] : cfgs) {
+        roots.emplace_back(name, root.get());
+    }
+
+    // variables are interned in procedure order so that the ids do not depend on thread scheduling.
+    std::vector<std::set<std::string>> variables(roots.size());
+    ThreadPool::shared().parallelFor(roots.size(), [&](std::size_t i) {
+        forEachStatement(roots[i].second, [&](const CFGNode* node, auto&, bool) {
+            for (auto& var : node->modifies) {
+                variables[i].insert(var.name);
+            }
+            for (auto& var : node->uses) {
+                variables[i].insert(var.name);
+            }
+        });
+    });
+    auto program = std::make_shared<ProgramCFG>();
+    for (auto& names : variables) {
+        for (auto& name : names) {
+            program->vars.intern(name);
+        }
+    }
+
+    std::unordered_map<std::string, int> procIndex;
+    for (std::size_t i = 0; i < roots.size(); i++) {
+        procIndex.emplace(roots[i].first, static_cast<int>(i));
+    }
+    program->procedures.resize(roots.size());
+    ThreadPool::shared().parallelFor(roots.size(), [&](std::size_t i) {
+        program->procedures[i] = BlockCFG::build(roots[i].first, roots[i].second, program->vars, procIndex);
+    });
+    program->summarize();
+
+    for (std::size_t p = 0; p < program->procedures.size(); p++) {
+        auto& procedure = program->procedures[p];
+        for (std::size_t s = 0; s < procedure.getStmtCount(); s++) {
+            if (procedure.blockOf[s] == -1) {
+                continue;
+            }
+            int stmtNo = procedure.stmts[s].statementNum;
+            if (program->procOfStmt.size() <= static_cast<std::size_t>(stmtNo)) {
+                program->procOfStmt.resize(stmtNo + 1, -1);
+            }
+            program->procOfStmt[stmtNo] = static_cast<int>(p);
+        }
+    }
+    return program;
+}
+
+void ProgramCFG::summarize() {
+    // the level of a procedure is one above the highest of its callees, recursion is rejected by the validator.
+    std::vector<int> levelOf(procedures.size(), -1);
+    std::function<int(int)> computeLevel = [&](int p) {
+        if (levelOf[p] != -1) {
+            return levelOf[p];
+        }
+        levelOf[p] = 0;
+        int level = 0;
+        for (auto callee : procedures[p].callees) {
+            if (callee != -1) {
+                level = std::max(level, computeLevel(callee) + 1);
+            }
+        }
+        return levelOf[p] = level;
+    };
+    std::vector<std::vector<int>> levels;
+    for (std::size_t p = 0; p < procedures.size(); p++) {
+        std::size_t level = computeLevel(static_cast<int>(p));
+        if (levels.size() <= level) {
+            levels.resize(level + 1);
+        }
+        levels[level].push_back(static_cast<int>(p));
+    }
+
+    summaries.assign(procedures.size(), ProcedureSummary{ Bitset(vars.size()) });
+    for (auto& level : levels) {
+        // each procedure only writes its own summary and reads the ones of lower levels.
+        ThreadPool::shared().parallelFor(level.size(), [&](std::size_t i) {
+            summaries[level[i]] = procedures[level[i]].summarize(summaries, vars.size());
+        });
+    }
+}
+
+namespace {
+void writeBitsets(snapshot::Writer& out, const std::vector<Bitset>& bitsets) {
+    out.write<std::uint64_t>(bitsets.size());
+    for (auto& bits : bitsets) {
+        out.writeBitset(bits);
+    }
+}
+
+std::vector<Bitset> readBitsets(snapshot::Reader& in) {
+    std::vector<Bitset> bitsets(in.readCount());
+    for (auto& bits : bitsets) {
+        bits = in.readBitset();
+    }
+    return bitsets;
+}
+}  // namespace
+
+void ProgramCFG::write(snapshot::Writer& out) const {
+    out.write<std::uint64_t>(vars.size());
+    for (std::size_t i = 0; i < vars.size(); i++) {
+        out.writeName(vars.getName(i));
+    }
+    out.write<std::uint64_t>(procedures.size());
+    for (auto& procedure : procedures) {
+        out.writeName(procedure.name);
+        out.write<int>(procedure.firstStmtNo);
+        out.write<int>(procedure.entryBlock);
+        out.write<std::uint64_t>(procedure.stmts.size());
+        for (auto& stmt : procedure.stmts) {
+            snapshot::writeStmt(out, stmt);
+        }
+        writeBitsets(out, procedure.modifies);
+        writeBitsets(out, procedure.uses);
+        out.writeVector(procedure.blockOf);
+        out.writeVector(procedure.posInBlock);
+        out.writeVector(procedure.callees);
+        out.writeBitset(procedure.exitBlocks);
+        out.writeVector(procedure.blockOffsets);
+        out.writeVector(procedure.blockStmts);
+        out.writeVector(procedure.succOffsets);
+        out.writeVector(procedure.succs);
+        out.writeVector(procedure.predOffsets);
+        out.writeVector(procedure.preds);
+    }
+    for (auto& summary : summaries) {
+        out.writeBitset(summary.mayModify);
+    }
+    out.writeVector(procOfStmt);
+}
+
+std::shared_ptr<const ProgramCFG> ProgramCFG::read(snapshot::Reader& in) {
+    auto program = std::make_shared<ProgramCFG>();
+    auto varCount = in.readCount();
+    for (std::size_t i = 0; i < varCount; i++) {
+        program->vars.intern(in.readName());
+    }
+    program->procedures.resize(in.readCount());
+    for (auto& procedure : program->procedures) {
+        procedure.name = in.readName();
+        procedure.firstStmtNo = in.read<int>();
+        procedure.entryBlock = in.read<int>();
+        auto stmtCount = in.readCount();
+        for (std::size_t i = 0; i < stmtCount; i++) {
+            procedure.stmts.push_back(snapshot::readStmt(in));
+        }
+        procedure.modifies = readBitsets(in);
+        procedure.uses = readBitsets(in);
+        procedure.blockOf = in.readVector<BlockCFG::BlockId>();
+        procedure.posInBlock = in.readVector<int>();
+        procedure.callees = in.readVector<int>();
+        procedure.exitBlocks = in.readBitset();
+        procedure.blockOffsets = in.readVector<int>();
+        procedure.blockStmts = in.readVector<int>();
+        procedure.succOffsets = in.readVector<int>();
+        procedure.succs = in.readVector<int>();
+        procedure.predOffsets = in.readVector<int>();
+        procedure.preds = in.readVector<int>();
+
+        std::size_t blockCount = procedure.getBlockCount();
+        bool isValid = procedure.modifies.size() == stmtCount && procedure.uses.size() == stmtCount &&
+            procedure.blockOf.size() == stmtCount && procedure.posInBlock.size() == stmtCount &&
+            procedure.callees.size() == stmtCount &&
+            procedure.succOffsets.size() == procedure.blockOffsets.size() &&
+            procedure.predOffsets.size() == procedure.blockOffsets.size() &&
+            (blockCount == 0 || (procedure.blockOffsets.back() == static_cast<int>(procedure.blockStmts.size()) &&
+                                 procedure.succOffsets.back() == static_cast<int>(procedure.succs.size()) &&
+                                 procedure.predOffsets.back() == static_cast<int>(procedure.preds.size())));
+        if (!isValid) {
+            throw snapshot::SnapshotError("Invalid CFG in snapshot");
+        }
+    }
+    program->summaries.resize(program->procedures.size());
+    for (auto& summary : program->summaries) {
+        summary.mayModify = in.readBitset();
+    }
+    program->procOfStmt = in.readVector<int>();
+    return program;
+}
+
+std::pair<const BlockCFG*, BlockCFG::StmtIndex> ProgramCFG::locate(int stmtNo) const {
+    if (stmtNo < 0 || static_cast<std::size_t>(stmtNo) >= procOfStmt.size() || procOfStmt[stmtNo] == -1) {
+        return { nullptr, -1 };
+    }
+    auto& procedure = procedures[procOfStmt[stmtNo]];
+    return { &procedure, procedure.indexOf(stmtNo) };
+}
+
+std::size_t ProgramCFG::getMemoryBytes() const {
+    std::size_t bytes = vars.getMemoryBytes();
+    bytes += procedures.capacity() * sizeof(BlockCFG);
+    for (auto& cfg : procedures) {
+        bytes += memory::heapBytes(cfg.name) + memory::heapBytes(cfg.stmts) + memory::heapBytes(cfg.modifies) +
+            memory::heapBytes(cfg.uses) + memory::heapBytes(cfg.blockOf) + memory::heapBytes(cfg.posInBlock) +
+            memory::heapBytes(cfg.callees) + memory::heapBytes(cfg.exitBlocks) +
+            memory::heapBytes(cfg.blockOffsets) + memory::heapBytes(cfg.blockStmts) +
+            memory::heapBytes(cfg.succOffsets) + memory::heapBytes(cfg.succs) +
+            memory::heapBytes(cfg.predOffsets) + memory::heapBytes(cfg.preds);
+    }
+    bytes += summaries.capacity() * sizeof(ProcedureSummary);
+    for (auto& summary : summaries) {
+        bytes += memory::heapBytes(summary.mayModify);
+    }
+    return bytes + memory::heapBytes(procOfStmt);
+}
+
+}  // namespace cfg
+}  // namespace sp
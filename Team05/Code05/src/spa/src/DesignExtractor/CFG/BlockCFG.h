@@ -0,0 +1,269 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Bitset.h"
+#include "DesignExtractor/CFG/CFG.h"
+#include "MemoryUsage.h"
+#include "PKB/PKBField.h"
+#include "Snapshot.h"
+
+namespace sp {
+namespace cfg {
+
+using VarId = std::size_t;
+
+/**
+ * @brief Interns variable names into dense ids, so that the variables a statement modifies or uses can be
+ * stored as a Bitset.
+ */
+class VarIndex {
+public:
+    VarId intern(const std::string& name);
+    std::optional<VarId> find(const std::string& name) const;
+    const std::string& getName(VarId id) const { return names.at(id); }
+    std::size_t size() const { return names.size(); }
+    std::size_t getMemoryBytes() const { return memory::heapBytes(names) + memory::heapBytes(ids); }
+
+private:
+    std::vector<std::string> names;
+    std::unordered_map<std::string, VarId> ids;
+};
+
+/**
+ * @brief What a call to a procedure does to the variables, as seen from the call site.
+ * @details mayModify holds the variables modified on some path through the procedure, or through the procedures
+ * it calls, as a bitset over the interned variables. A call kills the Affects paths through it for exactly these
+ * variables, so nothing more precise is kept.
+ */
+struct ProcedureSummary {
+    Bitset mayModify;
+};
+
+/**
+ * @brief Compact basic block CFG of a single procedure.
+ * @details Statements are addressed by their local index, which is their statement number minus the first
+ * statement number of the procedure. Straight-line runs of statements are collapsed into basic blocks, and the
+ * statements of each block as well as the successor and predecessor edges between blocks are kept in flat
+ * offset/value arrays. The variables each statement modifies and uses are kept as bitsets over the interned
+ * variable ids of the program.
+ */
+class BlockCFG {
+public:
+    using StmtIndex = int;
+    using BlockId = int;
+
+    /**
+     * @brief A read-only view over a slice of one of the flat arrays.
+     */
+    struct Range {
+        const int* first;
+        const int* last;
+        const int* begin() const { return first; }
+        const int* end() const { return last; }
+        std::size_t size() const { return last - first; }
+        bool empty() const { return first == last; }
+    };
+
+    const std::string& getName() const { return name; }
+    std::size_t getStmtCount() const { return stmts.size(); }
+    std::size_t getBlockCount() const { return blockOffsets.empty() ? 0 : blockOffsets.size() - 1; }
+
+    /**
+     * @return the local index of the statement, or -1 if the statement is not in this procedure.
+     */
+    StmtIndex indexOf(int stmtNo) const {
+        int local = stmtNo - firstStmtNo;
+        return local >= 0 && local < static_cast<int>(stmts.size()) && blockOf[local] != -1 ? local : -1;
+    }
+
+    const STMT_LO& getStmt(StmtIndex i) const { return stmts[i]; }
+    const Bitset& getModifies(StmtIndex i) const { return modifies[i]; }
+    const Bitset& getUses(StmtIndex i) const { return uses[i]; }
+    BlockId getBlock(StmtIndex i) const { return blockOf[i]; }
+    int getPosInBlock(StmtIndex i) const { return posInBlock[i]; }
+
+    /**
+     * @return the index of the procedure called by statement i in the program, or -1 if it is not a call.
+     */
+    int getCallee(StmtIndex i) const { return callees[i]; }
+
+    /**
+     * @return the block holding the first statement executed by the procedure.
+     */
+    BlockId getEntryBlock() const { return entryBlock; }
+
+    /**
+     * @return whether control can leave the procedure after the last statement of the block.
+     */
+    bool isExitBlock(BlockId b) const { return exitBlocks.test(b); }
+
+    /**
+     * @return the statements of the block, in execution order.
+     */
+    Range getBlockStmts(BlockId b) const { return slice(blockOffsets, blockStmts, b); }
+    Range getSuccessors(BlockId b) const { return slice(succOffsets, succs, b); }
+    Range getPredecessors(BlockId b) const { return slice(predOffsets, preds, b); }
+
+    /**
+     * @brief Calls f with every statement that can be executed directly after statement i, i.e. Next(i, s).
+     */
+    template <typename F>
+    void forEachNext(StmtIndex i, F&& f) const {
+        auto block = getBlockStmts(blockOf[i]);
+        if (posInBlock[i] + 1 < static_cast<int>(block.size())) {
+            f(block.first[posInBlock[i] + 1]);
+            return;
+        }
+        for (auto succ : getSuccessors(blockOf[i])) {
+            f(getBlockStmts(succ).first[0]);
+        }
+    }
+
+    /**
+     * @brief Calls f with every statement that can be executed directly before statement i, i.e. Next(s, i).
+     */
+    template <typename F>
+    void forEachPrevious(StmtIndex i, F&& f) const {
+        if (posInBlock[i] > 0) {
+            f(getBlockStmts(blockOf[i]).first[posInBlock[i] - 1]);
+            return;
+        }
+        for (auto pred : getPredecessors(blockOf[i])) {
+            auto block = getBlockStmts(pred);
+            f(block.last[-1]);
+        }
+    }
+
+    /**
+     * @return the blocks that can be entered after leaving block b, through one or more edges.
+     */
+    Bitset getBlocksReachableFrom(BlockId b) const;
+
+    /**
+     * @return the blocks that can be left before entering block b, through one or more edges.
+     */
+    Bitset getBlocksReaching(BlockId b) const;
+
+    /**
+     * @brief Expands the blocks reachable from the block of statement i into the statements reachable from i.
+     *
+     * @return the statements s such that Next*(i, s), as a bitset over local indices.
+     */
+    Bitset getReachableFrom(StmtIndex i, const Bitset& reachableBlocks) const;
+    Bitset getReachableFrom(StmtIndex i) const { return getReachableFrom(i, getBlocksReachableFrom(blockOf[i])); }
+
+    /**
+     * @return the statements s such that Next*(s, i), as a bitset over local indices.
+     */
+    Bitset getReaching(StmtIndex i, const Bitset& reachingBlocks) const;
+    Bitset getReaching(StmtIndex i) const { return getReaching(i, getBlocksReaching(blockOf[i])); }
+
+    /**
+     * @return whether Next*(from, to) holds.
+     */
+    bool isReachable(StmtIndex from, StmtIndex to) const;
+
+    /**
+     * @brief Builds the basic block CFG of a procedure from the CFGNode graph produced by the CFGExtractor.
+     *
+     * @param name the name of the procedure
+     * @param root the dummy root of the procedure's CFGNode graph
+     * @param vars the interned variables, which must already contain every variable of the procedure
+     * @param procIndex the index of every procedure of the program, to resolve the calls with
+     */
+    static BlockCFG build(const std::string& name, const CFGNode* root, const VarIndex& vars,
+        const std::unordered_map<std::string, int>& procIndex);
+
+    /**
+     * @brief Computes the summary of the procedure from its statements and the summaries of its callees.
+     *
+     * @param summaries the summaries of the program's procedures, which must be filled in for every callee
+     * @param varCount the number of interned variables
+     */
+    ProcedureSummary summarize(const std::vector<ProcedureSummary>& summaries, std::size_t varCount) const;
+
+private:
+    friend class ProgramCFG;
+
+    std::string name;
+    int firstStmtNo = 0;
+    BlockId entryBlock = 0;
+    std::vector<STMT_LO> stmts;
+    std::vector<Bitset> modifies, uses;
+    std::vector<BlockId> blockOf;
+    std::vector<int> posInBlock;
+    std::vector<int> callees;
+    Bitset exitBlocks;
+    std::vector<int> blockOffsets, blockStmts;
+    std::vector<int> succOffsets, succs;
+    std::vector<int> predOffsets, preds;
+
+    static Range slice(const std::vector<int>& offsets, const std::vector<int>& values, int i) {
+        return Range{ values.data() + offsets[i], values.data() + offsets[i + 1] };
+    }
+};
+
+/**
+ * @brief The basic block CFGs of every procedure in a program, together with the variables they are indexed by.
+ */
+class ProgramCFG {
+public:
+    /**
+     * @brief Builds the flat CFG of every procedure, each procedure on its own thread.
+     */
+    static std::shared_ptr<const ProgramCFG> build(const PROC_CFG_MAP& cfgs);
+
+    /**
+     * @brief Writes every flat array of the CFG to a snapshot, so that read can restore it without building it
+     * from the CFGNode graphs again.
+     */
+    void write(snapshot::Writer& out) const;
+
+    /**
+     * @brief Restores a CFG written by write.
+     *
+     * @throws snapshot::SnapshotError if the snapshot does not hold a valid CFG
+     */
+    static std::shared_ptr<const ProgramCFG> read(snapshot::Reader& in);
+
+    const VarIndex& getVarIndex() const { return vars; }
+    const std::vector<BlockCFG>& getProcedures() const { return procedures; }
+
+    /**
+     * @return the summary of every procedure, in the same order as the procedures.
+     */
+    const std::vector<ProcedureSummary>& getSummaries() const { return summaries; }
+
+    /**
+     * @return the procedure holding the statement and the local index of the statement in it, or a nullptr
+     * if the statement is not in any procedure.
+     */
+    std::pair<const BlockCFG*, BlockCFG::StmtIndex> locate(int stmtNo) const;
+
+    /**
+     * @return the bytes held by the flat arrays of every procedure, their summaries and the variable index.
+     */
+    std::size_t getMemoryBytes() const;
+
+private:
+    /**
+     * @brief Summarizes the procedures in reverse topological order of the calls between them. Procedures whose
+     * callees are all summarized are independent of each other, so each such level is done in parallel.
+     */
+    void summarize();
+
+    VarIndex vars;
+    std::vector<BlockCFG> procedures;
+    std::vector<ProcedureSummary> summaries;
+    std::vector<int> procOfStmt;  // statement number to index in procedures, -1 if there is no such statement
+};
+
+}  // namespace cfg
+}  // namespace sp
@@ -1,11 +1,13 @@
 #include <unordered_set>
 
 #include "CFG.h"
+#include "BlockCFG.h"
 #include "DesignExtractor/RelationshipExtractor/ModifiesExtractor.h"
 #include "DesignExtractor/RelationshipExtractor/UsesExtractor.h"
 #include "logging.h"
+#include "ThreadPool.h"
 
-#define DEBUG_LOG Logger(Level::DEBUG) << "CFGExtractor.cpp Extracted "
+#define DEBUG_LOG LOG(Level::DEBUG) << "CFGExtractor.cpp Extracted "
 
 namespace sp {
 namespace cfg {
@@ -95,24 +97,7 @@ bool CFGNode::isAncestorOf(CFGNode* other) {
     return false;
 }
 
-using EntrySet = std::set<sp::design_extractor::Entry>;
-
-ContentToVarMap createContentVarMap(const EntrySet &entrySet) {
-    ContentToVarMap result;
-    for (auto entry : entrySet) {
-        auto relationship = std::get<design_extractor::Relationship>(entry);
-        Content key, val;
-        std::tie (std::ignore, key, val) = relationship;
-        if (result.find(key) != result.end()) {
-            result.at(key).insert(std::get<VAR_NAME>(val));
-        } else {
-            std::unordered_set<VAR_NAME> newSet;
-            newSet.insert(std::get<VAR_NAME>(val));
-            result[key] = newSet;
-        }
-    }
-    return result;
-}
+CFG::CFG(NODE_LIST nodes, PROC_CFG_MAP cfgs) : nodes(nodes), cfgs(cfgs), blocks(ProgramCFG::build(this->cfgs)) {}
 
 VAR_NAMES filterContentVarMap(const ContentToVarMap &contentToVarMap, const Content &content) {
     VAR_NAMES result;
@@ -162,7 +147,7 @@ void CFGExtractor::visit(const ast::Read& node) {
     auto newNode = std::make_shared<CFGNode>(node.getStmtNo(), StatementType::Read);
     // inserting Modifies relationship info for Read stmt CFGNode
     STMT_LO stmt = STMT_LO(node.getStmtNo(), StatementType::Read);
-    newNode->modifies = filterContentVarMap(modifiesMap, stmt);
+    newNode->modifies = filterContentVarMap(*modifiesMap, stmt);
 
     lastVisited->insert(newNode);
     lst.push_back(newNode);  // updating the list of nodes
@@ -182,8 +167,8 @@ void CFGExtractor::visit(const ast::Assign& node) {
     auto newNode = std::make_shared<CFGNode>(node.getStmtNo(), StatementType::Assignment);
     // inserting Modifies relationship info for Assign stmt CFGNode
     STMT_LO stmt = STMT_LO(node.getStmtNo(), StatementType::Assignment);
-    newNode->modifies = filterContentVarMap(modifiesMap, stmt);
-    newNode->uses = filterContentVarMap(usesMap, stmt);
+    newNode->modifies = filterContentVarMap(*modifiesMap, stmt);
+    newNode->uses = filterContentVarMap(*usesMap, stmt);
 
     lastVisited->insert(newNode);
     lst.push_back(newNode);  // updating the list of nodes
@@ -193,9 +178,10 @@ void CFGExtractor::visit(const ast::Assign& node) {
 
 void CFGExtractor::visit(const ast::Call& node) {
     auto newNode = std::make_shared<CFGNode>(node.getStmtNo(), StatementType::Call);
+    newNode->callee = node.getName();
     // inserting Modifies relationship info for Call stmt CFGNode
     STMT_LO stmt = STMT_LO(node.getStmtNo(), StatementType::Call);
-    newNode->modifies = filterContentVarMap(modifiesMap, stmt);
+    newNode->modifies = filterContentVarMap(*modifiesMap, stmt);
 
     lastVisited->insert(newNode);
     lst.push_back(newNode);  // updating the list of nodes
@@ -229,12 +215,46 @@ void CFGExtractor::exitContainer() {
 
 CFG CFGExtractor::extract(ast::ASTNode* node) {
     auto modifiesEntrySet = design_extractor::ModifiesExtractor().extract(node);
-    modifiesMap = createContentVarMap(modifiesEntrySet);
     auto usesEntrySet = design_extractor::UsesExtractor().extract(node);
-    usesMap = createContentVarMap(usesEntrySet);
-    node->accept(this);
-    auto cfgContainer = CFG(lst, procNameAndRoot);
-    return cfgContainer;
+    return extract(node,
+        std::make_shared<const ContentToVarMap>(
+            design_extractor::groupStatementVariables(modifiesEntrySet, PKBRelationship::MODIFIES)),
+        std::make_shared<const ContentToVarMap>(
+            design_extractor::groupStatementVariables(usesEntrySet, PKBRelationship::USES)));
+}
+
+CFG CFGExtractor::extract(ast::ASTNode* node, std::shared_ptr<const ContentToVarMap> modifiesMap,
+    std::shared_ptr<const ContentToVarMap> usesMap) {
+    this->modifiesMap = std::move(modifiesMap);
+    this->usesMap = std::move(usesMap);
+
+    auto program = dynamic_cast<const ast::Program*>(node);
+    if (!program) {
+        node->accept(this);
+        return CFG(lst, procNameAndRoot);
+    }
+
+    auto& procedures = program->getProcedures();
+    std::vector<CFGExtractor> extractors;
+    extractors.reserve(procedures.size());
+    for (std::size_t i = 0; i < procedures.size(); i++) {
+        extractors.push_back(CFGExtractor(this->modifiesMap, this->usesMap));
+    }
+    ThreadPool::shared().parallelFor(procedures.size(), [&](std::size_t i) {
+        procedures[i]->accept(&extractors[i]);
+    });
+    for (auto& extractor : extractors) {
+        lst.insert(lst.end(), extractor.lst.begin(), extractor.lst.end());
+        procNameAndRoot.insert(extractor.procNameAndRoot.begin(), extractor.procNameAndRoot.end());
+    }
+    return CFG(lst, procNameAndRoot);
+}
+
+std::pair<std::shared_ptr<CFGNode>, NODE_LIST> CFGExtractor::extractProcedure(const ast::Procedure& node,
+    std::shared_ptr<const ContentToVarMap> modifiesMap, std::shared_ptr<const ContentToVarMap> usesMap) {
+    CFGExtractor extractor(std::move(modifiesMap), std::move(usesMap));
+    node.accept(&extractor);
+    return { extractor.procNameAndRoot.at(node.getName()), std::move(extractor.lst) };
 }
 
 }  // namespace cfg
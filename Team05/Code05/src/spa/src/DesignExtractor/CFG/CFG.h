@@ -5,6 +5,7 @@
 #include <map>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 
 #include "DesignExtractor/TreeWalker.h"
 #include "PKB/PKBField.h"
@@ -13,6 +14,7 @@ namespace sp {
 namespace cfg {
 
 class CFGNode;
+class ProgramCFG;
 using PROC_CFG_MAP = std::map<std::string, std::shared_ptr<cfg::CFGNode>>;
 using NODE_LIST = std::vector<std::shared_ptr<CFGNode>>;
 using VAR_NAMES = std::unordered_set<VAR_NAME>;
@@ -31,6 +33,7 @@ public:
     std::optional<STMT_LO> stmt;
     VAR_NAMES modifies;  // information on modifies relationship for current node
     VAR_NAMES uses;  // information on uses relationship relationship for current node
+    std::optional<std::string> callee;  // the procedure called, for call nodes
     CFGNode () : stmt(std::nullopt) {}
     CFGNode(int stmtNo, StatementType stmtType) : stmt(STMT_LO(stmtNo, stmtType)) {}
 
@@ -43,13 +46,18 @@ public:
     std::vector<std::weak_ptr<CFGNode>> getChildren() const { return children; }
 };
 
+/**
+ * @brief Class to encapsulate the CFG of a program.
+ * @details cfgs is the CFGNode graph of each procedure, as built by the CFGExtractor. blocks is the flat basic block
+ * form of the same graphs, which is what Next, Next* and Affects are evaluated over.
+ */
 class CFG {
 private:
     NODE_LIST nodes;
 public:
     PROC_CFG_MAP cfgs;
-    CFG (NODE_LIST nodes, PROC_CFG_MAP cfgs)
-    : nodes(nodes), cfgs(cfgs) {}
+    std::shared_ptr<const ProgramCFG> blocks;
+    CFG (NODE_LIST nodes, PROC_CFG_MAP cfgs);
     CFG () {}  // Overloaded to preserve default constructor
 };
 
@@ -69,6 +77,8 @@ using VarName = std::string;
  * The While node will always lead down the path of execution and point back to the parent While node,
  * and subsequent statements will point from the While node.
  * The extract() method will return a map of procedure names to their respective CFGs.
+ * The procedures of a program do not share any CFGNode, so each of them is built by its own extractor
+ * on the shared thread pool, and the results are merged in program order.
  */
 class CFGExtractor: public design_extractor::TreeWalker {
 private:
@@ -77,12 +87,16 @@ private:
     int containerCount = 0;  // keeps track of # of containers/stmtLst to enter for if or while stmts
     Bucket bucket, exitReference;  // keeps track parent and exit CFGnodes at different nesting levels
     Depth currentDepth = 0;  // keeps track of the depth of the current statement in the stmtLst
-    ContentToVarMap modifiesMap, usesMap;  // reference for adding modifies and uses information to the CFG
+    // reference for adding modifies and uses information to the CFG, shared by the extractors of all procedures
+    std::shared_ptr<const ContentToVarMap> modifiesMap, usesMap;
     NODE_LIST lst;
     void enterBucket(std::shared_ptr<CFGNode> node) {
         bucket.insert_or_assign(currentDepth, node);
     }
+    CFGExtractor(std::shared_ptr<const ContentToVarMap> modifiesMap, std::shared_ptr<const ContentToVarMap> usesMap) :
+        modifiesMap(std::move(modifiesMap)), usesMap(std::move(usesMap)) {}
 public:
+    CFGExtractor() = default;
     void visit(const ast::Procedure& node) override;
     void visit(const ast::If& node) override;
     void visit(const ast::While& node) override;
@@ -92,7 +106,30 @@ public:
     void visit(const ast::Call& node) override;
     void enterContainer(std::variant<int, std::string> containerId) override;
     void exitContainer() override;
+    /**
+     * @brief Extracts the CFG, annotating its nodes with Modifies and Uses extracted from the AST on the spot.
+     */
     CFG extract(ast::ASTNode* node);
+
+    /**
+     * @brief Extracts the CFG, annotating its nodes with Modifies and Uses that were already extracted, so that the
+     * interprocedural propagation does not have to be computed again.
+     * 
+     * @param node the AST to extract the CFG from
+     * @param modifiesMap the variables modified by each statement
+     * @param usesMap the variables used by each statement
+     */
+    CFG extract(ast::ASTNode* node, std::shared_ptr<const ContentToVarMap> modifiesMap,
+        std::shared_ptr<const ContentToVarMap> usesMap);
+
+    /**
+     * @brief Extracts the CFG of a single procedure without flattening it, e.g. to reuse it in the CFG of a later
+     * version of the program.
+     *
+     * @return the root of the procedure's CFG, and every other node of it, which the root does not own.
+     */
+    static std::pair<std::shared_ptr<CFGNode>, NODE_LIST> extractProcedure(const ast::Procedure& node,
+        std::shared_ptr<const ContentToVarMap> modifiesMap, std::shared_ptr<const ContentToVarMap> usesMap);
 };
 }  // namespace cfg
 }  // namespace sp
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <algorithm>
+#include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "TreeWalker.h"
@@ -36,7 +39,73 @@ public:
             return procMap;
     }
 
+    /**
+     * @brief Orders the procedures such that every procedure comes after all the procedures it calls.
+     * 
+     * Extractors that propagate information from callee to caller (e.g. Modifies and Uses through call
+     * statements) can walk the procedures in this order and rely on every callee being processed already.
+     * 
+     * @return the procedures in reverse topological order of the call graph.
+     */
+    std::vector<const ast::Procedure*> getReverseTopologicalOrder() const {
+        std::vector<const ast::Procedure*> order;
+        std::unordered_set<std::string> visited;
+        processReverseTopoOrder("1", visited, order);
+        return order;
+    }
+
+    /**
+     * @brief Groups the procedures into levels, where level 0 holds the procedures that call nothing and every
+     * other procedure is one level above the highest of its callees.
+     *
+     * Procedures in the same level never call each other, so they can be processed concurrently once all the
+     * lower levels are done. As recursion is rejected by the validator, every strongly connected component of
+     * the call graph is a single procedure and the levels are exactly the SCC levels of its condensation.
+     *
+     * @return the levels in increasing order, each with its procedures in reverse topological order.
+     */
+    std::vector<std::vector<const ast::Procedure*>> getReverseTopologicalLevels() const {
+        std::unordered_map<std::string, std::size_t> levelOf;
+        std::vector<std::vector<const ast::Procedure*>> levels;
+        for (auto proc : getReverseTopologicalOrder()) {
+            // callees are ordered first, so their levels are already known.
+            std::size_t level = 0;
+            if (auto it = callGraph.find(proc->getName()); it != callGraph.end()) {
+                for (auto& callee : it->second) {
+                    if (auto calleeLevel = levelOf.find(callee); calleeLevel != levelOf.end()) {
+                        level = std::max(level, calleeLevel->second + 1);
+                    }
+                }
+            }
+            levelOf[proc->getName()] = level;
+            if (levels.size() <= level) {
+                levels.resize(level + 1);
+            }
+            levels[level].push_back(proc);
+        }
+        return levels;
+    }
+
 protected:
+    void processReverseTopoOrder(
+        const std::string& proc,
+        std::unordered_set<std::string>& visited,
+        std::vector<const ast::Procedure*>& order
+    ) const {
+        if (!visited.insert(proc).second) {
+            return;
+        }
+        if (auto it = callGraph.find(proc); it != callGraph.end()) {
+            for (auto& callee : it->second) {
+                processReverseTopoOrder(callee, visited, order);
+            }
+        }
+        // the place holder root "1" has no procedure node.
+        if (auto it = procMap.find(proc); it != procMap.end()) {
+            order.push_back(it->second);
+        }
+    }
+
     std::string currentProc = "";
     AdjacencyList callGraph;
     std::unordered_map<std::string, const ast::Procedure*> procMap;
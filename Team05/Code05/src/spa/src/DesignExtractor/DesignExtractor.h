@@ -2,11 +2,14 @@
 
 #include <list>
 
+#include "DesignExtractor/CFG/BlockCFG.h"
 #include "DesignExtractor/CFG/CFG.h"
 #include "DesignExtractor/EntityExtractor/EntityExtractor.h"
 #include "DesignExtractor/Extractor.h"
+#include "DesignExtractor/FusedExtractor.h"
 #include "DesignExtractor/RelationshipExtractor/RelationshipExtractor.h"
 #include "Parser/AST.h"
+#include "PhaseProfile.h"
 #include "PKB.h"
 
 namespace sp {
@@ -14,41 +17,49 @@ namespace design_extractor {
 class DesignExtractor {
 private:
     std::list<std::shared_ptr<ExtractorModule<const ast::ASTNode*>>> astExtractors;
-    std::list<std::shared_ptr<ExtractorModule<const cfg::PROC_CFG_MAP*>>> cfgExtractors;
+    std::list<std::shared_ptr<ExtractorModule<const cfg::ProgramCFG*>>> cfgExtractors;
     PKB* pkb;
-    cfg::PROC_CFG_MAP cfgs;
+    cfg::CFG cfgContainer;
 
 public:
     explicit DesignExtractor(PKB* pkb) : pkb(pkb) {
-        astExtractors.push_back(std::make_shared<StatementExtractorModule>(pkb));
-        astExtractors.push_back(std::make_shared<VariableExtractorModule>(pkb));
-        astExtractors.push_back(std::make_shared<ConstExtractorModule>(pkb));
-        astExtractors.push_back(std::make_shared<ProcedureExtractorModule>(pkb));
-        astExtractors.push_back(std::make_shared<ModifiesExtractorModule>(pkb));
-        astExtractors.push_back(std::make_shared<UsesExtractorModule>(pkb));
-        astExtractors.push_back(std::make_shared<FollowsExtractorModule>(pkb));
-        astExtractors.push_back(std::make_shared<ParentExtractorModule>(pkb));
-        astExtractors.push_back(std::make_shared<CallsExtractorModule>(pkb));
+        // entities, Follows, Parent, Calls, Modifies and Uses are all collected in a single AST traversal.
+        astExtractors.push_back(std::make_shared<FusedExtractorModule>(pkb));
 
         cfgExtractors.push_back(std::make_shared<NextExtractorModule>(pkb));
     }
 
-    void extract(ast::ASTNode* ast) {
-        sp::cfg::CFG cfgContainer;
-        if (cfgs.empty()) {
-            cfgContainer = cfg::CFGExtractor().extract(ast);
-            cfgs = cfgContainer.cfgs;
-        }
+    /**
+     * @brief Extracts every design abstraction of the program into the PKB, together with its CFG.
+     * 
+     * Unless a CFG was inserted beforehand, the CFG is built after the AST extractors and annotated with the
+     * Modifies and Uses they extracted, so the interprocedural propagation is only done once.
+     *
+     * @param profile if given, records the time taken by every extractor module, by building the CFG and by
+     * loading the results into the PKB.
+     */
+    void extract(ast::ASTNode* ast, PhaseProfile* profile = nullptr) {
+        std::set<Entry> entries;
         for (auto extractor : astExtractors) {
-            extractor->extract(ast);
+            entries.merge(extractor->extract(ast, profile));
+        }
+        if (!cfgContainer.blocks) {
+            cfgContainer = PhaseProfile::time(profile, "cfg", [&]() {
+                return cfg::CFGExtractor().extract(ast,
+                    std::make_shared<const cfg::ContentToVarMap>(
+                        groupStatementVariables(entries, PKBRelationship::MODIFIES)),
+                    std::make_shared<const cfg::ContentToVarMap>(
+                        groupStatementVariables(entries, PKBRelationship::USES)));
+            });
         }
         for (auto extractor : cfgExtractors) {
-            extractor->extract(&cfgs);
+            extractor->extract(cfgContainer.blocks.get(), profile);
         }
+        PhaseProfile::time(profile, "pkb load", [&]() { pkb->insertCFG(cfgContainer); });
     }
 
-    void insert(const cfg::PROC_CFG_MAP &newCFGs) {
-        cfgs = newCFGs;
+    void insert(const cfg::CFG &cfgContainer) {
+        this->cfgContainer = cfgContainer;
     }
 };
 }  // namespace design_extractor
@@ -31,8 +31,8 @@ public:
 template<typename T>
 class EntityExtractorModule : public ExtractorModule<const ast::ASTNode*> {
 public:
-    explicit EntityExtractorModule(PKB *pkb) :
-        ExtractorModule(std::make_unique<EntityExtractor<T>>(), pkb) {}
+    EntityExtractorModule(PKB *pkb, std::string name) :
+        ExtractorModule(std::make_unique<EntityExtractor<T>>(), pkb, std::move(name)) {}
 };
 
 struct VariableCollector : public Collector {
@@ -43,7 +43,7 @@ struct VariableCollector : public Collector {
 
 struct VariableExtractorModule : public EntityExtractorModule<VariableCollector> {
     explicit VariableExtractorModule(PKB *pkb) : 
-        EntityExtractorModule(pkb) {}
+        EntityExtractorModule(pkb, "variable extractor") {}
 };
 
 struct ConstCollector : public Collector {
@@ -54,7 +54,7 @@ struct ConstCollector : public Collector {
 
 struct ConstExtractorModule : public EntityExtractorModule<ConstCollector> {
     explicit ConstExtractorModule(PKB *pkb) :
-        EntityExtractorModule(pkb) {}
+        EntityExtractorModule(pkb, "constant extractor") {}
 };
 
 
@@ -66,7 +66,7 @@ struct ProcedureCollector : public Collector {
 
 struct ProcedureExtractorModule : public EntityExtractorModule<ProcedureCollector> {
     explicit ProcedureExtractorModule(PKB *pkb) :
-        EntityExtractorModule(pkb) {}
+        EntityExtractorModule(pkb, "procedure extractor") {}
 };
 
 struct StatementCollector : public Collector {
@@ -97,7 +97,7 @@ struct StatementCollector : public Collector {
 
 struct StatementExtractorModule : public EntityExtractorModule<StatementCollector> {
     explicit StatementExtractorModule(PKB *pkb) :
-        EntityExtractorModule(pkb) {}
+        EntityExtractorModule(pkb, "statement extractor") {}
 };
 
 
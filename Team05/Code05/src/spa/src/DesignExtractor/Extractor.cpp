@@ -1,4 +1,6 @@
+#include <algorithm>
 #include <functional>
+#include <optional>
 #include <variant>
 
 #include "Extractor.h"
@@ -11,6 +13,35 @@ template<class... Ts> overloaded(Ts...) -> overloaded<Ts...>;
 namespace sp {
 namespace design_extractor {
 
+namespace {
+template <typename Iterator>
+cfg::ContentToVarMap groupStatementVariables(Iterator it, Iterator end, PKBRelationship type) {
+    cfg::ContentToVarMap result;
+    for (; it != end; ++it) {
+        auto relationship = std::get_if<Relationship>(&*it);
+        if (relationship == nullptr || std::get<0>(*relationship) != type) {
+            break;
+        }
+        auto& [_, first, second] = *relationship;
+        if (std::holds_alternative<STMT_LO>(first)) {
+            result[first].insert(std::get<VAR_NAME>(second));
+        }
+    }
+    return result;
+}
+}  // namespace
+
+cfg::ContentToVarMap groupStatementVariables(const std::set<Entry>& entries, PKBRelationship type) {
+    // relationships of the same type are contiguous and start after the smallest possible relationship of the type.
+    auto first = entries.lower_bound(Relationship(type, Content{}, Content{}));
+    return groupStatementVariables(first, entries.end(), type);
+}
+
+cfg::ContentToVarMap groupStatementVariables(const std::vector<Entry>& entries, PKBRelationship type) {
+    auto first = std::lower_bound(entries.begin(), entries.end(), Entry(Relationship(type, Content{}, Content{})));
+    return groupStatementVariables(first, entries.end(), type);
+}
+
 void PKBInserter::insert(Entry entry) {
     std::visit(overloaded {
         [&](Entity &item) { pkb->insertEntity(item); },
@@ -23,5 +54,40 @@ void PKBInserter::insert(Entry entry) {
     }, entry);
 }
 
+void PKBInserter::insert(const std::set<Entry>& entries) {
+    insertSorted(entries);
+}
+
+void PKBInserter::insert(const std::vector<Entry>& entries) {
+    insertSorted(entries);
+}
+
+template <typename Entries>
+void PKBInserter::insertSorted(const Entries& entries) {
+    // Entities order before relationships in the set, and relationships of the same type are contiguous.
+    std::optional<PKBRelationship> currentType;
+    RelationshipRows rows;
+    auto flush = [&]() {
+        if (currentType.has_value() && !rows.empty()) {
+            pkb->bulkInsertRelationships(currentType.value(), std::move(rows));
+        }
+        rows.clear();
+    };
+
+    for (auto &entry : entries) {
+        if (auto entity = std::get_if<Entity>(&entry)) {
+            pkb->insertEntity(*entity);
+            continue;
+        }
+        auto& [type, first, second] = std::get<Relationship>(entry);
+        if (currentType != type) {
+            flush();
+            currentType = type;
+        }
+        rows.emplace_back(first, second);
+    }
+    flush();
+}
+
 }  // namespace design_extractor
 }  // namespace sp
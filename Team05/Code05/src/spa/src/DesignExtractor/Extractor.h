@@ -1,9 +1,12 @@
 #pragma once
 
 #include <set>
+#include <string>
+#include <vector>
 
 #include "DesignExtractor/CFG/CFG.h"
 #include "Parser/AST.h"
+#include "PhaseProfile.h"
 #include "PKB.h"
 #include "TreeWalker.h"
 
@@ -27,7 +30,7 @@ class Collector : public TreeWalker {
 protected:
     std::set<Entry> entries;
 public:
-    const std::set<Entry> getEntries() { return entries; }
+    const std::set<Entry>& getEntries() const { return entries; }
 };
 
 /**
@@ -43,6 +46,24 @@ struct Extractor {
     virtual inline ~Extractor() {}
 };
 
+/**
+ * @brief Groups the Modifies or Uses relationships of the statements in an extraction result by statement, which is
+ * how the CFG nodes are annotated.
+ * 
+ * @param entries an extraction result holding the Modifies and Uses relationships
+ * @param type either PKBRelationship::MODIFIES or PKBRelationship::USES
+ * @return cfg::ContentToVarMap the variables of each statement
+ */
+cfg::ContentToVarMap groupStatementVariables(const std::set<Entry>& entries, PKBRelationship type);
+
+/**
+ * @brief Groups the Modifies or Uses relationships of the statements in a sorted extraction result by statement.
+ *
+ * @param entries an extraction result holding the Modifies and Uses relationships, sorted and unique
+ * @param type either PKBRelationship::MODIFIES or PKBRelationship::USES
+ */
+cfg::ContentToVarMap groupStatementVariables(const std::vector<Entry>& entries, PKBRelationship type);
+
 /**
  * @brief Define the ways to insert a single entry into the PKB
  */
@@ -52,6 +73,25 @@ private:
 public:
     explicit PKBInserter(PKB *pkb) : pkb(pkb) {}
     void insert(Entry entry);
+
+    /**
+     * @brief Inserts a whole extraction result. Entities are inserted one by one, while the relationships of
+     * each type are handed to the PKB in a single bulk load as they are already valid.
+     * 
+     * @param entries the entries to insert, in their set order.
+     */
+    void insert(const std::set<Entry>& entries);
+
+    /**
+     * @brief Inserts a whole extraction result, like insert(const std::set<Entry>&).
+     *
+     * @param entries the entries to insert, sorted and unique.
+     */
+    void insert(const std::vector<Entry>& entries);
+
+private:
+    template <typename Entries>
+    void insertSorted(const Entries& entries);
 };
 
 /**
@@ -64,15 +104,22 @@ class ExtractorModule {
 private:
     std::unique_ptr<Extractor<T>> extractor;
     PKBInserter inserter;
+    std::string name;
 public:
-    ExtractorModule(std::unique_ptr<Extractor<T>> extractor, PKB *pkb) : 
-        extractor(std::move(extractor)), inserter(pkb) {}
-    void extract(T info) {
-        auto entries = extractor->extract(info);
-        for (auto &entry : entries) {
-            inserter.insert(entry);
-        }
+    ExtractorModule(std::unique_ptr<Extractor<T>> extractor, PKB *pkb, std::string name) : 
+        extractor(std::move(extractor)), inserter(pkb), name(std::move(name)) {}
+    /**
+     * @param profile if given, the time taken by the extraction is added to the phase named after the module,
+     * and the time taken by the insertion to the "pkb load" phase.
+     * @return the extracted entries, for the extraction steps that build on them.
+     */
+    std::set<Entry> extract(T info, PhaseProfile* profile = nullptr) {
+        auto entries = PhaseProfile::time(profile, name, [&]() { return extractor->extract(info); });
+        PhaseProfile::time(profile, "pkb load", [&]() { inserter.insert(entries); });
+        return entries;
     }
+
+    const std::string& getName() const { return name; }
 };
 
 
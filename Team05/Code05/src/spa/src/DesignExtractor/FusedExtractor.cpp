@@ -0,0 +1,79 @@
+#include "DesignExtractor/CallGraph.h"
+#include "DesignExtractor/EntityExtractor/EntityExtractor.h"
+#include "DesignExtractor/RelationshipExtractor/RelationshipExtractor.h"
+#include "FusedExtractor.h"
+#include "ThreadPool.h"
+
+namespace sp {
+namespace design_extractor {
+
+ProcedureExtraction extractProcedure(
+    const ast::Procedure* proc,
+    const ProcVarMap& modifiesSummaries,
+    const ProcVarMap& usesSummaries
+) {
+    StatementCollector statements;
+    VariableCollector variables;
+    ConstCollector constants;
+    ProcedureCollector procedures;
+    ModifiesCollector modifies;
+    UsesCollector uses;
+    FollowsCollector follows;
+    ParentCollector parent;
+    CallsCollector calls;
+    modifies.useCalleeSummaries(&modifiesSummaries);
+    uses.useCalleeSummaries(&usesSummaries);
+
+    CollectorMultiplexer multiplexer {
+        &statements, &variables, &constants, &procedures, &modifies, &uses, &follows, &parent, &calls
+    };
+    proc->accept(&multiplexer);
+
+    ProcedureExtraction result;
+    for (const Collector* collector : std::initializer_list<const Collector*> {
+        &statements, &variables, &constants, &procedures, &modifies, &uses, &follows, &parent, &calls
+    }) {
+        result.entries.insert(collector->getEntries().begin(), collector->getEntries().end());
+    }
+    auto procName = PROC_NAME{proc->getName()};
+    if (auto it = modifies.getProcVarMap().find(procName); it != modifies.getProcVarMap().end()) {
+        result.modifiedVars = it->second;
+    }
+    if (auto it = uses.getProcVarMap().find(procName); it != uses.getProcVarMap().end()) {
+        result.usedVars = it->second;
+    }
+    return result;
+}
+
+std::set<Entry> FusedExtractor::extract(const ast::ASTNode* node) {
+    ProcVarMap modifiesSummaries, usesSummaries;
+    std::vector<std::set<Entry>> buffers;
+
+    for (auto& level : CallGraph(node).getReverseTopologicalLevels()) {
+        std::vector<ProcedureExtraction> results(level.size());
+        // the summaries are only read while a level is running and only written in between levels.
+        ThreadPool::shared().parallelFor(level.size(), [&](std::size_t i) {
+            results[i] = extractProcedure(level[i], modifiesSummaries, usesSummaries);
+        });
+        for (std::size_t i = 0; i < level.size(); i++) {
+            auto procName = PROC_NAME{level[i]->getName()};
+            // procedures without any variable are left out, the same as in a sequential walk.
+            if (!results[i].modifiedVars.empty()) {
+                modifiesSummaries[procName] = std::move(results[i].modifiedVars);
+            }
+            if (!results[i].usedVars.empty()) {
+                usesSummaries[procName] = std::move(results[i].usedVars);
+            }
+            buffers.push_back(std::move(results[i].entries));
+        }
+    }
+
+    std::set<Entry> entries;
+    for (auto& buffer : buffers) {
+        entries.merge(buffer);
+    }
+    return entries;
+}
+
+}  // namespace design_extractor
+}  // namespace sp
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <initializer_list>
+#include <vector>
+
+#include "DesignExtractor/Extractor.h"
+#include "DesignExtractor/RelationshipExtractor/TransitiveRelationshipTemplate.h"
+
+namespace sp {
+namespace design_extractor {
+
+/**
+ * @brief A visitor that forwards every callback of a single AST traversal to a list of collectors.
+ * 
+ * Collectors are notified in the order they were given, so each of them observes exactly the same
+ * sequence of nodes as it would when walking the AST on its own.
+ */
+class CollectorMultiplexer : public ast::ASTNodeVisitor {
+private:
+    std::vector<Collector*> collectors;
+public:
+    explicit CollectorMultiplexer(std::initializer_list<Collector*> collectors) : collectors(collectors) {}
+
+    void visit(const ast::Program& node) override { forward(node); }
+    void visit(const ast::Procedure& node) override { forward(node); }
+    void visit(const ast::StmtLst& node) override { forward(node); }
+    void visit(const ast::If& node) override { forward(node); }
+    void visit(const ast::While& node) override { forward(node); }
+    void visit(const ast::Read& node) override { forward(node); }
+    void visit(const ast::Print& node) override { forward(node); }
+    void visit(const ast::Assign& node) override { forward(node); }
+    void visit(const ast::Call& node) override { forward(node); }
+    void visit(const ast::Var& node) override { forward(node); }
+    void visit(const ast::Const& node) override { forward(node); }
+    void visit(const ast::BinExpr& node) override { forward(node); }
+    void visit(const ast::RelExpr& node) override { forward(node); }
+    void visit(const ast::CondBinExpr& node) override { forward(node); }
+    void visit(const ast::NotCondExpr& node) override { forward(node); }
+
+    void enterContainer(std::variant<int, std::string> containerId) override {
+        for (auto collector : collectors) {
+            collector->enterContainer(containerId);
+        }
+    }
+
+    void exitContainer() override {
+        for (auto collector : collectors) {
+            collector->exitContainer();
+        }
+    }
+
+private:
+    template <typename T>
+    void forward(const T& node) {
+        for (auto collector : collectors) {
+            collector->visit(node);
+        }
+    }
+};
+
+/**
+ * @brief The result of walking a single procedure.
+ */
+struct ProcedureExtraction {
+    std::set<Entry> entries;
+    std::set<VAR_NAME> modifiedVars;  // the variables the procedure modifies, directly or through its calls
+    std::set<VAR_NAME> usedVars;  // the variables the procedure uses, directly or through its calls
+};
+
+/**
+ * @brief Extracts every AST based entity and relationship of a single procedure.
+ *
+ * @param modifiesSummaries the variables modified by every procedure the procedure calls
+ * @param usesSummaries the variables used by every procedure the procedure calls
+ */
+ProcedureExtraction extractProcedure(
+    const ast::Procedure* proc,
+    const ProcVarMap& modifiesSummaries,
+    const ProcVarMap& usesSummaries);
+
+/**
+ * @brief Extracts every AST based entity and relationship in a single traversal of the AST.
+ * 
+ * Every procedure is walked once with all the entity, Follows, Parent, Calls, Modifies and Uses collectors
+ * attached, each procedure into its own set of collectors. Only the Modifies and Uses of call statements depend
+ * on other procedures, so the procedures are grouped into the levels of the call graph: the procedures of a level
+ * are extracted in parallel on the shared thread pool, and the variables of their procedures are published to the
+ * next level once the whole level is done. The per procedure entries are merged at the end.
+ */
+class FusedExtractor : public Extractor<const ast::ASTNode*> {
+public:
+    std::set<Entry> extract(const ast::ASTNode* node) override;
+};
+
+/**
+ * Extracts all AST based entities and relationships in one pass and send them to the PKB
+ */
+class FusedExtractorModule : public ExtractorModule<const ast::ASTNode*> {
+public:
+    explicit FusedExtractorModule(PKB *pkb) :
+        ExtractorModule(std::make_unique<FusedExtractor>(), pkb, "fused extractor") {}
+};
+
+}  // namespace design_extractor
+}  // namespace sp
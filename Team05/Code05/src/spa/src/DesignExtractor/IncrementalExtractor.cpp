@@ -0,0 +1,280 @@
+#include <algorithm>
+#include <cstring>
+#include <unordered_set>
+#include <utility>
+
+#include "DesignExtractor/CallGraph.h"
+#include "DesignExtractor/FusedExtractor.h"
+#include "DesignExtractor/IncrementalExtractor.h"
+#include "DesignExtractor/RelationshipExtractor/NextExtractor.h"
+#include "ThreadPool.h"
+
+namespace sp {
+namespace design_extractor {
+namespace {
+/**
+ * Encodes a procedure with its statements numbered from 0, so that two versions of a procedure have the same
+ * fingerprint exactly when they only differ in where the procedure starts.
+ */
+class Fingerprinter : public TreeWalker {
+public:
+    std::string fingerprint;
+    int firstStmtNo = -1;
+
+    void visit(const ast::Procedure& node) override {
+        fingerprint += 'P';
+        appendName(node.getName());
+    }
+    void visit(const ast::StmtLst& node) override {
+        fingerprint += 'L';
+        appendValue(node.size());
+    }
+    void visit(const ast::If& node) override { appendStatement('I', node); }
+    void visit(const ast::While& node) override { appendStatement('W', node); }
+    void visit(const ast::Read& node) override { appendStatement('R', node); }
+    void visit(const ast::Print& node) override { appendStatement('O', node); }
+    void visit(const ast::Assign& node) override { appendStatement('A', node); }
+    void visit(const ast::Call& node) override {
+        appendStatement('C', node);
+        appendName(node.getName());
+    }
+    void visit(const ast::Var& node) override {
+        fingerprint += 'v';
+        appendName(node.getVarName());
+    }
+    void visit(const ast::Const& node) override {
+        fingerprint += 'c';
+        appendValue(node.getConstValue());
+    }
+    void visit(const ast::BinExpr& node) override {
+        fingerprint += 'b';
+        appendValue(node.getOp());
+    }
+    void visit(const ast::RelExpr& node) override {
+        fingerprint += 'r';
+        appendValue(node.getOp());
+    }
+    void visit(const ast::CondBinExpr& node) override {
+        fingerprint += 'o';
+        appendValue(node.getOp());
+    }
+    void visit(const ast::NotCondExpr&) override {
+        fingerprint += '!';
+    }
+
+private:
+    template <typename T>
+    void appendValue(T value) {
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        fingerprint.append(bytes, sizeof(T));
+    }
+
+    void appendName(const std::string& name) {
+        appendValue(name.size());
+        fingerprint += name;
+    }
+
+    void appendStatement(char tag, const ast::Statement& node) {
+        // statements are numbered in the order they are visited, so the first one has the smallest number.
+        if (firstStmtNo == -1) {
+            firstStmtNo = node.getStmtNo();
+        }
+        fingerprint += tag;
+        appendValue(node.getStmtNo() - firstStmtNo);
+    }
+};
+
+void shift(Content& content, int delta) {
+    if (auto stmt = std::get_if<STMT_LO>(&content)) {
+        stmt->statementNum += delta;
+    }
+}
+
+void shift(std::vector<Entry>& entries, int delta) {
+    for (auto& entry : entries) {
+        if (auto entity = std::get_if<Entity>(&entry)) {
+            shift(*entity, delta);
+        } else {
+            auto& [_, first, second] = std::get<Relationship>(entry);
+            shift(first, delta);
+            shift(second, delta);
+        }
+    }
+}
+
+/**
+ * Merges sorted runs of entries into a single sorted run without duplicates.
+ */
+std::vector<Entry> mergeRuns(const std::vector<const std::vector<Entry>*>& runs) {
+    std::vector<Entry> merged;
+    std::size_t size = 0;
+    for (auto run : runs) {
+        size += run->size();
+    }
+    merged.reserve(size);
+    std::vector<std::size_t> bounds { 0 };
+    for (auto run : runs) {
+        merged.insert(merged.end(), run->begin(), run->end());
+        bounds.push_back(merged.size());
+    }
+    // every run is already sorted, so they are merged pairwise instead of sorting everything again.
+    while (bounds.size() > 2) {
+        std::vector<std::size_t> next { 0 };
+        for (std::size_t i = 2; i < bounds.size(); i += 2) {
+            std::inplace_merge(merged.begin() + bounds[i - 2], merged.begin() + bounds[i - 1],
+                merged.begin() + bounds[i]);
+            next.push_back(bounds[i]);
+        }
+        if (bounds.size() % 2 == 0) {
+            next.push_back(bounds.back());
+        }
+        bounds = std::move(next);
+    }
+    merged.erase(std::unique(merged.begin(), merged.end()), merged.end());
+    return merged;
+}
+}  // namespace
+
+void IncrementalExtractor::ProcedureState::moveTo(int newOffset) {
+    int delta = newOffset - offset;
+    if (delta == 0) {
+        return;
+    }
+    // adding the same amount to every statement number keeps the entries sorted.
+    shift(entries, delta);
+    if (nextEntries) {
+        shift(*nextEntries, delta);
+    }
+    for (auto& node : cfgNodes) {
+        if (node->stmt) {
+            node->stmt->statementNum += delta;
+        }
+    }
+    offset = newOffset;
+}
+
+void IncrementalExtractor::extract(const ast::Program* program, PKB* pkb, PhaseProfile* profile) {
+    auto& procs = program->getProcedures();
+    std::vector<Fingerprinter> fingerprints(procs.size());
+    std::unordered_map<std::string, std::size_t> indexOf;
+    PhaseProfile::time(profile, "diff", [&]() {
+        ThreadPool::shared().parallelFor(procs.size(), [&](std::size_t i) {
+            procs[i]->accept(&fingerprints[i]);
+        });
+    });
+    for (std::size_t i = 0; i < procs.size(); i++) {
+        indexOf.emplace(procs[i]->getName(), i);
+    }
+
+    std::unordered_map<std::string, ProcedureState> states;
+    extractedProcedures.clear();
+    PhaseProfile::time(profile, "fused extractor", [&]() {
+        CallGraph callGraph(program);
+        auto calls = callGraph.getCallGraph();
+        // the procedures whose variables differ from the previous version, which their callers depend on
+        std::unordered_set<std::string> changedSummaries;
+        ProcVarMap modifiesSummaries, usesSummaries;
+
+        for (auto& level : callGraph.getReverseTopologicalLevels()) {
+            std::vector<const ast::Procedure*> changed;
+            for (auto proc : level) {
+                auto& shape = fingerprints[indexOf.at(proc->getName())];
+                auto previous = procedures.find(proc->getName());
+                bool isSameShape = previous != procedures.end() && previous->second.fingerprint == shape.fingerprint;
+                bool hasChangedCallee = std::any_of(calls[proc->getName()].begin(), calls[proc->getName()].end(),
+                    [&](const std::string& callee) { return changedSummaries.count(callee) > 0; });
+
+                ProcedureState& state = states[proc->getName()];
+                if (isSameShape && !hasChangedCallee) {
+                    state = std::move(previous->second);
+                } else {
+                    state.fingerprint = shape.fingerprint;
+                    state.offset = shape.firstStmtNo - 1;
+                    if (isSameShape) {
+                        // Next only depends on the procedure itself.
+                        state.offset = previous->second.offset;
+                        state.nextEntries = std::move(previous->second.nextEntries);
+                    }
+                    changed.push_back(proc);
+                }
+                state.moveTo(shape.firstStmtNo - 1);
+            }
+
+            // the summaries are only read while a level is running and only written in between levels.
+            std::vector<ProcedureExtraction> results(changed.size());
+            ThreadPool::shared().parallelFor(changed.size(), [&](std::size_t i) {
+                results[i] = extractProcedure(changed[i], modifiesSummaries, usesSummaries);
+            });
+            for (std::size_t i = 0; i < changed.size(); i++) {
+                std::string name = changed[i]->getName();
+                auto& state = states.at(name);
+                auto previous = procedures.find(name);
+                if (previous == procedures.end() || previous->second.modifiedVars != results[i].modifiedVars ||
+                    previous->second.usedVars != results[i].usedVars) {
+                    changedSummaries.insert(name);
+                }
+                state.entries.assign(results[i].entries.begin(), results[i].entries.end());
+                state.modifiedVars = std::move(results[i].modifiedVars);
+                state.usedVars = std::move(results[i].usedVars);
+                extractedProcedures.push_back(name);
+            }
+            for (auto proc : level) {
+                auto& state = states.at(proc->getName());
+                // procedures without any variable are left out, the same as in the FusedExtractor.
+                if (!state.modifiedVars.empty()) {
+                    modifiesSummaries[PROC_NAME{proc->getName()}] = state.modifiedVars;
+                }
+                if (!state.usedVars.empty()) {
+                    usesSummaries[PROC_NAME{proc->getName()}] = state.usedVars;
+                }
+            }
+        }
+    });
+
+    cfg::CFG cfgContainer = PhaseProfile::time(profile, "cfg", [&]() {
+        ThreadPool::shared().parallelFor(extractedProcedures.size(), [&](std::size_t i) {
+            auto& state = states.at(extractedProcedures[i]);
+            std::tie(state.cfgRoot, state.cfgNodes) = cfg::CFGExtractor::extractProcedure(
+                *procs[indexOf.at(extractedProcedures[i])],
+                std::make_shared<const cfg::ContentToVarMap>(
+                    groupStatementVariables(state.entries, PKBRelationship::MODIFIES)),
+                std::make_shared<const cfg::ContentToVarMap>(
+                    groupStatementVariables(state.entries, PKBRelationship::USES)));
+        });
+        cfg::NODE_LIST nodes;
+        cfg::PROC_CFG_MAP cfgs;
+        for (auto& [name, state] : states) {
+            nodes.insert(nodes.end(), state.cfgNodes.begin(), state.cfgNodes.end());
+            cfgs.emplace(name, state.cfgRoot);
+        }
+        return cfg::CFG(nodes, cfgs);
+    });
+
+    PhaseProfile::time(profile, "next extractor", [&]() {
+        auto& blocks = cfgContainer.blocks->getProcedures();
+        ThreadPool::shared().parallelFor(blocks.size(), [&](std::size_t i) {
+            auto& state = states.at(blocks[i].getName());
+            if (!state.nextEntries) {
+                auto entries = NextExtractor().extractOne(blocks[i]);
+                state.nextEntries.emplace(entries.begin(), entries.end());
+            }
+        });
+    });
+
+    PhaseProfile::time(profile, "pkb load", [&]() {
+        std::vector<const std::vector<Entry>*> runs;
+        for (auto& proc : procs) {
+            auto& state = states.at(proc->getName());
+            runs.push_back(&state.entries);
+            runs.push_back(&*state.nextEntries);
+        }
+        PKBInserter(pkb).insert(mergeRuns(runs));
+        pkb->insertCFG(cfgContainer);
+    });
+
+    // procedures that are gone are dropped with the rest of the previous version.
+    procedures = std::move(states);
+}
+}  // namespace design_extractor
+}  // namespace sp
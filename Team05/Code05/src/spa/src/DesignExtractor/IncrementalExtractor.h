@@ -0,0 +1,74 @@
+#pragma once
+
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "DesignExtractor/CFG/CFG.h"
+#include "DesignExtractor/Extractor.h"
+#include "Parser/AST.h"
+#include "PhaseProfile.h"
+#include "PKB.h"
+
+namespace sp {
+namespace design_extractor {
+/**
+ * @brief Extracts the design abstractions of successive versions of a program, e.g. as it is being edited, reusing
+ * what was extracted for the procedures that did not change.
+ *
+ * Procedures are matched by name, and a procedure is unchanged if its AST is the same up to the numbering of its
+ * statements. Follows, Parent, Next and the CFG of a procedure only depend on the procedure itself. Its Modifies
+ * and Uses also depend on the procedures it calls, so a procedure is extracted again if the variables modified or
+ * used by any of its callees changed, which only walks up the paths of the call graph from the edited procedures.
+ * Whatever is reused is renumbered if the statements of the procedures before it grew or shrank.
+ *
+ * Example Usage:
+ * IncrementalExtractor extractor;
+ * extractor.extract(firstVersion.get(), &firstPkb);
+ * extractor.extract(secondVersion.get(), &secondPkb);  // only extracts what differs from firstVersion
+ */
+class IncrementalExtractor {
+public:
+    /**
+     * @brief Extracts every design abstraction of the program into the PKB together with its CFG, the same as
+     * DesignExtractor::extract, and keeps what was extracted for the next version of the program.
+     *
+     * @param profile if given, records the time taken to compare the procedures against the previous version,
+     * by the extractors, by building the CFG and by loading the results into the PKB.
+     */
+    void extract(const ast::Program* program, PKB* pkb, PhaseProfile* profile = nullptr);
+
+    /**
+     * @return the procedures whose Modifies and Uses were extracted again by the last call to extract, in the order
+     * they were extracted.
+     */
+    const std::vector<std::string>& getExtractedProcedures() const { return extractedProcedures; }
+
+private:
+    /**
+     * What was extracted from a single procedure, with the statements numbered as in the version of the program it
+     * was last used in.
+     */
+    struct ProcedureState {
+        std::string fingerprint;
+        int offset = 0;  // the number of statements before the procedure
+        std::vector<Entry> entries;  // sorted and unique
+        std::set<VAR_NAME> modifiedVars;
+        std::set<VAR_NAME> usedVars;
+        std::optional<std::vector<Entry>> nextEntries;  // sorted and unique, once the flat CFG is built
+        std::shared_ptr<cfg::CFGNode> cfgRoot;
+        cfg::NODE_LIST cfgNodes;
+
+        /**
+         * Renumbers the statements of everything extracted for the procedure.
+         */
+        void moveTo(int newOffset);
+    };
+
+    std::unordered_map<std::string, ProcedureState> procedures;
+    std::vector<std::string> extractedProcedures;
+};
+}  // namespace design_extractor
+}  // namespace sp
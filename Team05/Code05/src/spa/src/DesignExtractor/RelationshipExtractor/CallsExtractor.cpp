@@ -4,17 +4,6 @@
 namespace sp {
 namespace design_extractor {
 
-/**
- * a ASTNodeVisitor that collects the Calls relationship as it walks through the AST.
- */
-class CallsCollector : public Collector {
-private:
-    std::string currentProc = "";
-public:
-    void visit(const ast::Procedure&) override;
-    void visit(const ast::Call&) override;
-};
-
 void CallsCollector::visit(const ast::Procedure& node) {
     currentProc = node.getName();
 }
@@ -1,9 +1,22 @@
 #pragma once
 
+#include <string>
+
 #include "DesignExtractor/Extractor.h"
 
 namespace sp {
 namespace design_extractor {
+/**
+ * a ASTNodeVisitor that collects the Calls relationship as it walks through the AST.
+ */
+class CallsCollector : public Collector {
+private:
+    std::string currentProc = "";
+public:
+    void visit(const ast::Procedure&) override;
+    void visit(const ast::Call&) override;
+};
+
 /**
  * Extracts all Calls relationship from the AST and return them as a set of entries
  */
@@ -17,7 +30,7 @@ struct CallsExtractor : public Extractor<const ast::ASTNode*> {
 struct CallsExtractorModule : public ExtractorModule<const ast::ASTNode*> {
 public:
     explicit CallsExtractorModule(PKB *pkb) : 
-        ExtractorModule(std::make_unique<CallsExtractor>(), pkb) {}
+        ExtractorModule(std::make_unique<CallsExtractor>(), pkb, "calls extractor") {}
 };
 
 }  // namespace design_extractor
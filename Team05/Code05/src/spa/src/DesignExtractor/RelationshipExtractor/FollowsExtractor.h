@@ -40,7 +40,7 @@ public:
 class FollowsExtractorModule : public ExtractorModule<const ast::ASTNode*> {
 public:
     explicit FollowsExtractorModule(PKB *pkb) : 
-        ExtractorModule(std::make_unique<FollowsExtractor>(), pkb) {}
+        ExtractorModule(std::make_unique<FollowsExtractor>(), pkb, "follows extractor") {}
 };
 }  // namespace design_extractor
 }  // namespace sp
@@ -1,23 +1,9 @@
 #include "logging.h"
 #include "ModifiesExtractor.h"
 
-#define DEBUG_LOG Logger(Level::DEBUG) << "ModifiesExtractor.cpp Extracted "
+#define DEBUG_LOG LOG(Level::DEBUG) << "ModifiesExtractor.cpp Extracted "
 namespace sp {
 namespace design_extractor {
-/**
- * a ASTNodeVisitor that collects the Modifies relationship as it walks through the AST.
- */
-class ModifiesCollector : public TransitiveRelationshipTemplate {
-private:
-    void insert(Content, Content);
-public:
-    using TransitiveRelationshipTemplate::TransitiveRelationshipTemplate;
-    void visit(const ast::Read&) override;
-    void visit(const ast::Assign&) override;
-    void visit(const ast::While&) override;
-    void visit(const ast::If&) override;
-};
-
 std::set<Entry> ModifiesExtractor::extract(const ast::ASTNode* node) {
     ModifiesCollector collector;
     collector.extract(node);
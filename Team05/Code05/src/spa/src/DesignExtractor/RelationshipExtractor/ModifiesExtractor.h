@@ -10,6 +10,20 @@
 
 namespace sp {
 namespace design_extractor {
+/**
+ * a ASTNodeVisitor that collects the Modifies relationship as it walks through the AST.
+ */
+class ModifiesCollector : public TransitiveRelationshipTemplate {
+private:
+    void insert(Content, Content);
+public:
+    using TransitiveRelationshipTemplate::TransitiveRelationshipTemplate;
+    void visit(const ast::Read&) override;
+    void visit(const ast::Assign&) override;
+    void visit(const ast::While&) override;
+    void visit(const ast::If&) override;
+};
+
 /**
  * Extracts all Modifies relationship from the AST and return them as a set of entries
  */
@@ -25,7 +39,7 @@ public:
 class ModifiesExtractorModule : public ExtractorModule<const ast::ASTNode*> {
 public:
     explicit ModifiesExtractorModule(PKB *pkb) : 
-        ExtractorModule(std::make_unique<ModifiesExtractor>(), pkb) {}
+        ExtractorModule(std::make_unique<ModifiesExtractor>(), pkb, "modifies extractor") {}
 };
 }  // namespace design_extractor
 }  // namespace sp
@@ -36,7 +36,7 @@ public:
 class ParentExtractorModule : public ExtractorModule<const ast::ASTNode*> {
 public:
     explicit ParentExtractorModule(PKB *pkb) : 
-        ExtractorModule(std::make_unique<ParentExtractor>(), pkb) {}
+        ExtractorModule(std::make_unique<ParentExtractor>(), pkb, "parent extractor") {}
 };
 
 }  // namespace design_extractor
@@ -1,81 +1,52 @@
 #include "DesignExtractor/CallGraph.h"
-#include "DesignExtractor/EntityExtractor/EntityExtractor.h"
 #include "TransitiveRelationshipTemplate.h"
 
 namespace sp {
 namespace design_extractor {
 
-struct CallGraphPreProcessor {
-    std::vector<std::string> topolst;
-    std::unordered_map<std::string, const ast::Procedure*> procMap;
-    void processReverseTopoOrder(
-        std::string node, 
-        const CallGraph::AdjacencyList& lst,
-        std::map<std::string, bool>& visited
-    ) {
-        if (visited[node]) {
-            return;
-        }
-        visited.insert_or_assign(node, true);
-
-        if (lst.find(node) != lst.end()) {
-            for (auto m : lst.at(node)) {
-                processReverseTopoOrder(m, lst, visited);
-            }
-        }
-
-        topolst.push_back(node);
-    }
-
-    void preprocess(const ast::ASTNode *node) {
-        CallGraph grapher(node);
-        
-        std::map<std::string, bool> visited;
-        processReverseTopoOrder("1", grapher.getCallGraph(), visited);
-
-        // remove the place holder 
-        topolst.pop_back();
-
-        procMap = grapher.getProcMap();
+/**
+ * Collects the names of all variables in a subtree directly, without going through Entry.
+ */
+struct VarNameCollector : public TreeWalker {
+    std::set<VAR_NAME> vars;
+    void visit(const ast::Var& node) override {
+        vars.insert(VAR_NAME{node.getVarName()});
     }
 };
 
-
 std::set<VAR_NAME> RelExtractorTemplate::extractVars(const ast::ASTNode *part) {
-    EntityExtractor<VariableCollector> ve;
-    auto results = ve.extract(part);
-    std::set<VAR_NAME> vars;
-    std::transform(
-        results.begin(),
-        results.end(), 
-        std::inserter(vars, vars.begin()),
-        [](auto entry) {
-            return std::get<VAR_NAME>(std::get<Entity>(entry));
-        }
-    );
-    return vars;
+    VarNameCollector collector;
+    part->accept(&collector);
+    return std::move(collector.vars);
 }
 
 void TransitiveRelationshipTemplate::visit(const ast::Call &node) {
     auto proc = PROC_NAME{node.getName()};
     try {
-        auto vars = procVarMap.at(proc);
+        auto& vars = getProcVars(proc);
         for (auto var : vars) {
             insert(STMT_LO{node.getStmtNo(), StatementType::Call}, var);
         }
         cascadeToContainer(vars);
     } catch (std::out_of_range &ex) {
         // if out of range exception thrown by at, that means something wrong with topo ordering.
-        Logger(Level::ERROR) << "TransitiveRelationshipTemplate.cpp " << 
+        LOG(Level::ERROR) << "TransitiveRelationshipTemplate.cpp " << 
         "empty proc at target " << proc.name << " something wrong with topo order";
     }
 }
 
+const std::set<VAR_NAME>& TransitiveRelationshipTemplate::getProcVars(const PROC_NAME &proc) const {
+    if (calleeSummaries) {
+        if (auto it = calleeSummaries->find(proc); it != calleeSummaries->end()) {
+            return it->second;
+        }
+    }
+    return procVarMap.at(proc);
+}
+
 void TransitiveRelationshipTemplate::extract(const ast::ASTNode *node) {
-    CallGraphPreProcessor cgpp;
-    cgpp.preprocess(node);
-    for (auto proc : cgpp.topolst) {
-        cgpp.procMap[proc]->accept(this);
+    for (auto proc : CallGraph(node).getReverseTopologicalOrder()) {
+        proc->accept(this);
     }
 }
 
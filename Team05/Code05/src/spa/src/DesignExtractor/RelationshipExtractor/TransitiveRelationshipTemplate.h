@@ -12,6 +12,9 @@
 
 namespace sp {
 namespace design_extractor {
+// The variables related to each procedure, including those through the procedures it calls.
+using ProcVarMap = std::map<PROC_NAME, std::set<VAR_NAME>>;
+
 class RelExtractorTemplate : public Collector {
 protected:
     virtual void extractAndInsert(Content, const ast::ASTNode*) = 0;
@@ -45,6 +48,19 @@ public:
      */
     void extract(const ast::ASTNode *node);
 
+    /**
+     * @brief Supplies the variables of procedures extracted by other collectors, so that a single procedure can be
+     * walked on its own once all of its callees are done.
+     * 
+     * @param summaries the procedure variables of the callees, which must outlive this collector.
+     */
+    void useCalleeSummaries(const ProcVarMap *summaries) { calleeSummaries = summaries; }
+
+    /**
+     * @return the variables of every procedure walked by this collector.
+     */
+    const ProcVarMap& getProcVarMap() const { return procVarMap; }
+
 protected:
     std::map<int, StatementType> stmtNumToType;
 
@@ -54,7 +70,10 @@ protected:
 private:
     std::deque<STMT_LO> container;
     PROC_NAME currentProcedure = PROC_NAME{ "" };
-    std::map<PROC_NAME, std::set<VAR_NAME>> procVarMap;
+    ProcVarMap procVarMap;
+    const ProcVarMap *calleeSummaries = nullptr;
+
+    const std::set<VAR_NAME>& getProcVars(const PROC_NAME&) const;
 
     void enterContainer(std::variant<int, std::string>) override;
     void exitContainer() override;
@@ -1,24 +1,10 @@
 #include "logging.h"
 #include "UsesExtractor.h"
 
-#define DEBUG_LOG Logger(Level::DEBUG) << "UsesExtractor.cpp Extracted "
+#define DEBUG_LOG LOG(Level::DEBUG) << "UsesExtractor.cpp Extracted "
 
 namespace sp {
 namespace design_extractor {
-/**
- * a ASTNodeVisitor that collects the Follows relationship as it walks through the AST.
- */
-class UsesCollector : public TransitiveRelationshipTemplate {
-private:
-    void insert(Content, Content);
-public:
-    using TransitiveRelationshipTemplate::TransitiveRelationshipTemplate;
-    void visit(const ast::Print&) override;
-    void visit(const ast::Assign&) override;
-    void visit(const ast::While&) override;
-    void visit(const ast::If&) override;
-};
-
 std::set<Entry> UsesExtractor::extract(const ast::ASTNode* node) {
     UsesCollector collector;
     collector.extract(node);
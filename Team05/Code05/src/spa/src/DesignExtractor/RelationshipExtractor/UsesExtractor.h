@@ -12,6 +12,20 @@
 
 namespace sp {
 namespace design_extractor {
+/**
+ * a ASTNodeVisitor that collects the Follows relationship as it walks through the AST.
+ */
+class UsesCollector : public TransitiveRelationshipTemplate {
+private:
+    void insert(Content, Content);
+public:
+    using TransitiveRelationshipTemplate::TransitiveRelationshipTemplate;
+    void visit(const ast::Print&) override;
+    void visit(const ast::Assign&) override;
+    void visit(const ast::While&) override;
+    void visit(const ast::If&) override;
+};
+
 /**
  * Extracts all Uses relationship from the AST and return them as a set of entries
  */
@@ -27,7 +41,7 @@ public:
 class UsesExtractorModule : public ExtractorModule<const ast::ASTNode*> {
 public:
     explicit UsesExtractorModule(PKB *pkb) : 
-        ExtractorModule(std::make_unique<UsesExtractor>(), pkb) {}
+        ExtractorModule(std::make_unique<UsesExtractor>(), pkb, "uses extractor") {}
 };
 
 }  // namespace design_extractor
@@ -0,0 +1,206 @@
+/*
+ * Accounting of the memory held by the PKB, the AST, the CFG and the intermediate results of queries. The bytes of
+ * a container are worked out from its size and the node layout of the standard library, so that every component
+ * can report what it holds without an allocator of its own.
+ *
+ * Example Usage:
+ * memory::Report report = pkb.getMemoryReport();
+ * report.getBytes("Follows");  // the bytes of the Follows table
+ * report.getTotal();
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "Bitset.h"
+#include "PKB/PKBField.h"
+
+namespace memory {
+// what a node of a hash table adds to its value: the link to the next node and the cached hash.
+inline constexpr std::size_t HASH_NODE_BYTES = sizeof(void*) + sizeof(std::size_t);
+// what a node of a red black tree adds to its value: its colour and its parent, left and right links.
+inline constexpr std::size_t TREE_NODE_BYTES = 4 * sizeof(void*);
+// the control block that std::make_shared allocates next to the object: a vtable and two counts.
+inline constexpr std::size_t SHARED_BLOCK_BYTES = sizeof(void*) + 2 * sizeof(int);
+
+/**
+ * The bytes held by each component of something, e.g. the tables of a PKB, in the order they were first added.
+ */
+class Report {
+public:
+    /**
+     * Adds the bytes to the component, so that the parts of a component can be added one at a time.
+     */
+    void add(const std::string& component, std::size_t bytes) {
+        for (auto& [name, total] : components) {
+            if (name == component) {
+                total += bytes;
+                return;
+            }
+        }
+        components.emplace_back(component, bytes);
+    }
+
+    const std::vector<std::pair<std::string, std::size_t>>& getComponents() const { return components; }
+
+    /**
+     * @return the bytes of the component, or 0 if it was never added.
+     */
+    std::size_t getBytes(const std::string& component) const {
+        for (auto& [name, total] : components) {
+            if (name == component) return total;
+        }
+        return 0;
+    }
+
+    std::size_t getTotal() const {
+        std::size_t total = 0;
+        for (auto& component : components) total += component.second;
+        return total;
+    }
+
+private:
+    std::vector<std::pair<std::string, std::size_t>> components;
+};
+
+/**
+ * @return the bytes that a hash table allocates for its buckets and its nodes, not counting what its values hold.
+ */
+template <typename Container>
+std::size_t hashTableBytes(const Container& container) {
+    return container.bucket_count() * sizeof(void*) +
+        container.size() * (sizeof(typename Container::value_type) + HASH_NODE_BYTES);
+}
+
+/**
+ * @return the bytes that a tree allocates for its nodes, not counting what its values hold.
+ */
+template <typename Container>
+std::size_t treeBytes(const Container& container) {
+    return container.size() * (sizeof(typename Container::value_type) + TREE_NODE_BYTES);
+}
+
+// The bytes that a value holds outside of itself, e.g. the characters of a long string or the elements of a
+// vector. Declared before they are defined so that the containers find the overloads of their values.
+inline std::size_t heapBytes(const std::string& value);
+inline std::size_t heapBytes(const Bitset& value);
+inline std::size_t heapBytes(const STMT_LO& value);
+inline std::size_t heapBytes(const VAR_NAME& value);
+inline std::size_t heapBytes(const PROC_NAME& value);
+inline std::size_t heapBytes(const Content& value);
+inline std::size_t heapBytes(const PKBField& value);
+template <typename T>
+inline std::size_t heapBytes(const std::optional<T>& value);
+template <typename A, typename B>
+inline std::size_t heapBytes(const std::pair<A, B>& value);
+template <typename T, typename Allocator>
+inline std::size_t heapBytes(const std::vector<T, Allocator>& value);
+template <typename T, typename Hash, typename Equal, typename Allocator>
+inline std::size_t heapBytes(const std::unordered_set<T, Hash, Equal, Allocator>& value);
+template <typename K, typename V, typename Hash, typename Equal, typename Allocator>
+inline std::size_t heapBytes(const std::unordered_map<K, V, Hash, Equal, Allocator>& value);
+template <typename T, typename Compare, typename Allocator>
+inline std::size_t heapBytes(const std::set<T, Compare, Allocator>& value);
+template <typename K, typename V, typename Compare, typename Allocator>
+inline std::size_t heapBytes(const std::map<K, V, Compare, Allocator>& value);
+
+/**
+ * Values that hold nothing outside of themselves, e.g. numbers and enums.
+ */
+template <typename T>
+std::enable_if_t<std::is_arithmetic_v<T> || std::is_enum_v<T>, std::size_t> heapBytes(const T&) {
+    return 0;
+}
+
+inline std::size_t heapBytes(const std::string& value) {
+    // short strings are kept inside the string itself.
+    return value.capacity() > std::string().capacity() ? value.capacity() + 1 : 0;
+}
+
+inline std::size_t heapBytes(const Bitset& value) {
+    return value.getWords().capacity() * sizeof(std::uint64_t);
+}
+
+inline std::size_t heapBytes(const STMT_LO& value) {
+    return heapBytes(value.attribute);
+}
+
+inline std::size_t heapBytes(const VAR_NAME& value) {
+    return heapBytes(value.name);
+}
+
+inline std::size_t heapBytes(const PROC_NAME& value) {
+    return heapBytes(value.name);
+}
+
+inline std::size_t heapBytes(const Content& value) {
+    return std::visit([](const auto& content) -> std::size_t {
+        if constexpr (std::is_same_v<std::decay_t<decltype(content)>, std::monostate>) {
+            return 0;
+        } else {
+            return heapBytes(content);
+        }
+    }, value);
+}
+
+inline std::size_t heapBytes(const PKBField& value) {
+    return heapBytes(value.content);
+}
+
+template <typename T>
+std::size_t heapBytes(const std::optional<T>& value) {
+    return value ? heapBytes(*value) : 0;
+}
+
+template <typename A, typename B>
+std::size_t heapBytes(const std::pair<A, B>& value) {
+    return heapBytes(value.first) + heapBytes(value.second);
+}
+
+template <typename T, typename Allocator>
+std::size_t heapBytes(const std::vector<T, Allocator>& value) {
+    std::size_t bytes = value.capacity() * sizeof(T);
+    for (auto& element : value) bytes += heapBytes(element);
+    return bytes;
+}
+
+template <typename T, typename Hash, typename Equal, typename Allocator>
+std::size_t heapBytes(const std::unordered_set<T, Hash, Equal, Allocator>& value) {
+    std::size_t bytes = hashTableBytes(value);
+    for (auto& element : value) bytes += heapBytes(element);
+    return bytes;
+}
+
+template <typename K, typename V, typename Hash, typename Equal, typename Allocator>
+std::size_t heapBytes(const std::unordered_map<K, V, Hash, Equal, Allocator>& value) {
+    std::size_t bytes = hashTableBytes(value);
+    for (auto& [key, mapped] : value) bytes += heapBytes(key) + heapBytes(mapped);
+    return bytes;
+}
+
+template <typename T, typename Compare, typename Allocator>
+std::size_t heapBytes(const std::set<T, Compare, Allocator>& value) {
+    std::size_t bytes = treeBytes(value);
+    for (auto& element : value) bytes += heapBytes(element);
+    return bytes;
+}
+
+template <typename K, typename V, typename Compare, typename Allocator>
+std::size_t heapBytes(const std::map<K, V, Compare, Allocator>& value) {
+    std::size_t bytes = treeBytes(value);
+    for (auto& [key, mapped] : value) bytes += heapBytes(key) + heapBytes(mapped);
+    return bytes;
+}
+}  // namespace memory
@@ -18,137 +18,94 @@ template<class... Ts> overloaded(Ts...)->overloaded<Ts...>;
 class AffectsCacher {
 public:
     /**
-    * Extracts all Affects relationships from the provided CFG
+    * Extracts all Affects relationships from the provided CFG. A call statement stops the walk for every variable
+    * that the summary of the called procedure may modify.
     * 
-    * @param cfgContainer The CFG from which to extract Affects relationships
+    * @param program The basic block CFG from which to extract Affects relationships
+    * @param token if given, checked before walking from every assignment
     * @return A set of pairs of STMT_LOs, representing the result of the extraction
-    * @see CFG
+    * @see ProgramCFG
     */
-    CacheResults evalAffects(const sp::cfg::CFG cfgContainer) {
-        // Initialize visited set for main traversal
-        CfgNodeSet visited;
-
-        // Traverse and extract relationships from each procedure's CFG
-        for (auto varCfgPair : cfgContainer.cfgs) {
-            // Skip first dummy node
-            auto root = varCfgPair.second;
-            if (!root->stmt.has_value() && root->getChildren().size() != 0) {
-                root = root->getChildren().at(0).lock();
+    CacheResults evalAffects(const sp::cfg::ProgramCFG& program, const CancellationToken* token = nullptr) {
+        summaries = &program.getSummaries();
+        for (auto& procedure : program.getProcedures()) {
+            for (std::size_t i = 0; i < procedure.getStmtCount(); i++) {
+                if (procedure.getBlock(i) != -1 && isAssignment(procedure.getStmt(i))) {
+                    CancellationToken::check(token);
+                    extractFrom(procedure, i);
+                }
             }
-
-            extractAndCacheFrom(root, &visited);
         }
         return res;
     }
 
 private:
     CacheResults res;
+    const std::vector<sp::cfg::ProcedureSummary>* summaries = nullptr;
 
-    void extractAndCacheFrom(NodePtr start, CfgNodeSet* visited) {
-        auto curr = start.lock().get();
+    /**
+    * The variables a statement may modify. Calls are resolved through the summary of the called procedure.
+    */
+    const Bitset& getModifies(const sp::cfg::BlockCFG& procedure, sp::cfg::BlockCFG::StmtIndex stmt) const {
+        auto callee = procedure.getCallee(stmt);
+        return callee != -1 ? summaries->at(callee).mayModify : procedure.getModifies(stmt);
+    }
 
-        // Case where node has already been visited
-        if (visited->find(curr) != visited->end()) {
+    /**
+    * Walks the CFG forward from an assignment until every path has modified the assigned variable, recording
+    * every assignment along the way that uses it.
+    */
+    void extractFrom(const sp::cfg::BlockCFG& procedure, sp::cfg::BlockCFG::StmtIndex src) {
+        // Extract variable of interest (i.e. var being modified)
+        const Bitset& voi = procedure.getModifies(src);
+        if (voi.none()) {
             return;
         }
 
-        // Deal with case where node is dummy
-        if (!curr->stmt.has_value()) {
-            // Get children
-            std::vector<NodePtr> children = curr->getChildren();
-            for (auto child : children) {
-                extractAndCacheFrom(child, visited);
-            }
-        } else {
-            // Add to visited list
-            visited->insert(curr);
-
-            // Get statement at curr
-            STMT_LO currStmt = curr->stmt.value();
-
-            // Check type of stmt
-            bool isAssignNode = currStmt.type.value() == StatementType::Assignment;
-
-            // Do secondary traversal if node is assignment statement
-            if (isAssignNode) {
-                // Extract variable of interest (i.e. var being modified)
-                auto voi = curr->modifies;
-
-                // Get children
-                std::vector<NodePtr> nextNodes = curr->getChildren();
-                for (auto nextNode : nextNodes) {
-                    CfgNodeSet secVisited;
-                    walkAndExtract(nextNode, voi, start, &secVisited);
+        // Scans a block from the given position, returning whether the variable of interest was modified in it
+        auto scan = [&](sp::cfg::BlockCFG::BlockId block, std::size_t from) {
+            auto stmts = procedure.getBlockStmts(block);
+            for (std::size_t pos = from; pos < stmts.size(); pos++) {
+                auto curr = stmts.first[pos];
+                if (isAssignment(procedure.getStmt(curr)) && procedure.getUses(curr).intersects(voi)) {
+                    res.insert(std::make_pair(procedure.getStmt(src), procedure.getStmt(curr)));
+                }
+                if (getModifies(procedure, curr).intersects(voi)) {
+                    return true;
                 }
             }
+            return false;
+        };
 
-            // Continue traversal
-            std::vector<NodePtr> children = curr->getChildren();
-            for (auto child : children) {
-                extractAndCacheFrom(child, visited);
-            }
-        }
-    }
-
-    void walkAndExtract(NodePtr curr, std::unordered_set<VAR_NAME> voi, NodePtr src,
-        CfgNodeSet* visited) {
-        // Get children
-        auto children = curr.lock()->getChildren();
-
-        // Check if dummy node
-        if (!curr.lock()->stmt.has_value()) {
-            // If children exist walk them
-            if (children.empty()) {
-                return;
-            }
-            for (auto child : children) {
-                walkAndExtract(child, voi, src, visited);
-            }
+        // The rest of the source's own block comes first, then whole blocks are walked
+        auto srcBlock = procedure.getBlock(src);
+        if (scan(srcBlock, procedure.getPosInBlock(src) + 1)) {
             return;
         }
 
-        // Check for affects relationship
-        STMT_LO currStmt = curr.lock()->stmt.value();
-        bool isAssignNode = currStmt.type.value() == StatementType::Assignment;
-        bool hasRs = false;
-        auto usedVars = curr.lock()->uses;
-        for (auto var : voi) {
-            if (usedVars.find(var) != usedVars.end()) {
-                hasRs = true;
-                break;
+        Bitset visited(procedure.getBlockCount());
+        std::vector<sp::cfg::BlockCFG::BlockId> stack(procedure.getSuccessors(srcBlock).begin(),
+            procedure.getSuccessors(srcBlock).end());
+        while (!stack.empty()) {
+            auto block = stack.back();
+            stack.pop_back();
+            if (visited.test(block)) {
+                continue;
             }
-        }
-        if (hasRs && isAssignNode) {
-            STMT_LO srcStmt = src.lock()->stmt.value();
-            std::pair stmtPair = std::make_pair(srcStmt, currStmt);
-            res.insert(stmtPair);
-        }
-
-        // Check if node modifies voi
-        if (!curr.lock()->modifies.empty()) {
-            auto modVars = curr.lock().get()->modifies;
-            for (auto var : voi) {
-                if (modVars.find(var) != modVars.end()) {
-                    visited->insert(curr.lock().get());
-                    return;
+            visited.set(block);
+            if (scan(block, 0)) {
+                continue;
+            }
+            for (auto next : procedure.getSuccessors(block)) {
+                if (!visited.test(next)) {
+                    stack.push_back(next);
                 }
             }
         }
-
-        // Check if node already visited
-        if (visited->find(curr.lock().get()) != visited->end()) {
-            return;
-        }
-
-        // Update visited list and continue traversal
-        visited->insert(curr.lock().get());
-        for (auto child : children) {
-            walkAndExtract(child, voi, src, visited);
-        }
     }
 
-    bool isAssignment(PKBField field) {
-        return field.getContent<STMT_LO>()->type.value() == StatementType::Assignment;
+    bool isAssignment(const STMT_LO& stmt) {
+        return stmt.type.value() == StatementType::Assignment;
     }
 };
 
@@ -169,12 +126,16 @@ PKB::PKB() {
 
 // INSERT API
 void PKB::insertEntity(Content entity) {
+    if (frozen) {
+        LOG(Level::ERROR) << "PKB.cpp " << "Cannot insert an entity into a frozen PKB";
+        return;
+    }
     std::visit(overloaded{
         [&](VAR_NAME& item) { insertVariable(item); },
         [&](STMT_LO& item) { insertStatement(item); },
         [&](PROC_NAME& item) { insertProcedure(item); },
         [&](CONST& item) { insertConstant(item); },
-        [](auto& item) { Logger(Level::ERROR) << "PKB.cpp " << "Unsupported entity type"; }
+        [](auto& item) { LOG(Level::ERROR) << "PKB.cpp " << "Unsupported entity type"; }
         }, entity);
 }
 
@@ -200,7 +161,7 @@ void PKB::insertAST(std::unique_ptr<sp::ast::Program> root) {
 }
 
 void PKB::insertCFG(const sp::cfg::CFG cfgContainer) {
-    this->cfgContainer = cfgContainer;
+    this->cfg = cfgContainer.blocks;
 }
 
 bool PKB::validate(const PKBField field) const {
@@ -273,9 +234,14 @@ void PKB::appendStatementInformation(PKBField* field) {
 }
 
 void PKB::insertRelationship(PKBRelationship type, PKBField field1, PKBField field2) {
+    if (frozen) {
+        LOG(Level::ERROR) << "PKB.cpp " << "Cannot insert a relationship into a frozen PKB";
+        return;
+    }
+
     // if both fields are not concrete, no insert can be done
     if (field1.fieldType != PKBFieldType::CONCRETE || field2.fieldType != PKBFieldType::CONCRETE) {
-        Logger(Level::INFO) << "Both fields have to be concrete.\n";
+        LOG(Level::INFO) << "Both fields have to be concrete.\n";
         return;
     }
 
@@ -289,6 +255,34 @@ void PKB::insertRelationship(PKBRelationship type, PKBField field1, PKBField fie
     getRelationshipTable(type)->insert(field1, field2);
 }
 
+void PKB::bulkInsertRelationships(PKBRelationship type, RelationshipRows rows) {
+    if (frozen) {
+        LOG(Level::ERROR) << "PKB.cpp " << "Cannot insert relationships into a frozen PKB";
+        return;
+    }
+
+    // Statements are looked up by number in O(1) instead of being validated field by field.
+    auto resolve = [&](Content& content) {
+        if (auto stmt = std::get_if<STMT_LO>(&content)) {
+            content = statementTable->getStmt(stmt->statementNum).value();
+        }
+    };
+    for (auto& [first, second] : rows) {
+        resolve(first);
+        resolve(second);
+    }
+
+    getRelationshipTable(type)->bulkInsert(rows);
+}
+
+void PKB::freeze() {
+    frozen = true;
+}
+
+bool PKB::isFrozen() const {
+    return frozen;
+}
+
 /**
 * Helper method to check whether the given relationship is transitive.
 *
@@ -331,7 +325,7 @@ std::shared_ptr<RelationshipTable> PKB::getRelationshipTable(PKBRelationship rel
     if (search != relationshipTables.end()) {
         return search->second;
     } else {
-        Logger(Level::ERROR) << "No RelationshipTable for the given PKBRelationship";
+        LOG(Level::ERROR) << "No RelationshipTable for the given PKBRelationship";
         throw std::invalid_argument("No RelationshipTable for the given PKBRelationship");
     }
 }
@@ -350,6 +344,12 @@ bool PKB::isRelationshipPresent(PKBField field1, PKBField field2, PKBRelationshi
 
     this->populateAffCache(rs);
 
+    if (rs == PKBRelationship::NEXTT && cfg) {
+        return containsNextT(field1, field2);
+    } else if (rs == PKBRelationship::AFFECTST) {
+        return containsAffectsT(field1, field2);
+    }
+
     auto relationshipTablePtr = getRelationshipTable(rs);
     if (isTransitiveRelationship(rs)) {
         if (rs == PKBRelationship::CALLST) {
@@ -366,7 +366,8 @@ bool PKB::isRelationshipPresent(PKBField field1, PKBField field2, PKBRelationshi
 
 // GET API
 
-PKBResponse PKB::getRelationship(PKBField field1, PKBField field2, PKBRelationship rs) {
+PKBResponse PKB::getRelationship(PKBField field1, PKBField field2, PKBRelationship rs,
+                                 const CancellationToken* token) {
     if (!validate(field1) || !validate(field2)) {
         return PKBResponse{ false, FieldRowResponse{} };
     }
@@ -376,16 +377,20 @@ PKBResponse PKB::getRelationship(PKBField field1, PKBField field2, PKBRelationsh
 
     FieldRowResponse extracted;
 
-    this->populateAffCache(rs);
+    this->populateAffCache(rs, token);
 
     auto relationshipTablePtr = getRelationshipTable(rs);
-    if (isTransitiveRelationship(rs)) {
+    if (rs == PKBRelationship::NEXTT && cfg) {
+        extracted = retrieveNextT(field1, field2, token);
+    } else if (rs == PKBRelationship::AFFECTST) {
+        extracted = retrieveAffectsT(field1, field2, token);
+    } else if (isTransitiveRelationship(rs)) {
         if (rs == PKBRelationship::CALLST) {
             extracted = std::dynamic_pointer_cast<TransitiveRelationshipTable<PROC_NAME>>(relationshipTablePtr)->
-                retrieveT(field1, field2);
+                retrieveT(field1, field2, token);
         } else {
             extracted = std::dynamic_pointer_cast<TransitiveRelationshipTable<STMT_LO>>(relationshipTablePtr)->
-                retrieveT(field1, field2);
+                retrieveT(field1, field2, token);
         }
     } else {
         extracted = relationshipTablePtr->retrieve(field1, field2);
@@ -396,6 +401,144 @@ PKBResponse PKB::getRelationship(PKBField field1, PKBField field2, PKBRelationsh
     : PKBResponse{ false, Response{extracted} };
 }
 
+/**
+* Helper method to check whether a statement matches a statement declaration or wildcard.
+*
+* @param stmt the statement to check
+* @param field a declaration or wildcard of statements
+* @return bool
+*/
+bool matchesStatementType(const STMT_LO& stmt, const PKBField& field) {
+    if (field.fieldType == PKBFieldType::WILDCARD || !field.statementType.has_value()) {
+        return true;
+    }
+    auto type = field.statementType.value();
+    return type == StatementType::All || stmt.type.value() == type;
+}
+
+bool PKB::containsNextT(PKBField field1, PKBField field2) const {
+    if (field1.entityType != PKBEntityType::STATEMENT || field2.entityType != PKBEntityType::STATEMENT) {
+        return false;
+    }
+    auto [procedure, from] = cfg->locate(field1.getContent<STMT_LO>()->statementNum);
+    auto to = procedure ? procedure->indexOf(field2.getContent<STMT_LO>()->statementNum) : -1;
+    return procedure && from != -1 && to != -1 && procedure->isReachable(from, to);
+}
+
+FieldRowResponse PKB::retrieveNextT(PKBField field1, PKBField field2, const CancellationToken* token) const {
+    FieldRowResponse res;
+    if (field1.entityType != PKBEntityType::STATEMENT || field2.entityType != PKBEntityType::STATEMENT) {
+        return res;
+    }
+
+    bool isConcreteFirst = field1.fieldType == PKBFieldType::CONCRETE;
+    bool isConcreteSec = field2.fieldType == PKBFieldType::CONCRETE;
+    if (isConcreteFirst && isConcreteSec) {
+        if (containsNextT(field1, field2)) {
+            res.insert({ field1, field2 });
+        }
+        return res;
+    }
+
+    if (isConcreteFirst) {
+        auto [procedure, from] = cfg->locate(field1.getContent<STMT_LO>()->statementNum);
+        if (procedure) {
+            procedure->getReachableFrom(from).forEach([&, procedure = procedure](std::size_t to) {
+                auto& stmt = procedure->getStmt(to);
+                if (matchesStatementType(stmt, field2)) {
+                    res.insert({ field1, PKBField::createConcrete(Content{ stmt }) });
+                }
+            });
+        }
+        return res;
+    }
+
+    if (isConcreteSec) {
+        auto [procedure, to] = cfg->locate(field2.getContent<STMT_LO>()->statementNum);
+        if (procedure) {
+            procedure->getReaching(to).forEach([&, procedure = procedure](std::size_t from) {
+                auto& stmt = procedure->getStmt(from);
+                if (matchesStatementType(stmt, field1)) {
+                    res.insert({ PKBField::createConcrete(Content{ stmt }), field2 });
+                }
+            });
+        }
+        return res;
+    }
+
+    // the blocks reachable from a block are shared by all of its statements, so they are computed once per block.
+    for (auto& procedure : cfg->getProcedures()) {
+        std::vector<std::optional<Bitset>> reachableBlocks(procedure.getBlockCount());
+        for (std::size_t from = 0; from < procedure.getStmtCount(); from++) {
+            CancellationToken::check(token);
+            auto block = procedure.getBlock(from);
+            if (block == -1 || !matchesStatementType(procedure.getStmt(from), field1)) {
+                continue;
+            }
+            if (!reachableBlocks[block].has_value()) {
+                reachableBlocks[block] = procedure.getBlocksReachableFrom(block);
+            }
+            auto first = PKBField::createConcrete(Content{ procedure.getStmt(from) });
+            procedure.getReachableFrom(from, reachableBlocks[block].value()).forEach([&](std::size_t to) {
+                auto& stmt = procedure.getStmt(to);
+                if (matchesStatementType(stmt, field2)) {
+                    res.insert({ first, PKBField::createConcrete(Content{ stmt }) });
+                }
+            });
+        }
+    }
+    return res;
+}
+
+bool PKB::containsAffectsT(PKBField field1, PKBField field2) const {
+    if (field1.entityType != PKBEntityType::STATEMENT || field2.entityType != PKBEntityType::STATEMENT) {
+        return false;
+    }
+    return affectsClosure.contains(field1.getContent<STMT_LO>()->statementNum,
+        field2.getContent<STMT_LO>()->statementNum);
+}
+
+FieldRowResponse PKB::retrieveAffectsT(PKBField field1, PKBField field2, const CancellationToken* token) const {
+    FieldRowResponse res;
+    if (field1.entityType != PKBEntityType::STATEMENT || field2.entityType != PKBEntityType::STATEMENT) {
+        return res;
+    }
+
+    bool isConcreteFirst = field1.fieldType == PKBFieldType::CONCRETE;
+    bool isConcreteSec = field2.fieldType == PKBFieldType::CONCRETE;
+    if (isConcreteFirst && isConcreteSec) {
+        if (containsAffectsT(field1, field2)) {
+            res.insert({ field1, field2 });
+        }
+    } else if (isConcreteFirst) {
+        affectsClosure.forEachReachable(field1.getContent<STMT_LO>()->statementNum, [&](const STMT_LO& stmt) {
+            if (matchesStatementType(stmt, field2)) {
+                res.insert({ field1, PKBField::createConcrete(Content{ stmt }) });
+            }
+        });
+    } else if (isConcreteSec) {
+        affectsClosure.forEachReaching(field2.getContent<STMT_LO>()->statementNum, [&](const STMT_LO& stmt) {
+            if (matchesStatementType(stmt, field1)) {
+                res.insert({ PKBField::createConcrete(Content{ stmt }), field2 });
+            }
+        });
+    } else {
+        affectsClosure.forEachSource([&](const STMT_LO& from) {
+            CancellationToken::check(token);
+            if (!matchesStatementType(from, field1)) {
+                return;
+            }
+            auto first = PKBField::createConcrete(Content{ from });
+            affectsClosure.forEachReachable(from.statementNum, [&](const STMT_LO& to) {
+                if (matchesStatementType(to, field2)) {
+                    res.insert({ first, PKBField::createConcrete(Content{ to }) });
+                }
+            });
+        });
+    }
+    return res;
+}
+
 /**
 * Helper method to convert a vector of PKBDataTypes into a PKBResponse.
 *
@@ -443,7 +586,7 @@ PKBResponse PKB::match(StatementType type, sp::design_extractor::PatternParam lh
     case StatementType::While:
         return match<sp::ast::While>(lhs, rhs);
     default:
-        Logger(Level::ERROR) << "No pattern matching available for the provided statement type.";
+        LOG(Level::ERROR) << "No pattern matching available for the provided statement type.";
         throw std::invalid_argument("No pattern matching available for the provided statement type.");
     }
 }
@@ -492,19 +635,68 @@ PKBResponse PKB::match(sp::design_extractor::PatternParam lhs, sp::design_extrac
 }
 
 void PKB::clearCache() {
+    std::lock_guard<std::mutex> lock(*affCacheMutex);
+    if (isAffCacheRetained) {
+        return;
+    }
     relationshipTables.at(PKBRelationship::AFFECTS).reset(new AffectsRelationshipTable());
+    affectsClosure = TransitiveClosure();
     this->isAffCacheActive = false;
 }
 
-void PKB::populateAffCache(PKBRelationship rs) {
+void PKB::retainCache() {
+    std::lock_guard<std::mutex> lock(*affCacheMutex);
+    isAffCacheRetained = true;
+}
+
+memory::Report PKB::getMemoryReport() const {
+    memory::Report report;
+    report.add("statements", statementTable->getMemoryBytes());
+    report.add("variables", variableTable->getMemoryBytes());
+    report.add("procedures", procedureTable->getMemoryBytes());
+    report.add("constants", constantTable->getMemoryBytes());
+
+    const std::pair<PKBRelationship, const char*> names[] = {
+        { PKBRelationship::MODIFIES, "Modifies" }, { PKBRelationship::USES, "Uses" },
+        { PKBRelationship::FOLLOWS, "Follows" }, { PKBRelationship::PARENT, "Parent" },
+        { PKBRelationship::CALLS, "Calls" }, { PKBRelationship::NEXT, "Next" },
+    };
+    for (auto& [rs, name] : names) {
+        report.add(name, relationshipTables.at(rs)->getMemoryBytes());
+    }
+    {
+        // the Affects cache may be populated by the queries of a batch while it is being measured.
+        std::lock_guard<std::mutex> lock(*affCacheMutex);
+        report.add("Affects", relationshipTables.at(PKBRelationship::AFFECTS)->getMemoryBytes());
+        report.add("Affects*", affectsClosure.getMemoryBytes());
+    }
+
+    auto program = dynamic_cast<const sp::ast::Program*>(root.get());
+    report.add("AST", program && program->getArena() ? program->getArena()->getBytesReserved() : 0);
+    report.add("CFG", cfg ? cfg->getMemoryBytes() : 0);
+    return report;
+}
+
+void PKB::populateAffCache(PKBRelationship rs, const CancellationToken* token) {
     bool isAffectsRs = rs == PKBRelationship::AFFECTS || rs == PKBRelationship::AFFECTST;
-    if (isAffectsRs && !isAffCacheActive) {
-        AffectsCacher affCacher;
-        CacheResults res = affCacher.evalAffects(cfgContainer);
-        for (auto item : res) {
-            this->insertRelationship(rs, PKBField::createConcrete(item.first), 
-                PKBField::createConcrete(item.second));
+    if (!isAffectsRs) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(*affCacheMutex);
+    if (!isAffCacheActive) {
+        CacheResults res;
+        if (cfg) {
+            res = AffectsCacher().evalAffects(*cfg, token);
+        }
+        // the cache is derived from the CFG, so the pairs are valid, complete and already sorted.
+        RelationshipRows rows;
+        rows.reserve(res.size());
+        for (auto& [first, second] : res) {
+            rows.emplace_back(first, second);
         }
+        getRelationshipTable(PKBRelationship::AFFECTS)->bulkInsert(rows);
+        // Affects* is answered from the closure, computed once for as long as the cache lives.
+        affectsClosure = TransitiveClosure(res);
         this->isAffCacheActive = true;
     }
 }
@@ -5,20 +5,22 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 #include "logging.h"
+#include "Cancellation.h"
+#include "MemoryUsage.h"
 
 #include "PKB/PKBTables.h"
 #include "PKB/PKBRelationshipTables.h"
 #include "PKB/PKBResponse.h"
 #include "PKB/PKBField.h"
+#include "PKB/TransitiveClosure.h"
 #include "DesignExtractor/PatternMatcher.h"
+#include "DesignExtractor/CFG/BlockCFG.h"
 #include "DesignExtractor/CFG/CFG.h"
 
 using CacheResults = std::set<std::pair<STMT_LO, STMT_LO>>;
-using NodePtr = std::weak_ptr<sp::cfg::CFGNode>;
-using ProcToCfgMap = sp::cfg::PROC_CFG_MAP;
-using CfgNodeSet = std::unordered_set<sp::cfg::CFGNode*>;
 
 class PKB {
 public:
@@ -40,6 +42,30 @@ public:
     */
     virtual void insertRelationship(PKBRelationship type, PKBField field1, PKBField field2);
 
+    /**
+    * Bulk loads relationships of a single type that have already been validated, skipping the per-entry checks
+    * done by insertRelationship. The rows must be sorted and unique, and every entity they refer to must already
+    * be inserted. Statements only need their statement number, the rest of the statement information is filled
+    * in from the StatementTable by direct lookup.
+    *
+    * @param type relationship type
+    * @param rows (first, second) program design entities of each relationship
+    */
+    virtual void bulkInsertRelationships(PKBRelationship type, RelationshipRows rows);
+
+    /**
+    * Marks the source program as fully loaded. Any further insert of entities or relationships is rejected.
+    * The Affects cache, which is derived at query time, is not affected.
+    */
+    void freeze();
+
+    /**
+    * Checks whether the PKB has been frozen.
+    *
+    * @return bool
+    */
+    bool isFrozen() const;
+
     /**
     * Stores the AST parsed by the source processor.
     *
@@ -47,7 +73,33 @@ public:
     */
     void insertAST(std::unique_ptr<sp::ast::Program> root);
 
-    void insertCFG(const sp::cfg::CFG roots);
+    /**
+    * Stores the flat basic block CFG of the program, over which Next* and Affects are evaluated.
+    *
+    * @param cfgContainer the CFG extracted from the SIMPLE source program
+    */
+    void insertCFG(const sp::cfg::CFG cfgContainer);
+
+    /**
+    * Writes everything the PKB holds about the source program to a snapshot file: the entities, the
+    * relationships extracted from the source, the CFG and the AST. The Affects cache is not written, as it is
+    * derived at query time.
+    *
+    * @param path the file to write to, replaced atomically if it exists
+    * @param source the SIMPLE source the PKB was processed from
+    * @return false if the snapshot cannot be written
+    */
+    bool saveSnapshot(const std::string& path, const std::string& source) const;
+
+    /**
+    * Loads a snapshot written by saveSnapshot into an empty PKB, and freezes it. Nothing is loaded if the
+    * snapshot was made from any other source, of another version of the snapshot format, or is corrupted.
+    *
+    * @param path the file to read from
+    * @param source the SIMPLE source the snapshot is expected to be made from
+    * @return whether the snapshot was loaded
+    */
+    bool loadSnapshot(const std::string& path, const std::string& source);
 
     /**
     * Checks whether there exist. If any fields are invalid, return false. Both fields must be concrete.
@@ -67,10 +119,13 @@ public:
     * @param field1 the first program design entity in the relationship
     * @param field2 the second program design entity in the relationship
     * @param rs the relationship type
+    * @param token if given, checked while Next*, Affects and the transitive relationships are walked
     *
     * @return PKBResponse matching relationships wrapped in PKBResponse
+    * @throws exceptions::QueryStoppedException if the query of the token is stopped
     */
-    PKBResponse getRelationship(PKBField field1, PKBField field2, PKBRelationship rs);
+    PKBResponse getRelationship(PKBField field1, PKBField field2, PKBRelationship rs,
+                                const CancellationToken* token = nullptr);
 
     /**
     * Retrieve all statements.
@@ -130,10 +185,29 @@ public:
         sp::design_extractor::PatternParam rhs = sp::design_extractor::PatternParam(std::nullopt)) const;
 
     /**
-    * Clears the cache for Affects. To be called at the end of every QPS query.
+    * Clears the cache for Affects. To be called at the end of every QPS query, or at the end of a batch of queries
+    * evaluated together. Must not be called while a query is being evaluated. Does nothing once the cache is
+    * retained.
     */
     void clearCache();
 
+    /**
+    * Keeps the Affects cache for as long as the PKB lives once it is populated, so that clearCache leaves it as it
+    * is. For a frozen PKB whose queries are evaluated concurrently, where the end of one query must not clear the
+    * cache that the others are reading.
+    */
+    void retainCache();
+
+    /**
+    * Reports the bytes held by every table of the PKB, by the AST and by the CFG, as the components `statements`,
+    * `variables`, `procedures`, `constants`, one per relationship table (e.g. `Follows`), `Affects*` for the
+    * closure of Affects, `AST` and `CFG`. Affects and Affects* only hold anything while the Affects cache is
+    * populated. The AST is reported as the blocks of its arena, so an AST built on the heap is not counted.
+    *
+    * @return memory::Report
+    */
+    memory::Report getMemoryReport() const;
+
 private:
     std::unordered_map<PKBRelationship, std::shared_ptr<RelationshipTable>> relationshipTables;
 
@@ -142,9 +216,14 @@ private:
     std::unique_ptr<ProcedureTable> procedureTable;
     std::unique_ptr<ConstantTable> constantTable;
 
-    sp::cfg::CFG cfgContainer;
+    std::shared_ptr<const sp::cfg::ProgramCFG> cfg;
+    TransitiveClosure affectsClosure;
     std::unique_ptr<sp::ast::ASTNode> root;
     bool isAffCacheActive = false;
+    bool isAffCacheRetained = false;
+    // lets the queries of a batch populate the Affects cache concurrently, behind a pointer to keep the PKB movable
+    std::unique_ptr<std::mutex> affCacheMutex = std::make_unique<std::mutex>();
+    bool frozen = false;
     
     /**
     * Returns a pointer to the relationship table corresponding to the given relationship. Transitive
@@ -231,9 +310,35 @@ private:
     * If so, populates the Affects cache if it is not already populated.
     * 
     * @param rs The provided relationship type to check against
+    * @param token if given, checked for every assignment the Affects are extracted from. The cache is left empty
+    * if the extraction is stopped.
     * @see PKBRelationship
     */
-    void populateAffCache(PKBRelationship rs);
+    void populateAffCache(PKBRelationship rs, const CancellationToken* token = nullptr);
+
+    /**
+    * Checks whether Next*(field1, field2) holds by searching the basic blocks of the CFG. Both fields must be
+    * concrete statements that have been validated.
+    */
+    bool containsNextT(PKBField field1, PKBField field2) const;
+
+    /**
+    * Retrieves all pairs of statements that satisfy Next*(field1, field2) from the basic blocks of the CFG.
+    * Wildcards and declarations are matched by their statement type.
+    */
+    FieldRowResponse retrieveNextT(PKBField field1, PKBField field2, const CancellationToken* token) const;
+
+    /**
+    * Checks whether Affects*(field1, field2) holds using the closure computed with the Affects cache. Both fields
+    * must be concrete statements that have been validated.
+    */
+    bool containsAffectsT(PKBField field1, PKBField field2) const;
+
+    /**
+    * Retrieves all pairs of statements that satisfy Affects*(field1, field2) from the closure computed with the
+    * Affects cache. Wildcards and declarations are matched by their statement type.
+    */
+    FieldRowResponse retrieveAffectsT(PKBField field1, PKBField field2, const CancellationToken* token) const;
 
     /**
     * Helper template method to extract the patterns from the AST node indicated in the type T.
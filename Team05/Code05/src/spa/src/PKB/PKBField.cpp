@@ -2,6 +2,7 @@
 #include <vector>
 
 #include "PKBField.h"
+#include "utils.h"
 
 /** ==================================== STMT_LO METHODS ==================================== */
 
@@ -112,8 +113,11 @@ size_t PKBFieldVectorHash::operator() (const std::vector<PKBField>& other) const
 }
 
 size_t std::hash<STMT_LO>::operator()(const STMT_LO& k) const {
-    std::hash<std::string> hasher;
-    return hasher("STMT_LO" + k.statementNum);
+    // salted so that a statement never hashes like a CONST of the same value
+    static const size_t salt = std::hash<std::string>()("STMT_LO");
+    size_t seed = salt;
+    utils::hash_combine(seed, k.statementNum);
+    return seed;
 }
 
 size_t std::hash<VAR_NAME>::operator()(const VAR_NAME& k) const {
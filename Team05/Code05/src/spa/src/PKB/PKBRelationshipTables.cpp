@@ -1,4 +1,5 @@
 #include "PKBRelationshipTables.h"
+#include "utils.h"
 
 /** ============================= RELATIONSHIPROW METHODS ============================== */
 
@@ -20,10 +21,9 @@ size_t RelationshipRowHash::operator() (const RelationshipRow& other) const {
     PKBField ent1 = other.getFirst();
     PKBField ent2 = other.getSecond();
 
-    PKBEntityType entityType1 = ent1.entityType;
-    PKBEntityType entityType2 = ent2.entityType;
-
-    return (std::hash<PKBEntityType>()(entityType1) ^ std::hash<PKBEntityType>()(entityType2));
+    size_t seed = PKBFieldHash()(ent1);
+    utils::hash_combine(seed, PKBFieldHash()(ent2));
+    return seed;
 }
 
 /** ============================ RELATIONSHIPTABLE METHODS ============================= */
@@ -69,7 +69,7 @@ bool NonTransitiveRelationshipTable::isInsertOrContainsValid(PKBField field1, PK
 
 bool NonTransitiveRelationshipTable::contains(PKBField field1, PKBField field2) const {
     if (!isInsertOrContainsValid(field1, field2)) {
-        Logger(Level::ERROR) <<
+        LOG(Level::ERROR) <<
             "RelationshipTable can only contain concrete fields and STATEMENT or PROCEDURE entity types.";
         return false;
     }
@@ -79,7 +79,7 @@ bool NonTransitiveRelationshipTable::contains(PKBField field1, PKBField field2)
 
 void NonTransitiveRelationshipTable::insert(PKBField field1, PKBField field2) {
     if (!isInsertOrContainsValid(field1, field2)) {
-        Logger(Level::ERROR) <<
+        LOG(Level::ERROR) <<
             "RelationshipTable only allow inserts of concrete fields and STATEMENT or PROCEDURE entity types.";
         return;
     }
@@ -87,13 +87,20 @@ void NonTransitiveRelationshipTable::insert(PKBField field1, PKBField field2) {
     rows.insert(RelationshipRow(field1, field2));
 }
 
+void NonTransitiveRelationshipTable::bulkInsert(const RelationshipRows& newRows) {
+    rows.reserve(rows.size() + newRows.size());
+    for (auto& [first, second] : newRows) {
+        rows.emplace(PKBField::createConcrete(first), PKBField::createConcrete(second));
+    }
+}
+
 FieldRowResponse NonTransitiveRelationshipTable::retrieve(PKBField field1, PKBField field2) {
     PKBFieldType fieldType1 = field1.fieldType;
     PKBFieldType fieldType2 = field2.fieldType;
     FieldRowResponse res;
 
     if (!isRetrieveValid(field1, field2)) {
-        Logger(Level::ERROR) <<
+        LOG(Level::ERROR) <<
             "Only fields of STATEMENT or PROCEDURE entity types can be retrieved from RelationshipTable.";
         return res;
     }
@@ -136,6 +143,14 @@ int NonTransitiveRelationshipTable::getSize() const {
     return rows.size();
 }
 
+std::size_t NonTransitiveRelationshipTable::getMemoryBytes() const {
+    std::size_t bytes = memory::hashTableBytes(rows);
+    for (auto& row : rows) {
+        bytes += memory::heapBytes(row.getFirst()) + memory::heapBytes(row.getSecond());
+    }
+    return bytes;
+}
+
 /** ======================== MODIFIESRELATIONSHIPTABLE METHODS ========================= */
 
 ModifiesRelationshipTable::ModifiesRelationshipTable() : NonTransitiveRelationshipTable{ PKBRelationship::MODIFIES } {};
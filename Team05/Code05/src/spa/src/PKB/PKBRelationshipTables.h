@@ -13,6 +13,8 @@
 #include <functional>
 #include <cstdarg>
 #include "logging.h"
+#include "Cancellation.h"
+#include "MemoryUsage.h"
 #include "PKBField.h"
 #include "PKBCommons.h"
 #include "DesignExtractor/CFG/CFG.h"
@@ -51,6 +53,11 @@ public:
 
 using FieldRowResponse = std::unordered_set<std::vector<PKBField>, PKBFieldVectorHash>;
 
+/**
+* Pre-validated relationships to be bulk loaded into a RelationshipTable, as (first, second) content pairs.
+*/
+using RelationshipRows = std::vector<std::pair<Content, Content>>;
+
 /**
 * A data structure to store program design abstractions. Base class of *RelationshipTables.
 */
@@ -78,6 +85,15 @@ public:
     */
     virtual void insert(PKBField field1, PKBField field2) = 0;
 
+    /**
+    * Inserts all the given relationships at once, building the table's index in a single pass.
+    * No validation is done: every row must be concrete, its statements must carry the information stored in
+    * the StatementTable, and the rows must be sorted and unique.
+    *
+    * @param rows the relationships to insert
+    */
+    virtual void bulkInsert(const RelationshipRows& rows) = 0;
+
     /**
     * Retrieves all pairs of PKBFields in table that satisfies the parameters. If a statement field
     * has no corresponding row in statement table, or if the first parameter is a wildcard, return false.
@@ -104,6 +120,13 @@ public:
     */
     virtual int getSize() const = 0;
 
+    /**
+    * Retrieves the bytes that the table holds for its relationships.
+    *
+    * @return std::size_t
+    */
+    virtual std::size_t getMemoryBytes() const = 0;
+
 protected:
     PKBRelationship type;
 
@@ -158,6 +181,13 @@ public:
     */
     void insert(PKBField field1, PKBField field2) override;
 
+    /**
+    * Inserts all the given relationships at once without validating them.
+    *
+    * @param rows sorted, unique and pre-validated relationships
+    */
+    void bulkInsert(const RelationshipRows& rows) override;
+
     /**
     * Retrieves all pairs of PKBFields in table that satisfies the parameters. If a statement field
     * has no corresponding row in statement table, or if the first parameter is a wildcard, return false.
@@ -177,6 +207,8 @@ public:
     */
     int getSize() const override;
 
+    std::size_t getMemoryBytes() const override;
+
 private:
     std::unordered_set<RelationshipRow, RelationshipRowHash> rows;
 
@@ -292,6 +324,26 @@ public:
         vNode->prev.insert(uNodePtr);
     }
 
+    /**
+    * Adds an edge for every given relationship without validating them. Since the rows are sorted, all edges
+    * leaving a node are added together and every node is looked up once per run instead of once per edge.
+    *
+    * @param rows sorted, unique and pre-validated rs(u, v) relationships
+    */
+    void addEdges(const RelationshipRows& rows) {
+        nodes.reserve(nodes.size() + rows.size());
+        std::shared_ptr<Node<T>> uNode;
+        for (auto& [u, v] : rows) {
+            const T& uVal = std::get<T>(u);
+            if (!uNode || !(uNode->val == uVal)) {
+                uNode = getOrCreateNode(uVal);
+            }
+            auto vNode = getOrCreateNode(std::get<T>(v));
+            uNode->next.insert(std::weak_ptr<Node<T>>(vNode));
+            vNode->prev.insert(std::weak_ptr<Node<T>>(uNode));
+        }
+    }
+
     /**
     * Checks if rs(field1, field2) is in the graph.
     *
@@ -363,11 +415,12 @@ public:
     *
     * @param field1 the first program design entity  in a rs*(u,v) query wrapped in a PKBField
     * @param field2 the second program design entity  in a rs*(u,v) query wrapped in a PKBField
+    * @param token if given, checked for every node walked from when both fields are declarations
     *
     * @return std::unordered_set<std::vector<PKBField>, PKBFieldVectorHash> all pairs of PKBFields
     *   that satisfy rs*(field1, field2)
     */
-    Result retrieveT(PKBField field1, PKBField field2) {
+    Result retrieveT(PKBField field1, PKBField field2, const CancellationToken* token = nullptr) {
         bool isConcreteFirst = field1.fieldType == PKBFieldType::CONCRETE;
         bool isDeclarationFirst = field1.fieldType == PKBFieldType::DECLARATION;
         bool isConcreteSec = field2.fieldType == PKBFieldType::CONCRETE;
@@ -378,7 +431,7 @@ public:
         } else if (isDeclarationFirst && isConcreteSec) {
             return traverseEndT(field1, field2);
         } else if (isDeclarationFirst && isDeclarationSec) {
-            return traverseAllT(field1, field2);
+            return traverseAllT(field1, field2, token);
         } else {
             return containsT(field1, field2) ? Result{ {{field1, field2}} } : Result{};
         }
@@ -393,6 +446,21 @@ public:
         return nodes.size();
     }
 
+    /**
+    * Retrieves the bytes that the graph holds for its nodes and edges. Every node is allocated together with the
+    * control block of its shared_ptr, and keeps every edge twice, once in each of its ends.
+    *
+    * @return std::size_t
+    */
+    std::size_t getMemoryBytes() const {
+        std::size_t bytes = memory::hashTableBytes(nodes);
+        for (auto& [val, node] : nodes) {
+            bytes += memory::heapBytes(val) + memory::SHARED_BLOCK_BYTES + sizeof(Node<T>) +
+                memory::heapBytes(node->val) + memory::treeBytes(node->next) + memory::treeBytes(node->prev);
+        }
+        return bytes;
+    }
+
 private:
     PKBRelationship type; /**< The type of relationships this Graph holds */
     std::unordered_map<T, std::shared_ptr<Node<T>>> nodes; /**< The list of nodes in this Graph */
@@ -436,6 +504,19 @@ private:
         return node;
     }
 
+    /**
+    * Returns the node holding val, creating it if absent. Used by the unvalidated bulk insertion path.
+    *
+    * @param val a program design entity
+    */
+    std::shared_ptr<Node<T>> getOrCreateNode(const T& val) {
+        auto [it, inserted] = nodes.try_emplace(val, nullptr);
+        if (inserted) {
+            it->second = std::make_shared<Node<T>>(val, typename Node<T>::NodeSet{}, typename Node<T>::NodeSet{});
+        }
+        return it->second;
+    }
+
     /**
     * Helper function for containsT. Keeps track of all nodes visited and performs depth-first traversal.
     * Checks if rs*(field1, field2) is in the graph.
@@ -784,18 +865,20 @@ private:
     *
     * @param type1 the first field
     * @param type2 the second field
+    * @param token if given, checked for every node walked from
     *
     * @return std::unordered_set<std::vector<PKBField>, PKBFieldVectorHash> all pairs of PKBFields where each
     * item in each pair satisfies the corresponding the parameters.
     *
     * @see PKBField
     */
-    Result traverseAllT(PKBField field1, PKBField field2) {
+    Result traverseAllT(PKBField field1, PKBField field2, const CancellationToken* token) {
         Result res;
 
         std::set<T> found;
 
         for (auto const& [key, node] : nodes) {
+            CancellationToken::check(token);
             auto curr = node;
             found.clear();
 
@@ -847,7 +930,7 @@ public:
     */
     bool contains(PKBField field1, PKBField field2) const override {
         if (!isInsertOrContainsValid(field1, field2)) {
-            Logger(Level::ERROR) << "Invalid contains on a TransitiveRelationshipTable.";
+            LOG(Level::ERROR) << "Invalid contains on a TransitiveRelationshipTable.";
             return false;
         }
 
@@ -866,13 +949,22 @@ public:
     */
     void insert(PKBField field1, PKBField field2) override {
         if (!isInsertOrContainsValid(field1, field2)) {
-            Logger(Level::ERROR) << "Invalid insert on a TransitiveRelationshipTable.";
+            LOG(Level::ERROR) << "Invalid insert on a TransitiveRelationshipTable.";
             return;
         }
 
         graph->addEdge(*field1.getContent<T>(), *field2.getContent<T>());
     }
 
+    /**
+    * Inserts into Graph an edge for every given relationship without validating them.
+    *
+    * @param rows sorted, unique and pre-validated relationships
+    */
+    void bulkInsert(const RelationshipRows& rows) override {
+        graph->addEdges(rows);
+    }
+
     void convertWildcardToDeclaration(PKBField* field) const {
         if (field->fieldType == PKBFieldType::WILDCARD) {
             field->fieldType = PKBFieldType::DECLARATION;
@@ -898,7 +990,7 @@ public:
     FieldRowResponse retrieve(PKBField field1, PKBField field2) override {
         // Both fields have to be a statement type
         if (!isRetrieveValid(field1, field2)) {
-            Logger(Level::ERROR) <<
+            LOG(Level::ERROR) <<
                 "Invalid retrieve from a TransitiveRelationshipTable.";
             return FieldRowResponse{};
         }
@@ -929,7 +1021,7 @@ public:
     */
     bool containsT(PKBField field1, PKBField field2) const {
         if (!isInsertOrContainsValid(field1, field2)) {
-            Logger(Level::ERROR) <<
+            LOG(Level::ERROR) <<
                 "Invalid insert/contains on a TransitiveRelationshipTable.";
             return false;
         }
@@ -942,6 +1034,7 @@ public:
     *
     * @param field1 the first program design entity in a rs*(u,v) query wrapped in a PKBField
     * @param field2 the second program design entity in a rs*(u,v) query wrapped in a PKBField
+    * @param token if given, checked while the graph is walked
     *
     * @return std::unordered_set<std::vector<PKBField>, PKBFieldVectorHash> an unordered set of vectors of PKBFields,
     *  each vector represents the two program design entities in a rs* relationship,
@@ -949,10 +1042,10 @@ public:
     *
     * @see PKBField
     */
-    FieldRowResponse retrieveT(PKBField field1, PKBField field2) {
+    FieldRowResponse retrieveT(PKBField field1, PKBField field2, const CancellationToken* token = nullptr) {
         // Both fields have to be a statement type
         if (!isRetrieveValid(field1, field2)) {
-            Logger(Level::ERROR) <<
+            LOG(Level::ERROR) <<
                 "Invalid retrieve from a TransitiveRelationshipTable.";
             return FieldRowResponse{};
         }
@@ -968,13 +1061,17 @@ public:
             : FieldRowResponse{};
         }
 
-        return graph->retrieveT(field1, field2);
+        return graph->retrieveT(field1, field2, token);
     }
 
     int getSize() const override {
         return graph->getSize();
     }
 
+    std::size_t getMemoryBytes() const override {
+        return sizeof(Graph<T>) + graph->getMemoryBytes();
+    }
+
 private:
     std::unique_ptr<Graph<T>> graph;
 
@@ -0,0 +1,265 @@
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "logging.h"
+#include "PKB.h"
+#include "PKB/PKBSnapshot.h"
+#include "Parser/ASTSnapshot.h"
+
+namespace snapshot {
+void writeStmt(Writer& out, const STMT_LO& stmt) {
+    out.write<int>(stmt.statementNum);
+    out.write<std::int8_t>(stmt.type.has_value() ? static_cast<std::int8_t>(stmt.type.value()) : -1);
+    out.write<bool>(stmt.hasAttribute());
+    if (stmt.hasAttribute()) {
+        out.writeName(stmt.attribute.value());
+    }
+}
+
+STMT_LO readStmt(Reader& in) {
+    STMT_LO stmt(in.read<int>());
+    auto type = in.read<std::int8_t>();
+    if (type < -1 || type > static_cast<std::int8_t>(StatementType::None)) {
+        throw SnapshotError("Unknown statement type in snapshot");
+    }
+    if (type != -1) {
+        stmt.type = static_cast<StatementType>(type);
+    }
+    if (in.read<bool>()) {
+        stmt.attribute = in.readName();
+    }
+    return stmt;
+}
+}  // namespace snapshot
+
+namespace {
+/**
+ * The relationships extracted from the source, in the order they are written, and the entities each of them is
+ * retrieved with. Affects is left out as it is derived from the CFG at query time.
+ */
+const std::vector<std::pair<PKBRelationship, std::vector<std::pair<PKBField, PKBField>>>>& getSnapshotTables() {
+    static const auto stmt = PKBField::createDeclaration(StatementType::All);
+    static const auto var = PKBField::createDeclaration(PKBEntityType::VARIABLE);
+    static const auto proc = PKBField::createDeclaration(PKBEntityType::PROCEDURE);
+    static const std::vector<std::pair<PKBRelationship, std::vector<std::pair<PKBField, PKBField>>>> tables {
+        { PKBRelationship::FOLLOWS, { { stmt, stmt } } },
+        { PKBRelationship::PARENT, { { stmt, stmt } } },
+        { PKBRelationship::NEXT, { { stmt, stmt } } },
+        { PKBRelationship::CALLS, { { proc, proc } } },
+        { PKBRelationship::MODIFIES, { { stmt, var }, { proc, var } } },
+        { PKBRelationship::USES, { { stmt, var }, { proc, var } } },
+    };
+    return tables;
+}
+
+// statements are written by number only, the rest is looked up in the StatementTable when they are loaded.
+void writeContent(snapshot::Writer& out, const Content& content) {
+    out.write<std::uint8_t>(static_cast<std::uint8_t>(content.index()));
+    if (auto stmt = std::get_if<STMT_LO>(&content)) {
+        out.write<int>(stmt->statementNum);
+    } else if (auto var = std::get_if<VAR_NAME>(&content)) {
+        out.writeName(var->name);
+    } else {
+        out.writeName(std::get<PROC_NAME>(content).name);
+    }
+}
+
+/**
+ * The entities a relationship may refer to, so that a row of a snapshot is never loaded without them.
+ */
+struct KnownEntities {
+    std::unordered_set<int> stmts;
+    std::unordered_set<std::string> vars;
+    std::unordered_set<std::string> procs;
+};
+
+Content readContent(snapshot::Reader& in, const KnownEntities& known) {
+    bool isKnown;
+    Content content;
+    switch (in.read<std::uint8_t>()) {
+    case 1: {
+        int stmtNo = in.read<int>();
+        isKnown = known.stmts.count(stmtNo);
+        content = STMT_LO{ stmtNo };
+        break;
+    }
+    case 2: {
+        auto& name = in.readName();
+        isKnown = known.vars.count(name);
+        content = VAR_NAME{ name };
+        break;
+    }
+    case 3: {
+        auto& name = in.readName();
+        isKnown = known.procs.count(name);
+        content = PROC_NAME{ name };
+        break;
+    }
+    default:
+        throw snapshot::SnapshotError("Unexpected entity in snapshot relationship");
+    }
+    if (!isKnown) {
+        throw snapshot::SnapshotError("Snapshot relationship refers to an unknown entity");
+    }
+    return content;
+}
+
+void writeNames(snapshot::Writer& out, const std::vector<std::string>& names) {
+    out.write<std::uint64_t>(names.size());
+    for (auto& name : names) {
+        out.writeName(name);
+    }
+}
+
+std::vector<std::string> readNames(snapshot::Reader& in) {
+    std::vector<std::string> names(in.readCount());
+    for (auto& name : names) {
+        name = in.readName();
+    }
+    return names;
+}
+}  // namespace
+
+bool PKB::saveSnapshot(const std::string& path, const std::string& source) const {
+    snapshot::Writer out;
+
+    auto stmts = statementTable->getAllEntity();
+    std::sort(stmts.begin(), stmts.end(), [](const STMT_LO& a, const STMT_LO& b) {
+        return a.statementNum < b.statementNum;
+    });
+    out.write<std::uint64_t>(stmts.size());
+    for (auto& stmt : stmts) {
+        snapshot::writeStmt(out, stmt);
+    }
+    std::vector<std::string> vars;
+    for (auto& var : variableTable->getAllEntity()) {
+        vars.push_back(var.name);
+    }
+    std::sort(vars.begin(), vars.end());
+    writeNames(out, vars);
+    std::vector<std::string> procs;
+    for (auto& proc : procedureTable->getAllEntity()) {
+        procs.push_back(proc.name);
+    }
+    std::sort(procs.begin(), procs.end());
+    writeNames(out, procs);
+    auto constants = constantTable->getAllEntity();
+    std::sort(constants.begin(), constants.end());
+    out.writeVector(constants);
+
+    // rows are written sorted as they are extracted, which is the order bulkInsertRelationships expects
+    for (auto& [type, fields] : getSnapshotTables()) {
+        std::vector<std::pair<Content, Content>> rows;
+        for (auto& [first, second] : fields) {
+            for (auto& row : getRelationshipTable(type)->retrieve(first, second)) {
+                rows.emplace_back(row[0].content, row[1].content);
+            }
+        }
+        std::sort(rows.begin(), rows.end());
+        out.write<std::uint64_t>(rows.size());
+        for (auto& [first, second] : rows) {
+            writeContent(out, first);
+            writeContent(out, second);
+        }
+    }
+
+    out.write<bool>(cfg != nullptr);
+    if (cfg) {
+        cfg->write(out);
+    }
+    auto program = dynamic_cast<const sp::ast::Program*>(root.get());
+    out.write<bool>(program != nullptr);
+    if (program) {
+        sp::ast::write(out, *program);
+    }
+
+    try {
+        out.save(path, snapshot::checksum(source));
+    } catch (const snapshot::SnapshotError& e) {
+        LOG(Level::ERROR) << "PKBSnapshot.cpp " << e.what();
+        return false;
+    }
+    return true;
+}
+
+bool PKB::loadSnapshot(const std::string& path, const std::string& source) {
+    if (frozen) {
+        LOG(Level::ERROR) << "PKBSnapshot.cpp " << "Cannot load a snapshot into a frozen PKB";
+        return false;
+    }
+
+    // everything is read before anything is inserted, so that a bad snapshot leaves the PKB untouched
+    std::vector<STMT_LO> stmts;
+    std::vector<std::string> vars;
+    std::vector<std::string> procs;
+    std::vector<CONST> constants;
+    std::vector<RelationshipRows> tables;
+    std::shared_ptr<const sp::cfg::ProgramCFG> loadedCfg;
+    std::unique_ptr<sp::ast::Program> program;
+    try {
+        snapshot::Reader in(path);
+        if (in.getSourceChecksum() != snapshot::checksum(source)) {
+            LOG(Level::INFO) << "PKBSnapshot.cpp " << "Snapshot " << path << " was made from another source";
+            return false;
+        }
+
+        KnownEntities known;
+        stmts.resize(in.readCount(), STMT_LO{ 0 });
+        for (auto& stmt : stmts) {
+            stmt = snapshot::readStmt(in);
+            known.stmts.insert(stmt.statementNum);
+        }
+        vars = readNames(in);
+        known.vars.insert(vars.begin(), vars.end());
+        procs = readNames(in);
+        known.procs.insert(procs.begin(), procs.end());
+        constants = in.readVector<CONST>();
+
+        for (std::size_t i = 0; i < getSnapshotTables().size(); i++) {
+            auto& rows = tables.emplace_back(in.readCount());
+            for (auto& [first, second] : rows) {
+                first = readContent(in, known);
+                second = readContent(in, known);
+            }
+        }
+
+        if (in.read<bool>()) {
+            loadedCfg = sp::cfg::ProgramCFG::read(in);
+        }
+        if (in.read<bool>()) {
+            program = sp::ast::readProgram(in);
+        }
+        if (!in.isAtEnd()) {
+            throw snapshot::SnapshotError("Trailing data in snapshot");
+        }
+    } catch (const snapshot::SnapshotError& e) {
+        LOG(Level::ERROR) << "PKBSnapshot.cpp " << e.what();
+        return false;
+    }
+
+    for (auto& stmt : stmts) {
+        insertEntity(stmt);
+    }
+    for (auto& var : vars) {
+        insertEntity(VAR_NAME{ var });
+    }
+    for (auto& proc : procs) {
+        insertEntity(PROC_NAME{ proc });
+    }
+    for (auto constant : constants) {
+        insertEntity(constant);
+    }
+    for (std::size_t i = 0; i < tables.size(); i++) {
+        if (!tables[i].empty()) {
+            bulkInsertRelationships(getSnapshotTables()[i].first, std::move(tables[i]));
+        }
+    }
+    cfg = std::move(loadedCfg);
+    root = std::move(program);
+    freeze();
+    return true;
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "PKB/PKBField.h"
+#include "Snapshot.h"
+
+namespace snapshot {
+/**
+ * Writes a statement with its type and attribute, if it has them.
+ */
+void writeStmt(Writer& out, const STMT_LO& stmt);
+
+/**
+ * Reads a statement written by writeStmt.
+ */
+STMT_LO readStmt(Reader& in);
+}  // namespace snapshot
@@ -40,6 +40,10 @@ int StatementVector::getSize() const {
     return getAllEntities().size();
 }
 
+std::size_t StatementVector::getMemoryBytes() const {
+    return memory::heapBytes(entities);
+}
+
 std::vector<STMT_LO> StatementVector::getAllEntities() const {
     std::vector<STMT_LO> res;
 
@@ -112,12 +116,12 @@ VariableTable::VariableTable() : EntityTable(EntitySet<VAR_NAME>{}) {}
 StatementTable::StatementTable() : EntityTable(StatementVector{}) {}
 
 bool StatementTable::contains(int statementNumber) const {
-    auto statementVector = std::get<StatementVector>(entities);
+    const auto& statementVector = std::get<StatementVector>(entities);
     return statementVector.contains(statementNumber);
 }
 
 bool StatementTable::contains(StatementType type, int statementNumber) const {
-    auto statementVector = std::get<StatementVector>(entities);
+    const auto& statementVector = std::get<StatementVector>(entities);
     auto stmt = statementVector.getStmt(statementNumber);
     if (stmt.has_value()) {
         return stmt.value().type.value() == type;
@@ -127,7 +131,7 @@ bool StatementTable::contains(StatementType type, int statementNumber) const {
 }
 
 std::vector<STMT_LO> StatementTable::getStmtOfType(StatementType type) const {
-    auto statementVector = std::get<StatementVector>(entities);
+    const auto& statementVector = std::get<StatementVector>(entities);
     return statementVector.getStmtsOfType(type);
 }
 
@@ -143,6 +147,6 @@ std::optional<StatementType> StatementTable::getStmtTypeOfLine(int statementNumb
 }
 
 std::optional<STMT_LO> StatementTable::getStmt(int statementNumber) const {
-    auto statementVector = std::get<StatementVector>(entities);
+    const auto& statementVector = std::get<StatementVector>(entities);
     return statementVector.getStmt(statementNumber);
 }
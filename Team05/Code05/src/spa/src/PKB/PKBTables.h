@@ -8,6 +8,7 @@
 #include <variant>
 #include <memory>
 
+#include "MemoryUsage.h"
 #include "PKBField.h"
 
 /**
@@ -44,6 +45,13 @@ public:
     * @return a vector of entities
     */
     virtual std::vector<T> getAllEntities() const = 0;
+
+    /**
+    * Returns the bytes that the data structure holds for its entries.
+    *
+    * @return std::size_t
+    */
+    virtual std::size_t getMemoryBytes() const = 0;
 };
 
 /**
@@ -142,6 +150,14 @@ public:
         return res;
     }
 
+    std::size_t getMemoryBytes() const override {
+        std::size_t bytes = memory::hashTableBytes(rows);
+        for (auto& row : rows) {
+            bytes += memory::heapBytes(row.getVal());
+        }
+        return bytes;
+    }
+
 protected:
     std::unordered_set<EntityRow<T>, EntityRowHash<T>> rows;
 };
@@ -211,6 +227,8 @@ public:
     */
     std::vector<STMT_LO> getStmtsOfType(StatementType type) const;
 
+    std::size_t getMemoryBytes() const override;
+
 private:
     // unordered_map to get O(1) average, assumes that query will always have result
     std::vector<STMT_LO> entities;
@@ -250,6 +268,19 @@ public:
         }
     }
 
+    /**
+    * Returns the bytes that the EntityTable holds for its entities.
+    *
+    * @return std::size_t
+    */
+    std::size_t getMemoryBytes() const {
+        if constexpr (std::is_same_v<T, STMT_LO>) {
+            return std::get<StatementVector>(entities).getMemoryBytes();
+        } else {
+            return std::get<EntitySet<T>>(entities).getMemoryBytes();
+        }
+    }
+
     /**
     * Checks if the EntityDataStructure in the EntityTable contains the given program design entity.
     * 
@@ -0,0 +1,97 @@
+#include <algorithm>
+
+#include "TransitiveClosure.h"
+
+TransitiveClosure::TransitiveClosure(const std::set<std::pair<STMT_LO, STMT_LO>>& pairs) {
+    auto addNode = [this](const STMT_LO& stmt) {
+        auto [it, inserted] = nodeOf.try_emplace(stmt.statementNum, static_cast<int>(stmts.size()));
+        if (inserted) {
+            stmts.push_back(stmt);
+        }
+        return it->second;
+    };
+    std::vector<std::pair<int, int>> edges;
+    edges.reserve(pairs.size());
+    for (auto& [from, to] : pairs) {
+        int u = addNode(from);
+        edges.emplace_back(u, addNode(to));
+    }
+    std::size_t nodeCount = stmts.size();
+    std::vector<std::vector<int>> adjacent(nodeCount);
+    for (auto [u, v] : edges) {
+        adjacent[u].push_back(v);
+    }
+
+    // Tarjan's algorithm with an explicit stack, which emits every component after all the components it reaches.
+    componentOf.assign(nodeCount, -1);
+    std::vector<int> index(nodeCount, -1), low(nodeCount, 0);
+    std::vector<bool> onStack(nodeCount, false);
+    std::vector<int> stack;
+    std::vector<std::pair<int, std::size_t>> frames;  // node and the next edge to follow
+    int counter = 0;
+    auto open = [&](int node) {
+        index[node] = low[node] = counter++;
+        stack.push_back(node);
+        onStack[node] = true;
+        frames.emplace_back(node, 0);
+    };
+    for (std::size_t root = 0; root < nodeCount; root++) {
+        if (index[root] != -1) {
+            continue;
+        }
+        open(static_cast<int>(root));
+        while (!frames.empty()) {
+            int node = frames.back().first;
+            if (frames.back().second < adjacent[node].size()) {
+                int next = adjacent[node][frames.back().second++];
+                if (index[next] == -1) {
+                    open(next);
+                } else if (onStack[next]) {
+                    low[node] = std::min(low[node], index[next]);
+                }
+                continue;
+            }
+            frames.pop_back();
+            if (!frames.empty()) {
+                int parent = frames.back().first;
+                low[parent] = std::min(low[parent], low[node]);
+            }
+            if (low[node] != index[node]) {
+                continue;
+            }
+            int component = static_cast<int>(members.size());
+            members.emplace_back();
+            int member;
+            do {
+                member = stack.back();
+                stack.pop_back();
+                onStack[member] = false;
+                componentOf[member] = component;
+                members.back().push_back(member);
+            } while (member != node);
+        }
+    }
+
+    // the components reached by an edge are always emitted before the component the edge starts from.
+    reach.assign(members.size(), Bitset(members.size()));
+    for (std::size_t component = 0; component < members.size(); component++) {
+        if (members[component].size() > 1) {
+            reach[component].set(component);
+        }
+        for (auto node : members[component]) {
+            for (auto next : adjacent[node]) {
+                int target = componentOf[next];
+                reach[component].set(target);
+                if (target != static_cast<int>(component)) {
+                    reach[component] |= reach[target];
+                }
+            }
+        }
+    }
+}
+
+bool TransitiveClosure::contains(int from, int to) const {
+    int u = find(from);
+    int v = find(to);
+    return u != -1 && v != -1 && reach[componentOf[u]].test(componentOf[v]);
+}
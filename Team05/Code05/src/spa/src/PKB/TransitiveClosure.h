@@ -0,0 +1,114 @@
+#pragma once
+
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Bitset.h"
+#include "MemoryUsage.h"
+#include "PKBField.h"
+
+/**
+* The precomputed transitive closure of a relationship between statements, e.g. Affects* from Affects.
+*
+* The relationship graph is condensed into its strongly connected components, which are found in reverse
+* topological order. The components reachable from each component are then propagated as bitsets in that same
+* order, so every component is finished before any component that reaches it. A statement reaches every statement
+* of the components reachable from its own component, including its own component if that component has a cycle.
+*/
+class TransitiveClosure {
+public:
+    TransitiveClosure() = default;
+
+    /**
+    * Computes the closure of the given pairs.
+    *
+    * @param pairs the pairs (u, v) of the non-transitive relationship
+    */
+    explicit TransitiveClosure(const std::set<std::pair<STMT_LO, STMT_LO>>& pairs);
+
+    /**
+    * Checks whether rs*(from, to) holds.
+    *
+    * @param from the statement number of the first statement
+    * @param to the statement number of the second statement
+    * @return bool
+    */
+    bool contains(int from, int to) const;
+
+    /**
+    * Calls f with every statement s such that rs*(from, s).
+    */
+    template <typename F>
+    void forEachReachable(int from, F&& f) const {
+        int node = find(from);
+        if (node == -1) {
+            return;
+        }
+        reach[componentOf[node]].forEach([&](std::size_t component) {
+            for (auto member : members[component]) {
+                f(stmts[member]);
+            }
+        });
+    }
+
+    /**
+    * Calls f with every statement s such that rs*(s, to).
+    */
+    template <typename F>
+    void forEachReaching(int to, F&& f) const {
+        int node = find(to);
+        if (node == -1) {
+            return;
+        }
+        for (std::size_t component = 0; component < members.size(); component++) {
+            if (reach[component].test(componentOf[node])) {
+                for (auto member : members[component]) {
+                    f(stmts[member]);
+                }
+            }
+        }
+    }
+
+    /**
+    * Calls f with every statement that is the first statement of some pair in the closure.
+    */
+    template <typename F>
+    void forEachSource(F&& f) const {
+        for (std::size_t node = 0; node < stmts.size(); node++) {
+            if (reach[componentOf[node]].any()) {
+                f(stmts[node]);
+            }
+        }
+    }
+
+    /**
+    * Retrieves the number of statements in the relationship graph.
+    *
+    * @return std::size_t
+    */
+    std::size_t size() const { return stmts.size(); }
+
+    /**
+    * Retrieves the bytes that the closure holds for its statements, components and reachability.
+    *
+    * @return std::size_t
+    */
+    std::size_t getMemoryBytes() const {
+        return memory::heapBytes(stmts) + memory::heapBytes(nodeOf) + memory::heapBytes(componentOf) +
+            memory::heapBytes(members) + memory::heapBytes(reach);
+    }
+
+private:
+    std::vector<STMT_LO> stmts;  // the statements of the graph, each identified by its index
+    std::unordered_map<int, int> nodeOf;  // statement number to index in stmts
+    std::vector<int> componentOf;
+    std::vector<std::vector<int>> members;  // the statements of each component
+    std::vector<Bitset> reach;  // the components reachable from each component through one or more edges
+
+    int find(int stmtNo) const {
+        auto it = nodeOf.find(stmtNo);
+        return it == nodeOf.end() ? -1 : it->second;
+    }
+};
@@ -1,8 +1,66 @@
+#include <algorithm>
+#include <cstdint>
+
 #include "AST.h"
 
 namespace sp {
 namespace ast {
 
+void* Arena::allocate(std::size_t size, std::size_t alignment) {
+    std::size_t padding = reinterpret_cast<std::uintptr_t>(cursor) % alignment;
+    if (padding != 0) {
+        padding = alignment - padding;
+    }
+    if (cursor == nullptr || padding + size > remaining) {
+        // oversized nodes get a block of their own so that the current block is not wasted.
+        std::size_t newBlockSize = std::max(blockSize, size + alignment);
+        blocks.push_back(std::make_unique<std::byte[]>(newBlockSize));
+        bytesReserved += newBlockSize;
+        cursor = blocks.back().get();
+        remaining = newBlockSize;
+        padding = reinterpret_cast<std::uintptr_t>(cursor) % alignment;
+        if (padding != 0) {
+            padding = alignment - padding;
+        }
+    }
+    std::byte* result = cursor + padding;
+    cursor = result + size;
+    remaining -= padding + size;
+    bytesUsed += size;
+    return result;
+}
+
+void Arena::absorb(Arena&& other) {
+    // the unused tail of the other arena's current block is simply never handed out again.
+    for (auto& block : other.blocks) {
+        blocks.push_back(std::move(block));
+    }
+    bytesUsed += other.bytesUsed;
+    bytesReserved += other.bytesReserved;
+    other.blocks.clear();
+    other.cursor = nullptr;
+    other.remaining = 0;
+    other.bytesUsed = 0;
+    other.bytesReserved = 0;
+}
+
+void StmtLst::shiftStmtNo(int offset) {
+    for (auto& s : list) {
+        s->shiftStmtNo(offset);
+    }
+}
+
+void If::shiftStmtNo(int offset) {
+    Statement::shiftStmtNo(offset);
+    thenBlk.shiftStmtNo(offset);
+    elseBlk.shiftStmtNo(offset);
+}
+
+void While::shiftStmtNo(int offset) {
+    Statement::shiftStmtNo(offset);
+    stmtLst.shiftStmtNo(offset);
+}
+
 // Victims
 void Var::accept(ASTNodeVisitor* visitor) const {
     visitor->visit(*this);
@@ -1,8 +1,10 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <vector>
 #include <memory>
+#include <new>
 #include <utility>
 #include <variant>
 
@@ -18,12 +20,108 @@ namespace sp {
 namespace ast {
 
 struct ASTNodeVisitor;
+class Arena;
 
 class ASTNode {
 public:
+    ASTNode() = default;
+    // A copy is a fresh object and never lives in the arena of the original.
+    ASTNode(const ASTNode&) {}
+    ASTNode& operator=(const ASTNode&) { return *this; }
     virtual ~ASTNode() {}
     virtual void accept(ASTNodeVisitor* visitor) const = 0;
     virtual bool operator==(ASTNode const& o) const = 0;
+
+    bool isArenaAllocated() const { return arenaAllocated; }
+
+private:
+    friend class Arena;
+    bool arenaAllocated = false;
+};
+
+/**
+ * @brief Deleter for AST child pointers.
+ * @details Nodes allocated from an Arena are only destroyed in place, their storage is
+ * released in bulk when the owning Arena goes away. Nodes built on the heap (e.g. with make)
+ * are deleted as usual, so a std::unique_ptr<T> converts implicitly into a Ptr<T>.
+ */
+struct NodeDeleter {
+    NodeDeleter() = default;
+    template <class U>
+    NodeDeleter(const std::default_delete<U>&) {}  // NOLINT(runtime/explicit)
+
+    void operator()(const ASTNode* node) const {
+        if (node->isArenaAllocated()) {
+            node->~ASTNode();
+        } else {
+            delete node;
+        }
+    }
+};
+
+/**
+ * @brief Owning pointer to a child node whose storage may live in an Arena.
+ */
+template <class T>
+using Ptr = std::unique_ptr<T, NodeDeleter>;
+
+/**
+ * @class Arena
+ * @brief Monotonic bump allocator that owns the storage of every node of a parsed Program.
+ * @details Nodes are placed back to back in large blocks in the order the parser creates them,
+ * so a tree walk touches memory mostly sequentially. Storage is never reused; it is released
+ * all at once when the Arena is destroyed, which must happen after every node in it has been
+ * destroyed (the Program guarantees this by owning both).
+ */
+class Arena {
+public:
+    static constexpr std::size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    explicit Arena(std::size_t blockSize = DEFAULT_BLOCK_SIZE) : blockSize(blockSize) {}
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /**
+     * @brief Constructs a node of type T inside the arena.
+     *
+     * @tparam T the ASTNode type to construct.
+     * @param args arguments forwarded to the constructor of T.
+     * @return Ptr<T> an owning pointer that destroys the node in place.
+     */
+    template <class T, typename... Args>
+    Ptr<T> make(Args&&... args) {
+        void* mem = allocate(sizeof(T), alignof(T));
+        T* node = new (mem) T(std::forward<Args>(args)...);
+        static_cast<ASTNode*>(node)->arenaAllocated = true;
+        return Ptr<T>(node);
+    }
+
+    /**
+     * @return the number of bytes handed out to nodes so far.
+     */
+    std::size_t getBytesUsed() const { return bytesUsed; }
+
+    /**
+     * @return the number of bytes reserved from the system, including unused block tails.
+     */
+    std::size_t getBytesReserved() const { return bytesReserved; }
+
+    /**
+     * @brief Takes over every block of another arena, e.g. one that a procedure was parsed into on its own.
+     * @details The nodes in the blocks stay where they are, so this only moves block ownership.
+     * New nodes keep going to the current block of this arena.
+     */
+    void absorb(Arena&& other);
+
+private:
+    void* allocate(std::size_t size, std::size_t alignment);
+
+    std::vector<std::unique_ptr<std::byte[]>> blocks;
+    std::byte* cursor = nullptr;
+    std::size_t remaining = 0;
+    std::size_t blockSize;
+    std::size_t bytesUsed = 0;
+    std::size_t bytesReserved = 0;
 };
 
 // Abstract classes
@@ -135,6 +233,14 @@ public:
     const int getStmtNo() const {
         return stmtNo;
     }
+
+    /**
+     * @brief Adds an offset to the statement number of this statement and of every statement nested in it.
+     * @details Used when procedures are numbered independently and placed one after another afterwards.
+     */
+    virtual void shiftStmtNo(int offset) {
+        stmtNo += offset;
+    }
 };
 
 /**
@@ -167,13 +273,25 @@ public:
  */
 class StmtLst : public ASTNode {
 private:
-    std::vector<std::unique_ptr<Statement>> list;
+    std::vector<Ptr<Statement>> list;
 public:
-    explicit StmtLst(std::vector<std::unique_ptr<Statement>>& list)
+    explicit StmtLst(std::vector<Ptr<Statement>>& list)
     : list(std::move(list)) {}
 
+    explicit StmtLst(std::vector<std::unique_ptr<Statement>>& list) {
+        this->list.reserve(list.size());
+        for (auto& stmt : list) {
+            this->list.emplace_back(std::move(stmt));
+        }
+        list.clear();
+    }
+
     void accept(ASTNodeVisitor* visitor) const;
 
+    std::size_t size() const { return list.size(); }
+
+    void shiftStmtNo(int offset);
+
     virtual bool operator==(ASTNode const& o) const;
 };
 
@@ -198,6 +316,7 @@ public:
 
     void accept(ASTNodeVisitor* visitor) const;
     std::string getName() const { return procName; }
+    void shiftStmtNo(int offset) { stmtLst.shiftStmtNo(offset); }
     virtual bool operator==(ASTNode const& o) const;
 };
 
@@ -212,11 +331,20 @@ public:
  */
 class Program : public ASTNode {
 private:
-    std::vector<std::unique_ptr<Procedure>> procedures;
+    // declared first so that it is destroyed after every node it holds.
+    std::unique_ptr<Arena> arena;
+    std::vector<Ptr<Procedure>> procedures;
 public:
-    explicit Program(std::vector<std::unique_ptr<Procedure>> procedures) :
-        procedures(std::move(procedures)) {}
-    
+    explicit Program(std::vector<Ptr<Procedure>> procedures, std::unique_ptr<Arena> arena = nullptr) :
+        arena(std::move(arena)), procedures(std::move(procedures)) {}
+
+    /**
+     * @return the arena backing the nodes of this program, or nullptr if it was built on the heap.
+     */
+    const Arena* getArena() const { return arena.get(); }
+
+    const std::vector<Ptr<Procedure>>& getProcedures() const { return procedures; }
+
     void accept(ASTNodeVisitor* visitor) const;
 
     virtual bool operator==(ASTNode const& o) const;
@@ -236,13 +364,13 @@ public:
  */
 class If : public Statement {
 private:
-    std::unique_ptr<CondExpr> condExpr;
+    Ptr<CondExpr> condExpr;
     StmtLst thenBlk;
     StmtLst elseBlk;
 public:
     If(
         int stmtNo,
-        std::unique_ptr<CondExpr> condExpr,
+        Ptr<CondExpr> condExpr,
         StmtLst thenBlk,
         StmtLst elseBlk
     ) :
@@ -252,6 +380,7 @@ public:
         elseBlk(std::move(elseBlk)) {}
 
     void accept(ASTNodeVisitor* visitor) const;
+    void shiftStmtNo(int offset) override;
     CondExpr* getCondExpr() const {
         return condExpr.get();
     }
@@ -272,12 +401,12 @@ public:
  */
 class While : public Statement {
 private:
-    std::unique_ptr<CondExpr> condExpr;
+    Ptr<CondExpr> condExpr;
     StmtLst stmtLst;
 public:
     While(
         int stmtNo,
-        std::unique_ptr<CondExpr> condExpr,
+        Ptr<CondExpr> condExpr,
         StmtLst stmtLst
     ) :
         Statement(stmtNo),
@@ -285,6 +414,7 @@ public:
         stmtLst(std::move(stmtLst)) {}
 
     void accept(ASTNodeVisitor* visitor) const;
+    void shiftStmtNo(int offset) override;
     CondExpr* getCondExpr() const {
         return condExpr.get();
     }
@@ -304,14 +434,14 @@ public:
  */
 class Assign : public Statement {
 private:
-    std::unique_ptr<Var> var;
-    std::unique_ptr<Expr> expr;
+    Ptr<Var> var;
+    Ptr<Expr> expr;
 
 public:
     Assign(
         int stmtNo,
-        std::unique_ptr<Var> var, 
-        std::unique_ptr<Expr> expr
+        Ptr<Var> var, 
+        Ptr<Expr> expr
     ) :
         Statement(stmtNo),
         var(std::move(var)), 
@@ -343,16 +473,16 @@ public:
  */
 class IO : public Statement {
 protected:
-    std::unique_ptr<Var> var;
+    Ptr<Var> var;
 public:
     IO(
         int stmtNo,
-        std::unique_ptr<Var> var
+        Ptr<Var> var
     ) :
         Statement(stmtNo),
         var(std::move(var)) {}
 
-    const Var getVar() const { return *var; }
+    const Var& getVar() const { return *var; }
 
     virtual bool operator==(ASTNode const& o) const;
 };
@@ -443,12 +573,12 @@ enum class BinOp {
 class BinExpr: public Expr {
 private:
     BinOp Op;
-    std::unique_ptr<Expr> LHS, RHS;
+    Ptr<Expr> LHS, RHS;
 public:
     BinExpr(
         BinOp Op, 
-        std::unique_ptr<Expr> LHS, 
-        std::unique_ptr<Expr> RHS
+        Ptr<Expr> LHS, 
+        Ptr<Expr> RHS
     ) : 
         Op(Op), 
         LHS(std::move(LHS)), 
@@ -456,6 +586,8 @@ public:
 
     void accept(ASTNodeVisitor* visitor) const;
 
+    BinOp getOp() const { return Op; }
+
     virtual bool operator==(ASTNode const& o) const;
 };
 
@@ -488,12 +620,12 @@ enum class RelOp {
 class RelExpr : public CondExpr {
 private:
     RelOp Op;
-    std::unique_ptr<Expr> LHS, RHS;
+    Ptr<Expr> LHS, RHS;
 public:
     RelExpr(
         RelOp Op, 
-        std::unique_ptr<Expr> LHS, 
-        std::unique_ptr<Expr> RHS
+        Ptr<Expr> LHS, 
+        Ptr<Expr> RHS
     ) : 
         Op(Op), 
         LHS(std::move(LHS)), 
@@ -501,6 +633,8 @@ public:
 
     void accept(ASTNodeVisitor* visitor) const;
 
+    RelOp getOp() const { return Op; }
+
     virtual bool operator==(ASTNode const& o) const;
 };
 
@@ -529,12 +663,12 @@ enum class CondOp {
 class CondBinExpr : public CondExpr {
 private:
     CondOp Op;
-    std::unique_ptr<CondExpr> LHS, RHS;
+    Ptr<CondExpr> LHS, RHS;
 public:
     CondBinExpr(
         CondOp Op, 
-        std::unique_ptr<CondExpr> LHS, 
-        std::unique_ptr<CondExpr> RHS
+        Ptr<CondExpr> LHS, 
+        Ptr<CondExpr> RHS
     ) : 
         Op(Op), 
         LHS(std::move(LHS)), 
@@ -542,6 +676,8 @@ public:
 
     void accept(ASTNodeVisitor* visitor) const;
 
+    CondOp getOp() const { return Op; }
+
     virtual bool operator==(ASTNode const& o) const;
 };
 
@@ -557,10 +693,10 @@ public:
 class NotCondExpr : public CondExpr {
 private:
     CondOp Op = CondOp::NOT;
-    std::unique_ptr<CondExpr> condExpr;
+    Ptr<CondExpr> condExpr;
 public:
     NotCondExpr(
-        std::unique_ptr<CondExpr> condExpr
+        Ptr<CondExpr> condExpr
     ) : 
         condExpr(std::move(condExpr)) {}
 
@@ -643,8 +779,8 @@ std::unique_ptr<T> make(K arg1, H arg2, V arg3, Z arg4) {
  */
 template <typename ... Ts>
 StmtLst makeStmts(Ts &&... ts) {
-    std::unique_ptr<Statement> stmtArr[] = { std::move(ts)... };
-    auto lst = std::vector<std::unique_ptr<Statement>> { 
+    Ptr<Statement> stmtArr[] = { std::move(ts)... };
+    auto lst = std::vector<Ptr<Statement>> { 
         std::make_move_iterator(std::begin(stmtArr)), std::make_move_iterator(std::end(stmtArr))
     };
 
@@ -653,8 +789,8 @@ StmtLst makeStmts(Ts &&... ts) {
 
 template <typename ...Ts>
 std::unique_ptr<Program> makeProgram(Ts &&... ts) {
-    std::unique_ptr<Procedure> procArr[] = { std::move(ts)... };
-    auto lst = std::vector<std::unique_ptr<Procedure>> {
+    Ptr<Procedure> procArr[] = { std::move(ts)... };
+    auto lst = std::vector<Ptr<Procedure>> {
         std::make_move_iterator(std::begin(procArr)), std::make_move_iterator(std::end(procArr))
     };
     return std::make_unique<Program>(std::move(lst));
@@ -0,0 +1,234 @@
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Parser/ASTSnapshot.h"
+
+namespace sp {
+namespace ast {
+namespace {
+enum class Tag : std::uint8_t {
+    PROCEDURE, STMT_LST, IF, WHILE, READ, PRINT, ASSIGN, CALL, VAR, CONST, BIN_EXPR, REL_EXPR, COND_BIN_EXPR,
+    NOT_COND_EXPR
+};
+
+/**
+ * Writes every node as its tag followed by its own fields, in the order the nodes are visited. The children of a
+ * node follow it, and a statement list is preceded by its length, so the tree can be rebuilt without any offsets.
+ */
+class SnapshotWriter : public ASTNodeVisitor {
+public:
+    explicit SnapshotWriter(snapshot::Writer& out) : out(out) {}
+
+    void visit(const Program& node) override {
+        out.write<std::uint64_t>(node.getProcedures().size());
+    }
+    void visit(const Procedure& node) override {
+        writeTag(Tag::PROCEDURE);
+        out.writeName(node.getName());
+    }
+    void visit(const StmtLst& node) override {
+        writeTag(Tag::STMT_LST);
+        out.write<std::uint64_t>(node.size());
+    }
+    void visit(const If& node) override {
+        writeStatement(Tag::IF, node);
+    }
+    void visit(const While& node) override {
+        writeStatement(Tag::WHILE, node);
+    }
+    void visit(const Read& node) override {
+        writeStatement(Tag::READ, node);
+    }
+    void visit(const Print& node) override {
+        writeStatement(Tag::PRINT, node);
+    }
+    void visit(const Assign& node) override {
+        writeStatement(Tag::ASSIGN, node);
+    }
+    void visit(const Call& node) override {
+        writeStatement(Tag::CALL, node);
+        out.writeName(node.getName());
+    }
+    void visit(const Var& node) override {
+        writeTag(Tag::VAR);
+        out.writeName(node.getVarName());
+    }
+    void visit(const Const& node) override {
+        writeTag(Tag::CONST);
+        out.write<int>(node.getConstValue());
+    }
+    void visit(const BinExpr& node) override {
+        writeTag(Tag::BIN_EXPR);
+        out.write<char>(static_cast<char>(node.getOp()));
+    }
+    void visit(const RelExpr& node) override {
+        writeTag(Tag::REL_EXPR);
+        out.write<std::uint8_t>(static_cast<std::uint8_t>(node.getOp()));
+    }
+    void visit(const CondBinExpr& node) override {
+        writeTag(Tag::COND_BIN_EXPR);
+        out.write<std::uint8_t>(static_cast<std::uint8_t>(node.getOp()));
+    }
+    void visit(const NotCondExpr&) override {
+        writeTag(Tag::NOT_COND_EXPR);
+    }
+    void enterContainer(std::variant<int, std::string>) override {}
+    void exitContainer() override {}
+
+private:
+    snapshot::Writer& out;
+
+    void writeTag(Tag tag) {
+        out.write<Tag>(tag);
+    }
+
+    void writeStatement(Tag tag, const Statement& node) {
+        writeTag(tag);
+        out.write<int>(node.getStmtNo());
+    }
+};
+
+/**
+ * Rebuilds the nodes written by SnapshotWriter in the same order, so they are laid out in the arena as the parser
+ * would have laid them out.
+ */
+class SnapshotReader {
+public:
+    SnapshotReader(snapshot::Reader& in, Arena& arena) : in(in), arena(arena) {}
+
+    Ptr<Procedure> readProcedure() {
+        expect(Tag::PROCEDURE);
+        std::string name = in.readName();
+        return arena.make<Procedure>(name, readStmtLst());
+    }
+
+private:
+    snapshot::Reader& in;
+    Arena& arena;
+
+    Tag readTag() {
+        auto tag = in.read<Tag>();
+        if (tag > Tag::NOT_COND_EXPR) {
+            throw snapshot::SnapshotError("Unknown AST node in snapshot");
+        }
+        return tag;
+    }
+
+    void expect(Tag expected) {
+        if (readTag() != expected) {
+            throw snapshot::SnapshotError("Unexpected AST node in snapshot");
+        }
+    }
+
+    template <typename Op>
+    Op readOp(Op last) {
+        auto op = in.read<std::uint8_t>();
+        if (op > static_cast<std::uint8_t>(last)) {
+            throw snapshot::SnapshotError("Unknown operator in snapshot");
+        }
+        return static_cast<Op>(op);
+    }
+
+    StmtLst readStmtLst() {
+        expect(Tag::STMT_LST);
+        auto count = in.readCount();
+        std::vector<Ptr<Statement>> list;
+        for (std::size_t i = 0; i < count; i++) {
+            list.push_back(readStatement());
+        }
+        return StmtLst(list);
+    }
+
+    Ptr<Statement> readStatement() {
+        auto tag = readTag();
+        int stmtNo = in.read<int>();
+        switch (tag) {
+        case Tag::IF: {
+            auto condExpr = readCondExpr();
+            auto thenBlk = readStmtLst();
+            return arena.make<If>(stmtNo, std::move(condExpr), std::move(thenBlk), readStmtLst());
+        }
+        case Tag::WHILE: {
+            auto condExpr = readCondExpr();
+            return arena.make<While>(stmtNo, std::move(condExpr), readStmtLst());
+        }
+        case Tag::READ:
+            return arena.make<Read>(stmtNo, readVar());
+        case Tag::PRINT:
+            return arena.make<Print>(stmtNo, readVar());
+        case Tag::ASSIGN: {
+            auto var = readVar();
+            return arena.make<Assign>(stmtNo, std::move(var), readExpr());
+        }
+        case Tag::CALL:
+            return arena.make<Call>(stmtNo, in.readName());
+        default:
+            throw snapshot::SnapshotError("Unexpected AST node in snapshot");
+        }
+    }
+
+    Ptr<Var> readVar() {
+        expect(Tag::VAR);
+        return arena.make<Var>(in.readName());
+    }
+
+    Ptr<Expr> readExpr() {
+        switch (readTag()) {
+        case Tag::VAR:
+            return arena.make<Var>(in.readName());
+        case Tag::CONST:
+            return arena.make<Const>(in.read<int>());
+        case Tag::BIN_EXPR: {
+            auto op = static_cast<BinOp>(in.read<char>());
+            if (op != BinOp::PLUS && op != BinOp::MINUS && op != BinOp::DIVIDE && op != BinOp::MULT &&
+                op != BinOp::MOD) {
+                throw snapshot::SnapshotError("Unknown operator in snapshot");
+            }
+            auto lhs = readExpr();
+            return arena.make<BinExpr>(op, std::move(lhs), readExpr());
+        }
+        default:
+            throw snapshot::SnapshotError("Unexpected AST node in snapshot");
+        }
+    }
+
+    Ptr<CondExpr> readCondExpr() {
+        switch (readTag()) {
+        case Tag::REL_EXPR: {
+            auto op = readOp(RelOp::NE);
+            auto lhs = readExpr();
+            return arena.make<RelExpr>(op, std::move(lhs), readExpr());
+        }
+        case Tag::COND_BIN_EXPR: {
+            auto op = readOp(CondOp::OR);
+            auto lhs = readCondExpr();
+            return arena.make<CondBinExpr>(op, std::move(lhs), readCondExpr());
+        }
+        case Tag::NOT_COND_EXPR:
+            return arena.make<NotCondExpr>(readCondExpr());
+        default:
+            throw snapshot::SnapshotError("Unexpected AST node in snapshot");
+        }
+    }
+};
+}  // namespace
+
+void write(snapshot::Writer& out, const Program& program) {
+    SnapshotWriter writer(out);
+    program.accept(&writer);
+}
+
+std::unique_ptr<Program> readProgram(snapshot::Reader& in) {
+    auto arena = std::make_unique<Arena>();
+    auto count = in.readCount();
+    std::vector<Ptr<Procedure>> procedures;
+    SnapshotReader reader(in, *arena);
+    for (std::size_t i = 0; i < count; i++) {
+        procedures.push_back(reader.readProcedure());
+    }
+    return std::make_unique<Program>(std::move(procedures), std::move(arena));
+}
+}  // namespace ast
+}  // namespace sp
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <memory>
+
+#include "Parser/AST.h"
+#include "Snapshot.h"
+
+namespace sp {
+namespace ast {
+/**
+ * @brief Writes a program to a snapshot as a preorder walk of its nodes.
+ */
+void write(snapshot::Writer& out, const Program& program);
+
+/**
+ * @brief Reads a program written by write, with every node allocated from an arena the program owns.
+ * @throws snapshot::SnapshotError if the snapshot does not hold a valid program.
+ */
+std::unique_ptr<Program> readProgram(snapshot::Reader& in);
+}  // namespace ast
+}  // namespace sp
@@ -20,7 +20,7 @@ void logQueue(std::deque<Token> q) {
     }
     oss << "]";
 
-    Logger(Level::DEBUG) << "Lexer.cpp " << "Tokens: " << oss.str();
+    LOG(Level::DEBUG) << "Lexer.cpp " << "Tokens: " << oss.str();
 }
 #endif  // _DEBUG
 
@@ -30,10 +30,10 @@ void logQueue(std::deque<Token> q) {
  * This lex method currently has no failure conditions as all unrecognized symbols
  * are considered as special characters.
  */
-void Lexer::lex(const std::string& source) {
-    Logger() << "Lexer.cpp " << "Lexing the source code:\n" << source;
+void Lexer::lex(const std::string& source, SourceLineCount firstLine) {
+    LOG(Level::INFO) << "Lexer.cpp " << "Lexing the source code:\n" << source;
     // keeps track of source line
-    SourceLineCount count = 1;
+    SourceLineCount count = firstLine;
 
     char lastChar = ' ';
     for (auto it = source.begin(); it != source.end(); it++) {
@@ -65,7 +65,7 @@ void Lexer::lex(const std::string& source) {
             if (s.length() > 1 && s[0] == '0') {
                 std::ostringstream os;
                 os << "Number cannot start with 0 at line: " << count;
-                Logger(Level::ERROR) << os.str();
+                LOG(Level::ERROR) << os.str();
                 throw std::invalid_argument(os.str());
             }
             int number = strtod(s.c_str(), nullptr);
@@ -81,7 +81,10 @@ void Lexer::lex(const std::string& source) {
     this->tokens.push_back(Token{TokenType::eof, EOF, count});
 
 #ifdef _DEBUG
-    logQueue(this->tokens);
+    // the token dump copies the whole queue, so it is only built when it is going to be printed
+    if (logging::isEnabled(Level::DEBUG)) {
+        logQueue(this->tokens);
+    }
 #endif  // _DEBUG
 }
 
@@ -37,10 +37,14 @@ struct Token {
 class Lexer {
 private:
     std::deque<Token> tokens;
-    void lex(const std::string& source);
+    void lex(const std::string& source, SourceLineCount firstLine);
 public:
-    explicit Lexer(const std::string& source) {
-        this->lex(source);
+    /**
+     * @param source the source code to lex.
+     * @param firstLine the source line the code starts at, for code cut out of a larger source.
+     */
+    explicit Lexer(const std::string& source, SourceLineCount firstLine = 1) {
+        this->lex(source, firstLine);
     }
     std::deque<Token>& getTokens();
 };
@@ -9,17 +9,21 @@
 #include <utility>
 #include <unordered_map>
 #include <set>
+#include <algorithm>
+#include <exception>
+#include <optional>
 
 #include "Lexer.h"
 #include "Parser.h"
 #include "logging.h"
 #include "AST.h"
 #include "Validator.h"
+#include "ThreadPool.h"
+#include "PhaseProfile.h"
 
 namespace sp {
 namespace parser {
 
-using std::make_unique;
 using std::move;
 using std::unique_ptr;
 using std::deque;
@@ -31,13 +35,40 @@ using std::cout;
 using std::endl;
 using std::vector;
 
-int lineCount = 1;
-std::unordered_map<int, std::string> callStmts;
-std::set<std::string> procedures;
+namespace {
+thread_local ParseState threadState;  // used by the component parsers when no parse is in progress
+thread_local ParseState* activeState = nullptr;
+}  // namespace
+
+ParseState& currentState() {
+    return activeState ? *activeState : threadState;
+}
+
+ParseStateScope::ParseStateScope(ParseState* state) : previous(activeState) {
+    activeState = state;
+}
+
+ParseStateScope::~ParseStateScope() {
+    activeState = previous;
+}
+
 /** =============================== HELPER METHODS ================================ */
 
+/**
+ * @brief Constructs an AST node in the arena of the program being parsed.
+ * @details Falls back to a heap allocation when no program is being parsed, e.g. when
+ * an expression is parsed on its own for pattern matching.
+ */
+template <class T, typename... Args>
+ast::Ptr<T> makeNode(Args&&... args) {
+    if (auto arena = currentState().arena) {
+        return arena->make<T>(std::forward<Args>(args)...);
+    }
+    return ast::Ptr<T>(new T(std::forward<Args>(args)...));
+}
+
 void throwInvalidArgError(string msg) {
-    Logger(Level::ERROR) << msg;
+    LOG(Level::ERROR) << msg;
     throw invalid_argument(msg);
 }
 
@@ -80,24 +111,24 @@ namespace AtomicParser {
 /**
  * Parses constants
  */
-unique_ptr<ast::Const> parseConst(deque<Token>& tokens) {
+ast::Ptr<ast::Const> parseConst(deque<Token>& tokens) {
     Token currToken = getNextToken(tokens);
     if (currToken.type != TokenType::number) {
         throwUnexpectedToken("Number", currToken.sourceline);
     }
-    return make_unique<ast::Const>(get<int>(currToken.value));
+    return makeNode<ast::Const>(get<int>(currToken.value));
 }
 
 /**
  * Parses variable names
  */
-unique_ptr<ast::Var> parseVariable(deque<Token>& tokens) {
+ast::Ptr<ast::Var> parseVariable(deque<Token>& tokens) {
     Token varToken = getNextToken(tokens);
     string* varName = get_if<string>(&varToken.value);
     if (!varName) {
         throwUnexpectedToken("Name", varToken.sourceline);
     }
-    return make_unique<ast::Var>(*varName); 
+    return makeNode<ast::Var>(*varName); 
 }
 
 ast::RelOp parseRelOp(deque<Token>& tokens) {
@@ -218,7 +249,7 @@ std::unordered_map<char, int> binOpPrecedence = {
  * @param operands  a reference to a stack of operands
  * @param operators a reference to a stack of operators
  */
-void popAndPush(std::stack<std::unique_ptr<ast::Expr>>& operands, std::stack<char>& operators) {
+void popAndPush(std::stack<ast::Ptr<ast::Expr>>& operands, std::stack<char>& operators) {
     if (operands.size() < 2) {
         throwInvalidArgError("More tokens (for Expr Parsing) expected");
     }
@@ -227,7 +258,7 @@ void popAndPush(std::stack<std::unique_ptr<ast::Expr>>& operands, std::stack<cha
     operands.pop();
     auto expr2 = move(operands.top());
     operands.pop();
-    operands.push(make_unique<ast::BinExpr>(AtomicParser::binOpMap[top], move(expr2), move(expr1)));
+    operands.push(makeNode<ast::BinExpr>(AtomicParser::binOpMap[top], move(expr2), move(expr1)));
     operators.pop();
 }
 
@@ -239,7 +270,7 @@ void popAndPush(std::stack<std::unique_ptr<ast::Expr>>& operands, std::stack<cha
  * @param operand    an operand that is being parsed
  */
 void handleOperand(
-    std::stack<std::unique_ptr<ast::Expr>>& operands, 
+    std::stack<ast::Ptr<ast::Expr>>& operands, 
     std::stack<char>& operators, 
     char operand) {
     while (!operators.empty()) {
@@ -262,7 +293,7 @@ void handleOperand(
  * @param operators a reference to a stack of operators
  * @return a bool indicating whether it is the end of an expression or not  
  */
-bool handleClosingParen(std::stack<std::unique_ptr<ast::Expr>>& operands, std::stack<char>& operators) {
+bool handleClosingParen(std::stack<ast::Ptr<ast::Expr>>& operands, std::stack<char>& operators) {
     while (!operators.empty()) {
         char top = operators.top();
         if (top == '(') {
@@ -273,9 +304,9 @@ bool handleClosingParen(std::stack<std::unique_ptr<ast::Expr>>& operands, std::s
     return true;
 }
 
-unique_ptr<ast::Expr> shuntingYardParser(deque<Token>& tokens) {
+ast::Ptr<ast::Expr> shuntingYardParser(deque<Token>& tokens) {
     // converting from infix to postfix expr
-    std::stack<std::unique_ptr<ast::Expr>> operands;
+    std::stack<ast::Ptr<ast::Expr>> operands;
     deque<Token> queue;
     std::stack<char> operators;
     SourceLineCount lastLineCount = tokens.front().sourceline;
@@ -337,7 +368,7 @@ unique_ptr<ast::Expr> shuntingYardParser(deque<Token>& tokens) {
     return move(operands.top());
 }
 
-unique_ptr<ast::Expr> parse(deque<Token>& tokens) {
+ast::Ptr<ast::Expr> parse(deque<Token>& tokens) {
     // can be a name | const | binExpr | '(' expr ')'
     return shuntingYardParser(tokens);
 }
@@ -347,12 +378,12 @@ unique_ptr<ast::Expr> parse(deque<Token>& tokens) {
 /** =============================== CONDEXPR PARSER =============================== */
 namespace cond_expr_parser {
 
-unique_ptr<ast::CondExpr> parseRelExpr(deque<Token>& tokens) {
+ast::Ptr<ast::CondExpr> parseRelExpr(deque<Token>& tokens) {
     auto lhsExpr = expr_parser::parse(tokens);
     // the symbols '>', '>=', '<', '<=', '==', '!='
     auto relOp = AtomicParser::parseRelOp(tokens);
     auto rhsExpr = expr_parser::parse(tokens);
-    return make_unique<ast::RelExpr>(relOp, move(lhsExpr), move(rhsExpr));
+    return makeNode<ast::RelExpr>(relOp, move(lhsExpr), move(rhsExpr));
 }
 
 /**
@@ -386,9 +417,9 @@ bool isCondExpr(deque<Token>& tokens) {
     return false;
 }
 
-unique_ptr<ast::CondExpr> parse(deque<Token>& tokens) {
+ast::Ptr<ast::CondExpr> parse(deque<Token>& tokens) {
     Token currToken = tokens.front();
-    unique_ptr<ast::CondExpr> condExprResult;
+    ast::Ptr<ast::CondExpr> condExprResult;
     try {
         if (currToken.type == TokenType::special) {
             // we have to "unwrap" the "(...)" or "!(...)"
@@ -397,7 +428,7 @@ unique_ptr<ast::CondExpr> parse(deque<Token>& tokens) {
                 // This means: "!(condExpr)"
                 tokens.pop_front();  // consume the '!'
                 checkAndConsume('(', tokens);
-                condExprResult = make_unique<ast::NotCondExpr>(move(parse(tokens)));
+                condExprResult = makeNode<ast::NotCondExpr>(move(parse(tokens)));
                 checkAndConsume(')', tokens);
             } else if (tokenVal == '(') {
                 if (isCondExpr(tokens)) {
@@ -426,7 +457,7 @@ unique_ptr<ast::CondExpr> parse(deque<Token>& tokens) {
         // otherwise, we still need to handle the other clause.
         auto condOp = move(AtomicParser::parseCondOp(tokens));
         auto rhsCondExprResult = move(parse(tokens));
-        return make_unique<ast::CondBinExpr>(condOp, move(condExprResult), move(rhsCondExprResult));
+        return makeNode<ast::CondBinExpr>(condOp, move(condExprResult), move(rhsCondExprResult));
     } catch (std::exception e) {
         throwInvalidArgError("CondExpr fails to parse at line: " + std::to_string(currToken.sourceline));
     }
@@ -436,35 +467,35 @@ unique_ptr<ast::CondExpr> parse(deque<Token>& tokens) {
 /** ================================= STMT PARSER ================================= */
 namespace statement_list_parser {
 
-unique_ptr<ast::Statement> parseReadStmt(deque<Token>& tokens) {
-    int lineNo = lineCount++;
+ast::Ptr<ast::Statement> parseReadStmt(deque<Token>& tokens) {
+    int lineNo = currentState().lineCount++;
     checkAndConsume("read", tokens);
     auto var = AtomicParser::parseVariable(tokens);
     checkAndConsume(';', tokens);
-    return make_unique<ast::Read>(lineNo, move(var));
+    return makeNode<ast::Read>(lineNo, move(var));
 }
 
-unique_ptr<ast::Statement> parsePrintStmt(deque<Token>& tokens) {
-    int lineNo = lineCount++;
+ast::Ptr<ast::Statement> parsePrintStmt(deque<Token>& tokens) {
+    int lineNo = currentState().lineCount++;
     checkAndConsume("print", tokens);
     auto var = AtomicParser::parseVariable(tokens);
     checkAndConsume(';', tokens);
-    return make_unique<ast::Print>(lineNo, move(var));
+    return makeNode<ast::Print>(lineNo, move(var));
 }
 
-unique_ptr<ast::Statement> parseAssignStmt(deque<Token>& tokens) {
-    int lineNo = lineCount++;
+ast::Ptr<ast::Statement> parseAssignStmt(deque<Token>& tokens) {
+    int lineNo = currentState().lineCount++;
     // get the var being assigned
     auto var = AtomicParser::parseVariable(tokens);
     checkAndConsume('=', tokens);
     // parse the expr on the right hand side
     auto rhsExpr = expr_parser::parse(tokens);
     checkAndConsume(';', tokens);
-    return make_unique<ast::Assign>(lineNo, move(var), move(rhsExpr));
+    return makeNode<ast::Assign>(lineNo, move(var), move(rhsExpr));
 }
 
-unique_ptr<ast::Statement> parseWhileStmt(deque<Token>& tokens) {
-    int lineNo = lineCount++;
+ast::Ptr<ast::Statement> parseWhileStmt(deque<Token>& tokens) {
+    int lineNo = currentState().lineCount++;
     // check for "while"
     checkAndConsume("while", tokens);
     checkAndConsume('(', tokens);
@@ -474,13 +505,13 @@ unique_ptr<ast::Statement> parseWhileStmt(deque<Token>& tokens) {
     auto stmtLstResult = parse(tokens);
     checkAndConsume('}', tokens);
 
-    return make_unique<ast::While>(
+    return makeNode<ast::While>(
         lineNo, move(condExprResult), move(stmtLstResult)
     );
 }
 
-unique_ptr<ast::Statement> parseIfStmt(deque<Token>& tokens) {
-    int lineNo = lineCount++;
+ast::Ptr<ast::Statement> parseIfStmt(deque<Token>& tokens) {
+    int lineNo = currentState().lineCount++;
     
     // check for "if"
     checkAndConsume("if", tokens);
@@ -500,7 +531,7 @@ unique_ptr<ast::Statement> parseIfStmt(deque<Token>& tokens) {
     auto elseStmtLst = parse(tokens);
     checkAndConsume('}', tokens);
 
-    return make_unique<ast::If>(
+    return makeNode<ast::If>(
         lineNo,
         move(condExprResult),
         move(thenStmtLst),
@@ -508,8 +539,8 @@ unique_ptr<ast::Statement> parseIfStmt(deque<Token>& tokens) {
     );
 }
 
-unique_ptr<ast::Statement> parseCallStmt(deque<Token>& tokens) {
-    int lineNo = lineCount++;
+ast::Ptr<ast::Statement> parseCallStmt(deque<Token>& tokens) {
+    int lineNo = currentState().lineCount++;
     checkAndConsume("call", tokens);
     // get procName
     auto currToken = getNextToken(tokens);
@@ -520,15 +551,15 @@ unique_ptr<ast::Statement> parseCallStmt(deque<Token>& tokens) {
     string procName = get<string>(currToken.value);
     checkAndConsume(';', tokens);
     // insert into callStmts tracker
-    callStmts[sourceline] = procName;
-    return make_unique<ast::Call>(
+    currentState().callStmts[sourceline] = procName;
+    return makeNode<ast::Call>(
         lineNo,
         procName
     );
 }
 
 ast::StmtLst parse(deque<Token>& tokens) {
-    vector<unique_ptr<ast::Statement>> list;
+    vector<ast::Ptr<ast::Statement>> list;
     do {
         Token currToken = tokens.front();
         string* keyword = get_if<string>(&currToken.value);
@@ -559,7 +590,7 @@ ast::StmtLst parse(deque<Token>& tokens) {
 
 /** ============================== HIGH-LEVEL PARSERS =============================== */
 
-unique_ptr<ast::Procedure> parseProcedure(deque<Token>& tokens) {
+ast::Ptr<ast::Procedure> parseProcedure(deque<Token>& tokens) {
     // consume "procedure"
     checkAndConsume("procedure", tokens);
     // get procName
@@ -572,20 +603,58 @@ unique_ptr<ast::Procedure> parseProcedure(deque<Token>& tokens) {
     checkAndConsume('{', tokens);
     auto stmtLst = statement_list_parser::parse(tokens);
     checkAndConsume('}', tokens);
+    auto& procedures = currentState().procedures;
     if (procedures.count(procName)) {
         std::ostringstream os;
         os << "Repeated procedure name: \"" << procName << "\" at line: " << currToken.sourceline;
         throwInvalidArgError(os.str());
     }
     procedures.insert(procName);
-    return make_unique<ast::Procedure>(move(procName), move(stmtLst));
+    return makeNode<ast::Procedure>(move(procName), move(stmtLst));
+}
+
+/**
+ * @brief Checks the program level constraints on the procedures of a parse and assembles the program.
+ * 
+ * @param procedures the procedures of the program in source order.
+ * @param programArena the arena that owns the nodes of all the procedures.
+ * @param state the state of the parse, holding all the procedure names and call statements.
+ */
+unique_ptr<ast::Program> assembleProgram(
+    std::vector<ast::Ptr<ast::Procedure>> procedures,
+    std::unique_ptr<ast::Arena> programArena,
+    const ParseState& state
+) {
+    // check if the call statements are calling existent procedures
+    for (auto callStmt : state.callStmts) {
+        if (!state.procedures.count(callStmt.second)) {
+            std::ostringstream os;
+            os << "Calling a non-existent procedure: " 
+            << callStmt.second << " at line: " << callStmt.first << "";
+            throwInvalidArgError(os.str());
+        }
+    }
+
+    auto ast = std::make_unique<ast::Program>(move(procedures), move(programArena));
+    if (isCyclicCalls(ast.get())) {
+        throw invalid_argument("Cyclical call detected");
+    }
+    return ast;
 }
 
 unique_ptr<ast::Program> parseProgram(deque<Token>& tokens) {
     if (tokens.empty() || tokens.front().type == TokenType::eof) {
         throwInvalidArgError("Empty program received");
     }
-    std::vector<unique_ptr<ast::Procedure>> res;
+    // every node of the program is allocated from an arena that the program owns.
+    auto programArena = std::make_unique<ast::Arena>();
+    struct ArenaScope {
+        ast::Arena* previous;
+        explicit ArenaScope(ast::Arena* current) : previous(currentState().arena) { currentState().arena = current; }
+        ~ArenaScope() { currentState().arena = previous; }
+    } scope(programArena.get());
+
+    std::vector<ast::Ptr<ast::Procedure>> res;
     while (!tokens.empty() && tokens.front().type != TokenType::eof) {
         if (tokens.front().type != TokenType::name || get<string>(tokens.front().value) != "procedure") {
             throwUnexpectedToken("\"procedure\"", tokens.front().sourceline);
@@ -594,35 +663,189 @@ unique_ptr<ast::Program> parseProgram(deque<Token>& tokens) {
     }
 
     Token currToken = getNextToken(tokens);  // consume eof
-    // check if the call statements are calling existent procedures
-    for (auto callStmt : callStmts) {
-        if (!procedures.count(callStmt.second)) {
+    return assembleProgram(move(res), move(programArena), currentState());
+}
+
+/** ============================= PARALLEL FRONT END ============================== */
+namespace {
+/**
+ * A top level procedure cut out of the source.
+ */
+struct ProcedureSource {
+    string source;
+    SourceLineCount firstLine;
+};
+
+/**
+ * @brief Splits the source at the top level procedure boundaries, i.e. after every '}' that closes the
+ * outermost '{' of a procedure.
+ * 
+ * @return the procedures in source order, or nullopt if the braces do not delimit a sequence of blocks.
+ * Such sources are left to the sequential parser, which reports the error.
+ */
+std::optional<vector<ProcedureSource>> splitProcedures(const string& source) {
+    vector<ProcedureSource> result;
+    SourceLineCount line = 1;
+    SourceLineCount startLine = 1;
+    std::size_t start = string::npos;
+    int depth = 0;
+    for (std::size_t i = 0; i < source.size(); i++) {
+        char c = source[i];
+        if (c == '\n') {
+            line++;
+        }
+        if (start == string::npos) {
+            if (isspace(static_cast<unsigned char>(c))) {
+                continue;
+            }
+            start = i;
+            startLine = line;
+        }
+        if (c == '{') {
+            depth++;
+        } else if (c == '}') {
+            if (--depth < 0) {
+                return std::nullopt;
+            }
+            if (depth == 0) {
+                result.push_back(ProcedureSource{source.substr(start, i + 1 - start), startLine});
+                start = string::npos;
+            }
+        }
+    }
+    if (start != string::npos) {
+        return std::nullopt;
+    }
+    return result;
+}
+
+/**
+ * The result of parsing a single procedure on its own, with its statements numbered from 1.
+ */
+struct ParsedProcedure {
+    std::unique_ptr<ast::Arena> arena;  // declared first so that it is destroyed after the procedure.
+    ast::Ptr<ast::Procedure> procedure;
+    SourceLineCount nameLine = 0;
+    ParseState state;
+    std::exception_ptr syntaxError;  // an invalid_argument from the parser, turned into a failed parse.
+    std::exception_ptr fatalError;  // anything the sequential front end would let through, e.g. lexing errors.
+    deque<Token> tokens;  // only kept between lexing and parsing the procedure.
+};
+
+void lexProcedureSource(const ProcedureSource& procSource, ParsedProcedure& result) {
+    try {
+        result.tokens = Lexer(procSource.source, procSource.firstLine).getTokens();
+    } catch (...) {
+        result.fatalError = std::current_exception();
+    }
+}
+
+void parseProcedureSource(const ProcedureSource& procSource, ParsedProcedure& result) {
+    if (result.fatalError) {
+        return;
+    }
+    // sized after the procedure so that small procedures do not each reserve a full block.
+    result.arena = std::make_unique<ast::Arena>(
+        std::clamp<std::size_t>(procSource.source.size() * 16, 4096, ast::Arena::DEFAULT_BLOCK_SIZE));
+    result.state.arena = result.arena.get();
+    ParseStateScope scope(&result.state);
+
+    deque<Token> tokens = move(result.tokens);
+    try {
+        if (tokens.front().type != TokenType::name || get<string>(tokens.front().value) != "procedure") {
+            throwUnexpectedToken("\"procedure\"", tokens.front().sourceline);
+        }
+        if (tokens.size() > 1) {
+            result.nameLine = tokens[1].sourceline;
+        }
+        result.procedure = parseProcedure(tokens);
+        if (tokens.front().type != TokenType::eof) {
+            throwUnexpectedToken("\"procedure\"", tokens.front().sourceline);
+        }
+    } catch (invalid_argument&) {
+        result.syntaxError = std::current_exception();
+    } catch (...) {
+        result.fatalError = std::current_exception();
+    }
+}
+
+/**
+ * @brief Places independently parsed procedures one after another in a single program.
+ */
+unique_ptr<ast::Program> mergeProcedures(vector<ParsedProcedure>& parsed) {
+    auto programArena = std::make_unique<ast::Arena>();
+    ParseState merged;
+    std::vector<ast::Ptr<ast::Procedure>> procedures;
+    int offset = 0;
+    for (auto& result : parsed) {
+        string procName = result.procedure->getName();
+        if (merged.procedures.count(procName)) {
             std::ostringstream os;
-            os << "Calling a non-existent procedure: " 
-            << callStmt.second << " at line: " << callStmt.first << "";
+            os << "Repeated procedure name: \"" << procName << "\" at line: " << result.nameLine;
             throwInvalidArgError(os.str());
         }
-    }
+        merged.procedures.insert(procName);
+        merged.callStmts.insert(result.state.callStmts.begin(), result.state.callStmts.end());
 
-    auto ast = make_unique<ast::Program>(move(res));
-    if (isCyclicCalls(ast.get())) {
-        throw invalid_argument("Cyclical call detected");
+        if (offset != 0) {
+            result.procedure->shiftStmtNo(offset);
+        }
+        offset += result.state.lineCount - 1;
+
+        programArena->absorb(move(*result.arena));
+        procedures.push_back(move(result.procedure));
     }
-    return ast;
+    return assembleProgram(move(procedures), move(programArena), merged);
 }
+}  // namespace
+
+unique_ptr<ast::Program> parse(const string& source, PhaseProfile* profile) {
+    auto procSources = PhaseProfile::time(profile, "lex", [&]() { return splitProcedures(source); });
+    if (!procSources || procSources->size() < 2) {
+        // nothing to split, parse the program as a whole.
+        ParseState state;
+        ParseStateScope scope(&state);
+        // we first tokenise the source code
+        deque<Token> lexedTokens = PhaseProfile::time(profile, "lex", [&]() { return Lexer(source).getTokens(); });
+        try {
+            return PhaseProfile::time(profile, "parse", [&]() { return parseProgram(lexedTokens); });
+        }
+        catch (invalid_argument ex) {
+            LOG(Level::ERROR) << "Exception caught: " << ex.what();
+            return unique_ptr<ast::Program>();
+        }
+    }
 
-unique_ptr<ast::Program> parse(const string& source) {
-    // new program, reset state.
-    lineCount = 1;
-    callStmts.clear();
-    procedures.clear();
-    // we first tokenise the source code
-    deque<Token> lexedTokens = Lexer(source).getTokens();
+    // every procedure is lexed before any is parsed, so that each phase is timed by the wall clock rather than
+    // summed over the workers.
+    vector<ParsedProcedure> parsed(procSources->size());
+    PhaseProfile::time(profile, "lex", [&]() {
+        ThreadPool::shared().parallelFor(parsed.size(), [&](std::size_t i) {
+            lexProcedureSource((*procSources)[i], parsed[i]);
+        });
+    });
+    PhaseProfile::time(profile, "parse", [&]() {
+        ThreadPool::shared().parallelFor(parsed.size(), [&](std::size_t i) {
+            parseProcedureSource((*procSources)[i], parsed[i]);
+        });
+    });
+    // errors are reported for the first procedure that has one, lexing errors first as the
+    // sequential front end lexes the whole source before parsing.
+    for (auto& result : parsed) {
+        if (result.fatalError) {
+            std::rethrow_exception(result.fatalError);
+        }
+    }
     try {
-        return parseProgram(lexedTokens);
+        for (auto& result : parsed) {
+            if (result.syntaxError) {
+                std::rethrow_exception(result.syntaxError);
+            }
+        }
+        return PhaseProfile::time(profile, "parse", [&]() { return mergeProcedures(parsed); });
     }
     catch (invalid_argument ex) {
-        Logger(Level::ERROR) << "Exception caught: " << ex.what();
+        LOG(Level::ERROR) << "Exception caught: " << ex.what();
         return unique_ptr<ast::Program>();
     }
 }
@@ -7,15 +7,43 @@
 
 #include "AST.h"
 #include "Lexer.h"
+#include "PhaseProfile.h"
 
 namespace sp {
 namespace parser {
-extern int lineCount;  // keep track of line number
-extern std::unordered_map<int, std::string> callStmts;  // keep track of all the call statements
-extern std::set<std::string> procedures;  // keep track of all the procedures (procNames)
+/**
+ * @brief The mutable state of a single parse.
+ * @details Every parse has its own state, so parses can run concurrently on different threads and a
+ * parse can be started while another one is in progress.
+ */
+struct ParseState {
+    int lineCount = 1;  // keep track of line number
+    std::unordered_map<int, std::string> callStmts;  // keep track of all the call statements
+    std::set<std::string> procedures;  // keep track of all the procedures (procNames)
+    ast::Arena* arena = nullptr;  // arena of the program being parsed, nodes go to the heap when unset
+};
+
+/**
+ * @return the state of the parse running on the calling thread. Outside of a ParseStateScope, this is
+ * a default state owned by the thread, which the component parsers below use when called directly.
+ */
+ParseState& currentState();
+
+/**
+ * @brief Makes a state the current one of the calling thread for the lifetime of the scope.
+ */
+class ParseStateScope {
+private:
+    ParseState* previous;
+public:
+    explicit ParseStateScope(ParseState* state);
+    ~ParseStateScope();
+    ParseStateScope(const ParseStateScope&) = delete;
+    ParseStateScope& operator=(const ParseStateScope&) = delete;
+};
 
 namespace expr_parser {
-    std::unique_ptr<ast::Expr> parse(std::deque<Token>& tokens);
+    ast::Ptr<ast::Expr> parse(std::deque<Token>& tokens);
 }  // namespace expr_parser
 
 namespace statement_list_parser {
@@ -23,12 +51,21 @@ namespace statement_list_parser {
 }  // namespace statement_list_parser
 
 namespace cond_expr_parser {
-    std::unique_ptr<ast::CondExpr> parse(std::deque<Token>& tokens);
+    ast::Ptr<ast::CondExpr> parse(std::deque<Token>& tokens);
 }  // namespace cond_expr_parser
 
-// can expose this under the namespace
-std::unique_ptr<ast::Program> parse(const std::string& source);  // main method that parses the source code
-std::unique_ptr<ast::Procedure> parseProcedure(std::deque<Token>& tokens);
+/**
+ * @brief Main method that parses the source code.
+ * @details The source is first split at the top level procedure boundaries. Each procedure is then lexed
+ * and parsed on its own on the shared thread pool, with its statements numbered from 1, and the statements
+ * are renumbered by the offset of their procedure at the end.
+ *
+ * @param profile if given, records the time spent lexing and parsing. The procedures are lexed and parsed in
+ * parallel, so their times are summed over the procedures and can add up to more than the time parse takes.
+ * @return the program, or nullptr if the source is not a valid SIMPLE program.
+ */
+std::unique_ptr<ast::Program> parse(const std::string& source, PhaseProfile* profile = nullptr);
+ast::Ptr<ast::Procedure> parseProcedure(std::deque<Token>& tokens);
 std::unique_ptr<ast::Program> parseProgram(std::deque<Token>& tokens);
 
 }  // namespace parser
@@ -0,0 +1,74 @@
+/*
+ * Wall clock time taken by each phase of processing a SIMPLE source, e.g. lexing, parsing, building the CFG and
+ * every design extractor module.
+ *
+ * Example Usage:
+ * auto tokens = sp::PhaseProfile::time(profile, "lex", [&]() { return Lexer(source).getTokens(); });
+ */
+
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace sp {
+class PhaseProfile {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Adds the duration to the time of the phase. Phases are kept in the order they first ran.
+     */
+    void add(const std::string& phase, Clock::duration duration) {
+        double ms = std::chrono::duration<double, std::milli>(duration).count();
+        for (auto& [name, total] : phases) {
+            if (name == phase) {
+                total += ms;
+                return;
+            }
+        }
+        phases.emplace_back(phase, ms);
+    }
+
+    /**
+     * Runs f and adds the time it took to the phase of the profile. f is simply run if there is no profile, so
+     * that the phases do not have to be timed when nobody is looking at them.
+     *
+     * @return what f returns
+     */
+    template <typename F>
+    static decltype(auto) time(PhaseProfile* profile, const std::string& phase, F&& f) {
+        if (!profile) return f();
+        auto start = Clock::now();
+        if constexpr (std::is_void_v<decltype(f())>) {
+            f();
+            profile->add(phase, Clock::now() - start);
+        } else {
+            decltype(auto) result = f();
+            profile->add(phase, Clock::now() - start);
+            return result;
+        }
+    }
+
+    /**
+     * @return the phases and their time in milliseconds, in the order they first ran.
+     */
+    const std::vector<std::pair<std::string, double>>& getPhases() const { return phases; }
+
+    /**
+     * @return the time of the phase in milliseconds, or 0 if it never ran.
+     */
+    double getMs(const std::string& phase) const {
+        for (auto& [name, total] : phases) {
+            if (name == phase) return total;
+        }
+        return 0;
+    }
+
+private:
+    std::vector<std::pair<std::string, double>> phases;
+};
+}  // namespace sp
@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <functional>
+
 #include "exceptions.h"
 #include "ClauseHandler.h"
 
@@ -44,16 +47,18 @@ namespace qps::evaluator {
         }
     }
 
-    void ClauseHandler::handleSynRelRef(std::shared_ptr<query::RelRef> clause) {
+    ClauseResult ClauseHandler::handleSynRelRef(std::shared_ptr<query::RelRef> clause) {
         query::RelRef *relRefPtr = clause.get();
         std::vector<query::Declaration> declarations = relRefPtr->getDecs();
-        std::vector<std::string> synonyms{};
+        std::vector<query::SynonymId> synonyms{};
         for (auto d : declarations) {
-            synonyms.push_back(d.getSynonym());
+            synonyms.push_back(d.getId());
         }
         std::vector<PKBField> fields = relRefPtr->getField();
-        PKBResponse response = pkb->getRelationship(fields[0], fields[1],
-                                                    PKBTypeMatcher::getPKBRelationship(relRefPtr->getType()));
+        PKBResponse response = lookup([&]() {
+            return pkb->getRelationship(fields[0], fields[1], PKBTypeMatcher::getPKBRelationship(relRefPtr->getType()),
+                                        token);
+        });
         bool isFirstSyn = fields[0].fieldType == PKBFieldType::DECLARATION;
         bool isSecondSyn = fields[1].fieldType == PKBFieldType::DECLARATION;
         if (!isFirstSyn || !isSecondSyn) {
@@ -62,7 +67,7 @@ namespace qps::evaluator {
             synonyms.pop_back();
             filterPKBResponse(response);
         }
-        tableRef.insert(response, synonyms);
+        return ClauseResult{response, synonyms};
     }
 
     bool ClauseHandler::handleNoSynRelRef(const std::shared_ptr<query::RelRef>& noSynClauses) {
@@ -70,17 +75,16 @@ namespace qps::evaluator {
         PKBField field1 = relRefPtr->getField()[0];
         PKBField field2 = relRefPtr->getField()[1];
         PKBRelationship relationship = PKBTypeMatcher::getPKBRelationship(relRefPtr->getType());
-        if (!pkb->getRelationship(field1, field2, relationship).hasResult) return false;
-        return true;
+        return lookup([&]() { return pkb->getRelationship(field1, field2, relationship, token).hasResult; });
     }
 
-    void ClauseHandler::handlePattern(query::Pattern pattern) {
+    ClauseResult ClauseHandler::handlePattern(query::Pattern pattern) {
         using sp::design_extractor::PatternParam;
 
         StatementType statementType = PKBTypeMatcher::getStatementType(pattern.getSynonymType());
         query::EntRef lhs = pattern.getEntRef();
-        std::vector<std::string> synonyms{pattern.getSynonym()};
-        if (lhs.isDeclaration()) synonyms.push_back(lhs.getDeclarationSynonym());
+        std::vector<query::SynonymId> synonyms{pattern.getSynonymId()};
+        if (lhs.isDeclaration()) synonyms.push_back(lhs.getDeclarationId());
 
         std::optional<std::string> lhsParam = {};
         if (lhs.isVarName()) lhsParam = lhs.getVariableName();
@@ -94,7 +98,9 @@ namespace qps::evaluator {
         }
         PKBResponse response;
         try {
-            response = pkb->match(statementType, PatternParam(lhsParam), PatternParam(rhsParam, isStrict));
+            response = lookup([&]() {
+                return pkb->match(statementType, PatternParam(lhsParam), PatternParam(rhsParam, isStrict));
+            });
         } catch (std::invalid_argument) {
             throw exceptions::PqlSyntaxException("Syntax Error has occured!");
         }
@@ -102,7 +108,7 @@ namespace qps::evaluator {
         if (!lhs.isDeclaration()) {
             response = selectDeclaredValue(response, true);
         }
-        tableRef.insert(response, synonyms);
+        return ClauseResult{response, synonyms};
     }
 
     bool ClauseHandler::handleNoAttrRefWith(const query::AttrCompare& noAttrClause) {
@@ -115,41 +121,40 @@ namespace qps::evaluator {
         return true;
     }
 
-    void ClauseHandler::handleTwoAttrRef(query::AttrRef lhs, query::AttrRef rhs) {
-        PKBResponse lhsResult = getAll(lhs.getDeclarationType());
-        PKBResponse rhsResult = getAll(rhs.getDeclarationType());
+    ClauseResult ClauseHandler::handleTwoAttrRef(query::AttrRef lhs, query::AttrRef rhs) {
+        PKBResponse lhsResult = lookup([&]() { return getAll(lhs.getDeclarationType()); });
+        PKBResponse rhsResult = lookup([&]() { return getAll(rhs.getDeclarationType()); });
         PKBResponse newResponse;
         auto lhsPtr = std::get_if<SingleResponse>(&lhsResult.res);
         auto rhsPtr = std::get_if<SingleResponse>(&rhsResult.res);
-        if (lhs.getDeclarationSynonym() == rhs.getDeclarationSynonym()) {
-            tableRef.insert(lhsResult, std::vector<std::string>{lhs.getDeclarationSynonym()});
-            return;
+        if (lhs.getDeclarationId() == rhs.getDeclarationId()) {
+            return ClauseResult{lhsResult, std::vector<query::SynonymId>{lhs.getDeclarationId()}};
         }
         if (lhs.getAttrName() == query::AttrName::PROCNAME || lhs.getAttrName() == query::AttrName::VARNAME) {
             newResponse = twoAttrMerge<std::string>(*lhsPtr, *rhsPtr);
         } else {
             newResponse = twoAttrMerge<int>(*lhsPtr, *rhsPtr);
         }
-        tableRef.insert(newResponse,
-                        std::vector<std::string>{lhs.getDeclarationSynonym(), rhs.getDeclarationSynonym()});
+        return ClauseResult{newResponse,
+                            std::vector<query::SynonymId>{lhs.getDeclarationId(), rhs.getDeclarationId()}};
     }
 
-    void ClauseHandler::handleOneAttrRef(query::AttrRef attr, query::AttrCompareRef concrete) {
-        PKBResponse attrResult = getAll(attr.getDeclarationType());
+    ClauseResult ClauseHandler::handleOneAttrRef(query::AttrRef attr, query::AttrCompareRef concrete) {
+        PKBResponse attrResult = lookup([&]() { return getAll(attr.getDeclarationType()); });
         if (concrete.isString()) attrResult = filterAttrValue<std::string>(attrResult, concrete.getString());
         if (concrete.isNumber()) attrResult = filterAttrValue<int>(attrResult, concrete.getNumber());
-        tableRef.insert(attrResult, std::vector<std::string>{attr.getDeclarationSynonym()});
+        return ClauseResult{attrResult, std::vector<query::SynonymId>{attr.getDeclarationId()}};
     }
 
-    void ClauseHandler::handleAttrRefWith(query::AttrCompare attrClause) {
+    ClauseResult ClauseHandler::handleAttrRefWith(query::AttrCompare attrClause) {
         auto lhs = attrClause.lhs;
         auto rhs = attrClause.rhs;
         if (lhs.isAttrRef() && rhs.isAttrRef()) {
-            handleTwoAttrRef(lhs.getAttrRef(), rhs.getAttrRef());
+            return handleTwoAttrRef(lhs.getAttrRef(), rhs.getAttrRef());
         } else {
-            if (!lhs.isAttrRef())  handleOneAttrRef(rhs.getAttrRef(), lhs);
+            if (!lhs.isAttrRef()) return handleOneAttrRef(rhs.getAttrRef(), lhs);
             else
-                handleOneAttrRef(lhs.getAttrRef(), rhs);
+                return handleOneAttrRef(lhs.getAttrRef(), rhs);
         }
     }
 
@@ -160,38 +165,121 @@ namespace qps::evaluator {
             if (elem.isDeclaration()) dec = elem.getDeclaration();
             else
                 dec = elem.getAttrRef().getDeclaration();
-            if (!tableRef.synExists(dec.getSynonym())) {
+            if (!tableRef.synExists(dec.getId())) {
                 PKBResponse r = getAll(dec.getType());
-                tableRef.insert(r, std::vector<std::string>{dec.getSynonym()});
+                tableRef.insert(r, std::vector<query::SynonymId>{dec.getId()}, token);
             }
         }
     }
 
 
-    bool ClauseHandler::handleGroup(optimizer::ClauseGroup group) {
-        while (group.hasNextClause()) {
-            optimizer::OrderedClause clause = group.nextClause();
-            if (clause.isSuchThat()) {
-                handleSynRelRef(clause.getSuchThat());
-            } else if (clause.isWith()) {
-                handleAttrRefWith(clause.getWith());
-            } else {
-                handlePattern(clause.getPattern());
+    ClauseResult ClauseHandler::handleClause(optimizer::OrderedClause clause) {
+        if (clause.isSuchThat()) {
+            return handleSynRelRef(clause.getSuchThat());
+        } else if (clause.isWith()) {
+            return handleAttrRefWith(clause.getWith());
+        } else {
+            return handlePattern(clause.getPattern());
+        }
+    }
+
+    bool ClauseHandler::handleNoSynClause(optimizer::OrderedClause clause) {
+        if (clause.isSuchThat()) {
+            return handleNoSynRelRef(clause.getSuchThat());
+        } else {
+            return handleNoAttrRefWith(clause.getWith());
+        }
+    }
+
+    std::shared_ptr<const ClauseResult> ClauseHandler::getClauseResult(const optimizer::OrderedClause& clause) {
+        CancellationToken::check(token);
+        lookupTime = {};
+        bool isComputed = false;
+        auto compute = [&]() {
+            isComputed = true;
+            return handleClause(clause);
+        };
+        auto result = cache ? cache->getClause(clause, compute) : std::make_shared<const ClauseResult>(compute());
+        if (profile) {
+            ClauseProfile clauseProfile = ClauseProfile::of(clause);
+            clauseProfile.isCached = !isComputed;
+            clauseProfile.lookupMs = toMs(lookupTime);
+            clauseProfile.rows = countRows(result->response);
+            profile->clauses.push_back(clauseProfile);
+        }
+        return result;
+    }
+
+    bool ClauseHandler::handleGroup(const optimizer::PlannedGroup& group) {
+        // the clauses on a single synonym only narrow down its domain, before any other clause is joined.
+        SynonymDomains domains;
+        std::vector<const optimizer::OrderedClause*> binaryClauses;
+        for (auto& clause : group.clauses) {
+            auto& syns = clause.getSynonyms();
+            if (std::adjacent_find(syns.begin(), syns.end(), std::not_equal_to<>()) != syns.end()) {
+                binaryClauses.push_back(&clause);
+                continue;
+            }
+            auto result = getClauseResult(clause);
+            std::optional<std::size_t> valuesBefore;
+            if (domains.hasDomain(result->synonyms[0])) valuesBefore = domains.getDomainSize(result->synonyms[0]);
+            bool isRestricted = domains.restrict(result->response, result->synonyms[0]);
+            if (profile) {
+                profile->clauses.back().rowsBefore = valuesBefore;
+                profile->clauses.back().rowsAfter = domains.getDomainSize(result->synonyms[0]);
+            }
+            if (!isRestricted) return false;
+        }
+        if (group.isCyclic) return handleCyclicGroup(binaryClauses, domains);
+
+        for (auto clause : binaryClauses) {
+            auto result = getClauseResult(*clause);
+            std::size_t rowsBefore = tableRef.getTable().size();
+            tableRef.insert(domains.filter(result->response, result->synonyms), result->synonyms, token);
+            if (profile) {
+                profile->clauses.back().rowsBefore = rowsBefore;
+                profile->clauses.back().rowsAfter = tableRef.getTable().size();
             }
 
             if (!tableRef.hasResult()) return false;
         }
-        return true;
+        for (auto s : domains.getSynonyms()) {
+            if (!tableRef.synExists(s)) {
+                tableRef.insert(domains.getDomain(s), std::vector<query::SynonymId>{s}, token);
+            }
+        }
+        return tableRef.hasResult();
+    }
+
+    bool ClauseHandler::handleCyclicGroup(const std::vector<const optimizer::OrderedClause*>& clauses,
+                                          const SynonymDomains& domains) {
+        TrieJoin join(token);
+        for (auto clause : clauses) {
+            auto result = getClauseResult(*clause);
+            PKBResponse response = domains.filter(result->response, result->synonyms);
+            if (!response.hasResult) return false;
+            join.addRelation(response, result->synonyms);
+        }
+        tableRef = join.join();
+        return tableRef.hasResult();
     }
 
-    bool ClauseHandler::handleNoSynGroup(optimizer::ClauseGroup group) {
-        while (group.hasNextClause()) {
-            optimizer::OrderedClause clause = group.nextClause();
-            bool isHold;
-            if (clause.isSuchThat()) {
-                isHold = handleNoSynRelRef(clause.getSuchThat());
-            } else {
-                isHold = handleNoAttrRefWith(clause.getWith());
+    bool ClauseHandler::handleNoSynGroup(const optimizer::PlannedGroup& group) {
+        for (auto& clause : group.clauses) {
+            CancellationToken::check(token);
+            lookupTime = {};
+            bool isComputed = false;
+            auto compute = [&]() {
+                isComputed = true;
+                return handleNoSynClause(clause);
+            };
+            bool isHold = cache ? cache->holds(clause, compute) : compute();
+            if (profile) {
+                ClauseProfile clauseProfile = ClauseProfile::of(clause);
+                clauseProfile.isCached = !isComputed;
+                clauseProfile.lookupMs = toMs(lookupTime);
+                clauseProfile.rows = isHold ? 1 : 0;
+                profile->clauses.push_back(clauseProfile);
             }
             if (!isHold) return false;
         }
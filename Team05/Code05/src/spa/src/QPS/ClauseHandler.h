@@ -1,15 +1,21 @@
 #pragma once
 
+#include <chrono>
 #include <memory>
 #include <type_traits>
 #include "Query.h"
 #include "Optimizer.h"
 #include "ResultTable.h"
+#include "ResultCache.h"
+#include "TrieJoin.h"
+#include "SynonymDomains.h"
+#include "Profile.h"
 #include "PKBTypeMatcher.h"
 #include "PKB/PKBCommons.h"
 #include "PKB/PKBField.h"
 #include "PKB/PKBResponse.h"
 #include "PKB.h"
+#include "Cancellation.h"
 
 namespace qps::evaluator {
 /**
@@ -19,9 +25,29 @@ class ClauseHandler {
 public:
     PKB *pkb;
     ResultTable &tableRef;
+    ResultCache *cache;
+    GroupProfile *profile = nullptr;  // records every clause handled through the group handlers if set
+    const CancellationToken *token = nullptr;  // checked between clauses, in the joins and in the PKB if set
+    std::chrono::steady_clock::duration lookupTime {};  // the time spent in the PKB by the current clause
 
-    /** Constructor of the ClauseHandler */
-    ClauseHandler(PKB *pkb, ResultTable &tableRef) : pkb(pkb), tableRef(tableRef) {}
+    /** Constructor of the ClauseHandler, which shares the results of its clauses through the cache if given */
+    ClauseHandler(PKB *pkb, ResultTable &tableRef, ResultCache *cache = nullptr)
+        : pkb(pkb), tableRef(tableRef), cache(cache) {}
+
+    /**
+     * Calls f, which retrieves a result from the PKB, and adds the time it takes to lookupTime when profiling.
+     *
+     * @param f the lookup
+     * @return the result of f
+     */
+    template<typename F>
+    auto lookup(F&& f) {
+        if (!profile) return f();
+        auto start = std::chrono::steady_clock::now();
+        auto result = f();
+        lookupTime += std::chrono::steady_clock::now() - start;
+        return result;
+    }
 
     /**
      * Retrieves all the results of a certain design entity from PKB database.
@@ -52,8 +78,9 @@ public:
      * Handles a RelRef clause with synonyms.
      *
      * @param clause a relationship clause with synonyms
+     * @return the result of the clause
      */
-    void handleSynRelRef(std::shared_ptr<query::RelRef> clause);
+    ClauseResult handleSynRelRef(std::shared_ptr<query::RelRef> clause);
 
     /**
      * Handles a RelRef clause without synonyms.
@@ -66,8 +93,9 @@ public:
      * Handles a pattern clause
      *
      * @param patterns a group of pattern clauses
+     * @return the result of the clause
      */
-    void handlePattern(query::Pattern pattern);
+    ClauseResult handlePattern(query::Pattern pattern);
 
     /**
      * Handles a with clause without attribute reference
@@ -81,23 +109,26 @@ public:
      * Handles a with clause with attribute reference
      *
      * @param attrClause a with clause with attribute reference
+     * @return the result of the clause
      */
-    void handleAttrRefWith(query::AttrCompare attrClause);
+    ClauseResult handleAttrRefWith(query::AttrCompare attrClause);
 
     /**
      * Handles a with clause whose lhs and rhs are both attRef
      *
      * @param lhs lhs attribute reference
      * @param rhs rhs attribute reference
+     * @return the result of the clause
      */
-    void handleTwoAttrRef(query::AttrRef lhs, query::AttrRef rhs);
+    ClauseResult handleTwoAttrRef(query::AttrRef lhs, query::AttrRef rhs);
 
     /**
      * Handles a with clause only contains one attRef
      * @param attr attribute reference
      * @param concrete string or int value of a parameter of the with clause
+     * @return the result of the clause
      */
-    void handleOneAttrRef(query::AttrRef attr, query::AttrCompareRef concrete);
+    ClauseResult handleOneAttrRef(query::AttrRef attr, query::AttrCompareRef concrete);
 
     /**
      * Retrieves the attribute value from a PKBField
@@ -153,6 +184,7 @@ public:
     PKBResponse twoAttrMerge(SingleResponse &lhsResponse, SingleResponse &rhsResponse) {
         VectorResponse res;
         for (auto lhsRecord : lhsResponse) {
+            CancellationToken::check(token);
             T lhsValue = getPKBFieldAttr<T>(lhsRecord);
             for (auto rhsRecord : rhsResponse) {
                 T rhsValue = getPKBFieldAttr<T>(rhsRecord);
@@ -170,20 +202,57 @@ public:
      */
     void  handleResultCl(query::ResultCl resultCl);
 
+    /**
+     * Handles a clause with synonyms
+     *
+     * @param clause a bound clause with synonyms
+     * @return the result of the clause
+     */
+    ClauseResult handleClause(optimizer::OrderedClause clause);
+
+    /**
+     * Handles a clause without synonyms
+     *
+     * @param clause a bound clause without synonyms
+     * @return true if the clause holds, false otherwise
+     */
+    bool handleNoSynClause(optimizer::OrderedClause clause);
+
+    /**
+     * Retrieves the result of a clause with synonyms from the cache, or evaluates it if there is no cache
+     *
+     * @param clause a bound clause with synonyms
+     * @return the result of the clause
+     */
+    std::shared_ptr<const ClauseResult> getClauseResult(const optimizer::OrderedClause& clause);
+
     /**
      * Handles a group of clause without synonyms
      *
-     * @param group the group of clause without synonyms
+     * @param group the bound group of clause without synonyms
      * @return true if every clause inside the group holds, false otherwise
      */
-    bool handleNoSynGroup(optimizer::ClauseGroup group);
+    bool handleNoSynGroup(const optimizer::PlannedGroup& group);
 
     /**
-     * Handles a group of clause with synonyms
+     * Handles a group of clause with synonyms. The clauses on a single synonym are evaluated first and only
+     * restrict the domain of their synonym, which then filters the results of the other clauses.
      *
-     * @param group the group of clause with synonyms
+     * @param group the bound group of clause with synonyms
      * @return true if every clause inside the group has result, false otherwise
+     * @see SynonymDomains
+     */
+    bool handleGroup(const optimizer::PlannedGroup& group);
+
+    /**
+     * Handles the clauses of a group whose synonyms form a cycle by joining their results all at once
+     *
+     * @param clauses the bound clauses on two synonyms of the group
+     * @param domains the domains of the synonyms of the group
+     * @return true if the join has result, false otherwise
+     * @see TrieJoin
      */
-    bool handleGroup(optimizer::ClauseGroup group);
+    bool handleCyclicGroup(const std::vector<const optimizer::OrderedClause*>& clauses,
+                           const SynonymDomains& domains);
 };
 }  // namespace qps::evaluator
@@ -1,15 +1,15 @@
 #include "Evaluator.h"
 
-#define DEBUG Logger(Level::DEBUG) << "evaluator.cpp "
+#define DEBUG LOG(Level::DEBUG) << "evaluator.cpp "
 
 namespace qps::evaluator {
-    std::vector<ResultTable> Evaluator::findResultRelatedGroup(std::vector<std::string> selectSyns) {
+    std::vector<ResultTable> Evaluator::findResultRelatedGroup(const std::vector<query::SynonymId>& selectSyns) {
         std::vector<ResultTable> resultRelatedGroups;
-        for (auto table : intermediateTables) {
+        for (auto& table : intermediateTables) {
             for (auto s : selectSyns) {
                 if (table.synExists(s)) {
-                    table.filterColumns(selectSyns);
                     resultRelatedGroups.push_back(table);
+                    resultRelatedGroups.back().filterColumns(selectSyns);
                     break;
                 }
             }
@@ -20,45 +20,125 @@ namespace qps::evaluator {
     ResultTable Evaluator::mergeGroupResults(std::vector<ResultTable> tables) {
         ResultTable finalResultTable = tables[0];
         for (int i = 1; i < tables.size(); i++) {
-            finalResultTable.crossJoin(tables[i]);
+            finalResultTable.crossJoin(tables[i], token);
         }
         return finalResultTable;
     }
 
+    std::shared_ptr<const GroupResult> Evaluator::evaluateGroup(const optimizer::PlannedGroup& group) {
+        GroupProfile groupProfile;
+        bool isComputed = false;
+        auto compute = [this, &group, &groupProfile, &isComputed]() {
+            isComputed = true;
+            ResultTable table = ResultTable();
+            ClauseHandler handler = ClauseHandler(pkb, table, cache);
+            if (profile) handler.profile = &groupProfile;
+            handler.token = token;
+            bool hasResult = group.noSyn ? handler.handleNoSynGroup(group) : handler.handleGroup(group);
+            return GroupResult{hasResult, table};
+        };
+        auto start = std::chrono::steady_clock::now();
+        auto result = cache ? cache->getGroup(group, compute) : std::make_shared<const GroupResult>(compute());
+        if (profile) {
+            groupProfile.noSyn = group.noSyn;
+            groupProfile.isCyclic = group.isCyclic;
+            groupProfile.isCached = !isComputed;
+            groupProfile.hasResult = result->hasResult;
+            groupProfile.timeMs = toMs(std::chrono::steady_clock::now() - start);
+            groupProfile.rows = result->table.getTable().size();
+            profile->groups.push_back(std::move(groupProfile));
+        }
+        return result;
+    }
+
     std::list<std::string> Evaluator::evaluate(query::Query query) {
-        query::ResultCl resultcl = query.getResultCl();
         std::vector<query::AttrCompare> with = query.getWith();
         std::vector<std::shared_ptr<query::RelRef>> suchthat = query.getSuchthat();
         std::vector<query::Pattern> patterns = query.getPattern();
 
         optimizer::Optimizer optimizer = optimizer::Optimizer(suchthat, with, patterns);
-        optimizer.optimize();
+        return evaluate(query.getResultCl(), optimizer.plan(), {});
+    }
 
-        while (optimizer.hasNextGroup()) {
-            optimizer::ClauseGroup group = optimizer.nextGroup();
-            ResultTable table = ResultTable();
-            ClauseHandler handler = ClauseHandler(pkb, table);
-            bool hasResult;
-            if (group.noSyn()) {
-                hasResult = handler.handleNoSynGroup(group);
-            } else {
-                hasResult = handler.handleGroup(group);
-                intermediateTables.push_back(table);
+    std::list<std::string> Evaluator::evaluate(const query::ResultCl& resultcl,
+                                               const std::vector<optimizer::PlannedGroup>& plan,
+                                               const std::vector<query::Literal>& params) {
+        std::list<std::string> results;
+        evaluate(resultcl, plan, params, [&results](std::vector<std::string>& chunk) {
+            std::move(chunk.begin(), chunk.end(), std::back_inserter(results));
+        });
+        return results;
+    }
+
+    void Evaluator::evaluate(const query::ResultCl& resultcl, const std::vector<optimizer::PlannedGroup>& plan,
+                             const std::vector<query::Literal>& params, const ResultSink& sink) {
+        auto start = std::chrono::steady_clock::now();
+        if (profile) profile->groups.clear();
+        intermediateTables.clear();
+        // the group tables are kept until the query is projected, so they count towards every table built after them.
+        struct Retained {
+            const CancellationToken* token;
+            std::size_t bytes = 0;
+            ~Retained() { if (token) token->release(bytes); }
+        } retained{token};
+        for (auto& planned : plan) {
+            CancellationToken::check(token);
+            std::shared_ptr<const GroupResult> result =
+                    params.empty() ? evaluateGroup(planned) : evaluateGroup(planned.bind(params));
+            if (!planned.noSyn) {
+                intermediateTables.push_back(result->table);
+                if (token) {
+                    std::size_t bytes = intermediateTables.back().estimateBytes();
+                    retained.bytes += bytes;
+                    token->retain(bytes);
+                }
             }
 
-            if (!hasResult)
-                return resultcl.isBoolean() ? std::list<std::string>{"FALSE"} : std::list<std::string>{};
+            if (!result->hasResult) {
+                if (profile) profile->evaluateMs = toMs(std::chrono::steady_clock::now() - start);
+                if (resultcl.isBoolean()) {
+                    std::vector<std::string> chunk{"FALSE"};
+                    if (profile) profile->resultCount = 1;
+                    sink(chunk);
+                }
+                return;
+            }
         }
 
         std::vector<ResultTable> resultRelatedTables = findResultRelatedGroup(resultcl.getSynAsList());
         resultTable = resultRelatedTables.empty() ? ResultTable() : mergeGroupResults(resultRelatedTables);
 
         ClauseHandler handler = ClauseHandler(pkb, resultTable);
+        handler.token = token;
         handler.handleResultCl(resultcl);
 
-        pkb->clearCache();
+        if (!cache) pkb->clearCache();
 
-        if (resultcl.isBoolean()) return std::list<std::string>{"TRUE"};
-        return ResultProjector::projectResult(resultTable, resultcl);
+        if (resultcl.isBoolean()) {
+            std::vector<std::string> chunk{"TRUE"};
+            if (profile) {
+                profile->evaluateMs = toMs(std::chrono::steady_clock::now() - start);
+                profile->resultCount = 1;
+            }
+            sink(chunk);
+            return;
+        }
+        // the results are projected a chunk at a time, so the token is checked in between chunks.
+        ResultSink checkedSink = [this, &sink](std::vector<std::string>& chunk) {
+            CancellationToken::check(token);
+            sink(chunk);
+        };
+        if (!profile) {
+            ResultProjector::projectResult(resultTable, resultcl, token ? checkedSink : sink);
+            return;
+        }
+        profile->evaluateMs = toMs(std::chrono::steady_clock::now() - start);
+        start = std::chrono::steady_clock::now();
+        profile->resultCount = 0;
+        ResultProjector::projectResult(resultTable, resultcl, [this, &checkedSink](std::vector<std::string>& chunk) {
+            profile->resultCount += chunk.size();
+            checkedSink(chunk);
+        });
+        profile->projectMs = toMs(std::chrono::steady_clock::now() - start);
     }
 }  // namespace qps::evaluator
@@ -15,10 +15,13 @@
 
 #include "QPS/Query.h"
 #include "QPS/ResultProjector.h"
+#include "QPS/ResultCache.h"
+#include "QPS/Profile.h"
 #include "PKB/PKBField.h"
 #include "PKB/PKBResponse.h"
 #include "PKB.h"
 #include "PKB/PKBCommons.h"
+#include "Cancellation.h"
 
 namespace qps::evaluator {
 /**
@@ -26,21 +29,35 @@ namespace qps::evaluator {
  */
 class Evaluator {
     PKB *pkb;
+    ResultCache *cache;
+    QueryProfile *profile;
+    const CancellationToken *token;
     std::vector<ResultTable> intermediateTables;
     ResultTable resultTable;
 
+    /**
+     * Evaluates a bound group of clauses, or retrieves its result from the cache if the group has been evaluated
+     * by another query sharing the cache. The group is recorded in the profile if there is one.
+     */
+    std::shared_ptr<const GroupResult> evaluateGroup(const optimizer::PlannedGroup& group);
+
 public:
-    /** Constructor for the evaluator. */
-    explicit Evaluator(PKB *pkb) {
-        this->pkb = pkb;
-    }
+    /**
+     * Constructor for the evaluator. If a cache is given, the results of clauses and groups are shared through it,
+     * and the caches of the PKB are left for the owner of the cache to clear. If a profile is given, the order,
+     * timing and row counts of every group and clause evaluated are recorded in it. If a token is given, the
+     * evaluation stops as soon as it sees that the token is cancelled, past its deadline or over its memory budget.
+     */
+    explicit Evaluator(PKB *pkb, ResultCache *cache = nullptr, QueryProfile *profile = nullptr,
+                       const CancellationToken *token = nullptr)
+        : pkb(pkb), cache(cache), profile(profile), token(token) {}
 
     /**
      * Finds the result table stores value of synonyms in selectedSyns
      * @param selectSyns synonyms in select clause
      * @return A list of result table containing synonym in selectSyns
      */
-    std::vector<ResultTable> findResultRelatedGroup(std::vector<std::string> selectSyns);
+    std::vector<ResultTable> findResultRelatedGroup(const std::vector<query::SynonymId>& selectSyns);
 
     /**
      * Merges tables into a single table
@@ -56,5 +73,30 @@ public:
      * @return the list of string representation of the query result
      */
     std::list<std::string> evaluate(query::Query query);
+
+    /**
+     * Evaluates a query that has already been planned by the optimizer.
+     *
+     * @param resultcl the result clause of the query
+     * @param plan the groups of clauses of the query, in evaluation order
+     * @param params the values bound to the placeholders of the query
+     * @return the list of string representation of the query result
+     */
+    std::list<std::string> evaluate(const query::ResultCl& resultcl, const std::vector<optimizer::PlannedGroup>& plan,
+                                    const std::vector<query::Literal>& params);
+
+    /**
+     * Evaluates a query that has already been planned by the optimizer, and streams its results to the sink in
+     * chunks instead of collecting them.
+     *
+     * @param resultcl the result clause of the query
+     * @param plan the groups of clauses of the query, in evaluation order
+     * @param params the values bound to the placeholders of the query
+     * @param sink the consumer of the results
+     * @throws exceptions::QueryStoppedException if the query of the token is stopped, possibly after some of the
+     * results were given to the sink
+     */
+    void evaluate(const query::ResultCl& resultcl, const std::vector<optimizer::PlannedGroup>& plan,
+                  const std::vector<query::Literal>& params, const ResultSink& sink);
 };
 }  // namespace qps::evaluator
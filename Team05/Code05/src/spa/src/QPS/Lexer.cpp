@@ -21,9 +21,10 @@ namespace qps::parser {
             { '=', TokenType::EQUAL },
             { '<', TokenType::LEFT_ARROW_HEAD },
             { '>', TokenType::RIGHT_ARROW_HEAD },
+            { '?', TokenType::PLACEHOLDER },
     };
 
-    std::vector<std::string> keywords = {
+    const std::vector<std::string_view> keywords = {
             "Select", "BOOLEAN", "Modifies", "Uses", "Parent*",
             "Parent", "Follows*", "Follows", "Next*",
             "Next", "Calls*", "Calls", "Affects*", "Affects",
@@ -31,7 +32,7 @@ namespace qps::parser {
             "value", "stmt#", "and"
     };
 
-    std::unordered_map<std::string, TokenType> keywordsToTokenTypeMap {
+    const std::unordered_map<std::string_view, TokenType> keywordsToTokenTypeMap {
             { "Select", TokenType::SELECT },
             { "BOOLEAN", TokenType::BOOLEAN },
             { "Modifies", TokenType::MODIFIES },
@@ -56,12 +57,12 @@ namespace qps::parser {
             { "stmt#", TokenType::STMTNUM }
     };
 
-    Token Lexer::getReservedToken(std::string keyword) {
+    Token Lexer::getReservedToken(std::string_view keyword) {
         auto pos = keywordsToTokenTypeMap.find(keyword);
         if (pos == keywordsToTokenTypeMap.end()) {
             throw exceptions::PqlSyntaxException(messages::qps::parser::keywordDoesNotExist);
         }
-        return Token { keyword, pos->second };
+        return Token { text.substr(0, keyword.length()), pos->second };
     }
 
     std::string_view Lexer::getText() {
@@ -73,8 +74,8 @@ namespace qps::parser {
             text.remove_prefix(1);
     }
 
-    bool Lexer::hasPrefix(std::string prefix) {
-        return text.find(prefix) == 0;
+    bool Lexer::hasPrefix(std::string_view prefix) {
+        return text.substr(0, prefix.length()) == prefix;
     }
 
     TokenType Lexer::getSpecialCharTokenType(char ch) {
@@ -91,7 +92,7 @@ namespace qps::parser {
         auto pos1 = text.find("\"");
         auto pos2 = text.find("\"", pos1 + 1);
         int num_chars = pos2 - pos1;
-        std::string strValue = std::string { text.substr(pos1 + 1, num_chars - 1) };
+        std::string_view strValue = text.substr(pos1 + 1, num_chars - 1);
 
         text.remove_prefix(num_chars + 1);
 
@@ -104,7 +105,7 @@ namespace qps::parser {
         while (text.length() > charCount && (isalpha(text[charCount]) || isdigit(text[charCount])))
             charCount++;
 
-        std::string identifier = std::string { text.substr(0, charCount) };
+        std::string_view identifier = text.substr(0, charCount);
         text.remove_prefix(charCount);
 
         return Token { identifier, TokenType::IDENTIFIER };
@@ -116,7 +117,7 @@ namespace qps::parser {
         while (text.length() > charCount && (isdigit(text[charCount])))
             charCount++;
 
-        std::string number = std::string { text.substr(0, charCount) };
+        std::string_view number = text.substr(0, charCount);
 
         if (number[0] == '0' && number.length() > 1)
             throw exceptions::PqlSyntaxException(messages::qps::parser::leadingZeroMessage);
@@ -128,7 +129,7 @@ namespace qps::parser {
 
     Token Lexer::getSpecialChar() {
         Token token;
-        std::string value = std::string { text.substr(0, 1) };
+        std::string_view value = text.substr(0, 1);
         TokenType type = getSpecialCharTokenType(text[0]);
 
         if (type == TokenType::INVALID) {
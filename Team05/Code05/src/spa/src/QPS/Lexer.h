@@ -20,6 +20,7 @@ enum class TokenType {
     AND,
     LEFT_ARROW_HEAD,
     RIGHT_ARROW_HEAD,
+    PLACEHOLDER,
 
     IDENTIFIER,
     NUMBER,
@@ -60,14 +61,15 @@ enum class TokenType {
 };
 
 /**
-* Struct used to represent a Token
+* Struct used to represent a Token. The text of the token is a slice of the query
+* held by the Lexer, so the query must outlive its tokens.
 */
 struct Token {
-    std::string text;
+    std::string_view text;
     TokenType type;
 
     TokenType getTokenType() const { return type; }
-    std::string getText() const { return text; }
+    std::string_view getText() const { return text; }
 
     bool operator==(const Token &o) const { return (type == o.type) && (text == o.text); }
 };
@@ -93,7 +95,7 @@ struct Lexer {
      * @param prefix the prefix to check
      * @return a boolean
      */
-    bool hasPrefix(std::string prefix);
+    bool hasPrefix(std::string_view prefix);
 
     std::string_view getText();
 
@@ -169,7 +171,7 @@ private:
     * @param keyword the reserved keyword
     * @return Token of the reserved keyword
     */
-    Token getReservedToken(std::string keyword);
+    Token getReservedToken(std::string_view keyword);
 };
 
 }  // namespace qps::parser
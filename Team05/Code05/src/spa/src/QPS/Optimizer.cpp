@@ -1,3 +1,5 @@
+#include <set>
+
 #include "Optimizer.h"
 namespace qps::optimizer {
     using query::RelRefType;
@@ -17,13 +19,11 @@ namespace qps::optimizer {
         query::AttrCompareRef rhs = o.with.getRhs();
 
         if (lhs.isAttrRef()) {
-            std::string synonym = lhs.getAttrRef().getDeclarationSynonym();
-            o.synonyms.push_back(synonym);
+            o.synonyms.push_back(lhs.getAttrRef().getDeclarationId());
         }
 
         if (rhs.isAttrRef()) {
-            std::string synonym = rhs.getAttrRef().getDeclarationSynonym();
-            o.synonyms.push_back(synonym);
+            o.synonyms.push_back(rhs.getAttrRef().getDeclarationId());
         }
 
         return o;
@@ -37,7 +37,7 @@ namespace qps::optimizer {
         std::vector<query::Declaration> declarations = o.suchthat.get()->getDecs();
 
         for (int i = 0; i < declarations.size(); i++) {
-            o.synonyms.push_back(declarations[i].getSynonym());
+            o.synonyms.push_back(declarations[i].getId());
         }
 
         return o;
@@ -49,9 +49,9 @@ namespace qps::optimizer {
         o.pattern = std::move(pattern);
 
         query::EntRef lhs = o.pattern.getEntRef();
-        o.synonyms.push_back(o.pattern.getSynonym());
+        o.synonyms.push_back(o.pattern.getSynonymId());
         if (lhs.isDeclaration()) {
-            o.synonyms.push_back(lhs.getDeclarationSynonym());
+            o.synonyms.push_back(lhs.getDeclarationId());
         }
 
         return o;
@@ -84,6 +84,18 @@ namespace qps::optimizer {
         return priority;
     }
 
+    OrderedClause OrderedClause::bind(const std::vector<query::Literal>& params) const {
+        OrderedClause o = *this;
+        if (isSuchThat()) {
+            o.suchthat = suchthat->bind(params);
+        } else if (isWith()) {
+            o.with = with.bind(params);
+        } else if (isPattern()) {
+            o.pattern = pattern.bind(params);
+        }
+        return o;
+    }
+
     bool OrderedClause::operator==(const OrderedClause &o) const {
         if (type != o.type) return false;
         if (type == OrderedClauseType::SUCH_THAT) {
@@ -98,26 +110,65 @@ namespace qps::optimizer {
     size_t OrderedClause::getHash() const {
         size_t seed = 0;
         hash_combine(seed, type);
-        if (type == OrderedClauseType::SUCH_THAT) hash_combine(seed, suchthat);
+        if (type == OrderedClauseType::SUCH_THAT) hash_combine(seed, suchthat->getHash());
         if (type == OrderedClauseType::PATTERN) hash_combine(seed, pattern);
         if (type == OrderedClauseType::WITH) hash_combine(seed, with);
         return seed;
     }
 
+    PlannedGroup PlannedGroup::bind(const std::vector<query::Literal>& params) const {
+        PlannedGroup bound{noSyn, {}, isCyclic};
+        bound.clauses.reserve(clauses.size());
+        for (auto& clause : clauses) {
+            bound.clauses.push_back(clause.bind(params));
+        }
+        return bound;
+    }
+
+    bool PlannedGroup::hasCycle(const std::vector<OrderedClause>& clauses) {
+        std::unordered_map<SynonymId, SynonymId> parent;
+        auto find = [&parent](SynonymId s) {
+            parent.try_emplace(s, s);
+            while (parent[s] != s) s = parent[s];
+            return s;
+        };
+        std::set<std::pair<SynonymId, SynonymId>> edges;
+        for (auto& clause : clauses) {
+            auto& syns = clause.getSynonyms();
+            if (syns.size() != 2 || syns[0] == syns[1]) continue;
+            // two clauses over the same pair of synonyms are simply intersected, which pairwise joins handle well.
+            if (!edges.emplace(std::min(syns[0], syns[1]), std::max(syns[0], syns[1])).second) continue;
+            SynonymId first = find(syns[0]);
+            SynonymId second = find(syns[1]);
+            if (first == second) return true;
+            parent[first] = second;
+        }
+        return false;
+    }
+
+    size_t PlannedGroup::getHash() const {
+        size_t seed = 0;
+        hash_combine(seed, noSyn);
+        for (auto& clause : clauses) {
+            hash_combine(seed, clause.getHash());
+        }
+        return seed;
+    }
+
     ClauseGroup ClauseGroup::ofNewGroup(int id) {
         ClauseGroup group = ClauseGroup();
         group.groupId = id;
         return group;
     }
 
-    void ClauseGroup::addSyn(std::vector<std::string> s) {
+    void ClauseGroup::addSyn(const std::vector<SynonymId>& s) {
         for (auto syn : s) {
             syns.insert(syn);
         }
     }
 
     bool ClauseGroup::noSyn() {
-        return syns.size() == 1 && syns.find("") != syns.end();
+        return syns.size() == 1 && syns.find(SynonymTable::NO_SYNONYM) != syns.end();
     }
 
 
@@ -140,7 +191,7 @@ namespace qps::optimizer {
         return c;
     }
 
-    void ClauseGroup::insertToPQ(std::string s) {
+    void ClauseGroup::insertToPQ(SynonymId s) {
         bfs.visitedSyn.insert(s);
         for (auto cl : subgroups[s]) {
             if (bfs.visitedCl.find(cl) == bfs.visitedCl.end()) {
@@ -154,7 +205,7 @@ namespace qps::optimizer {
         return !bfs.pq.empty() || !bfs.initialized;
     }
 
-    void Optimizer::addSynsToMap(std::vector<std::string> syns, int groupId) {
+    void Optimizer::addSynsToMap(const std::vector<SynonymId>& syns, int groupId) {
         for (auto syn : syns) {
             synToGroup[syn] = groupId;
         }
@@ -182,4 +233,19 @@ namespace qps::optimizer {
     bool Optimizer::hasNextGroup() {
         return !pq.empty();
     }
+
+    std::vector<PlannedGroup> Optimizer::plan() {
+        optimize();
+        std::vector<PlannedGroup> planned;
+        while (hasNextGroup()) {
+            ClauseGroup group = nextGroup();
+            PlannedGroup p { group.noSyn(), {} };
+            while (group.hasNextClause()) {
+                p.clauses.push_back(group.nextClause());
+            }
+            p.isCyclic = !p.noSyn && PlannedGroup::hasCycle(p.clauses);
+            planned.push_back(std::move(p));
+        }
+        return planned;
+    }
 }  // namespace qps::optimizer
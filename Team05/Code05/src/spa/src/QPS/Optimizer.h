@@ -5,6 +5,8 @@
 #include <climits>
 #include "QPS/Query.h"
 namespace qps::optimizer {
+using query::SynonymId;
+using query::SynonymTable;
 
 enum class OrderedClauseType {
     INVALID,
@@ -24,11 +26,19 @@ struct OrderedClause {
     query::AttrCompare getWith() { return with; }
     query::Pattern getPattern() { return pattern; }
 
-    std::vector<std::string> getSynonyms() { return synonyms; }
+    const std::vector<SynonymId>& getSynonyms() const { return synonyms; }
     int getPriority();
-    bool isWith() { return type == OrderedClauseType::WITH; }
-    bool isSuchThat() { return type == OrderedClauseType::SUCH_THAT; }
-    bool isPattern() { return type == OrderedClauseType::PATTERN; }
+    bool isWith() const { return type == OrderedClauseType::WITH; }
+    bool isSuchThat() const { return type == OrderedClauseType::SUCH_THAT; }
+    bool isPattern() const { return type == OrderedClauseType::PATTERN; }
+
+    /**
+     * Returns the clause with the placeholders in it replaced by the bound values
+     *
+     * @param params the values bound to the placeholders of the query
+     * @return the bound OrderedClause
+     */
+    OrderedClause bind(const std::vector<query::Literal>& params) const;
 
     bool operator==(const OrderedClause& o) const;
     size_t getHash() const;
@@ -38,7 +48,7 @@ private:
     query::AttrCompare with {};
     query::Pattern pattern {};
 
-    std::vector<std::string> synonyms;
+    std::vector<SynonymId> synonyms;
 
     OrderedClauseType type = OrderedClauseType::INVALID;
 };
@@ -74,7 +84,7 @@ struct BFS {
     bool initialized = false;
     std::priority_queue<OrderedClause, std::vector<OrderedClause>, ClausePriority> pq;
     std::unordered_set<OrderedClause, OrderedClauseHash> visitedCl;
-    std::unordered_set<std::string> visitedSyn;
+    std::unordered_set<SynonymId> visitedSyn;
 };
 
 /**
@@ -82,20 +92,20 @@ struct BFS {
  */
 struct ClauseGroup {
     int groupId;
-    std::unordered_set<std::string> syns;
+    std::unordered_set<SynonymId> syns;
     std::unordered_set<std::shared_ptr<query::RelRef>> suchthatGroup;
     std::unordered_set<query::AttrCompare> withGroup;
     std::unordered_set<query::Pattern> patternGroup;
 
-    std::unordered_map<std::string, std::vector<OrderedClause>> subgroups;
-    std::string startingPoint;
+    std::unordered_map<SynonymId, std::vector<OrderedClause>> subgroups;
+    SynonymId startingPoint = SynonymTable::NO_SYNONYM;
     int minClauseNo = INT_MAX;
     BFS bfs;
 
     static ClauseGroup ofNewGroup(int id);
 
     template<typename T>
-    void addClause(T& clause, std::vector<std::string> syns) {
+    void addClause(T& clause, const std::vector<SynonymId>& syns) {
         OrderedClause o;
         if constexpr(std::is_same_v<T, std::shared_ptr<query::RelRef>>) {
             suchthatGroup.emplace(clause);
@@ -132,14 +142,14 @@ struct ClauseGroup {
      *
      * @param s list of synonyms to add
      */
-    void addSyn(std::vector<std::string> s);
+    void addSyn(const std::vector<SynonymId>& s);
 
     /**
      * Insert clauses containing synonym s into the priority queue
      *
-     * @param s synonym name
+     * @param s synonym id
      */
-    void insertToPQ(std::string s);
+    void insertToPQ(SynonymId s);
 
     /**
      * Returns whether there is clause to evaluate
@@ -162,9 +172,9 @@ struct ClauseGroup {
 struct GroupPriority {
 public:
     bool operator()(ClauseGroup& a, ClauseGroup& b) {
-        if (a.syns.find("") != a.syns.end()) {
+        if (a.syns.find(SynonymTable::NO_SYNONYM) != a.syns.end()) {
             return false;
-        } else if (b.syns.find("") != b.syns.end()) {
+        } else if (b.syns.find(SynonymTable::NO_SYNONYM) != b.syns.end()) {
             return true;
         } else {
             return a.syns.size() > b.syns.size();
@@ -172,12 +182,49 @@ public:
     }
 };
 
+/**
+ * Struct used to store a group of clauses in the order they are to be evaluated
+ */
+struct PlannedGroup {
+    bool noSyn;
+    std::vector<OrderedClause> clauses;
+    bool isCyclic = false;  // whether the synonyms of the clauses form a cycle, see hasCycle
+
+    /**
+     * Checks whether the synonyms of the clauses form a cycle, taking every clause with two different synonyms as
+     * an edge between them. Such groups are evaluated by a worst-case optimal join instead of pairwise joins.
+     *
+     * @param clauses the clauses of a group
+     * @return true if the synonyms form a cycle, false otherwise
+     */
+    static bool hasCycle(const std::vector<OrderedClause>& clauses);
+
+    /**
+     * Returns the group with the placeholders in every clause replaced by the bound values
+     *
+     * @param params the values bound to the placeholders of the query
+     * @return the bound PlannedGroup
+     */
+    PlannedGroup bind(const std::vector<query::Literal>& params) const;
+
+    bool operator==(const PlannedGroup& o) const { return noSyn == o.noSyn && clauses == o.clauses; }
+    size_t getHash() const;
+};
+
+/**
+ * Customized hash function of PlannedGroup
+ */
+struct PlannedGroupHash {
+public:
+    size_t operator() (const PlannedGroup& group) const { return group.getHash(); }
+};
+
 /**
  * Struct used to represent an optimizer
  */
 class Optimizer {
 std::vector<ClauseGroup> groups;
-std::unordered_map<std::string, int> synToGroup;
+std::unordered_map<SynonymId, int> synToGroup;
 std::vector<std::shared_ptr<query::RelRef>>& suchthat;
 std::vector<query::AttrCompare>& with;
 std::vector<query::Pattern>& pattern;
@@ -190,26 +237,27 @@ public:
     }
 
     template<typename T>
-    std::vector<std::string> getSynonyms(T clause) {
-        std::vector<std::string> res;
+    std::vector<SynonymId> getSynonyms(T clause) {
+        std::vector<SynonymId> res;
         if constexpr(std::is_same_v<T, std::shared_ptr<query::RelRef>>) {
             std::vector<query::Declaration> decs = clause->getDecs();
-            if (decs.empty()) return std::vector<std::string>{""};
+            if (decs.empty()) return std::vector<SynonymId>{SynonymTable::NO_SYNONYM};
             for (auto d : decs) {
-                res.push_back(d.getSynonym());
+                res.push_back(d.getId());
             }
         } else if constexpr(std::is_same_v<T, query::AttrCompare>) {
-            if (!clause.getLhs().isAttrRef() && !clause.getRhs().isAttrRef()) return std::vector<std::string>{""};
-            if (clause.getLhs().isAttrRef()) res.push_back(clause.getLhs().getAttrRef().getDeclarationSynonym());
-            if (clause.getRhs().isAttrRef()) res.push_back(clause.getRhs().getAttrRef().getDeclarationSynonym());
+            if (!clause.getLhs().isAttrRef() && !clause.getRhs().isAttrRef())
+                return std::vector<SynonymId>{SynonymTable::NO_SYNONYM};
+            if (clause.getLhs().isAttrRef()) res.push_back(clause.getLhs().getAttrRef().getDeclarationId());
+            if (clause.getRhs().isAttrRef()) res.push_back(clause.getRhs().getAttrRef().getDeclarationId());
         } else if constexpr(std::is_same_v<T, query::Pattern>) {
-            res.push_back(clause.getSynonym());
-            if (clause.getEntRef().isDeclaration()) res.push_back(clause.getEntRef().getDeclarationSynonym());
+            res.push_back(clause.getSynonymId());
+            if (clause.getEntRef().isDeclaration()) res.push_back(clause.getEntRef().getDeclarationId());
         }
         return res;
     }
 
-    void addSynsToMap(std::vector<std::string> syns, int groupId);
+    void addSynsToMap(const std::vector<SynonymId>& syns, int groupId);
 
     /**
      * Divides clauses with type T into groups
@@ -219,7 +267,7 @@ public:
     template<typename T>
     void groupClauses(std::vector<T>& clauses) {
         for (auto clause : clauses) {
-            std::vector<std::string> syns = getSynonyms<T>(clause);
+            std::vector<SynonymId> syns = getSynonyms<T>(clause);
             int groupId = groups.size();
             bool belongsToExistGroup = false;
             for (auto s : syns) {
@@ -259,5 +307,13 @@ public:
      * @return the next ClauseGroup waiting for evaluation
      */
     ClauseGroup nextGroup();
+
+    /**
+     * Optimizes the clauses and drains every group, so that the evaluation order can be kept and reused.
+     * The order only depends on the synonyms and the kinds of the clauses, not on their literals.
+     *
+     * @return the groups in the order they are to be evaluated
+     */
+    std::vector<PlannedGroup> plan();
 };
 }  // namespace qps::optimizer
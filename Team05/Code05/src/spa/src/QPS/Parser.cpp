@@ -1,4 +1,5 @@
-#include <sstream>
+#include <charconv>
+#include <limits>
 
 #include "QPS/Parser.h"
 
@@ -46,6 +47,17 @@ namespace qps::parser {
             DesignEntity::PROCEDURE, DesignEntity::VARIABLE
     };
 
+    /**
+     * Converts the text of a NUMBER token into an int, saturating at INT_MAX like a stream extraction would
+     */
+    int toNumber(std::string_view text) {
+        int number = 0;
+        auto [ptr, err] = std::from_chars(text.data(), text.data() + text.size(), number);
+        if (err == std::errc::result_out_of_range)
+            return std::numeric_limits<int>::max();
+        return number;
+    }
+
     Token Parser::getNextToken() {
         return lexer.getNextToken();
     }
@@ -126,9 +138,7 @@ namespace qps::parser {
 
     Declaration Parser::parseDeclaration(Query &query) {
         Token identifier = getAndCheckNextToken(TokenType::IDENTIFIER);
-        std::string synonym = identifier.getText();
-        DesignEntity de = query.getDeclarationDesignEntity(synonym);
-        return Declaration { synonym, de };
+        return query.getDeclaration(identifier.getText());
     }
 
     AttrName Parser::parseAttrName(Query &query, const Declaration& declaration) {
@@ -192,15 +202,13 @@ namespace qps::parser {
         TokenType type = token.getTokenType();
         StmtRef stmtRef;
         if (type == TokenType::NUMBER) {
-            int lineNo;
-            std::stringstream ss(token.getText());
-            ss >> lineNo;
-            stmtRef = StmtRef::ofLineNo(lineNo);
+            stmtRef = StmtRef::ofLineNo(toNumber(token.getText()));
         } else if (type == TokenType::UNDERSCORE) {
             stmtRef = StmtRef::ofWildcard();
+        } else if (type == TokenType::PLACEHOLDER) {
+            stmtRef = StmtRef::ofParameter(queryObj.addParameter());
         } else if (type == TokenType::IDENTIFIER) {
-            stmtRef = StmtRef::ofDeclaration(Declaration {token.getText(),
-                                                          queryObj.getDeclarationDesignEntity(token.getText())});
+            stmtRef = StmtRef::ofDeclaration(queryObj.getDeclaration(token.getText()));
 
             if (!isValidStatementType(queryObj, stmtRef))
                 throw exceptions::PqlSemanticException(messages::qps::parser::synonymNotStatementTypeMessage);
@@ -217,12 +225,13 @@ namespace qps::parser {
         TokenType type = token.getTokenType();
         EntRef entRef;
         if (type == TokenType::STRING) {
-            entRef = EntRef::ofVarName(token.getText());
+            entRef = EntRef::ofVarName(std::string { token.getText() });
         } else if (type == TokenType::UNDERSCORE) {
             entRef = EntRef::ofWildcard();
+        } else if (type == TokenType::PLACEHOLDER) {
+            entRef = EntRef::ofParameter(queryObj.addParameter());
         } else if (type == TokenType::IDENTIFIER) {
-            entRef = EntRef::ofDeclaration(Declaration {token.getText(),
-                                                        queryObj.getDeclarationDesignEntity(token.getText())});
+            entRef = EntRef::ofDeclaration(queryObj.getDeclaration(token.getText()));
 
             if (!isValidEntityType(queryObj, entRef))
                 throw exceptions::PqlSemanticException(messages::qps::parser::synonymNotEntityTypeMessage);
@@ -303,7 +312,7 @@ namespace qps::parser {
 
     bool Parser::isValidStatementType(Query &query, const StmtRef& s) {
         if (s.isDeclaration()) {
-            DesignEntity d = query.getDeclarationDesignEntity(s.getDeclarationSynonym());
+            DesignEntity d = s.getDeclarationType();
             return statementsType.find(d) != statementsType.end();
         }
         return false;
@@ -330,7 +339,7 @@ namespace qps::parser {
         if (peekNextToken().getTokenType() == TokenType::STRING) {
             hasString = true;
             Token token = getAndCheckNextToken(TokenType::STRING);
-            value = token.getText();
+            value = std::string { token.getText() };
         }
 
         if (hasString && hasWildcard) {
@@ -376,13 +385,12 @@ namespace qps::parser {
         getAndCheckNextToken(TokenType::OPENING_PARAN);
         EntRef e = parsePatternLhs(query);
 
-        std::string synonym = d.getSynonym();
         DesignEntity de = d.getType();
 
         if (de == DesignEntity::ASSIGN) {
             getAndCheckNextToken(TokenType::COMMA);
             ExpSpec expression = parseExpSpec();
-            p = Pattern::ofAssignPattern(synonym, e, expression);
+            p = Pattern::ofAssignPattern(d, e, expression);
         } else {
             int wildcardCount = (de == DesignEntity::IF) ? 2 : 1;
 
@@ -392,7 +400,7 @@ namespace qps::parser {
                 wildcardCount--;
             }
 
-            p = (de == DesignEntity::IF) ? Pattern::ofIfPattern(synonym, e) : Pattern::ofWhilePattern(synonym, e);
+            p = (de == DesignEntity::IF) ? Pattern::ofIfPattern(d, e) : Pattern::ofWhilePattern(d, e);
         }
 
         getAndCheckNextToken(TokenType::CLOSING_PARAN);
@@ -436,29 +444,20 @@ namespace qps::parser {
             return AttrCompareRef::ofAttrRef(parseAttrRef(query));
         } else if (tt == TokenType::STRING) {
             getNextToken();
-            return AttrCompareRef::ofString(t.getText());
+            return AttrCompareRef::ofString(std::string { t.getText() });
         } else if (tt == TokenType::NUMBER) {
             getNextToken();
-            int lineNo;
-            std::stringstream ss(t.getText());
-            ss >> lineNo;
-            return AttrCompareRef::ofNumber(lineNo);
+            return AttrCompareRef::ofNumber(toNumber(t.getText()));
+        } else if (tt == TokenType::PLACEHOLDER) {
+            getNextToken();
+            return AttrCompareRef::ofParameter(query.addParameter());
         } else {
             throw exceptions::PqlSyntaxException(messages::qps::parser::invalidAttrCompRefMessage);
         }
     }
 
     bool Parser::isAttrCompareRefsComparable(const AttrCompareRef& lhs, const AttrCompareRef& rhs) const {
-        if ((lhs.isString() && rhs.isString()) || (lhs.isNumber() && rhs.isNumber())) {
-            return true;
-        } else if (lhs.isAttrRef() && rhs.isAttrRef()) {
-            return lhs.getAttrRef().canBeCompared(rhs.getAttrRef());
-        } else if (lhs.isAttrRef()) {
-            return (lhs.getAttrRef().isString() && rhs.isString()) || (lhs.getAttrRef().isNumber() && rhs.isNumber());
-        } else if (rhs.isAttrRef()) {
-            return (lhs.isString() && rhs.getAttrRef().isString()) || (lhs.isNumber() && rhs.getAttrRef().isNumber());
-        }
-        return false;
+        return lhs.canBeCompared(rhs);
     }
 
     void Parser::validateComparingTypes(const AttrCompareRef& lhs, const AttrCompareRef& rhs) {
@@ -11,6 +11,7 @@ namespace qps::parser {
 
 using qps::query::Query;
 using qps::query::Declaration;
+using qps::query::SynonymId;
 using qps::query::DesignEntity;
 using qps::query::Elem;
 using qps::query::RelRef;
@@ -0,0 +1,138 @@
+#include <cstdio>
+#include <sstream>
+
+#include "QPS/Profile.h"
+
+namespace qps::evaluator {
+namespace {
+    std::string getRelationshipName(query::RelRefType type) {
+        switch (type) {
+            case query::RelRefType::FOLLOWS: return "Follows";
+            case query::RelRefType::FOLLOWST: return "Follows*";
+            case query::RelRefType::PARENT: return "Parent";
+            case query::RelRefType::PARENTT: return "Parent*";
+            case query::RelRefType::MODIFIESS: return "Modifies";
+            case query::RelRefType::MODIFIESP: return "Modifies";
+            case query::RelRefType::USESS: return "Uses";
+            case query::RelRefType::USESP: return "Uses";
+            case query::RelRefType::CALLS: return "Calls";
+            case query::RelRefType::CALLST: return "Calls*";
+            case query::RelRefType::NEXT: return "Next";
+            case query::RelRefType::NEXTT: return "Next*";
+            case query::RelRefType::AFFECTS: return "Affects";
+            case query::RelRefType::AFFECTST: return "Affects*";
+            default: return "Invalid";
+        }
+    }
+
+    std::string getPatternName(query::DesignEntity type) {
+        switch (type) {
+            case query::DesignEntity::ASSIGN: return "assign";
+            case query::DesignEntity::WHILE: return "while";
+            case query::DesignEntity::IF: return "if";
+            default: return "invalid";
+        }
+    }
+
+    void writeString(std::ostringstream& out, const std::string& s) {
+        out << '"';
+        for (char c : s) {
+            switch (c) {
+                case '"': out << "\\\""; break;
+                case '\\': out << "\\\\"; break;
+                case '\n': out << "\\n"; break;
+                case '\t': out << "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        char escaped[8];
+                        std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                        out << escaped;
+                    } else {
+                        out << c;
+                    }
+            }
+        }
+        out << '"';
+    }
+
+    void writeRows(std::ostringstream& out, const std::optional<std::size_t>& rows) {
+        if (rows) out << *rows;
+        else
+            out << "null";
+    }
+
+    void writeClause(std::ostringstream& out, const ClauseProfile& clause, const query::SynonymTable& synonyms) {
+        out << "{\"clause\":";
+        writeString(out, clause.clause);
+        out << ",\"synonyms\":[";
+        for (std::size_t i = 0; i < clause.synonyms.size(); i++) {
+            if (i > 0) out << ",";
+            writeString(out, synonyms.getName(clause.synonyms[i]));
+        }
+        out << "],\"cached\":" << (clause.isCached ? "true" : "false")
+            << ",\"lookupMs\":" << clause.lookupMs
+            << ",\"rows\":" << clause.rows
+            << ",\"rowsBefore\":";
+        writeRows(out, clause.rowsBefore);
+        out << ",\"rowsAfter\":";
+        writeRows(out, clause.rowsAfter);
+        out << "}";
+    }
+
+    void writeGroup(std::ostringstream& out, const GroupProfile& group, const query::SynonymTable& synonyms) {
+        out << "{\"noSyn\":" << (group.noSyn ? "true" : "false")
+            << ",\"cyclic\":" << (group.isCyclic ? "true" : "false")
+            << ",\"cached\":" << (group.isCached ? "true" : "false")
+            << ",\"hasResult\":" << (group.hasResult ? "true" : "false")
+            << ",\"timeMs\":" << group.timeMs
+            << ",\"rows\":" << group.rows
+            << ",\"clauses\":[";
+        for (std::size_t i = 0; i < group.clauses.size(); i++) {
+            if (i > 0) out << ",";
+            writeClause(out, group.clauses[i], synonyms);
+        }
+        out << "]}";
+    }
+}  // namespace
+
+    ClauseProfile ClauseProfile::of(const optimizer::OrderedClause& clause) {
+        optimizer::OrderedClause copy = clause;
+        ClauseProfile profile;
+        if (copy.isSuchThat()) {
+            profile.clause = "such that " + getRelationshipName(copy.getSuchThat()->getType());
+        } else if (copy.isPattern()) {
+            profile.clause = "pattern " + getPatternName(copy.getPattern().getSynonymType());
+        } else {
+            profile.clause = "with";
+        }
+        for (auto s : clause.getSynonyms()) {
+            if (s != query::SynonymTable::NO_SYNONYM) profile.synonyms.push_back(s);
+        }
+        return profile;
+    }
+
+    std::string QueryProfile::toJson() const {
+        std::ostringstream out;
+        out << "{\"query\":";
+        writeString(out, query);
+        out << ",\"valid\":" << (isValid ? "true" : "false")
+            << ",\"planMs\":" << planMs
+            << ",\"evaluateMs\":" << evaluateMs
+            << ",\"projectMs\":" << projectMs
+            << ",\"resultCount\":" << resultCount
+            << ",\"peakBytes\":" << peakBytes
+            << ",\"groups\":[";
+        for (std::size_t i = 0; i < groups.size(); i++) {
+            if (i > 0) out << ",";
+            writeGroup(out, groups[i], *synonyms);
+        }
+        out << "]}";
+        return out.str();
+    }
+
+    std::size_t countRows(const PKBResponse& response) {
+        if (auto *ptr = std::get_if<FieldResponse>(&response.res)) return ptr->size();
+        if (auto *ptr = std::get_if<FieldRowResponse>(&response.res)) return ptr->size();
+        return 0;
+    }
+}  // namespace qps::evaluator
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "QPS/Optimizer.h"
+#include "PKB/PKBResponse.h"
+
+namespace qps::evaluator {
+/**
+ * Struct used to record how a single clause was evaluated
+ */
+struct ClauseProfile {
+    std::string clause;  // the kind of the clause, e.g. `such that Follows*`, `pattern assign` or `with`
+    std::vector<query::SynonymId> synonyms;  // the names are in the SynonymTable of the QueryProfile
+    bool isCached = false;  // whether the result came from the cache shared by a batch
+    double lookupMs = 0;  // the time spent retrieving the result from the PKB
+    std::size_t rows = 0;  // the number of rows retrieved, or 1 if a clause without synonyms holds
+    // the rows of the group table, or the values of the synonym for a clause on a single synonym, before and after
+    // the result is joined. Empty for the clauses that are not joined one at a time.
+    std::optional<std::size_t> rowsBefore;
+    std::optional<std::size_t> rowsAfter;
+
+    /**
+     * Creates the profile of a clause, describing its kind and synonyms.
+     *
+     * @param clause the bound clause
+     * @return ClauseProfile
+     */
+    static ClauseProfile of(const optimizer::OrderedClause& clause);
+};
+
+/**
+ * Struct used to record how a group of clauses was evaluated, with its clauses in evaluation order
+ */
+struct GroupProfile {
+    bool noSyn = false;
+    bool isCyclic = false;
+    bool isCached = false;  // whether the whole group came from the cache shared by a batch
+    bool hasResult = false;
+    double timeMs = 0;
+    std::size_t rows = 0;  // the number of rows of the group table
+    std::vector<ClauseProfile> clauses;
+};
+
+/**
+ * Struct used to record how a query was planned and evaluated, i.e. the result of an EXPLAIN ANALYZE.
+ *
+ * The groups are in the order chosen by the optimizer, and only the groups evaluated before the query was known to
+ * have no result are present.
+ */
+struct QueryProfile {
+    std::string query;
+    bool isValid = false;
+    double planMs = 0;  // parsing, validating and planning
+    double evaluateMs = 0;  // evaluating every group and merging the tables of the selected synonyms
+    double projectMs = 0;
+    std::size_t resultCount = 0;
+    std::size_t peakBytes = 0;  // the most memory the intermediate results held at once, see CancellationToken
+    std::vector<GroupProfile> groups;
+    std::shared_ptr<const query::SynonymTable> synonyms;  // the names of the synonyms of the clauses
+
+    /**
+     * Prints the profile as a JSON object, so that the plans of a query can be compared between releases.
+     *
+     * @return std::string
+     */
+    std::string toJson() const;
+};
+
+/**
+ * Retrieves the number of rows of a PKBResponse.
+ *
+ * @param response the PKBResponse
+ * @return std::size_t
+ */
+std::size_t countRows(const PKBResponse& response);
+
+/**
+ * Converts a duration into milliseconds.
+ */
+inline double toMs(std::chrono::steady_clock::duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+}  // namespace qps::evaluator
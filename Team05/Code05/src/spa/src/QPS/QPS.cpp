@@ -1,22 +1,143 @@
+#include <chrono>
+#include <iterator>
 #include <list>
 #include <string_view>
+#include <unordered_map>
 
 #include "exceptions.h"
+#include "messages.h"
 #include "QPS/QPS.h"
 #include "QPS/Query.h"
 #include "QPS/Evaluator.h"
+#include "QPS/ResultCache.h"
+#include "ThreadPool.h"
 
 namespace qps {
-    void QPS::evaluate(const std::string& query_str, std::list<std::string> &results, PKB *pkbPtr) {
-        qps::query::Query query = parser.parsePql(std::string_view(query_str));
-        if (!query.isValid())
+namespace {
+    void run(const PreparedQuery& prepared, const std::vector<query::Literal>& params,
+             const evaluator::ResultSink& sink, PKB *pkbPtr, evaluator::ResultCache *cache,
+             evaluator::QueryProfile *profile = nullptr, const CancellationToken *token = nullptr) {
+        if (!prepared.isValid() || params.size() != static_cast<std::size_t>(prepared.getParameterCount()))
             return;
 
-        qps::evaluator::Evaluator evaluator(pkbPtr);
+        qps::evaluator::Evaluator evaluator(pkbPtr, cache, profile, token);
         try {
-            results = evaluator.evaluate(query);
+            evaluator.evaluate(prepared.resultCl, prepared.plan, params, sink);
         } catch (exceptions::PqlException) {
             return;
         }
     }
+
+    void checkParameterCount(const PreparedQuery& prepared, const std::vector<query::Literal>& params) {
+        if (prepared.isValid() && params.size() != static_cast<std::size_t>(prepared.getParameterCount()))
+            throw exceptions::PqlSemanticException(messages::qps::parser::wrongParameterCountMessage);
+    }
+
+    evaluator::ResultSink appendTo(std::list<std::string> &results) {
+        return [&results](std::vector<std::string>& chunk) {
+            std::move(chunk.begin(), chunk.end(), std::back_inserter(results));
+        };
+    }
+}  // namespace
+
+    void QPS::evaluate(const std::string& query_str, std::list<std::string> &results, PKB *pkbPtr,
+                       const CancellationToken *token) {
+        execute(prepare(query_str), {}, results, pkbPtr, token);
+    }
+
+    void QPS::evaluate(const std::string& query_str, const evaluator::ResultSink& sink, PKB *pkbPtr,
+                       const CancellationToken *token) {
+        execute(prepare(query_str), {}, sink, pkbPtr, token);
+    }
+
+    evaluator::QueryProfile QPS::explain(const std::string& query_str, std::list<std::string> &results,
+                                         PKB *pkbPtr) {
+        evaluator::QueryProfile profile;
+        profile.query = query_str;
+        auto start = std::chrono::steady_clock::now();
+        PreparedQuery prepared = prepare(query_str);
+        profile.planMs = evaluator::toMs(std::chrono::steady_clock::now() - start);
+        profile.isValid = prepared.isValid();
+        profile.synonyms = prepared.synonyms;
+        // a token without limits, only there to keep the peak memory of the query.
+        CancellationToken token;
+        run(prepared, {}, appendTo(results), pkbPtr, nullptr, &profile, &token);
+        profile.peakBytes = token.getPeakMemory();
+        return profile;
+    }
+
+    PreparedQuery QPS::prepare(const std::string& query_str) {
+        qps::query::Query query = parser.parsePql(std::string_view(query_str));
+        PreparedQuery prepared;
+        if (!query.isValid())
+            return prepared;
+
+        std::vector<query::AttrCompare> with = query.getWith();
+        std::vector<std::shared_ptr<query::RelRef>> suchthat = query.getSuchthat();
+        std::vector<query::Pattern> patterns = query.getPattern();
+        optimizer::Optimizer optimizer(suchthat, with, patterns);
+
+        prepared.valid = true;
+        prepared.parameterCount = query.getParameterCount();
+        prepared.resultCl = query.getResultCl();
+        prepared.plan = optimizer.plan();
+        prepared.synonyms = query.getSynonymTable();
+        return prepared;
+    }
+
+    void QPS::execute(const PreparedQuery& prepared, const std::vector<query::Literal>& params,
+                      std::list<std::string> &results, PKB *pkbPtr, const CancellationToken *token) {
+        checkParameterCount(prepared, params);
+        run(prepared, params, appendTo(results), pkbPtr, nullptr, nullptr, token);
+    }
+
+    void QPS::execute(const PreparedQuery& prepared, const std::vector<query::Literal>& params,
+                      const evaluator::ResultSink& sink, PKB *pkbPtr, const CancellationToken *token) {
+        checkParameterCount(prepared, params);
+        run(prepared, params, sink, pkbPtr, nullptr, nullptr, token);
+    }
+
+    void QPS::execute(const PreparedQuery& prepared, const std::vector<query::Literal>& params,
+                      std::list<std::string> &results, PKB *pkbPtr, evaluator::ResultCache *cache,
+                      const CancellationToken *token) {
+        checkParameterCount(prepared, params);
+        run(prepared, params, appendTo(results), pkbPtr, cache, nullptr, token);
+    }
+
+    std::vector<std::list<std::string>> QPS::evaluateBatch(const std::vector<std::string>& queries, PKB *pkbPtr,
+                                                           bool isParallel, const CancellationToken *token) {
+        std::vector<std::size_t> distinctOf(queries.size());
+        std::vector<PreparedQuery> prepared;
+        std::unordered_map<std::string_view, std::size_t> seen;
+        for (std::size_t i = 0; i < queries.size(); i++) {
+            auto [it, isNew] = seen.try_emplace(queries[i], prepared.size());
+            if (isNew) prepared.push_back(prepare(queries[i]));
+            distinctOf[i] = it->second;
+        }
+
+        std::vector<std::list<std::string>> distinctResults(prepared.size());
+        evaluator::ResultCache cache;
+        auto evaluateOne = [&](std::size_t i) {
+            run(prepared[i], {}, appendTo(distinctResults[i]), pkbPtr, &cache, nullptr, token);
+        };
+        try {
+            if (isParallel) {
+                ThreadPool::shared().parallelFor(prepared.size(), evaluateOne);
+            } else {
+                for (std::size_t i = 0; i < prepared.size(); i++) evaluateOne(i);
+            }
+        } catch (const exceptions::QueryStoppedException&) {
+            pkbPtr->clearCache();
+            throw;
+        }
+        // the queries of the batch leave the caches of the pkb to be cleared once they are all done.
+        pkbPtr->clearCache();
+
+        std::vector<std::list<std::string>> results;
+        results.reserve(queries.size());
+        for (auto i : distinctOf) {
+            results.push_back(distinctResults[i]);
+        }
+        return results;
+    }
 }  // namespace qps
@@ -2,12 +2,31 @@
 
 #include <string>
 #include <list>
+#include <memory>
+#include <vector>
 
 #include "QPS/Parser.h"
+#include "QPS/Optimizer.h"
 #include "QPS/Evaluator.h"
+#include "Cancellation.h"
 
 namespace qps {
 
+/**
+ * Struct used to represent a query that has been parsed and planned once, so that it can be
+ * executed many times with different values bound to its `?` placeholders
+ */
+struct PreparedQuery {
+    bool valid = false;
+    int parameterCount = 0;
+    query::ResultCl resultCl;
+    std::vector<optimizer::PlannedGroup> plan;
+    std::shared_ptr<const query::SynonymTable> synonyms;  // the names of the synonyms the plan refers to by id
+
+    bool isValid() const { return valid; }
+    int getParameterCount() const { return parameterCount; }
+};
+
 /**
  * Struct used to represent the QPS component
  */
@@ -20,8 +39,111 @@ struct QPS {
      * @param query the QPS query
      * @param results the list to store the QPS query results in
      * @param pkbPtr the pointer to the pkb
+     * @param token if given, stops the evaluation once it is cancelled, past its deadline or over its memory budget
+     * @throws exceptions::QueryStoppedException if the token stopped the evaluation
+     */
+    void evaluate(const std::string& query, std::list<std::string> &results, PKB *pkbPtr,
+                  const CancellationToken *token = nullptr);
+
+    /**
+     * Evaluates a query and streams the query results to the sink in chunks, so that they never have to be
+     * collected in a single list
+     *
+     * @param query the QPS query
+     * @param sink the consumer of the QPS query results
+     * @param pkbPtr the pointer to the pkb
+     * @param token if given, stops the evaluation once it is cancelled, past its deadline or over its memory budget
+     * @throws exceptions::QueryStoppedException if the token stopped the evaluation
+     */
+    void evaluate(const std::string& query, const evaluator::ResultSink& sink, PKB *pkbPtr,
+                  const CancellationToken *token = nullptr);
+
+    /**
+     * Evaluates a query like evaluate, and records how it was planned and evaluated: the order of its groups and
+     * clauses, the time spent in the PKB by every clause, the number of rows before and after every join and the
+     * peak memory of its intermediate results.
+     *
+     * @param query the QPS query
+     * @param results the list to store the QPS query results in
+     * @param pkbPtr the pointer to the pkb
+     * @return the profile of the query, which can be printed with QueryProfile::toJson
+     */
+    evaluator::QueryProfile explain(const std::string& query, std::list<std::string> &results, PKB *pkbPtr);
+
+    /**
+     * Parses, validates and plans a query whose literals may be `?` placeholders, e.g.
+     * `stmt s; Select s such that Modifies(s, ?)`
+     *
+     * @param query the QPS query
+     * @return the prepared query, which is invalid if the query is
+     */
+    PreparedQuery prepare(const std::string& query);
+
+    /**
+     * Evaluates a prepared query with values bound to its placeholders, in order of appearance,
+     * and stores the query results in a list of string
+     *
+     * @param prepared the prepared query
+     * @param params a number or a name for every placeholder of the query
+     * @param results the list to store the QPS query results in
+     * @param pkbPtr the pointer to the pkb
+     * @param token if given, stops the evaluation once it is cancelled, past its deadline or over its memory budget
+     * @throws exceptions::PqlSemanticException if the number of values does not match the number of placeholders
+     * @throws exceptions::QueryStoppedException if the token stopped the evaluation
+     */
+    void execute(const PreparedQuery& prepared, const std::vector<query::Literal>& params,
+                 std::list<std::string> &results, PKB *pkbPtr, const CancellationToken *token = nullptr);
+
+    /**
+     * Evaluates a prepared query with values bound to its placeholders, and streams the query results to the sink
+     *
+     * @param prepared the prepared query
+     * @param params a number or a name for every placeholder of the query
+     * @param sink the consumer of the QPS query results
+     * @param pkbPtr the pointer to the pkb
+     * @param token if given, stops the evaluation once it is cancelled, past its deadline or over its memory budget
+     * @throws exceptions::PqlSemanticException if the number of values does not match the number of placeholders
+     * @throws exceptions::QueryStoppedException if the token stopped the evaluation
+     */
+    void execute(const PreparedQuery& prepared, const std::vector<query::Literal>& params,
+                 const evaluator::ResultSink& sink, PKB *pkbPtr, const CancellationToken *token = nullptr);
+
+    /**
+     * Evaluates a prepared query with values bound to its placeholders, sharing the results of its clauses and
+     * groups through the cache, and stores the query results in a list of string. The caches of the pkb are left for
+     * the owner of the cache to clear, so that queries evaluated concurrently against the same pkb can use it.
+     *
+     * @param prepared the prepared query
+     * @param params a number or a name for every placeholder of the query
+     * @param results the list to store the QPS query results in
+     * @param pkbPtr the pointer to the pkb
+     * @param cache the cache shared with the other queries, e.g. of a batch
+     * @param token if given, stops the evaluation once it is cancelled, past its deadline or over its memory budget
+     * @throws exceptions::PqlSemanticException if the number of values does not match the number of placeholders
+     * @throws exceptions::QueryStoppedException if the token stopped the evaluation
+     */
+    void execute(const PreparedQuery& prepared, const std::vector<query::Literal>& params,
+                 std::list<std::string> &results, PKB *pkbPtr, evaluator::ResultCache *cache,
+                 const CancellationToken *token = nullptr);
+
+    /**
+     * Evaluates a batch of queries against the same pkb, and returns the results of every query in order.
+     *
+     * Every query is parsed and planned first. The groups and clauses that the queries have in common, after
+     * their synonyms are matched by declaration order and type, are then evaluated only once and their results are
+     * shared by every query of the batch. Identical queries are evaluated only once as well.
+     *
+     * @param queries the QPS queries
+     * @param pkbPtr the pointer to the pkb, which must not be modified while the batch is evaluated
+     * @param isParallel whether the queries are evaluated concurrently on the shared thread pool
+     * @param token if given, stops the whole batch once it is cancelled, past its deadline or over its memory budget,
+     * which is shared by the queries of the batch
+     * @return the results of every query, in the order of the queries
+     * @throws exceptions::QueryStoppedException if the token stopped the evaluation
      */
-    void evaluate(const std::string& query, std::list<std::string> &results, PKB *pkbPtr);
+    std::vector<std::list<std::string>> evaluateBatch(const std::vector<std::string>& queries, PKB *pkbPtr,
+                                                      bool isParallel = true,
+                                                      const CancellationToken *token = nullptr);
 };
 
 }  // namespace qps
@@ -8,7 +8,7 @@
 #include "PKBTypeMatcher.h"
 
 namespace qps::query {
-std::unordered_map<std::string, DesignEntity> designEntityMap = {
+std::unordered_map<std::string_view, DesignEntity> designEntityMap = {
         {"stmt", DesignEntity::STMT},
         {"read", DesignEntity::READ},
         {"print", DesignEntity::PRINT},
@@ -31,30 +31,68 @@ std::unordered_map<AttrName, std::unordered_set<DesignEntity>>
                                      DesignEntity::PRINT, DesignEntity::WHILE, DesignEntity::IF,
                                      DesignEntity::ASSIGN}} };
 
+SynonymTable::SynonymTable() {
+    names.emplace_back();
+    ids.emplace(names.back(), NO_SYNONYM);
+}
+
+SynonymId SynonymTable::intern(std::string_view name) {
+    auto pos = ids.find(name);
+    if (pos != ids.end())
+        return pos->second;
+
+    SynonymId id = static_cast<SynonymId>(names.size());
+    names.emplace_back(name);
+    ids.emplace(names.back(), id);
+    return id;
+}
+
+Declaration SynonymTable::declare(std::string_view name, DesignEntity type) {
+    SynonymId id = intern(name);
+    return Declaration{ id, names[id], type };
+}
+
 bool Query::isValid() const { return valid; }
 
 void Query::setValid(bool validity) { valid = validity; }
 
-bool Query::hasDeclaration(const std::string& name) const {
-    return declarations.count(name) > 0;
+int Query::addParameter() { return parameterCount++; }
+
+int Query::getParameterCount() const { return parameterCount; }
+
+const Declaration* Query::findDeclaration(std::string_view name) const {
+    for (auto& declaration : declarations) {
+        if (declaration.getSynonym() == name)
+            return &declaration;
+    }
+    return nullptr;
+}
+
+bool Query::hasDeclaration(std::string_view name) const {
+    return findDeclaration(name) != nullptr;
 }
 
 bool Query::hasSelectElem(const Elem& e) const {
     return selectResults.hasElem(e);
 }
 
-DesignEntity Query::getDeclarationDesignEntity(const std::string& name) const {
-    if (declarations.count(name) == 0)
+Declaration Query::getDeclaration(std::string_view name) const {
+    const Declaration* declaration = findDeclaration(name);
+    if (declaration == nullptr)
         throw exceptions::PqlSyntaxException(
                 messages::qps::parser::declarationDoesNotExistMessage);
 
-    return declarations.find(name)->second;
+    return *declaration;
 }
 
-std::unordered_map<std::string, DesignEntity> Query::getDeclarations() const {
-    return declarations;
+DesignEntity Query::getDeclarationDesignEntity(std::string_view name) const {
+    return getDeclaration(name).getType();
 }
 
+std::vector<Declaration> Query::getDeclarations() const { return declarations; }
+
+std::shared_ptr<const SynonymTable> Query::getSynonymTable() const { return synonyms; }
+
 ResultCl Query::getResultCl() const { return selectResults; }
 
 std::vector<std::shared_ptr<RelRef>> Query::getSuchthat() const {
@@ -65,11 +103,11 @@ std::vector<Pattern> Query::getPattern() const { return pattern; }
 
 std::vector<AttrCompare> Query::getWith() const { return with; }
 
-void Query::addDeclaration(const std::string& var, DesignEntity de) {
-    if (declarations.find(var) != declarations.end())
+void Query::addDeclaration(std::string_view var, DesignEntity de) {
+    if (hasDeclaration(var))
         throw exceptions::PqlSyntaxException(messages::qps::parser::declarationAlreadyExists);
 
-    declarations.emplace(var, de);
+    declarations.push_back(synonyms->declare(var, de));
 }
 
 void Query::addResultCl(const ResultCl& resultCl) { selectResults = resultCl; }
@@ -100,10 +138,10 @@ Elem Elem::ofAttrRef(AttrRef ar) {
     return e;
 }
 
-std::string Elem::getSyn() const {
-    if (isDeclaration()) return getDeclaration().getSynonym();
+SynonymId Elem::getSynId() const {
+    if (isDeclaration()) return declaration.getId();
     else
-        return getAttrRef().getDeclarationSynonym();
+        return ar.getDeclarationId();
 }
 
 ResultCl ResultCl::ofBoolean() {
@@ -122,12 +160,13 @@ bool ResultCl::hasElem(const Elem& e) const {
     return std::find(tuple.begin(), tuple.end(), e) != tuple.end();
 }
 
-std::vector<std::string> ResultCl::getSynAsList() const {
-    std::unordered_set<std::string> distinctSyn;
-    for (auto elem : getTuple()) {
-        distinctSyn.insert(elem.getSyn());
+std::vector<SynonymId> ResultCl::getSynAsList() const {
+    std::vector<SynonymId> syns;
+    for (auto& elem : tuple) {
+        SynonymId id = elem.getSynId();
+        if (std::find(syns.begin(), syns.end(), id) == syns.end())
+            syns.push_back(id);
     }
-    std::vector<std::string> syns(distinctSyn.begin(), distinctSyn.end());
     return syns;
 }
 
@@ -151,11 +190,31 @@ EntRef EntRef::ofWildcard() {
     return e;
 }
 
+EntRef EntRef::ofParameter(int index) {
+    EntRef e;
+    e.parameter = index;
+    e.type = EntRefType::PARAMETER;
+    return e;
+}
+
+EntRef EntRef::bind(const std::vector<Literal>& params) const {
+    if (!isParameter())
+        return *this;
+
+    auto name = std::get_if<std::string>(&params.at(parameter));
+    if (name == nullptr)
+        throw exceptions::PqlSemanticException(messages::qps::parser::invalidParameterValueMessage);
+
+    return ofVarName(*name);
+}
+
 EntRefType EntRef::getType() const { return type; }
 
 Declaration EntRef::getDeclaration() const { return declaration; }
 
-std::string EntRef::getDeclarationSynonym() const {
+SynonymId EntRef::getDeclarationId() const { return declaration.getId(); }
+
+std::string_view EntRef::getDeclarationSynonym() const {
     return declaration.getSynonym();
 }
 
@@ -189,6 +248,24 @@ StmtRef StmtRef::ofWildcard() {
     return s;
 }
 
+StmtRef StmtRef::ofParameter(int index) {
+    StmtRef s;
+    s.type = StmtRefType::PARAMETER;
+    s.parameter = index;
+    return s;
+}
+
+StmtRef StmtRef::bind(const std::vector<Literal>& params) const {
+    if (!isParameter())
+        return *this;
+
+    auto lineNo = std::get_if<int>(&params.at(parameter));
+    if (lineNo == nullptr)
+        throw exceptions::PqlSemanticException(messages::qps::parser::invalidParameterValueMessage);
+
+    return ofLineNo(*lineNo);
+}
+
 StmtRefType StmtRef::getType() const { return type; }
 
 Declaration StmtRef::getDeclaration() const { return declaration; }
@@ -197,7 +274,9 @@ DesignEntity StmtRef::getDeclarationType() const {
     return declaration.getType();
 }
 
-std::string StmtRef::getDeclarationSynonym() const {
+SynonymId StmtRef::getDeclarationId() const { return declaration.getId(); }
+
+std::string_view StmtRef::getDeclarationSynonym() const {
     return declaration.getSynonym();
 }
 
@@ -278,24 +357,30 @@ ExpSpec Pattern::getExpression() const {
     return expression;
 }
 
-Pattern Pattern::ofAssignPattern(std::string synonym, EntRef er, ExpSpec exp) {
+Pattern Pattern::bind(const std::vector<Literal>& params) const {
+    Pattern p = *this;
+    p.lhs = lhs.bind(params);
+    return p;
+}
+
+Pattern Pattern::ofAssignPattern(const Declaration& synonym, EntRef er, ExpSpec exp) {
     Pattern p;
-    p.declaration = Declaration{ std::move(synonym), DesignEntity::ASSIGN };
+    p.declaration = Declaration{ synonym.getId(), synonym.getSynonym(), DesignEntity::ASSIGN };
     p.lhs = std::move(er);
     p.expression = std::move(exp);
     return p;
 }
 
-Pattern Pattern::ofWhilePattern(std::string synonym, EntRef er) {
+Pattern Pattern::ofWhilePattern(const Declaration& synonym, EntRef er) {
     Pattern p;
-    p.declaration = Declaration{ std::move(synonym), DesignEntity::WHILE };
+    p.declaration = Declaration{ synonym.getId(), synonym.getSynonym(), DesignEntity::WHILE };
     p.lhs = std::move(er);
     return p;
 }
 
-Pattern Pattern::ofIfPattern(std::string synonym, EntRef er) {
+Pattern Pattern::ofIfPattern(const Declaration& synonym, EntRef er) {
     Pattern p;
-    p.declaration = Declaration{ std::move(synonym), DesignEntity::IF };
+    p.declaration = Declaration{ synonym.getId(), synonym.getSynonym(), DesignEntity::IF };
     p.lhs = std::move(er);
     return p;
 }
@@ -308,6 +393,17 @@ std::vector<Declaration> ModifiesS::getDecs() {
     return getDecsHelper(&ModifiesS::modifiesStmt, &ModifiesS::modified);
 }
 
+std::shared_ptr<RelRef> ModifiesS::bind(const std::vector<Literal>& params) const {
+    // a placeholder as the first argument stands for a statement, unless it is bound to a procedure name
+    if (modifiesStmt.isParameter() && std::holds_alternative<std::string>(params.at(modifiesStmt.getParameter()))) {
+        auto bound = std::make_shared<ModifiesP>();
+        bound->modifiesProc = EntRef::ofVarName(std::get<std::string>(params.at(modifiesStmt.getParameter())));
+        bound->modified = modified.bind(params);
+        return bound;
+    }
+    return bindHelper(&ModifiesS::modifiesStmt, &ModifiesS::modified, params);
+}
+
 bool ModifiesS::equalTo(const RelRef& r) const {
     if (r.type != this->type)
         return false;
@@ -346,6 +442,10 @@ std::vector<Declaration> ModifiesP::getDecs() {
     return getDecsHelper(&ModifiesP::modifiesProc, &ModifiesP::modified);
 }
 
+std::shared_ptr<RelRef> ModifiesP::bind(const std::vector<Literal>& params) const {
+    return bindHelper(&ModifiesP::modifiesProc, &ModifiesP::modified, params);
+}
+
 bool ModifiesP::equalTo(const RelRef& r) const {
     if (r.type != this->type)
         return false;
@@ -384,6 +484,10 @@ std::vector<Declaration> UsesP::getDecs() {
     return getDecsHelper(&UsesP::useProc, &UsesP::used);
 }
 
+std::shared_ptr<RelRef> UsesP::bind(const std::vector<Literal>& params) const {
+    return bindHelper(&UsesP::useProc, &UsesP::used, params);
+}
+
 bool UsesP::equalTo(const RelRef& r) const {
     if (r.type != this->type)
         return false;
@@ -419,6 +523,17 @@ std::vector<Declaration> UsesS::getDecs() {
     return getDecsHelper(&UsesS::useStmt, &UsesS::used);
 }
 
+std::shared_ptr<RelRef> UsesS::bind(const std::vector<Literal>& params) const {
+    // a placeholder as the first argument stands for a statement, unless it is bound to a procedure name
+    if (useStmt.isParameter() && std::holds_alternative<std::string>(params.at(useStmt.getParameter()))) {
+        auto bound = std::make_shared<UsesP>();
+        bound->useProc = EntRef::ofVarName(std::get<std::string>(params.at(useStmt.getParameter())));
+        bound->used = used.bind(params);
+        return bound;
+    }
+    return bindHelper(&UsesS::useStmt, &UsesS::used, params);
+}
+
 bool UsesS::equalTo(const RelRef& r) const {
     if (r.type != this->type)
         return false;
@@ -454,6 +569,10 @@ std::vector<Declaration> Follows::getDecs() {
     return getDecsHelper(&Follows::follower, &Follows::followed);
 }
 
+std::shared_ptr<RelRef> Follows::bind(const std::vector<Literal>& params) const {
+    return bindHelper(&Follows::follower, &Follows::followed, params);
+}
+
 bool Follows::equalTo(const RelRef& r) const {
     if (r.type != this->type)
         return false;
@@ -477,6 +596,10 @@ std::vector<Declaration> FollowsT::getDecs() {
     return getDecsHelper(&FollowsT::follower, &FollowsT::transitiveFollowed);
 }
 
+std::shared_ptr<RelRef> FollowsT::bind(const std::vector<Literal>& params) const {
+    return bindHelper(&FollowsT::follower, &FollowsT::transitiveFollowed, params);
+}
+
 bool FollowsT::equalTo(const RelRef& r) const {
     if (r.type != this->type)
         return false;
@@ -500,6 +623,10 @@ std::vector<Declaration> Parent::getDecs() {
     return getDecsHelper(&Parent::parent, &Parent::child);
 }
 
+std::shared_ptr<RelRef> Parent::bind(const std::vector<Literal>& params) const {
+    return bindHelper(&Parent::parent, &Parent::child, params);
+}
+
 bool Parent::equalTo(const RelRef& r) const {
     if (r.type != this->type)
         return false;
@@ -522,6 +649,10 @@ std::vector<Declaration> ParentT::getDecs() {
     return getDecsHelper(&ParentT::parent, &ParentT::transitiveChild);
 }
 
+std::shared_ptr<RelRef> ParentT::bind(const std::vector<Literal>& params) const {
+    return bindHelper(&ParentT::parent, &ParentT::transitiveChild, params);
+}
+
 bool ParentT::equalTo(const RelRef& r) const {
     if (r.type != this->type)
         return false;
@@ -546,6 +677,10 @@ std::vector<Declaration> Calls::getDecs() {
     return getDecsHelper(&Calls::caller, &Calls::callee);
 }
 
+std::shared_ptr<RelRef> Calls::bind(const std::vector<Literal>& params) const {
+    return bindHelper(&Calls::caller, &Calls::callee, params);
+}
+
 bool Calls::equalTo(const RelRef& r) const {
     if (r.type != this->type)
         return false;
@@ -586,6 +721,10 @@ std::vector<Declaration> CallsT::getDecs() {
     return getDecsHelper(&CallsT::caller, &CallsT::transitiveCallee);
 }
 
+std::shared_ptr<RelRef> CallsT::bind(const std::vector<Literal>& params) const {
+    return bindHelper(&CallsT::caller, &CallsT::transitiveCallee, params);
+}
+
 bool CallsT::equalTo(const RelRef& r) const {
     if (r.type != this->type)
         return false;
@@ -620,6 +759,10 @@ std::vector<Declaration> Next::getDecs() {
     return getDecsHelper(&Next::before, &Next::after);
 }
 
+std::shared_ptr<RelRef> Next::bind(const std::vector<Literal>& params) const {
+    return bindHelper(&Next::before, &Next::after, params);
+}
+
 std::vector<PKBField> Next::getField() {
     return getFieldHelper(&Next::before, &Next::after);
 }
@@ -642,6 +785,10 @@ std::vector<Declaration> NextT::getDecs() {
     return getDecsHelper(&NextT::before, &NextT::transitiveAfter);
 }
 
+std::shared_ptr<RelRef> NextT::bind(const std::vector<Literal>& params) const {
+    return bindHelper(&NextT::before, &NextT::transitiveAfter, params);
+}
+
 std::vector<PKBField> NextT::getField() {
     return getFieldHelper(&NextT::before, &NextT::transitiveAfter);
 }
@@ -664,6 +811,10 @@ std::vector<Declaration> Affects::getDecs() {
     return getDecsHelper(&Affects::affectingStmt, &Affects::affected);
 }
 
+std::shared_ptr<RelRef> Affects::bind(const std::vector<Literal>& params) const {
+    return bindHelper(&Affects::affectingStmt, &Affects::affected, params);
+}
+
 std::vector<PKBField> Affects::getField() {
     return getFieldHelper(&Affects::affectingStmt, &Affects::affected);
 }
@@ -702,6 +853,10 @@ std::vector<Declaration> AffectsT::getDecs() {
     return getDecsHelper(&AffectsT::affectingStmt, &AffectsT::transitiveAffected);
 }
 
+std::shared_ptr<RelRef> AffectsT::bind(const std::vector<Literal>& params) const {
+    return bindHelper(&AffectsT::affectingStmt, &AffectsT::transitiveAffected, params);
+}
+
 std::vector<PKBField> AffectsT::getField() {
     return getFieldHelper(&AffectsT::affectingStmt,
                           &AffectsT::transitiveAffected);
@@ -758,4 +913,44 @@ AttrCompareRef AttrCompareRef::ofAttrRef(AttrRef ar) {
     acr.ar = std::move(ar);
     return acr;
 }
+
+AttrCompareRef AttrCompareRef::ofParameter(int index) {
+    AttrCompareRef acr;
+    acr.type = AttrCompareRefType::PARAMETER;
+    acr.parameter = index;
+    return acr;
+}
+
+AttrCompareRef AttrCompareRef::bind(const std::vector<Literal>& params) const {
+    if (!isParameter())
+        return *this;
+
+    const Literal& value = params.at(parameter);
+    if (auto num = std::get_if<int>(&value))
+        return ofNumber(*num);
+    return ofString(std::get<std::string>(value));
+}
+
+bool AttrCompareRef::canBeCompared(const AttrCompareRef& o) const {
+    if (isParameter() || o.isParameter()) {
+        return true;
+    } else if ((isString() && o.isString()) || (isNumber() && o.isNumber())) {
+        return true;
+    } else if (isAttrRef() && o.isAttrRef()) {
+        return ar.canBeCompared(o.ar);
+    } else if (isAttrRef()) {
+        return (ar.isString() && o.isString()) || (ar.isNumber() && o.isNumber());
+    } else if (o.isAttrRef()) {
+        return (isString() && o.ar.isString()) || (isNumber() && o.ar.isNumber());
+    }
+    return false;
+}
+
+AttrCompare AttrCompare::bind(const std::vector<Literal>& params) const {
+    AttrCompare bound { lhs.bind(params), rhs.bind(params) };
+    if (!bound.lhs.canBeCompared(bound.rhs))
+        throw exceptions::PqlSemanticException(messages::qps::parser::incompatibleComparisonMessage);
+
+    return bound;
+}
 }  // namespace qps::query
@@ -6,11 +6,14 @@
 #include "utils.h"
 
 #include <algorithm>
+#include <deque>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
+#include <variant>
 #include <vector>
 
 namespace qps::query {
@@ -31,31 +34,89 @@ enum class DesignEntity {
 
 enum class AttrName;
 
-extern std::unordered_map<std::string, DesignEntity> designEntityMap;
+extern std::unordered_map<std::string_view, DesignEntity> designEntityMap;
 extern std::unordered_map<AttrName, std::unordered_set<DesignEntity>> attrNameToDesignEntityMap;
 
 enum class StmtRefType {
     NOT_INITIALIZED,
     DECLARATION,
     LINE_NO,
-    WILDCARD
+    WILDCARD,
+    PARAMETER
+};
+
+/**
+* A value bound to a placeholder of a prepared query, either a number or a name
+*/
+using Literal = std::variant<int, std::string>;
+
+using SynonymId = int;
+
+struct Declaration;
+
+/**
+* Table interning the synonym names of a query into small integer ids, so that the rest of the query
+* processor compares and hashes synonyms by id instead of by string.
+*
+* Every query owns its own table, which is filled in as the synonyms are declared and freed together with
+* the query and the plan prepared from it, so ids are only meaningful within that query. Id 0 is the empty
+* synonym, which stands for "no synonym".
+*/
+class SynonymTable {
+public:
+    static constexpr SynonymId NO_SYNONYM = 0;
+
+    SynonymTable();
+    SynonymTable(const SynonymTable&) = delete;
+    SynonymTable& operator=(const SynonymTable&) = delete;
+
+    /**
+    * Returns the id of the synonym, adding it to the table if it has not been seen before
+    *
+    * @param name the name of the synonym
+    * @return the id of the synonym
+    */
+    SynonymId intern(std::string_view name);
+
+    /**
+    * Returns a Declaration of the synonym, interning its name
+    *
+    * @param name the name of the synonym
+    * @param type the DesignEntity of the synonym
+    * @return the Declaration, whose name is a view into this table
+    */
+    Declaration declare(std::string_view name, DesignEntity type);
+
+    /**
+    * Returns the name of an interned synonym
+    *
+    * @param id the id of the synonym
+    * @return the name of the synonym
+    */
+    const std::string& getName(SynonymId id) const { return names[id]; }
+
+private:
+    std::deque<std::string> names;  // a deque, so the views in ids and in the declarations stay valid
+    std::unordered_map<std::string_view, SynonymId> ids;
 };
 
 /**
 * Struct used to store information on a Declaration
 */
 struct Declaration {
-    std::string synonym;
+    SynonymId id = SynonymTable::NO_SYNONYM;
+    std::string_view synonym;  // a view into the SynonymTable of the query that declared it
     DesignEntity type{};
 
     Declaration() {}
-    Declaration(std::string synonym, DesignEntity type) : synonym(std::move(synonym)), type(type) {}
+    Declaration(SynonymId id, std::string_view synonym, DesignEntity type) : id(id), synonym(synonym), type(type) {}
 
-    std::string getSynonym() const { return synonym; }
+    SynonymId getId() const { return id; }
+    std::string_view getSynonym() const { return synonym; }
     DesignEntity getType() const { return type; }
 
     bool operator==(const Declaration& o) const {
-        return synonym == o.synonym && type == o.type;
+        return id == o.id && type == o.type;
     }
 };
 
@@ -81,7 +142,8 @@ struct AttrRef {
     bool operator==(const AttrRef& o) const { return (attrName == o.attrName) && (declaration == o.declaration); }
 
     AttrName getAttrName() const { return attrName; }
-    std::string getDeclarationSynonym() const { return declaration.getSynonym(); }
+    SynonymId getDeclarationId() const { return declaration.getId(); }
+    std::string_view getDeclarationSynonym() const { return declaration.getSynonym(); }
     DesignEntity getDeclarationType() const { return declaration.getType(); }
     Declaration getDeclaration() const { return declaration; }
 
@@ -108,7 +170,7 @@ struct Elem {
 
     Declaration getDeclaration() const { return declaration; }
     AttrRef getAttrRef() const { return ar; }
-    std::string getSyn() const;
+    SynonymId getSynId() const;
 
     bool operator==(const Elem& o) const {
         if ((type == ElemType::ATTR_REF) && (o.type == ElemType::ATTR_REF)) {
@@ -135,7 +197,7 @@ struct ResultCl {
 
     bool isBoolean() const { return boolean; }
     std::vector<Elem> getTuple() const { return tuple; }
-    std::vector<std::string> getSynAsList() const;
+    std::vector<SynonymId> getSynAsList() const;
 
     bool hasElem(const Elem& e) const;
 
@@ -151,6 +213,7 @@ struct StmtRef {
 private:
     Declaration declaration{};
     int lineNo = -1;
+    int parameter = -1;
     StmtRefType type = StmtRefType::NOT_INITIALIZED;
 
 public:
@@ -177,29 +240,50 @@ public:
     */
     static StmtRef ofWildcard();
 
+    /**
+    * Returns a StmtRef of type Parameter, a placeholder for a line number
+    *
+    * @param index the index of the placeholder in the query
+    * @return StmtRef of type parameter
+    */
+    static StmtRef ofParameter(int index);
+
+    /**
+    * Returns the StmtRef with its placeholder, if any, replaced by the bound value
+    *
+    * @param params the values bound to the placeholders of the query
+    * @return StmtRef without a placeholder
+    */
+    StmtRef bind(const std::vector<Literal>& params) const;
+
     StmtRefType getType() const;
-    std::string getDeclarationSynonym() const;
+    SynonymId getDeclarationId() const;
+    std::string_view getDeclarationSynonym() const;
     DesignEntity getDeclarationType() const;
     Declaration getDeclaration() const;
 
     int getLineNo() const;
+    int getParameter() const { return parameter; }
 
     bool isDeclaration() const;
     bool isLineNo() const;
     bool isWildcard() const;
+    bool isParameter() const { return type == StmtRefType::PARAMETER; }
 
     bool operator==(const StmtRef& o) const {
         if (type == StmtRefType::DECLARATION && o.type == StmtRefType::DECLARATION) {
             return declaration == o.declaration;
         } else if (type == StmtRefType::LINE_NO && o.type == StmtRefType::LINE_NO) {
             return lineNo == o.lineNo;
+        } else if (type == StmtRefType::PARAMETER && o.type == StmtRefType::PARAMETER) {
+            return parameter == o.parameter;
         }
 
         return type == StmtRefType::WILDCARD && o.type == StmtRefType::WILDCARD;
     }
 };
 
-enum class EntRefType { NOT_INITIALIZED, DECLARATION, VARIABLE_NAME, WILDCARD };
+enum class EntRefType { NOT_INITIALIZED, DECLARATION, VARIABLE_NAME, WILDCARD, PARAMETER };
 
 /**
 * Struct used to store information on a EntRef
@@ -208,6 +292,7 @@ struct EntRef {
 private:
     Declaration declaration{};
     std::string variable;
+    int parameter = -1;
     EntRefType type = EntRefType::NOT_INITIALIZED;
 
 public:
@@ -234,17 +319,36 @@ public:
     */
     static EntRef ofWildcard();
 
+    /**
+    * Returns a EntRef of type Parameter, a placeholder for a name
+    *
+    * @param index the index of the placeholder in the query
+    * @return EntRef of type parameter
+    */
+    static EntRef ofParameter(int index);
+
+    /**
+    * Returns the EntRef with its placeholder, if any, replaced by the bound value
+    *
+    * @param params the values bound to the placeholders of the query
+    * @return EntRef without a placeholder
+    */
+    EntRef bind(const std::vector<Literal>& params) const;
+
     EntRefType getType() const;
 
-    std::string getDeclarationSynonym() const;
+    SynonymId getDeclarationId() const;
+    std::string_view getDeclarationSynonym() const;
     DesignEntity getDeclarationType() const;
     Declaration getDeclaration() const;
 
     std::string getVariableName() const;
+    int getParameter() const { return parameter; }
 
     bool isDeclaration() const;
     bool isVarName() const;
     bool isWildcard() const;
+    bool isParameter() const { return type == EntRefType::PARAMETER; }
 
     bool operator==(const EntRef& o) const {
         if (type == EntRefType::DECLARATION && o.type == EntRefType::DECLARATION)
@@ -252,6 +356,8 @@ public:
         else if (type == EntRefType::VARIABLE_NAME &&
             o.type == EntRefType::VARIABLE_NAME)
             return variable == o.variable;
+        else if (type == EntRefType::PARAMETER && o.type == EntRefType::PARAMETER)
+            return parameter == o.parameter;
 
         return type == EntRefType::WILDCARD && o.type == EntRefType::WILDCARD;
     }
@@ -341,6 +447,15 @@ struct RelRef {
       */
     virtual std::vector<Declaration> getDecs() = 0;
 
+    /**
+      * Pure virtual function that returns a copy of the RelRef with the
+      * placeholders in its arguments replaced by the bound values
+      *
+      * @param params the values bound to the placeholders of the query
+      * @returns the bound RelRef
+      */
+    virtual std::shared_ptr<RelRef> bind(const std::vector<Literal>& params) const = 0;
+
 protected:
     /**
     * Returns a vector of PKBFields after transforming the RelRef subclass 
@@ -395,6 +510,24 @@ protected:
         return synonyms;
     }
 
+    /**
+    * Returns a copy of the RelRef subclass with both of its member
+    * attributes bound
+    *
+    * @param *f1 memory address of class member
+    * @param *f2 memory address of class member
+    * @param params the values bound to the placeholders of the query
+    *
+    * @return the bound RelRef
+    */
+    template <typename T, typename F1, typename F2>
+    std::shared_ptr<RelRef> bindHelper(F1 T::*f1, F2 T::*f2, const std::vector<Literal>& params) const {
+        auto bound = std::make_shared<T>(*static_cast<const T*>(this));
+        (*bound).*f1 = ((*bound).*f1).bind(params);
+        (*bound).*f2 = ((*bound).*f2).bind(params);
+        return bound;
+    }
+
     /**
     * Returns True if a RelRef subclass is = to one aonother
     
@@ -423,6 +556,7 @@ struct ModifiesS : RelRef {
 
     std::vector<PKBField> getField() override;
     std::vector<Declaration> getDecs() override;
+    std::shared_ptr<RelRef> bind(const std::vector<Literal>& params) const override;
 
     bool equalTo(const RelRef& r) const override;
     size_t getHash() const override;
@@ -442,6 +576,7 @@ struct ModifiesP : RelRef {
 
     std::vector<PKBField> getField() override;
     std::vector<Declaration> getDecs() override;
+    std::shared_ptr<RelRef> bind(const std::vector<Literal>& params) const override;
 
     bool equalTo(const RelRef& r) const override;
     size_t getHash() const override;
@@ -461,6 +596,7 @@ struct UsesS : RelRef {
 
     std::vector<PKBField> getField() override;
     std::vector<Declaration> getDecs() override;
+    std::shared_ptr<RelRef> bind(const std::vector<Literal>& params) const override;
 
     bool equalTo(const RelRef& r) const override;
     size_t getHash() const override;
@@ -480,6 +616,7 @@ struct UsesP : RelRef {
 
     std::vector<PKBField> getField() override;
     std::vector<Declaration> getDecs() override;
+    std::shared_ptr<RelRef> bind(const std::vector<Literal>& params) const override;
 
     bool equalTo(const RelRef& r) const override;
 
@@ -500,6 +637,7 @@ struct Follows : RelRef {
 
     std::vector<PKBField> getField() override;
     std::vector<Declaration> getDecs() override;
+    std::shared_ptr<RelRef> bind(const std::vector<Literal>& params) const override;
     bool equalTo(const RelRef& r) const override;
 
     size_t getHash() const override;
@@ -516,6 +654,7 @@ struct FollowsT : RelRef {
 
     std::vector<PKBField> getField() override;
     std::vector<Declaration> getDecs() override;
+    std::shared_ptr<RelRef> bind(const std::vector<Literal>& params) const override;
 
     bool equalTo(const RelRef& r) const override;
 
@@ -533,6 +672,7 @@ struct Parent : RelRef {
 
     std::vector<PKBField> getField() override;
     std::vector<Declaration> getDecs() override;
+    std::shared_ptr<RelRef> bind(const std::vector<Literal>& params) const override;
 
     bool equalTo(const RelRef& r) const override;
 
@@ -550,6 +690,7 @@ struct ParentT : RelRef {
 
     std::vector<PKBField> getField() override;
     std::vector<Declaration> getDecs() override;
+    std::shared_ptr<RelRef> bind(const std::vector<Literal>& params) const override;
 
     bool equalTo(const RelRef& r) const override;
 
@@ -567,6 +708,7 @@ struct Calls : RelRef {
 
     std::vector<PKBField> getField() override;
     std::vector<Declaration> getDecs() override;
+    std::shared_ptr<RelRef> bind(const std::vector<Literal>& params) const override;
 
     bool equalTo(const RelRef& r) const override;
 
@@ -587,6 +729,7 @@ struct CallsT : RelRef {
 
     std::vector<PKBField> getField() override;
     std::vector<Declaration> getDecs() override;
+    std::shared_ptr<RelRef> bind(const std::vector<Literal>& params) const override;
 
     bool equalTo(const RelRef& r) const override;
 
@@ -607,6 +750,7 @@ struct Next : RelRef {
 
     std::vector<PKBField> getField() override;
     std::vector<Declaration> getDecs() override;
+    std::shared_ptr<RelRef> bind(const std::vector<Literal>& params) const override;
 
     bool equalTo(const RelRef& r) const override;
 
@@ -624,6 +768,7 @@ struct NextT : RelRef {
 
     std::vector<PKBField> getField() override;
     std::vector<Declaration> getDecs() override;
+    std::shared_ptr<RelRef> bind(const std::vector<Literal>& params) const override;
 
     bool equalTo(const RelRef& r) const override;
 
@@ -641,6 +786,7 @@ struct Affects : RelRef {
 
     std::vector<PKBField> getField() override;
     std::vector<Declaration> getDecs() override;
+    std::shared_ptr<RelRef> bind(const std::vector<Literal>& params) const override;
 
     bool equalTo(const RelRef& r) const override;
 
@@ -661,6 +807,7 @@ struct AffectsT : RelRef {
 
     std::vector<PKBField> getField() override;
     std::vector<Declaration> getDecs() override;
+    std::shared_ptr<RelRef> bind(const std::vector<Literal>& params) const override;
 
     bool equalTo(const RelRef& r) const override;
 
@@ -721,40 +868,49 @@ struct Pattern {
     /**
     * Returns a Pattern which is of type Assign
     *
-    * @param synonym the synonym of the declaration for the assign pattern
+    * @param synonym the declaration of the synonym for the assign pattern
     * @param er the lhs of the assign pattern
     * @param exp the ExpSpec of the assign pattern
     *
     * @return Pattern which has declaartion type of assign
     */
-    static Pattern ofAssignPattern(std::string synonym, EntRef er, ExpSpec exp);
+    static Pattern ofAssignPattern(const Declaration& synonym, EntRef er, ExpSpec exp);
     /**
     * Returns a Pattern which is of type If
     *
-    * @param synonym the synonym of the declaration for the If pattern
+    * @param synonym the declaration of the synonym for the If pattern
     * @param er the lhs of the If pattern
     *
     * @return Pattern which has declaration type of If
     */
-    static Pattern ofIfPattern(std::string synonym, EntRef er);
+    static Pattern ofIfPattern(const Declaration& synonym, EntRef er);
     /**
     * Returns a Pattern which is of type While
     *
-    * @param synonym the synonym of the declaration for the while pattern
+    * @param synonym the declaration of the synonym for the while pattern
     * @param er the lhs of the while pattern
     * @param exp the ExpSpec of the while pattern
     *
     * @return Pattern which has declaration type of while
     */
-    static Pattern ofWhilePattern(std::string synonym, EntRef er);
+    static Pattern ofWhilePattern(const Declaration& synonym, EntRef er);
 
-    std::string getSynonym() const { return declaration.getSynonym(); }
+    SynonymId getSynonymId() const { return declaration.getId(); }
+    std::string_view getSynonym() const { return declaration.getSynonym(); }
     DesignEntity getSynonymType() const { return declaration.getType(); }
     Declaration getDeclaration() const { return declaration; }
 
     EntRef getEntRef() const { return lhs; }
     ExpSpec getExpression() const;
 
+    /**
+    * Returns the Pattern with the placeholder in its lhs, if any, replaced by the bound value
+    *
+    * @param params the values bound to the placeholders of the query
+    * @return the bound Pattern
+    */
+    Pattern bind(const std::vector<Literal>& params) const;
+
     bool operator==(const Pattern& o) const {
         return (declaration == o.declaration) 
             && (lhs == o.lhs)
@@ -767,7 +923,7 @@ private:
     ExpSpec expression{};
 };
 
-enum class AttrCompareRefType { NOT_INITIALIZED, NUMBER, STRING, ATTRREF };
+enum class AttrCompareRefType { NOT_INITIALIZED, NUMBER, STRING, ATTRREF, PARAMETER };
 
 /**
 * Struct used to represent an AttrCompareRef (ref of a with clause)
@@ -778,6 +934,7 @@ private:
     std::string str_value;
     AttrCompareRefType type = AttrCompareRefType::NOT_INITIALIZED;
     int number = -1;
+    int parameter = -1;
 
 public:
     /**
@@ -801,14 +958,40 @@ public:
     * @return AttrCompareRef of type attrref
     */
     static AttrCompareRef ofAttrRef(AttrRef ar);
+    /**
+    * Returns a AttrCompareRef of type parameter, a placeholder for a string or a number
+    *
+    * @param index the index of the placeholder in the query
+    * @return AttrCompareRef of type parameter
+    */
+    static AttrCompareRef ofParameter(int index);
+
+    /**
+    * Returns the AttrCompareRef with its placeholder, if any, replaced by the bound value
+    *
+    * @param params the values bound to the placeholders of the query
+    * @return AttrCompareRef without a placeholder
+    */
+    AttrCompareRef bind(const std::vector<Literal>& params) const;
 
     std::string getString() const { return str_value; }
     int getNumber() const { return number; }
+    int getParameter() const { return parameter; }
     AttrRef getAttrRef() const { return ar; }
 
     bool isString() const { return type == AttrCompareRefType::STRING; }
     bool isNumber() const { return type == AttrCompareRefType::NUMBER; }
     bool isAttrRef() const { return type == AttrCompareRefType::ATTRREF; }
+    bool isParameter() const { return type == AttrCompareRefType::PARAMETER; }
+
+    /**
+    * Returns whether the two refs can be compared in a with clause. A placeholder can
+    * be compared with anything until it is bound.
+    *
+    * @param o the other AttrCompareRef
+    * @return a boolean
+    */
+    bool canBeCompared(const AttrCompareRef& o) const;
 
     bool operator==(const AttrCompareRef& o) const {
         if (isString() && o.isString()) {
@@ -817,6 +1000,8 @@ public:
             return number == o.getNumber();
         } else if (isAttrRef() && o.isAttrRef()) {
             return ar == o.getAttrRef();
+        } else if (isParameter() && o.isParameter()) {
+            return parameter == o.getParameter();
         }
 
         return false;
@@ -836,6 +1021,14 @@ struct AttrCompare {
     AttrCompareRef getLhs() const { return lhs; }
     AttrCompareRef getRhs() const { return rhs; }
 
+    /**
+    * Returns the AttrCompare with its placeholders replaced by the bound values
+    *
+    * @param params the values bound to the placeholders of the query
+    * @return the bound AttrCompare
+    */
+    AttrCompare bind(const std::vector<Literal>& params) const;
+
     bool operator==(const AttrCompare &o) const {
         return (lhs == o.lhs) && (rhs == o.rhs);
     }
@@ -846,15 +1039,19 @@ struct AttrCompare {
 */
 class Query {
 private:
-    std::unordered_map<std::string, DesignEntity> declarations;
+    std::shared_ptr<SynonymTable> synonyms = std::make_shared<SynonymTable>();
+    std::vector<Declaration> declarations;
     ResultCl selectResults;
     std::vector<std::shared_ptr<RelRef>> suchthat;
     std::vector<Pattern> pattern;
     std::vector<AttrCompare> with;
+    int parameterCount = 0;
     bool valid;
 
+    const Declaration* findDeclaration(std::string_view name) const;
+
 public:
-    std::unordered_map<std::string, DesignEntity> getDeclarations() const;
+    std::vector<Declaration> getDeclarations() const;
     ResultCl getResultCl() const;
 
     std::vector<std::shared_ptr<RelRef>> getSuchthat() const;
@@ -864,23 +1061,52 @@ public:
     bool isValid() const;
     void setValid(bool);
 
-    bool hasDeclaration(const std::string&) const;
+    /**
+    * Returns the index of a new placeholder in the query
+    *
+    * @return the index of the placeholder
+    */
+    int addParameter();
+    int getParameterCount() const;
+
+    bool hasDeclaration(std::string_view) const;
     bool hasSelectElem(const Elem& e) const;
 
-    void addDeclaration(const std::string&, DesignEntity);
+    /**
+    * Declares a synonym, interning its name into a SynonymId
+    *
+    * @param name the name of the synonym
+    * @param de the DesignEntity of the synonym
+    */
+    void addDeclaration(std::string_view name, DesignEntity de);
     void addResultCl(const ResultCl& resultCl);
 
     void addSuchthat(const std::shared_ptr<RelRef>&);
     void addPattern(const Pattern&);
     void addWith(const AttrCompare&);
 
+    /**
+    * Returns the Declaration of the specified synonym
+    *
+    * @param name the name of the declaration
+    * @return the Declaration holding the id and DesignEntity of the synonym
+    */
+    Declaration getDeclaration(std::string_view name) const;
+
+    /**
+    * Returns the table holding the names of the synonyms declared by the query
+    *
+    * @return the SynonymTable, which lives as long as the query or a plan prepared from it
+    */
+    std::shared_ptr<const SynonymTable> getSynonymTable() const;
+
     /**
     * Returns the DesignEntity of the specified declaration
     *
     * @param declaration the name of the declaration
     * @return DesignEntity of the specified declaration
     */
-    DesignEntity getDeclarationDesignEntity(const std::string& declaration) const;
+    DesignEntity getDeclarationDesignEntity(std::string_view declaration) const;
 };
 }  // namespace qps::query
 
@@ -903,7 +1129,7 @@ using utils::hash_combine;
 template <> struct hash<Declaration> {
     size_t operator()(const Declaration& d) const {
         size_t seed = 0;
-        hash_combine(seed, d.getSynonym());
+        hash_combine(seed, d.getId());
         hash_combine(seed, d.getType());
         return seed;
     }
@@ -927,6 +1153,8 @@ template <> struct hash<StmtRef> {
             hash_combine(seed, s.getDeclaration());
         } else if (s.isLineNo()) {
             hash_combine(seed, s.getLineNo());
+        } else if (s.isParameter()) {
+            hash_combine(seed, s.getParameter());
         }
 
         return seed;
@@ -942,6 +1170,8 @@ template <> struct hash<EntRef> {
             hash_combine(seed, e.getDeclaration());
         } else if (e.isVarName()) {
             hash_combine(seed, e.getVariableName());
+        } else if (e.isParameter()) {
+            hash_combine(seed, e.getParameter());
         }
 
         return seed;
@@ -989,6 +1219,8 @@ template <> struct hash<AttrCompareRef> {
             hash_combine(seed, a.getNumber());
         } else if (a.isAttrRef()) {
             hash_combine(seed, a.getAttrRef());
+        } else if (a.isParameter()) {
+            hash_combine(seed, a.getParameter());
         }
         return seed;
     }
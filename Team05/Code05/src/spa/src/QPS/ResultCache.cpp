@@ -0,0 +1,64 @@
+#include "ResultCache.h"
+
+#include "exceptions.h"
+
+namespace qps::evaluator {
+    template <typename K, typename V, typename H>
+    std::shared_ptr<const V> ResultCache::lookup(Entries<K, V, H>& entries, const K& key,
+                                                 const std::function<V()>& compute) {
+        while (true) {
+            std::promise<std::shared_ptr<const V>> promise;
+            std::shared_future<std::shared_ptr<const V>> future;
+            bool isOwner = false;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                auto it = entries.find(key);
+                if (it != entries.end()) {
+                    future = it->second;
+                } else {
+                    future = promise.get_future().share();
+                    entries.emplace(key, future);
+                    isOwner = true;
+                }
+            }
+            // only the caller that created the entry computes it, every other caller waits on the future.
+            if (!isOwner) {
+                hits++;
+                try {
+                    return future.get();
+                } catch (const exceptions::QueryStoppedException&) {
+                    // the owner was stopped rather than the key being wrong, so the key is computed again.
+                    continue;
+                }
+            }
+            computed++;
+            try {
+                promise.set_value(std::make_shared<const V>(compute()));
+            } catch (const exceptions::QueryStoppedException&) {
+                // a stopped computation says nothing about the key, so it is not kept for the other callers.
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    entries.erase(key);
+                }
+                promise.set_exception(std::current_exception());
+            } catch (...) {
+                promise.set_exception(std::current_exception());
+            }
+            return future.get();
+        }
+    }
+
+    std::shared_ptr<const ClauseResult> ResultCache::getClause(const optimizer::OrderedClause& clause,
+                                                               const std::function<ClauseResult()>& compute) {
+        return lookup(clauses, clause, compute);
+    }
+
+    bool ResultCache::holds(const optimizer::OrderedClause& clause, const std::function<bool()>& compute) {
+        return *lookup(noSynClauses, clause, compute);
+    }
+
+    std::shared_ptr<const GroupResult> ResultCache::getGroup(const optimizer::PlannedGroup& group,
+                                                             const std::function<GroupResult()>& compute) {
+        return lookup(groups, group, compute);
+    }
+}  // namespace qps::evaluator
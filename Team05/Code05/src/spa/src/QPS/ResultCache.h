@@ -0,0 +1,100 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "QPS/Optimizer.h"
+#include "QPS/ResultTable.h"
+#include "PKB/PKBResponse.h"
+
+namespace qps::evaluator {
+/**
+ * Struct used to store the result of a single clause with synonyms, before it is joined into a group
+ */
+struct ClauseResult {
+    PKBResponse response;
+    std::vector<query::SynonymId> synonyms;
+};
+
+/**
+ * Struct used to store the result of a whole group of clauses
+ */
+struct GroupResult {
+    bool hasResult;
+    ResultTable table;
+};
+
+/**
+ * A cache of clause and group results shared by the queries of a batch evaluated against the same PKB.
+ *
+ * Every distinct key is computed exactly once: the first caller computes it, and concurrent callers asking for the
+ * same key wait for that result instead of computing it again. A computation that throws is cached as well, so
+ * every caller sees the same exception, unless it was stopped by its query's token: the key is then dropped and
+ * computed again by the next caller that asks for it.
+ */
+class ResultCache {
+public:
+    /**
+     * Retrieves the result of a clause with synonyms, computing it if no query of the batch has done so yet.
+     *
+     * @param clause the bound clause
+     * @param compute computes the result of the clause
+     * @return the result of the clause
+     */
+    std::shared_ptr<const ClauseResult> getClause(const optimizer::OrderedClause& clause,
+                                                  const std::function<ClauseResult()>& compute);
+
+    /**
+     * Checks whether a clause without synonyms holds, computing it if no query of the batch has done so yet.
+     *
+     * @param clause the bound clause
+     * @param compute checks whether the clause holds
+     * @return true if the clause holds, false otherwise
+     */
+    bool holds(const optimizer::OrderedClause& clause, const std::function<bool()>& compute);
+
+    /**
+     * Retrieves the result of a group of clauses, computing it if no query of the batch has done so yet.
+     *
+     * @param group the bound group
+     * @param compute computes the result of the group
+     * @return the result of the group
+     */
+    std::shared_ptr<const GroupResult> getGroup(const optimizer::PlannedGroup& group,
+                                                const std::function<GroupResult()>& compute);
+
+    /**
+     * Retrieves the number of clauses and groups computed so far.
+     *
+     * @return std::size_t
+     */
+    std::size_t getComputedCount() const { return computed; }
+
+    /**
+     * Retrieves the number of lookups answered from the cache so far.
+     *
+     * @return std::size_t
+     */
+    std::size_t getHitCount() const { return hits; }
+
+private:
+    template <typename K, typename V, typename H>
+    using Entries = std::unordered_map<K, std::shared_future<std::shared_ptr<const V>>, H>;
+
+    std::mutex mutex;
+    Entries<optimizer::OrderedClause, ClauseResult, optimizer::OrderedClauseHash> clauses;
+    Entries<optimizer::OrderedClause, bool, optimizer::OrderedClauseHash> noSynClauses;
+    Entries<optimizer::PlannedGroup, GroupResult, optimizer::PlannedGroupHash> groups;
+    std::atomic<std::size_t> computed {0};
+    std::atomic<std::size_t> hits {0};
+
+    template <typename K, typename V, typename H>
+    std::shared_ptr<const V> lookup(Entries<K, V, H>& entries, const K& key, const std::function<V()>& compute);
+};
+}  // namespace qps::evaluator
@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <iterator>
+
 #include "ResultProjector.h"
 
 namespace qps::evaluator {
@@ -42,33 +45,84 @@ namespace qps::evaluator {
         return res;
     }
 
-    std::list<std::string> ResultProjector::projectResult(ResultTable &table, query::ResultCl resultCl) {
-        if (!table.hasResult()) {
-            return std::list<std::string>{};
+    namespace {
+        /**
+         * Checks whether distinct fields can be projected to the same value, e.g. c.procName of two calls.
+         */
+        bool isAttrShared(const SelectElemInfo& elem, const query::Elem& e) {
+            if (!elem.isAttr) return false;
+            query::DesignEntity type = e.getAttrRef().getDeclarationType();
+            bool isStmt = type != query::DesignEntity::PROCEDURE && type != query::DesignEntity::VARIABLE &&
+                          type != query::DesignEntity::CONSTANT;
+            return isStmt && (elem.attrName == query::AttrName::PROCNAME || elem.attrName == query::AttrName::VARNAME);
         }
+    }  // namespace
+
+    std::list<std::string> ResultProjector::projectResult(const ResultTable &table,
+                                                          const query::ResultCl& resultCl) {
+        std::list<std::string> results;
+        projectResult(table, resultCl, [&results](std::vector<std::string>& chunk) {
+            std::move(chunk.begin(), chunk.end(), std::back_inserter(results));
+        });
+        return results;
+    }
+
+    void ResultProjector::projectResult(const ResultTable &table, const query::ResultCl& resultCl,
+                                        const ResultSink& sink, std::size_t chunkSize) {
+        if (!table.hasResult()) return;
+
         std::vector<query::Elem> tuple = resultCl.getTuple();
         std::vector<SelectElemInfo> elem{};
+        std::vector<bool> isProjected(table.getColumns().size(), false);
+        std::vector<bool> isShared{};
         for (auto e : tuple) {
             SelectElemInfo elemInfo;
             if (e.isDeclaration())
-                elemInfo = SelectElemInfo::ofDeclaration(table.getSynLocation(e.getDeclaration().getSynonym()));
+                elemInfo = SelectElemInfo::ofDeclaration(table.getSynLocation(e.getDeclaration().getId()));
             else
-                elemInfo = SelectElemInfo::ofAttr(table.getSynLocation(e.getAttrRef().getDeclarationSynonym()),
+                elemInfo = SelectElemInfo::ofAttr(table.getSynLocation(e.getAttrRef().getDeclarationId()),
                                                   e.getAttrRef().getAttrName());
+            isProjected[elemInfo.columnNo] = true;
+            isShared.push_back(isAttrShared(elemInfo, e));
             elem.push_back(elemInfo);
         }
-        std::unordered_set<std::string> resultSet;
-        for (auto record : table.getTable()) {
+        // the rows of the table are distinct, so they stay distinct if every column is projected by its own value.
+        bool isDistinct = std::find(isShared.begin(), isShared.end(), true) == isShared.end() &&
+                          std::find(isProjected.begin(), isProjected.end(), false) == isProjected.end();
+
+        std::unordered_set<std::vector<PKBField>, PKBFieldVectorHash> seen;
+        std::vector<std::string> chunk;
+        chunk.reserve(std::min(chunkSize, table.getTable().size()));
+        for (auto& record : table.getTable()) {
+            if (!isDistinct) {
+                std::vector<PKBField> key;
+                key.reserve(elem.size());
+                for (std::size_t i = 0; i < elem.size(); i++) {
+                    const PKBField& fld = record[elem[i].columnNo];
+                    if (isShared[i]) {
+                        std::string name = ClauseHandler::getPKBFieldAttr<std::string>(fld);
+                        key.push_back(elem[i].attrName == query::AttrName::PROCNAME
+                                      ? PKBField::createConcrete(PROC_NAME{name})
+                                      : PKBField::createConcrete(VAR_NAME{name}));
+                    } else {
+                        key.push_back(fld);
+                    }
+                }
+                if (!seen.insert(std::move(key)).second) continue;
+            }
+
             std::string result;
-            for (int i = 0; i  < elem.size(); i++) {
-                PKBField fld = record[elem[i].columnNo];
-                    result += (elem[i].isAttr ? PKBFieldAttrToString(fld, elem[i].attrName)
-                                        : PKBFieldToString(fld));
-                if (i != elem.size() - 1) result +=  " ";
+            for (std::size_t i = 0; i < elem.size(); i++) {
+                const PKBField& fld = record[elem[i].columnNo];
+                result += (elem[i].isAttr ? PKBFieldAttrToString(fld, elem[i].attrName) : PKBFieldToString(fld));
+                if (i != elem.size() - 1) result += " ";
+            }
+            chunk.push_back(std::move(result));
+            if (chunk.size() >= chunkSize) {
+                sink(chunk);
+                chunk.clear();
             }
-            resultSet.insert(result);
         }
-
-        return std::list<std::string>{resultSet.begin(), resultSet.end()};
+        if (!chunk.empty()) sink(chunk);
     }
 }  // namespace qps::evaluator
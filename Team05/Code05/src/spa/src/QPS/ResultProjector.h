@@ -1,6 +1,9 @@
 #pragma once
 
+#include <functional>
 #include <list>
+#include <string>
+#include <vector>
 #include "ResultTable.h"
 #include "Query.h"
 #include "ClauseHandler.h"
@@ -18,8 +21,17 @@ struct SelectElemInfo {
     static SelectElemInfo ofAttr(int columnNo, query::AttrName attrName);
 };
 
+/**
+ * A caller-supplied consumer of projected results, which receives them in chunks. The chunk is cleared and reused
+ * after the call, so the sink should move out the strings it keeps.
+ */
+using ResultSink = std::function<void(std::vector<std::string>& chunk)>;
+
 class ResultProjector {
 public:
+    /** The number of results formatted before they are handed to the sink. */
+    static constexpr std::size_t DEFAULT_CHUNK_SIZE = 1024;
+
     /**
      * Wraps a certain PKBField into a string representation.
      *
@@ -43,6 +55,21 @@ public:
      * @param variable the synonym in select part of the query
      * @return the list of string representation of the query result
      */
-    static std::list<std::string> projectResult(ResultTable &table, query::ResultCl resultCl);
+    static std::list<std::string> projectResult(const ResultTable &table, const query::ResultCl& resultCl);
+
+    /**
+     * Projects the final result from the result table and streams it to the sink in chunks.
+     *
+     * Rows are deduplicated on the projected fields before they are formatted, so only the distinct projected
+     * tuples are kept in memory, and none at all if every column of the table is projected. Each result is
+     * formatted only once, just before it is written to the chunk.
+     *
+     * @param table the reference the result table
+     * @param resultCl the result clause of the query
+     * @param sink the consumer of the results
+     * @param chunkSize the largest number of results handed to the sink at a time
+     */
+    static void projectResult(const ResultTable &table, const query::ResultCl& resultCl, const ResultSink& sink,
+                              std::size_t chunkSize = DEFAULT_CHUNK_SIZE);
 };
 }  // namespace qps::evaluator
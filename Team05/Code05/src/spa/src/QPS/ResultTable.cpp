@@ -1,31 +1,27 @@
 #include "ResultTable.h"
 
+#include <algorithm>
 #include <utility>
 
 namespace qps::evaluator {
-    bool ResultTable::synExists(std::string name) {
-        return synSequenceMap.find(name) != synSequenceMap.end();
+    bool ResultTable::synExists(SynonymId id) const {
+        return getSynLocation(id) != -1;
     }
 
-    std::unordered_map<std::string, int> ResultTable::getSynMap() {
-        return this->synSequenceMap;
-    }
-
-    std::vector<std::string> ResultTable::getColumns() {
+    const std::vector<SynonymId>& ResultTable::getColumns() const {
         return this->columns;
     }
 
-    int ResultTable::getSynLocation(std::string synonym) {
-        return getSynMap().find(synonym)->second;
+    int ResultTable::getSynLocation(SynonymId synonym) const {
+        auto pos = std::find(columns.begin(), columns.end(), synonym);
+        return pos == columns.end() ? -1 : static_cast<int>(pos - columns.begin());
     }
 
-    void ResultTable::insertSynLocationToLast(std::string name) {
-        int size = synSequenceMap.size();
-        synSequenceMap.insert({name, size});
-        columns.push_back(name);
+    void ResultTable::insertSynLocationToLast(SynonymId id) {
+        columns.push_back(id);
     }
     
-    Table ResultTable::getTable() {
+    const Table& ResultTable::getTable() const {
         return this->table;
     }
 
@@ -34,11 +30,11 @@ namespace qps::evaluator {
     }
 
     bool ResultTable::isEmpty() {
-        return table.empty() && synSequenceMap.empty();
+        return table.empty() && columns.empty();
     }
 
-    bool ResultTable::hasResult() {
-        return !table.empty() && !synSequenceMap.empty();
+    bool ResultTable::hasResult() const {
+        return !table.empty() && !columns.empty();
     }
 
     VectorResponse ResultTable::transToVectorResponse(SingleResponse response) {
@@ -49,7 +45,7 @@ namespace qps::evaluator {
         return newVectorRes;
     }
 
-    ResultTable ResultTable::transToResultTable(PKBResponse response, std::vector<std::string> synonyms) {
+    ResultTable ResultTable::transToResultTable(PKBResponse response, const std::vector<SynonymId>& synonyms) {
         ResultTable resTable = ResultTable();
         for (auto & synonym : synonyms) {
             resTable.insertSynLocationToLast(synonym);
@@ -68,13 +64,24 @@ namespace qps::evaluator {
         return resTable;
     }
 
-    void ResultTable::insert(PKBResponse r, std::vector<std::string> synonyms) {
-        ResultTable resTable = ResultTable::transToResultTable(std::move(r), std::move(synonyms));
-        join(resTable);
+    void ResultTable::insert(PKBResponse r, const std::vector<SynonymId>& synonyms,
+                             const CancellationToken* token) {
+        ResultTable resTable = ResultTable::transToResultTable(std::move(r), synonyms);
+        join(resTable, token);
+    }
+
+    std::size_t ResultTable::estimateBytes(std::size_t rows, std::size_t columns) {
+        // every row is a vector in a node of the set, which also keeps a bucket pointer per row.
+        std::size_t rowBytes = sizeof(std::vector<PKBField>) + columns * sizeof(PKBField) + 3 * sizeof(void*);
+        return rows * rowBytes;
+    }
+
+    std::size_t ResultTable::estimateBytes() const {
+        return estimateBytes(table.size(), columns.size());
     }
 
 
-    void ResultTable::crossJoin(ResultTable& other) {
+    void ResultTable::crossJoin(ResultTable& other, const CancellationToken* token) {
         for (auto s : other.columns) {
             insertSynLocationToLast(s);
         }
@@ -83,6 +90,8 @@ namespace qps::evaluator {
         }
         Table newTable;
         for (const auto& row : other.table) {
+            CancellationToken::check(token);
+            CancellationToken::checkMemory(token, estimateBytes(newTable.size() + table.size(), columns.size()));
             for (const auto& thisRow : table) {
                 auto newRow = thisRow;
                 auto rowCopy = row;
@@ -108,15 +117,15 @@ namespace qps::evaluator {
         return joinable;
     }
 
-    void ResultTable::innerJoin(ResultTable& other) {
+    void ResultTable::innerJoin(ResultTable& other, const CancellationToken* token) {
         if (table.empty()) {
             return;
         }
         std::vector<int> thisCols{};
         std::vector<int> otherCols{};
         for (auto syn : other.getColumns()) {
-            if (synSequenceMap.find(syn) != synSequenceMap.end()) {
-                thisCols.push_back(synSequenceMap.find(syn)->second);
+            if (synExists(syn)) {
+                thisCols.push_back(getSynLocation(syn));
                 otherCols.push_back(other.getSynLocation(syn));
             } else {
                 insertSynLocationToLast(syn);
@@ -124,6 +133,8 @@ namespace qps::evaluator {
         }
         Table newTable;
         for (auto row : other.table) {
+            CancellationToken::check(token);
+            CancellationToken::checkMemory(token, estimateBytes(newTable.size(), columns.size()));
             for (auto record : table) {
                 std::unordered_set<int> otherColsSet{otherCols.begin(), otherCols.end()};
                 bool joinable = isJoinable(record, row, thisCols, otherCols);
@@ -140,35 +151,35 @@ namespace qps::evaluator {
         this->table = std::move(newTable);
     }
 
-    void ResultTable::join(ResultTable& other) {
+    void ResultTable::join(ResultTable& other, const CancellationToken* token) {
         bool hasSharedSyn = false;
-        for (auto syn : other.getSynMap()) {
-            if (synSequenceMap.find(syn.first) != synSequenceMap.end()) hasSharedSyn = true;
+        for (auto syn : other.columns) {
+            if (synExists(syn)) hasSharedSyn = true;
         }
 
         if (isEmpty()) {
-            this->synSequenceMap = other.synSequenceMap;
             this->columns = other.columns;
             this->table = other.table;
         } else if (!hasSharedSyn) {
-            crossJoin(other);
+            crossJoin(other, token);
         } else {
-            innerJoin(other);
+            innerJoin(other, token);
         }
     }
 
-    void ResultTable::filterColumns(std::vector<std::string> selectSyns) {
+    void ResultTable::filterColumns(const std::vector<SynonymId>& selectSyns) {
         std::vector<int> selectedColumn;
-        std::unordered_map<std::string, int> map;
-        int columnNo = 0;
+        std::vector<SynonymId> selectedSyns;
         for (auto s : selectSyns) {
             if (synExists(s)) {
                 selectedColumn.push_back(getSynLocation(s));
-                map[s] = columnNo;
-                columnNo++;
+                selectedSyns.push_back(s);
             }
         }
-        this->synSequenceMap = map;
+        this->columns.clear();
+        for (auto s : selectedSyns) {
+            insertSynLocationToLast(s);
+        }
         Table newTable;
         for (auto row : table) {
             std::vector<PKBField> newRow;
@@ -6,9 +6,12 @@
 #include <unordered_set>
 #include <unordered_map>
 
+#include "Cancellation.h"
 #include "PKB/PKBResponse.h"
+#include "QPS/Query.h"
 
 namespace qps::evaluator {
+using query::SynonymId;
 using VectorResponse = std::unordered_set<std::vector<PKBField>, PKBFieldVectorHash>;
 using SingleResponse = std::unordered_set<PKBField, PKBFieldHash>;
 using Table = std::unordered_set<std::vector<PKBField>, PKBFieldVectorHash>;
@@ -18,53 +21,47 @@ using Table = std::unordered_set<std::vector<PKBField>, PKBFieldVectorHash>;
  */
 class ResultTable {
 private:
-    std::unordered_map<std::string, int> synSequenceMap;
-    std::vector<std::string> columns;
+    // the synonym of each column. A table only has a few columns, so a synonym is found by scanning them, which
+    // keeps the table as small as its own synonyms however many synonyms have been interned.
+    std::vector<SynonymId> columns;
     Table table;
 
 public:
     /**
      * Checks whether a synonym exists in current result table.
      *
-     * @param name the synonym name
+     * @param id the synonym id
      * @return whether the synonyms exists in the table.
      */
-    bool synExists(std::string name);
-
-    /**
-     * Retrieves the synonym map which contains the mapping information between synonym name and it's location.
-     *
-     * @return the synonym map
-     */
-    std::unordered_map<std::string, int> getSynMap();
+    bool synExists(SynonymId id) const;
 
     /**
      * Retrieves the columns template of the result table.
      *
-     * @return the column names
+     * @return the synonym ids of the columns
      */
-    std::vector<std::string> getColumns();
+    const std::vector<SynonymId>& getColumns() const;
     /**
      * Retrieves the synonym column number in the table.
      *
-     * @param synonym name of the synonym to search
-     * @return the column number of the synonym
+     * @param synonym id of the synonym to search
+     * @return the column number of the synonym, or -1 if it is not in the table
      */
-    int getSynLocation(std::string synonym);
+    int getSynLocation(SynonymId synonym) const;
 
     /**
      * Allocates the last column of the table to the new synonym
      *
-     * @param name the synonym name
+     * @param id the synonym id
      */
-    void insertSynLocationToLast(std::string name);
+    void insertSynLocationToLast(SynonymId id);
 
     /**
      * Retrieves the entire result table.
      *
      * @return the result table
      */
-    Table getTable();
+    const Table& getTable() const;
 
     /**
      * Sets the table in the resultTable.
@@ -81,9 +78,23 @@ public:
     /**
      * @return whether the result table contains valid results;
      */
-    bool hasResult();
+    bool hasResult() const;
+
+    void filterColumns(const std::vector<SynonymId>& selectSyns);
 
-    void filterColumns(std::vector<std::string> selectSyns);
+    /**
+     * Estimates the memory held by a table, counting the rows, their fields and the buckets of the table.
+     *
+     * @param rows the number of rows
+     * @param columns the number of columns
+     * @return the estimated number of bytes
+     */
+    static std::size_t estimateBytes(std::size_t rows, std::size_t columns);
+
+    /**
+     * @return the estimated memory held by this table
+     */
+    std::size_t estimateBytes() const;
 
     /**
      * Transfers the PKBResponse in a type of set<PKBField> into set<vector<PKBField>>.
@@ -100,23 +111,26 @@ public:
      * @param synonyms the list of all synonyms from the query
      * @return a new resultTable with the content in PKBResponse.
      */
-    static ResultTable transToResultTable(PKBResponse response, std::vector<std::string> synonyms);
+    static ResultTable transToResultTable(PKBResponse response, const std::vector<SynonymId>& synonyms);
 
     /**
      * Inserts the PKBResponse to the result table and join the response to the table.
      *
      * @param r the PKBResponse from PKB side
      * @param synonyms the list of all synonyms from the query
+     * @param token if given, checked while the response is joined
      */
-    void insert(PKBResponse r, std::vector<std::string> synonyms);
+    void insert(PKBResponse r, const std::vector<SynonymId>& synonyms, const CancellationToken* token = nullptr);
 
     /**
      * CrossJoins the result table to the current response table when the synonyms of the result are different from
      * all synonyms in the table.
      *
      * @param other a resultTable
+     * @param token if given, checked for every row of other and against the size of the joined table
+     * @throws exceptions::QueryStoppedException if the query of the token is stopped
      */
-    void crossJoin(ResultTable& other);
+    void crossJoin(ResultTable& other, const CancellationToken* token = nullptr);
 
     /**
      * Checks whether two rows in two resultTable are able to inner join together.
@@ -134,14 +148,17 @@ public:
      * InnerJoins the result table to the current response table if table already contains the synonyms in the response.
      *
      * @param other a resultTable
+     * @param token if given, checked for every row of other and against the size of the joined table
+     * @throws exceptions::QueryStoppedException if the query of the token is stopped
      */
-    void innerJoin(ResultTable& other);
+    void innerJoin(ResultTable& other, const CancellationToken* token = nullptr);
 
     /**
      * Joins the result table to the result table using either crossJoin or innerJoin.
      *
      * @param other a resultTable
+     * @param token if given, checked while the tables are joined
      */
-    void join(ResultTable& other);
+    void join(ResultTable& other, const CancellationToken* token = nullptr);
 };
 }  // namespace qps::evaluator
@@ -0,0 +1,61 @@
+#include "SynonymDomains.h"
+
+namespace qps::evaluator {
+    bool SynonymDomains::restrict(const PKBResponse& response, SynonymId synonym) {
+        std::vector<int> ids;
+        if (auto *ptr = std::get_if<SingleResponse>(&response.res)) {
+            ids.reserve(ptr->size());
+            for (auto& field : *ptr) ids.push_back(index.intern(field));
+        } else if (auto *ptr = std::get_if<VectorResponse>(&response.res)) {
+            ids.reserve(ptr->size());
+            for (auto& row : *ptr) ids.push_back(index.intern(row[0]));
+        }
+        Bitset values(index.size());
+        for (auto id : ids) values.set(id);
+
+        auto [it, isNew] = domains.try_emplace(synonym, std::move(values));
+        if (!isNew) it->second &= values;
+        return it->second.any();
+    }
+
+    std::vector<SynonymId> SynonymDomains::getSynonyms() const {
+        std::vector<SynonymId> synonyms;
+        for (auto& [synonym, domain] : domains) synonyms.push_back(synonym);
+        return synonyms;
+    }
+
+    bool SynonymDomains::contains(const Bitset& domain, const PKBField& field) const {
+        int id = index.find(field);
+        return id != -1 && domain.test(id);
+    }
+
+    PKBResponse SynonymDomains::filter(const PKBResponse& response, const std::vector<SynonymId>& synonyms) const {
+        std::vector<const Bitset*> columns;
+        bool isFiltered = false;
+        for (auto s : synonyms) {
+            auto it = domains.find(s);
+            columns.push_back(it == domains.end() ? nullptr : &it->second);
+            isFiltered = isFiltered || it != domains.end();
+        }
+        auto *ptr = std::get_if<VectorResponse>(&response.res);
+        if (!isFiltered || !ptr) return response;
+
+        VectorResponse res;
+        for (auto& row : *ptr) {
+            bool isKept = true;
+            for (std::size_t i = 0; i < row.size() && isKept; i++) {
+                isKept = !columns[i] || contains(*columns[i], row[i]);
+            }
+            if (isKept) res.insert(row);
+        }
+        bool hasResult = !res.empty();
+        return PKBResponse{hasResult, Response{res}};
+    }
+
+    PKBResponse SynonymDomains::getDomain(SynonymId synonym) const {
+        SingleResponse res;
+        domains.at(synonym).forEach([&](std::size_t id) { res.insert(index.getField(static_cast<int>(id))); });
+        bool hasResult = !res.empty();
+        return PKBResponse{hasResult, Response{res}};
+    }
+}  // namespace qps::evaluator
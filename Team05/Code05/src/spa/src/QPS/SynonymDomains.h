@@ -0,0 +1,101 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include "Bitset.h"
+#include "QPS/ResultTable.h"
+#include "PKB/PKBField.h"
+#include "PKB/PKBResponse.h"
+
+namespace qps::evaluator {
+/**
+ * Interns the PKBFields seen while evaluating a group of clauses as dense ids, so that sets of fields can be kept as
+ * bitsets and relations as sorted ids.
+ */
+class FieldIndex {
+public:
+    /**
+     * Retrieves the id of a field, assigning the next id if the field has not been seen yet.
+     */
+    int intern(const PKBField& field) {
+        auto [it, isNew] = idOf.try_emplace(field, static_cast<int>(fields.size()));
+        if (isNew) fields.push_back(field);
+        return it->second;
+    }
+
+    /**
+     * Retrieves the id of a field, or -1 if the field has not been seen yet.
+     */
+    int find(const PKBField& field) const {
+        auto it = idOf.find(field);
+        return it == idOf.end() ? -1 : it->second;
+    }
+
+    const PKBField& getField(int id) const { return fields[id]; }
+
+    std::size_t size() const { return fields.size(); }
+
+private:
+    std::vector<PKBField> fields;
+    std::unordered_map<PKBField, int, PKBFieldHash> idOf;
+};
+
+/**
+ * The candidate values of the synonyms of a group of clauses, narrowed down by the clauses that only restrict a
+ * single synonym, e.g. `with s.stmt# = 10`, `pattern a("x", _)` or `Modifies(s, "x")`.
+ *
+ * Every such clause is intersected into the domain of its synonym as a bitset over interned field ids, before any
+ * clause relating two synonyms is joined. The results of those clauses are then filtered by the domains, so the
+ * single synonym clauses never have to go through a table join.
+ */
+class SynonymDomains {
+public:
+    /**
+     * Intersects the domain of a synonym with the values of a single synonym clause.
+     *
+     * @param response the result of the clause
+     * @param synonym the synonym of the clause
+     * @return false if the domain became empty, true otherwise
+     */
+    bool restrict(const PKBResponse& response, SynonymId synonym);
+
+    /**
+     * Checks whether any clause has restricted the synonym.
+     */
+    bool hasDomain(SynonymId synonym) const { return domains.find(synonym) != domains.end(); }
+
+    /**
+     * Retrieves the number of values in the domain of a synonym, or 0 if it has not been restricted.
+     */
+    std::size_t getDomainSize(SynonymId synonym) const {
+        auto it = domains.find(synonym);
+        return it == domains.end() ? 0 : it->second.count();
+    }
+
+    /**
+     * Retrieves the synonyms that have been restricted.
+     */
+    std::vector<SynonymId> getSynonyms() const;
+
+    /**
+     * Keeps the rows of a clause result whose every field is in the domain of its synonym, if it has one.
+     *
+     * @param response the result of the clause
+     * @param synonyms the synonyms of the columns of the result
+     * @return the filtered response
+     */
+    PKBResponse filter(const PKBResponse& response, const std::vector<SynonymId>& synonyms) const;
+
+    /**
+     * Retrieves the domain of a restricted synonym as the result of a single synonym clause.
+     */
+    PKBResponse getDomain(SynonymId synonym) const;
+
+private:
+    FieldIndex index;
+    std::unordered_map<SynonymId, Bitset> domains;
+
+    bool contains(const Bitset& domain, const PKBField& field) const;
+};
+}  // namespace qps::evaluator
@@ -0,0 +1,178 @@
+#include <algorithm>
+#include <numeric>
+
+#include "TrieJoin.h"
+
+namespace qps::evaluator {
+    void TrieJoin::addRow(Relation& relation, const std::vector<PKBField>& row) {
+        for (auto& field : row) {
+            relation.rows.push_back(index.intern(field));
+        }
+    }
+
+    void TrieJoin::addRelation(const PKBResponse& response, const std::vector<SynonymId>& synonyms) {
+        Relation relation{synonyms, {}};
+        if (auto *ptr = std::get_if<SingleResponse>(&response.res)) {
+            relation.rows.reserve(ptr->size());
+            for (auto& field : *ptr) {
+                relation.rows.push_back(index.intern(field));
+            }
+        } else if (auto *ptr = std::get_if<VectorResponse>(&response.res)) {
+            relation.rows.reserve(ptr->size() * synonyms.size());
+            for (auto& row : *ptr) {
+                addRow(relation, row);
+            }
+        }
+        relations.push_back(std::move(relation));
+    }
+
+    void TrieJoin::orderSynonyms() {
+        // starts from the synonym in the most relations, then keeps taking the synonym sharing the most relations
+        // with the synonyms taken so far, so that every synonym after the first is constrained as early as possible.
+        std::unordered_map<SynonymId, std::size_t> degree;
+        for (auto& relation : relations) {
+            for (auto s : relation.synonyms) degree[s]++;
+        }
+        std::unordered_map<SynonymId, std::size_t> connections;
+        while (order.size() < degree.size()) {
+            SynonymId next = query::SynonymTable::NO_SYNONYM;
+            for (auto& [s, d] : degree) {
+                if (std::find(order.begin(), order.end(), s) != order.end()) continue;
+                if (next == query::SynonymTable::NO_SYNONYM || connections[s] > connections[next] ||
+                    (connections[s] == connections[next] && (d > degree[next] || (d == degree[next] && s < next)))) {
+                    next = s;
+                }
+            }
+            order.push_back(next);
+            for (auto& relation : relations) {
+                if (std::find(relation.synonyms.begin(), relation.synonyms.end(), next) == relation.synonyms.end())
+                    continue;
+                for (auto s : relation.synonyms) connections[s]++;
+            }
+        }
+    }
+
+    void TrieJoin::sortRelations() {
+        auto position = [this](SynonymId s) { return std::find(order.begin(), order.end(), s) - order.begin(); };
+        relationsOf.assign(order.size(), {});
+        for (std::size_t r = 0; r < relations.size(); r++) {
+            Relation& relation = relations[r];
+            std::size_t arity = relation.arity();
+            std::vector<std::size_t> columns(arity);
+            std::iota(columns.begin(), columns.end(), 0);
+            std::sort(columns.begin(), columns.end(), [&](std::size_t a, std::size_t b) {
+                return position(relation.synonyms[a]) < position(relation.synonyms[b]);
+            });
+
+            std::vector<std::vector<int>> rows(relation.size(), std::vector<int>(arity));
+            for (std::size_t row = 0; row < rows.size(); row++) {
+                for (std::size_t i = 0; i < arity; i++) rows[row][i] = relation.key(row, columns[i]);
+            }
+            std::sort(rows.begin(), rows.end());
+            std::vector<SynonymId> synonyms(arity);
+            for (std::size_t i = 0; i < arity; i++) synonyms[i] = relation.synonyms[columns[i]];
+            relation.synonyms = std::move(synonyms);
+            relation.rows.clear();
+            for (auto& row : rows) relation.rows.insert(relation.rows.end(), row.begin(), row.end());
+
+            for (auto s : relation.synonyms) relationsOf[position(s)].push_back(r);
+        }
+    }
+
+    ResultTable TrieJoin::join() {
+        ResultTable table;
+        orderSynonyms();
+        for (auto s : order) table.insertSynLocationToLast(s);
+        for (auto& relation : relations) {
+            if (relation.size() == 0) return table;
+        }
+
+        sortRelations();
+        ranges.assign(relations.size(), {});
+        for (std::size_t r = 0; r < relations.size(); r++) {
+            ranges[r].push_back(Range{0, relations[r].size()});
+        }
+        binding.assign(order.size(), 0);
+        search(0);
+        table.setTable(std::move(result));
+        return table;
+    }
+
+    void TrieJoin::search(std::size_t depth) {
+        CancellationToken::check(token);
+        if (depth == order.size()) {
+            CancellationToken::checkMemory(token, ResultTable::estimateBytes(result.size() + 1, order.size()));
+            std::vector<PKBField> row;
+            row.reserve(binding.size());
+            for (auto id : binding) row.push_back(index.getField(id));
+            result.insert(std::move(row));
+            return;
+        }
+
+        // the synonyms of a relation are sorted in the global order, so the column of this synonym in each of its
+        // relations is the number of synonyms of that relation already bound.
+        const std::vector<std::size_t>& participants = relationsOf[depth];
+        std::size_t k = participants.size();
+        std::vector<std::size_t> position(k);
+        std::vector<std::size_t> column(k);
+        for (std::size_t i = 0; i < k; i++) {
+            std::size_t r = participants[i];
+            position[i] = ranges[r].back().lo;
+            column[i] = ranges[r].size() - 1;
+        }
+        auto key = [&](std::size_t i) { return relations[participants[i]].key(position[i], column[i]); };
+        auto isAtEnd = [&](std::size_t i) { return position[i] >= ranges[participants[i]].back().hi; };
+        // moves the iterator to the first row of its range whose key is at least value.
+        auto seek = [&](std::size_t i, int value) {
+            const Relation& relation = relations[participants[i]];
+            std::size_t lo = position[i], hi = ranges[participants[i]].back().hi;
+            while (lo < hi) {
+                std::size_t mid = lo + (hi - lo) / 2;
+                if (relation.key(mid, column[i]) < value) lo = mid + 1;
+                else
+                    hi = mid;
+            }
+            position[i] = lo;
+        };
+
+        for (std::size_t i = 0; i < k; i++) {
+            if (isAtEnd(i)) return;
+        }
+        int candidate = key(0);
+        for (std::size_t i = 1; i < k; i++) candidate = std::max(candidate, key(i));
+        std::size_t i = 0;
+        std::size_t agreed = 0;
+        while (true) {
+            seek(i, candidate);
+            if (isAtEnd(i)) return;
+            if (key(i) != candidate) {
+                candidate = key(i);
+                agreed = 1;
+            } else if (++agreed == k) {
+                // every relation agrees on the candidate, so bind it and descend into the matching rows.
+                for (std::size_t j = 0; j < k; j++) {
+                    std::size_t end = position[j];
+                    seek(j, candidate + 1);
+                    std::swap(end, position[j]);
+                    ranges[participants[j]].push_back(Range{position[j], end});
+                }
+                binding[depth] = candidate;
+                search(depth + 1);
+                for (std::size_t j = 0; j < k; j++) {
+                    position[j] = ranges[participants[j]].back().hi;
+                    ranges[participants[j]].pop_back();
+                }
+                if (isAtEnd(0)) return;
+                candidate = key(0);
+                for (std::size_t j = 1; j < k; j++) {
+                    if (isAtEnd(j)) return;
+                    candidate = std::max(candidate, key(j));
+                }
+                agreed = 0;
+                i = 0;
+                continue;
+            }
+            i = (i + 1) % k;
+        }
+    }
+}  // namespace qps::evaluator
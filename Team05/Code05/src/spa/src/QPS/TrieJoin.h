@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Cancellation.h"
+#include "QPS/ResultTable.h"
+#include "QPS/SynonymDomains.h"
+#include "PKB/PKBField.h"
+#include "PKB/PKBResponse.h"
+
+namespace qps::evaluator {
+/**
+ * A worst-case optimal join of the results of a group of clauses, used for groups whose synonyms form a cycle,
+ * e.g. Follows*(a, b) and Parent*(b, c) and Next*(a, c).
+ *
+ * Joining such clauses two at a time can build intermediate tables far larger than the final result, because the
+ * clause closing the cycle only prunes the rows at the very end. Instead, every clause result is stored as a
+ * relation of field ids sorted in a single global synonym order, which can be read as a trie. The synonyms are then
+ * bound one at a time, and the values of each synonym are the leapfrog intersection of the values allowed by every
+ * relation containing it, given the synonyms bound before it (Leapfrog Triejoin, Veldhuizen 2014).
+ */
+class TrieJoin {
+public:
+    /**
+     * @param token if given, checked for every synonym bound and against the size of the joined table
+     */
+    explicit TrieJoin(const CancellationToken* token = nullptr) : token(token) {}
+
+    /**
+     * Adds the result of a clause to the join.
+     *
+     * @param response the result of the clause
+     * @param synonyms the distinct synonyms of the columns of the result
+     */
+    void addRelation(const PKBResponse& response, const std::vector<SynonymId>& synonyms);
+
+    /**
+     * Joins every relation added so far.
+     *
+     * @return a table with a column for every synonym of the relations
+     * @throws exceptions::QueryStoppedException if the query of the token is stopped
+     */
+    ResultTable join();
+
+private:
+    struct Relation {
+        std::vector<SynonymId> synonyms;
+        std::vector<int> rows;  // row-major field ids, sorted once the synonym order is known
+        std::size_t arity() const { return synonyms.size(); }
+        std::size_t size() const { return rows.size() / synonyms.size(); }
+        int key(std::size_t row, std::size_t column) const { return rows[row * arity() + column]; }
+    };
+
+    struct Range {
+        std::size_t lo;
+        std::size_t hi;
+    };
+
+    const CancellationToken* token;
+    FieldIndex index;
+    std::vector<Relation> relations;
+
+    std::vector<SynonymId> order;
+    std::vector<std::vector<std::size_t>> relationsOf;  // the relations containing each synonym of the order
+    std::vector<std::vector<Range>> ranges;  // the range of rows of each relation matching the bound synonyms
+    std::vector<int> binding;
+    Table result;
+
+    void addRow(Relation& relation, const std::vector<PKBField>& row);
+    void orderSynonyms();
+    void sortRelations();
+    void search(std::size_t depth);
+};
+}  // namespace qps::evaluator
@@ -0,0 +1,181 @@
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SNAPSHOT_MMAP 1
+#endif
+
+#include "Snapshot.h"
+
+namespace snapshot {
+namespace {
+constexpr char MAGIC[8] = { 'S', 'P', 'A', 'S', 'N', 'A', 'P', '\n' };
+// written as is, so that a snapshot made on a machine of the other byte order is rejected
+constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+struct Header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byteOrder;
+    std::uint64_t sourceChecksum;
+    std::uint64_t payloadSize;
+    std::uint64_t payloadChecksum;
+};
+
+template <typename T>
+void append(std::string& out, const T& value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+}  // namespace
+
+std::uint64_t checksum(std::string_view data) {
+    // FNV-1a over 8 byte words, with the high bits folded back in so that every bit affects the whole hash
+    constexpr std::uint64_t PRIME = 0x100000001b3ULL;
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+    std::size_t i = 0;
+    for (; i + sizeof(std::uint64_t) <= data.size(); i += sizeof(std::uint64_t)) {
+        std::uint64_t word;
+        std::memcpy(&word, data.data() + i, sizeof(word));
+        hash = (hash ^ word) * PRIME;
+        hash ^= hash >> 32;
+    }
+    for (; i < data.size(); i++) {
+        hash = (hash ^ static_cast<unsigned char>(data[i])) * PRIME;
+    }
+    return hash ^ data.size();
+}
+
+void Writer::writeName(const std::string& name) {
+    auto [it, isNew] = nameIds.try_emplace(name, static_cast<std::uint32_t>(names.size()));
+    if (isNew) {
+        names.push_back(name);
+    }
+    write<std::uint32_t>(it->second);
+}
+
+void Writer::writeBitset(const Bitset& bits) {
+    write<std::uint64_t>(bits.size());
+    writeVector(bits.getWords());
+}
+
+void Writer::save(const std::string& path, std::uint64_t sourceChecksum) const {
+    // the name table goes first, so that the names are known before the body refers to them
+    std::string payload;
+    append<std::uint64_t>(payload, names.size());
+    for (auto& name : names) {
+        append<std::uint32_t>(payload, static_cast<std::uint32_t>(name.size()));
+        payload += name;
+    }
+    payload += body;
+
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = FORMAT_VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.sourceChecksum = sourceChecksum;
+    header.payloadSize = payload.size();
+    header.payloadChecksum = checksum(payload);
+
+    // written next to the target first, so that a reader never sees a partially written snapshot
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+        if (!out) {
+            throw SnapshotError("Cannot write the snapshot " + temporary);
+        }
+    }
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        throw SnapshotError("Cannot replace the snapshot " + path);
+    }
+}
+
+Reader::Reader(const std::string& path) {
+    const char* data = nullptr;
+    std::size_t size = 0;
+#ifdef SNAPSHOT_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw SnapshotError("Cannot open the snapshot " + path);
+    }
+    struct stat info{};
+    if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+        void* mapped = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped != MAP_FAILED) {
+            mapping.address = mapped;
+            mapping.size = static_cast<std::size_t>(info.st_size);
+            data = static_cast<const char*>(mapped);
+            size = mapping.size;
+        }
+    }
+    ::close(fd);
+#endif
+    if (!mapping.address) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            throw SnapshotError("Cannot open the snapshot " + path);
+        }
+        buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        data = buffer.data();
+        size = buffer.size();
+    }
+
+    Header header;
+    if (size < sizeof(header)) {
+        throw SnapshotError("Not a snapshot: " + path);
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.byteOrder != BYTE_ORDER_MARK) {
+        throw SnapshotError("Not a snapshot: " + path);
+    }
+    if (header.version != FORMAT_VERSION) {
+        throw SnapshotError("Snapshot " + path + " is of version " + std::to_string(header.version) +
+                            " instead of " + std::to_string(FORMAT_VERSION));
+    }
+    std::string_view payload(data + sizeof(header), size - sizeof(header));
+    if (header.payloadSize != payload.size() || header.payloadChecksum != checksum(payload)) {
+        throw SnapshotError("Snapshot " + path + " is corrupted");
+    }
+    sourceChecksum = header.sourceChecksum;
+    pos = payload.data();
+    end = payload.data() + payload.size();
+
+    auto count = readCount();
+    for (std::size_t i = 0; i < count; i++) {
+        auto length = read<std::uint32_t>();
+        names.emplace_back(take(length), length);
+    }
+}
+
+Reader::Mapping::~Mapping() {
+#ifdef SNAPSHOT_MMAP
+    if (address) {
+        ::munmap(address, size);
+    }
+#endif
+}
+
+const std::string& Reader::readName() {
+    auto id = read<std::uint32_t>();
+    if (id >= names.size()) {
+        throw SnapshotError("Unknown name in snapshot");
+    }
+    return names[id];
+}
+
+Bitset Reader::readBitset() {
+    auto size = read<std::uint64_t>();
+    auto words = readVector<std::uint64_t>();
+    if (size > words.size() * 64) {
+        throw SnapshotError("Invalid bitset in snapshot");
+    }
+    return Bitset(size, std::move(words));
+}
+}  // namespace snapshot
@@ -0,0 +1,173 @@
+/*
+ * Versioned binary snapshot files, e.g. of a processed PKB, so that a program does not have to be processed
+ * again while its source has not changed.
+ *
+ * A snapshot is a fixed size header, a table of the names it refers to and a body. The header holds the format
+ * version, a checksum of the source the snapshot was made from and a checksum of the rest of the file. Numbers and
+ * flat arrays are stored as they are laid out in memory, so reading the body of the mapped file is only copying.
+ *
+ * Example Usage:
+ * snapshot::Writer out;
+ * out.write<int>(42);
+ * out.writeName("x");
+ * out.save(path, snapshot::checksum(source));
+ *
+ * snapshot::Reader in(path);
+ * if (in.getSourceChecksum() == snapshot::checksum(source)) { int answer = in.read<int>(); ... }
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "Bitset.h"
+
+namespace snapshot {
+/**
+ * The version of the layout of snapshots. Snapshots of any other version are rejected, so it has to be bumped
+ * whenever anything written to a snapshot changes.
+ */
+constexpr std::uint32_t FORMAT_VERSION = 2;
+
+/**
+ * Thrown when a snapshot cannot be written or read, or is not a valid snapshot of this version.
+ */
+class SnapshotError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+/**
+ * @return a 64 bit checksum of the data, to tell whether a snapshot was made from a source or was corrupted.
+ */
+std::uint64_t checksum(std::string_view data);
+
+class Writer {
+public:
+    template <typename T>
+    void write(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        body.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    void writeVector(const std::vector<T>& values) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        write<std::uint64_t>(values.size());
+        body.append(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+    }
+
+    /**
+     * Writes a name as its index in the name table of the snapshot, so that every name is only stored once.
+     */
+    void writeName(const std::string& name);
+
+    void writeBitset(const Bitset& bits);
+
+    /**
+     * Writes the snapshot to a file, replacing it atomically if it exists.
+     *
+     * @param path the file to write to
+     * @param sourceChecksum the checksum of the source the snapshot was made from
+     * @throws SnapshotError if the file cannot be written
+     */
+    void save(const std::string& path, std::uint64_t sourceChecksum) const;
+
+private:
+    std::string body;
+    std::vector<std::string> names;
+    std::unordered_map<std::string, std::uint32_t> nameIds;
+};
+
+class Reader {
+public:
+    /**
+     * Maps the snapshot file into memory and checks its header and checksum.
+     *
+     * @throws SnapshotError if the file cannot be read, is not a snapshot of this version or is corrupted
+     */
+    explicit Reader(const std::string& path);
+    Reader(const Reader&) = delete;
+    Reader& operator=(const Reader&) = delete;
+
+    std::uint64_t getSourceChecksum() const { return sourceChecksum; }
+
+    template <typename T>
+    T read() {
+        static_assert(std::is_trivially_copyable_v<T>);
+        T value;
+        std::memcpy(&value, take(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    template <typename T>
+    std::vector<T> readVector() {
+        static_assert(std::is_trivially_copyable_v<T>);
+        auto count = read<std::uint64_t>();
+        if (count > static_cast<std::size_t>(end - pos) / sizeof(T)) {
+            throw SnapshotError("Truncated snapshot");
+        }
+        std::vector<T> values(count);
+        if (count > 0) {
+            std::memcpy(values.data(), take(count * sizeof(T)), count * sizeof(T));
+        }
+        return values;
+    }
+
+    /**
+     * Reads the number of elements that follow, each of which takes at least a byte.
+     *
+     * @throws SnapshotError if there are fewer bytes left than elements, so that no bogus count is allocated
+     */
+    std::size_t readCount() {
+        auto count = read<std::uint64_t>();
+        if (count > static_cast<std::size_t>(end - pos)) {
+            throw SnapshotError("Truncated snapshot");
+        }
+        return static_cast<std::size_t>(count);
+    }
+
+    const std::string& readName();
+
+    Bitset readBitset();
+
+    /**
+     * @return whether the whole body has been read.
+     */
+    bool isAtEnd() const { return pos == end; }
+
+private:
+    /**
+     * A read-only mapping of a whole file, unmapped when it goes away.
+     */
+    struct Mapping {
+        void* address = nullptr;
+        std::size_t size = 0;
+        ~Mapping();
+    };
+
+    Mapping mapping;
+    std::string buffer;  // the contents of the file where it cannot be mapped
+    const char* pos = nullptr;
+    const char* end = nullptr;
+    std::uint64_t sourceChecksum = 0;
+    std::vector<std::string> names;
+
+    const char* take(std::size_t bytes) {
+        if (bytes > static_cast<std::size_t>(end - pos)) {
+            throw SnapshotError("Truncated snapshot");
+        }
+        const char* taken = pos;
+        pos += bytes;
+        return taken;
+    }
+};
+}  // namespace snapshot
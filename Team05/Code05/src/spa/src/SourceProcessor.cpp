@@ -2,38 +2,69 @@
 
 #include "SourceProcessor.h"
 #include "PKB.h"
-#include "DesignExtractor/CFG/CFG.h"
 #include "Parser/Parser.h"
 #include "DesignExtractor/DesignExtractor.h"
 
-bool SourceProcessor::processSimple(const std::string& sourceCode, PKB *pkb) {
+bool SourceProcessor::processSimple(const std::string& sourceCode, PKB *pkb, sp::PhaseProfile* profile) {
     using sp::design_extractor::DesignExtractor;
 
     // parsing source code and extracting AST
-    auto ast = sp::parser::parse(sourceCode);
+    auto ast = sp::parser::parse(sourceCode, profile);
     // parsing failed
     if (!ast) {
         return false;
     }
 
-    // extracting CFG
-    sp::cfg::CFGExtractor cfgExtractor;
-    sp::cfg::CFG cfgContainer = cfgExtractor.extract(ast.get());
-
     // setting up Design Extractor
     auto de = DesignExtractor(pkb);
-    de.insert(cfgContainer.cfgs);  // insert CFG to Design Extractor for Next Extractor
-    
-    // running extractors and inserting into PKB
-    de.extract(ast.get());
 
-    // inserting CFG and AST into PKB
-    pkb->insertCFG(cfgContainer);
-    pkb->insertAST(std::move(ast));
+    // running extractors and inserting into PKB, the CFG is built from the extracted Modifies and Uses
+    de.extract(ast.get(), profile);
+
+    // inserting AST into PKB
+    sp::PhaseProfile::time(profile, "pkb load", [&]() {
+        pkb->insertAST(std::move(ast));
+        pkb->freeze();
+    });
     
     return true;
 }
 
+bool SourceProcessor::processIncremental(const std::string& sourceCode, PKB* pkb, sp::PhaseProfile* profile) {
+    // the whole source is parsed again, as the program level checks span all of its procedures
+    auto ast = sp::parser::parse(sourceCode, profile);
+    if (!ast) {
+        return false;
+    }
+
+    incrementalExtractor.extract(ast.get(), pkb, profile);
+
+    sp::PhaseProfile::time(profile, "pkb load", [&]() {
+        pkb->insertAST(std::move(ast));
+        pkb->freeze();
+    });
+    return true;
+}
+
+bool SourceProcessor::processCached(const std::string& sourceCode, PKB* pkb, const std::string& snapshotPath,
+                                    sp::PhaseProfile* profile) {
+    bool isLoaded = sp::PhaseProfile::time(profile, "snapshot load", [&]() {
+        return pkb->loadSnapshot(snapshotPath, sourceCode);
+    });
+    if (isLoaded) {
+        return true;
+    }
+
+    if (!processSimple(sourceCode, pkb, profile)) {
+        return false;
+    }
+    // a snapshot that cannot be written only costs the next run the processing time
+    sp::PhaseProfile::time(profile, "snapshot save", [&]() {
+        pkb->saveSnapshot(snapshotPath, sourceCode);
+    });
+    return true;
+}
+
 std::unique_ptr<sp::ast::Program> SourceProcessor::parse(const std::string& sourceCode) {
     return sp::parser::parse(sourceCode);
 }
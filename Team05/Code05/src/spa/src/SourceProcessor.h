@@ -2,13 +2,59 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
+#include "DesignExtractor/IncrementalExtractor.h"
 #include "Parser/AST.h"
+#include "PhaseProfile.h"
 #include "PKB.h"
 
 class SourceProcessor {
 public:
     SourceProcessor() {}
-    bool processSimple(const std::string&, PKB*);
+    /**
+     * Parses the SIMPLE source and loads all of its design abstractions into the PKB.
+     *
+     * @param profile if given, records the time taken by lexing, parsing, every design extractor module,
+     * building the CFG and loading the PKB, in the order they ran.
+     * @return false if the source is not a valid SIMPLE program.
+     */
+    bool processSimple(const std::string&, PKB*, sp::PhaseProfile* profile = nullptr);
+
+    /**
+     * Loads the PKB from a snapshot of the same source if there is one, and otherwise processes the source and
+     * writes a snapshot of the result for the next time.
+     *
+     * @param snapshotPath the snapshot file to load from or write to
+     * @param profile if given, records "snapshot load" and, when the source has to be processed, every phase of
+     * processSimple and "snapshot save".
+     * @return false if the source is not a valid SIMPLE program.
+     */
+    bool processCached(const std::string&, PKB*, const std::string& snapshotPath,
+                       sp::PhaseProfile* profile = nullptr);
+
+    /**
+     * Processes the source like processSimple, as the next version of the source given to the previous call.
+     * The whole source is parsed, but only the procedures that changed since the previous call, and the ones
+     * calling them whose Modifies or Uses change with them, are extracted again. Only the versions processed by
+     * this method are kept, so the first call after processSimple or processCached extracts every procedure.
+     *
+     * @param profile if given, records the phases of processSimple and the time taken to compare the procedures
+     * against the previous version, as "diff".
+     * @return false if the source is not a valid SIMPLE program, in which case the next call is still compared
+     * against the last valid source.
+     */
+    bool processIncremental(const std::string&, PKB*, sp::PhaseProfile* profile = nullptr);
+
+    /**
+     * @return the procedures extracted again by the last call to processIncremental.
+     */
+    const std::vector<std::string>& getExtractedProcedures() const {
+        return incrementalExtractor.getExtractedProcedures();
+    }
+
     std::unique_ptr<sp::ast::Program> parse(const std::string&);
+
+private:
+    sp::design_extractor::IncrementalExtractor incrementalExtractor;
 };
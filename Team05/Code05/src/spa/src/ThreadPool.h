@@ -0,0 +1,171 @@
+/*
+ * Small fixed size thread pool shared by the parts of the SPA that can split their work into
+ * independent tasks, e.g. per procedure design extraction.
+ *
+ * Example Usage:
+ * ThreadPool::shared().parallelFor(procedures.size(), [&](std::size_t i) { process(procedures[i]); });
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * A fixed number of worker threads consuming a FIFO queue of tasks.
+ */
+class ThreadPool {
+public:
+    explicit ThreadPool(std::size_t threadCount = defaultThreadCount()) {
+        threadCount = std::max<std::size_t>(threadCount, 1);
+        for (std::size_t i = 0; i < threadCount; i++) {
+            workers.emplace_back([this] { work(); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        available.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief The process wide pool, sized to the number of hardware threads.
+     */
+    static ThreadPool& shared() {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    static std::size_t defaultThreadCount() {
+        return std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    std::size_t size() const { return workers.size(); }
+
+    /**
+     * @brief Queues a task to be run by one of the workers.
+     *
+     * @return a future holding the result of the task, or the exception it threw.
+     */
+    template <typename F>
+    std::future<std::invoke_result_t<F>> submit(F&& task) {
+        using Result = std::invoke_result_t<F>;
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+        auto future = packaged->get_future();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.emplace([packaged] { (*packaged)(); });
+        }
+        available.notify_one();
+        return future;
+    }
+
+    /**
+     * @brief Runs body(0) ... body(count - 1) on the pool and blocks until all of them are done.
+     *
+     * The calling thread takes indices as well, so a parallelFor issued from inside a pool task completes
+     * even if every worker is busy. If any body throws, the first exception is rethrown to the caller after
+     * all the indices have been processed.
+     */
+    template <typename F>
+    void parallelFor(std::size_t count, F&& body) {
+        if (count == 0) {
+            return;
+        }
+        if (count == 1) {
+            body(0);
+            return;
+        }
+
+        struct State {
+            std::atomic<std::size_t> next {0};
+            std::size_t remaining;
+            std::exception_ptr error;
+            std::mutex mutex;
+            std::condition_variable done;
+            std::function<void(std::size_t)> body;
+        };
+        auto state = std::make_shared<State>();
+        state->remaining = count;
+        state->body = std::forward<F>(body);
+
+        // helpers that start after all the indices are taken find no work and return immediately.
+        auto drain = [state, count] {
+            std::size_t i;
+            while ((i = state->next.fetch_add(1)) < count) {
+                std::exception_ptr error;
+                try {
+                    state->body(i);
+                } catch (...) {
+                    error = std::current_exception();
+                }
+                std::lock_guard<std::mutex> lock(state->mutex);
+                if (error && !state->error) {
+                    state->error = error;
+                }
+                if (--state->remaining == 0) {
+                    state->done.notify_all();
+                }
+            }
+        };
+        std::size_t helpers = std::min(size(), count - 1);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (std::size_t i = 0; i < helpers; i++) {
+                tasks.emplace(drain);
+            }
+        }
+        available.notify_all();
+        drain();
+
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->done.wait(lock, [&state] { return state->remaining == 0; });
+        if (state->error) {
+            std::rethrow_exception(state->error);
+        }
+    }
+
+private:
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable available;
+    bool stopping = false;
+
+    void work() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                available.wait(lock, [this] { return stopping || !tasks.empty(); });
+                if (stopping && tasks.empty()) {
+                    return;
+                }
+                task = std::move(tasks.front());
+                tasks.pop();
+            }
+            task();
+        }
+    }
+};
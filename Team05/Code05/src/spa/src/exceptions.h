@@ -31,5 +31,23 @@ struct PqlSemanticException : PqlException  {
     explicit PqlSemanticException(const char* message) : PqlException(message) {}
 };
 
+/**
+ * Thrown out of the evaluation of a query that was stopped before it completed, so it has no result at all.
+ */
+struct QueryStoppedException : Exception {
+    enum class Reason { CANCELLED, DEADLINE, MEMORY };
+    Reason reason;
+
+    explicit QueryStoppedException(Reason reason) : Exception(getMessage(reason)), reason(reason) {}
+
+    static const char* getMessage(Reason reason) {
+        switch (reason) {
+            case Reason::DEADLINE: return messages::qps::evaluator::deadlineExceededMessage;
+            case Reason::MEMORY: return messages::qps::evaluator::memoryBudgetExceededMessage;
+            default: return messages::qps::evaluator::queryCancelledMessage;
+        }
+    }
+};
+
 }  // namespace exceptions
 
@@ -1,17 +1,32 @@
 /*
  * Small Header only logging utility written for CS3203 T05
  * Example Usage:
- * Logger(Level::INFO) << "Testing INFO Logger\n" << "It works similar to std::cout";
- * 
+ * LOG(Level::INFO) << "Testing INFO Logger\n" << "It works similar to std::cout";
+ * LOG(Level::DEBUG) << "Lexed the source" << logging::field("tokens", tokens.size());
+ *
+ * Levels below SPA_LOG_COMPILED_SEVERITY are compiled out of LOG statements entirely, and levels below the
+ * runtime threshold (logging::setLevel, or the SPA_LOG_LEVEL environment variable) skip the statement without
+ * evaluating anything streamed into it. Logger(level) can still be used directly, but its arguments are then
+ * always evaluated, so LOG should be preferred on hot paths.
  */
 
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <ctime>
+#include <deque>
+#include <iomanip>
 #include <iostream>
-#include <string>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <sstream>
-#include <iomanip>
-#include <ctime>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
 
 enum class Level {
     INFO,
@@ -21,39 +36,224 @@ enum class Level {
     OK,
 };
 
+// the lowest severity whose LOG statements are compiled at all: 0 debug, 1 info and ok, 2 warn, 3 error.
+#ifndef SPA_LOG_COMPILED_SEVERITY
+#ifdef _DEBUG
+#define SPA_LOG_COMPILED_SEVERITY 0
+#else
+#define SPA_LOG_COMPILED_SEVERITY 2
+#endif  // _DEBUG
+#endif  // SPA_LOG_COMPILED_SEVERITY
+
+namespace logging {
+constexpr int OFF = 4;
+
+constexpr int severity(Level level) {
+    switch (level) {
+    case Level::DEBUG: return 0;
+    case Level::INFO: return 1;
+    case Level::OK: return 1;
+    case Level::WARN: return 2;
+    case Level::ERROR: return 3;
+    }
+    return OFF;
+}
+
+constexpr bool isCompiled(Level level) {
+    return severity(level) >= SPA_LOG_COMPILED_SEVERITY;
+}
+
+/**
+ * The runtime threshold, which defaults to SPA_LOG_LEVEL (debug, info, warn, error or off) if it is set, and
+ * otherwise prints everything in debug builds and nothing in release builds.
+ */
+inline std::atomic<int>& threshold() {
+    static std::atomic<int> value = [] {
+        if (const char* env = std::getenv("SPA_LOG_LEVEL")) {
+            std::string_view name(env);
+            if (name == "debug") return 0;
+            if (name == "info") return 1;
+            if (name == "warn") return 2;
+            if (name == "error") return 3;
+            return OFF;
+        }
+#ifdef _DEBUG
+        return 0;
+#else
+        return OFF;
+#endif  // _DEBUG
+    }();
+    return value;
+}
+
+inline void setLevel(Level level) {
+    threshold().store(severity(level), std::memory_order_relaxed);
+}
+
+inline void disable() {
+    threshold().store(OFF, std::memory_order_relaxed);
+}
+
+inline bool isEnabled(Level level) {
+    return isCompiled(level) && severity(level) >= threshold().load(std::memory_order_relaxed);
+}
+
+/**
+ * The destination of the formatted log lines.
+ */
+class Sink {
+public:
+    virtual ~Sink() = default;
+    virtual void write(Level level, std::string line) = 0;
+    virtual void flush() {}
+};
+
+/**
+ * Writes errors to stderr and everything else to stdout, one whole line at a time.
+ */
+class ConsoleSink : public Sink {
+public:
+    void write(Level level, std::string line) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        (level == Level::ERROR ? std::cerr : std::cout) << line << std::endl;
+    }
+
+private:
+    std::mutex mutex;
+};
+
+/**
+ * Hands the lines to a background thread that writes them to another sink, so that logging threads never wait on
+ * the output. The remaining lines are written when the sink is flushed or destroyed.
+ */
+class AsyncSink : public Sink {
+public:
+    explicit AsyncSink(std::shared_ptr<Sink> target) : target(std::move(target)), worker([this] { work(); }) {}
+
+    ~AsyncSink() override {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        available.notify_one();
+        worker.join();
+    }
+
+    void write(Level level, std::string line) override {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            lines.emplace_back(level, std::move(line));
+        }
+        available.notify_one();
+    }
+
+    void flush() override {
+        std::unique_lock<std::mutex> lock(mutex);
+        drained.wait(lock, [this] { return lines.empty() && !isWriting; });
+        target->flush();
+    }
+
+private:
+    std::shared_ptr<Sink> target;
+    std::deque<std::pair<Level, std::string>> lines;
+    std::mutex mutex;
+    std::condition_variable available;
+    std::condition_variable drained;
+    bool stopping = false;
+    bool isWriting = false;
+    std::thread worker;
+
+    void work() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            available.wait(lock, [this] { return stopping || !lines.empty(); });
+            if (lines.empty()) {
+                return;
+            }
+            std::deque<std::pair<Level, std::string>> batch;
+            batch.swap(lines);
+            isWriting = true;
+            lock.unlock();
+            for (auto& [level, line] : batch) {
+                target->write(level, std::move(line));
+            }
+            lock.lock();
+            isWriting = false;
+            drained.notify_all();
+        }
+    }
+};
+
+inline std::mutex& sinkMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+inline std::shared_ptr<Sink>& currentSink() {
+    static std::shared_ptr<Sink> sink = std::make_shared<ConsoleSink>();
+    return sink;
+}
+
+inline std::shared_ptr<Sink> getSink() {
+    std::lock_guard<std::mutex> lock(sinkMutex());
+    return currentSink();
+}
+
+/**
+ * Replaces the sink of every Logger, e.g. with an AsyncSink wrapping the console or a file.
+ */
+inline void setSink(std::shared_ptr<Sink> sink) {
+    std::lock_guard<std::mutex> lock(sinkMutex());
+    currentSink() = std::move(sink);
+}
+
+/**
+ * A structured key=value field of a log line.
+ */
+template <typename T>
+struct Field {
+    std::string_view key;
+    const T& value;
+};
+
+template <typename T>
+Field<T> field(std::string_view key, const T& value) {
+    return Field<T>{key, value};
+}
+}  // namespace logging
+
 /**
  * The short-lived Logger object. Usage: Logger(Level::INFO) << "msg.
- * 
+ *
  * Logging level supported: INFO, WARN, DEBUG, ERROR, OK
  */
 class Logger {
 public:
     template<typename T>
     Logger& operator<< (const T& msg) {
-        this->oss << msg;
+        if (this->oss) *this->oss << msg;
+        return *this;
+    }
+
+    template<typename T>
+    Logger& operator<< (const logging::Field<T>& field) {
+        if (this->oss) *this->oss << " " << field.key << "=" << field.value;
         return *this;
     }
 
     explicit Logger(Level level = Level::INFO) : level(level) {
-        this->oss << this->getHeader();
+        if (logging::isEnabled(level)) {
+            this->oss.emplace();
+            *this->oss << this->getHeader();
+        }
     }
 
     ~Logger() {
-        #ifdef _DEBUG
-        // Using stdout for now. May consider log file later.
-        switch (this->level) {
-        case Level::ERROR:
-            std::cerr << this->oss.str() << std::endl;
-            break;
-        default:
-            std::cout << this->oss.str() << std::endl;
-            break;
-        }        
-        #endif
+        if (this->oss) logging::getSink()->write(this->level, this->oss->str());
     }
 
 private:
-    std::stringstream oss;
+    std::optional<std::ostringstream> oss;
     Level level;
 
     std::string getLabel() {
@@ -71,7 +271,13 @@ private:
     // Referenced from https://stackoverflow.com/questions/16357999/current-date-and-time-as-string/16358264
     std::string getTime() {
         auto t = std::time(nullptr);
-        auto tm = *std::localtime(&t);
+        // lines are logged from the workers of the thread pool, so the shared buffer of std::localtime is avoided.
+        std::tm tm{};
+#ifdef _MSC_VER
+        localtime_s(&tm, &t);
+#else
+        localtime_r(&t, &tm);
+#endif
         std::stringstream oss;
         oss << std::put_time(&tm, "%d-%m-%Y %H:%M:%S");
         return oss.str();
@@ -83,3 +289,10 @@ private:
         return oss.str();
     }
 };
+
+/**
+ * Logs a line at the given level. The statement is removed at compile time if the level is compiled out, and
+ * nothing streamed into it is evaluated if the level is disabled at runtime.
+ */
+#define LOG(level) \
+    if (!(::logging::isCompiled(level) && ::logging::isEnabled(level))) {} else Logger(level)  // NOLINT
@@ -50,8 +50,19 @@ namespace parser {
     inline constexpr char notValidPatternType[] = "Not an valid pattern type";
     inline constexpr char unableToParsePatternMessage[] = "Unable to parse pattern";
 
+    // Prepared query error messages
+    inline constexpr char wrongParameterCountMessage[] = "Number of values does not match the number of placeholders";
+    inline constexpr char invalidParameterValueMessage[] = "Value cannot be bound to this placeholder";
+
 }  //  namespace parser
 
+namespace evaluator {
+    // Stopped query messages
+    inline constexpr char queryCancelledMessage[] = "Query was cancelled";
+    inline constexpr char deadlineExceededMessage[] = "Query exceeded its deadline";
+    inline constexpr char memoryBudgetExceededMessage[] = "Query exceeded its memory budget";
+}  //  namespace evaluator
+
 }  //  namespace qps
 
 }  // namespace messages
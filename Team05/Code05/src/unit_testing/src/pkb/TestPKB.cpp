@@ -719,6 +719,36 @@ TEST_CASE("PKB Affects Testing - Single Proc") {
     PKBRelationship aff = PKBRelationship::AFFECTS;
     PKBRelationship affT = PKBRelationship::AFFECTST;
 
+    SECTION("Next* is evaluated over the CFG") {
+        PKBRelationship nextT = PKBRelationship::NEXTT;
+        PKBField conc3 = PKBField::createConcrete(STMT_LO(3, IF));
+        PKBField conc4 = PKBField::createConcrete(STMT_LO(4, WHILE));
+        PKBField conc5 = PKBField::createConcrete(STMT_LO(5, ASSIGN));
+        PKBField conc6 = PKBField::createConcrete(STMT_LO(6, ASSIGN));
+        PKBField conc8 = PKBField::createConcrete(STMT_LO(8, ASSIGN));
+        PKBField conc9 = PKBField::createConcrete(STMT_LO(9, ASSIGN));
+
+        REQUIRE(pkb->isRelationshipPresent(conc4, conc4, nextT));
+        REQUIRE(pkb->isRelationshipPresent(conc5, conc4, nextT));
+        REQUIRE(pkb->isRelationshipPresent(conc6, conc9, nextT));
+        REQUIRE_FALSE(pkb->isRelationshipPresent(conc6, conc5, nextT));
+        REQUIRE_FALSE(pkb->isRelationshipPresent(conc9, conc3, nextT));
+
+        FieldRowResponse expected1{ {conc4, conc5}, {conc4, conc8}, {conc4, conc9} };
+        REQUIRE(*(pkb->getRelationship(conc4, PKBField::createDeclaration(ASSIGN), nextT)
+            .getResponse<FieldRowResponse>()) == expected1);
+
+        FieldRowResponse expected2{ {conc4, conc5} };
+        REQUIRE(*(pkb->getRelationship(PKBField::createDeclaration(WHILE), conc5, nextT)
+            .getResponse<FieldRowResponse>()) == expected2);
+
+        FieldRowResponse expected3{ {conc3, conc4} };
+        REQUIRE(*(pkb->getRelationship(PKBField::createDeclaration(IF), PKBField::createDeclaration(WHILE), nextT)
+            .getResponse<FieldRowResponse>()) == expected3);
+        REQUIRE_FALSE(pkb->getRelationship(conc9, PKBField::createWildcard(PKBEntityType::STATEMENT), nextT)
+            .hasResult);
+    }
+
     SECTION("AffectsEvaluator::contains (transitive and non-transitive)") {
         PKBField conc1 = PKBField::createConcrete(STMT_LO(1, ASSIGN));
         PKBField conc2 = PKBField::createConcrete(STMT_LO(8, ASSIGN));
@@ -1055,3 +1085,92 @@ TEST_CASE("PKB regression test") {
         REQUIRE_FALSE(pkb->isRelationshipPresent(field4, field3, PKBRelationship::MODIFIES));
     }
 }
+
+TEST_CASE("PKB bulk load test") {
+    PKB pkb;
+    pkb.insertEntity(STMT_LO{ 1, StatementType::Read, "x" });
+    pkb.insertEntity(STMT_LO{ 2, StatementType::Call, "foo" });
+    pkb.insertEntity(STMT_LO{ 3, StatementType::Assignment });
+    pkb.insertEntity(VAR_NAME{ "x" });
+    pkb.insertEntity(PROC_NAME{ "main" });
+    pkb.insertEntity(PROC_NAME{ "foo" });
+
+    // statements are given by number only and completed from the statement table
+    pkb.bulkInsertRelationships(PKBRelationship::FOLLOWS, {
+        { STMT_LO{ 1 }, STMT_LO{ 2 } },
+        { STMT_LO{ 2 }, STMT_LO{ 3 } }
+    });
+    pkb.bulkInsertRelationships(PKBRelationship::MODIFIES, {
+        { STMT_LO{ 1 }, VAR_NAME{ "x" } },
+        { PROC_NAME{ "main" }, VAR_NAME{ "x" } }
+    });
+    pkb.bulkInsertRelationships(PKBRelationship::CALLS, { { PROC_NAME{ "main" }, PROC_NAME{ "foo" } } });
+
+    PKBField stmt1 = PKBField::createConcrete(STMT_LO{ 1, StatementType::Read, "x" });
+    PKBField stmt2 = PKBField::createConcrete(STMT_LO{ 2, StatementType::Call, "foo" });
+    PKBField stmt3 = PKBField::createConcrete(STMT_LO{ 3, StatementType::Assignment });
+    PKBField x = PKBField::createConcrete(VAR_NAME{ "x" });
+    REQUIRE(pkb.isRelationshipPresent(stmt1, stmt2, PKBRelationship::FOLLOWS));
+    REQUIRE(pkb.isRelationshipPresent(stmt1, stmt3, PKBRelationship::FOLLOWST));
+    REQUIRE(pkb.isRelationshipPresent(stmt1, x, PKBRelationship::MODIFIES));
+    REQUIRE(pkb.isRelationshipPresent(PKBField::createConcrete(PROC_NAME{ "main" }), x, PKBRelationship::MODIFIES));
+    REQUIRE(pkb.isRelationshipPresent(PKBField::createConcrete(PROC_NAME{ "main" }),
+        PKBField::createConcrete(PROC_NAME{ "foo" }), PKBRelationship::CALLS));
+
+    auto followers = pkb.getRelationship(stmt1, PKBField::createDeclaration(StatementType::All), PKBRelationship::FOLLOWS);
+    REQUIRE(followers.hasResult);
+    REQUIRE(std::get<FieldRowResponse>(followers.res) == FieldRowResponse{ { stmt1, stmt2 } });
+
+    // once frozen, no more inserts are accepted
+    REQUIRE_FALSE(pkb.isFrozen());
+    pkb.freeze();
+    REQUIRE(pkb.isFrozen());
+    pkb.insertEntity(VAR_NAME{ "y" });
+    pkb.insertRelationship(PKBRelationship::FOLLOWS, stmt1, stmt3);
+    REQUIRE_FALSE(pkb.isRelationshipPresent(stmt1, stmt3, PKBRelationship::FOLLOWS));
+    pkb.bulkInsertRelationships(PKBRelationship::MODIFIES, { { STMT_LO{ 3 }, VAR_NAME{ "x" } } });
+    REQUIRE_FALSE(pkb.isRelationshipPresent(stmt3, x, PKBRelationship::MODIFIES));
+    REQUIRE(std::get<std::unordered_set<PKBField, PKBFieldHash>>(pkb.getVariables().res).size() == 1);
+}
+
+TEST_CASE("PKB memory report test") {
+    PKB pkb;
+    auto empty = pkb.getMemoryReport();
+    std::vector<std::string> components;
+    for (auto& [name, bytes] : empty.getComponents()) {
+        components.push_back(name);
+    }
+    REQUIRE(components == std::vector<std::string>{ "statements", "variables", "procedures", "constants",
+        "Modifies", "Uses", "Follows", "Parent", "Calls", "Next", "Affects", "Affects*", "AST", "CFG" });
+    REQUIRE(empty.getBytes("AST") == 0);
+    REQUIRE(empty.getBytes("CFG") == 0);
+    REQUIRE(empty.getBytes("unknown") == 0);
+
+    pkb.insertEntity(STMT_LO{ 1, StatementType::Read, "a variable name too long to be kept inside the string" });
+    pkb.insertEntity(STMT_LO{ 2, StatementType::Assignment });
+    pkb.insertEntity(VAR_NAME{ "a variable name too long to be kept inside the string" });
+    pkb.insertEntity(PROC_NAME{ "main" });
+    pkb.bulkInsertRelationships(PKBRelationship::FOLLOWS, { { STMT_LO{ 1 }, STMT_LO{ 2 } } });
+    pkb.bulkInsertRelationships(PKBRelationship::MODIFIES, {
+        { STMT_LO{ 1 }, VAR_NAME{ "a variable name too long to be kept inside the string" } }
+    });
+
+    auto report = pkb.getMemoryReport();
+    REQUIRE(report.getComponents().size() == components.size());
+    REQUIRE(report.getBytes("statements") > empty.getBytes("statements"));
+    REQUIRE(report.getBytes("variables") > empty.getBytes("variables"));
+    REQUIRE(report.getBytes("procedures") > empty.getBytes("procedures"));
+    REQUIRE(report.getBytes("Follows") > empty.getBytes("Follows"));
+    REQUIRE(report.getBytes("Modifies") > empty.getBytes("Modifies"));
+    REQUIRE(report.getBytes("Uses") == empty.getBytes("Uses"));
+    // the long name is held by the statement, the variable and both ends of the Modifies row.
+    REQUIRE(report.getBytes("Modifies") - empty.getBytes("Modifies") >
+        memory::heapBytes(std::string("a variable name too long to be kept inside the string")));
+
+    std::size_t total = 0;
+    for (auto& [name, bytes] : report.getComponents()) {
+        total += bytes;
+    }
+    REQUIRE(report.getTotal() == total);
+    REQUIRE(report.getTotal() > empty.getTotal());
+}
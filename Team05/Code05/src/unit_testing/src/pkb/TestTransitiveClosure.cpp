@@ -0,0 +1,70 @@
+#include <set>
+#include <utility>
+
+#include "PKB/TransitiveClosure.h"
+#include "catch.hpp"
+
+namespace {
+STMT_LO assign(int statementNum) {
+    return STMT_LO(statementNum, StatementType::Assignment);
+}
+
+std::set<int> reachable(const TransitiveClosure& closure, int from) {
+    std::set<int> result;
+    closure.forEachReachable(from, [&](const STMT_LO& stmt) { result.insert(stmt.statementNum); });
+    return result;
+}
+
+std::set<int> reaching(const TransitiveClosure& closure, int to) {
+    std::set<int> result;
+    closure.forEachReaching(to, [&](const STMT_LO& stmt) { result.insert(stmt.statementNum); });
+    return result;
+}
+}  // namespace
+
+TEST_CASE("TransitiveClosure") {
+    // 1 -> 2 -> 3 -> 2 is a cycle, 3 -> 4, 5 -> 5 is a self loop, 6 -> 7 is disjoint.
+    std::set<std::pair<STMT_LO, STMT_LO>> pairs {
+        { assign(1), assign(2) }, { assign(2), assign(3) }, { assign(3), assign(2) }, { assign(3), assign(4) },
+        { assign(5), assign(5) }, { assign(6), assign(7) }
+    };
+    TransitiveClosure closure(pairs);
+    REQUIRE(closure.size() == 7);
+
+    SECTION("contains") {
+        REQUIRE(closure.contains(1, 4));
+        REQUIRE(closure.contains(2, 2));
+        REQUIRE(closure.contains(3, 3));
+        REQUIRE(closure.contains(5, 5));
+        REQUIRE(closure.contains(6, 7));
+        REQUIRE_FALSE(closure.contains(1, 1));
+        REQUIRE_FALSE(closure.contains(4, 4));
+        REQUIRE_FALSE(closure.contains(4, 2));
+        REQUIRE_FALSE(closure.contains(7, 6));
+        REQUIRE_FALSE(closure.contains(1, 8));
+    }
+
+    SECTION("forEachReachable and forEachReaching") {
+        REQUIRE(reachable(closure, 1) == std::set<int>{2, 3, 4});
+        REQUIRE(reachable(closure, 2) == std::set<int>{2, 3, 4});
+        REQUIRE(reachable(closure, 4).empty());
+        REQUIRE(reachable(closure, 5) == std::set<int>{5});
+        REQUIRE(reaching(closure, 4) == std::set<int>{1, 2, 3});
+        REQUIRE(reaching(closure, 2) == std::set<int>{1, 2, 3});
+        REQUIRE(reaching(closure, 1).empty());
+        REQUIRE(reaching(closure, 9).empty());
+    }
+
+    SECTION("forEachSource") {
+        std::set<int> sources;
+        closure.forEachSource([&](const STMT_LO& stmt) { sources.insert(stmt.statementNum); });
+        REQUIRE(sources == std::set<int>{1, 2, 3, 5, 6});
+    }
+
+    SECTION("Empty closure") {
+        TransitiveClosure empty;
+        REQUIRE(empty.size() == 0);
+        REQUIRE_FALSE(empty.contains(1, 2));
+        REQUIRE(reachable(empty, 1).empty());
+    }
+}
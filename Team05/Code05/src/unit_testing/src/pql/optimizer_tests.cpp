@@ -7,12 +7,18 @@
 #define TEST_LOG Logger() << "optimizer_tests.cpp"
 
 using qps::query::Declaration;
+using qps::query::SynonymId;
+using qps::query::SynonymTable;
+
+namespace {
+SynonymTable synonyms;
+}  // namespace
 
 void printGroupSyns(std::vector<qps::optimizer::ClauseGroup> groups) {
     for (auto group : groups) {
         std::string s;
         for (auto syn : group.syns) {
-            s += " " + syn;
+            s += " " + synonyms.getName(syn);
         }
         TEST_LOG << s;
     }
@@ -20,17 +26,17 @@ void printGroupSyns(std::vector<qps::optimizer::ClauseGroup> groups) {
 
 TEST_CASE("OrderedClause") {
     qps::query::Parent p1;
-    p1.parent = qps::query::StmtRef::ofDeclaration(qps::query::Declaration{ "s1", qps::query::DesignEntity::STMT });
-    p1.child = qps::query::StmtRef::ofDeclaration(qps::query::Declaration{ "s2", qps::query::DesignEntity::STMT });
+    p1.parent = qps::query::StmtRef::ofDeclaration(synonyms.declare("s1", qps::query::DesignEntity::STMT));
+    p1.child = qps::query::StmtRef::ofDeclaration(synonyms.declare("s2", qps::query::DesignEntity::STMT));
 
     std::shared_ptr<qps::query::RelRef> suchthat = std::make_shared<qps::query::Parent>(p1);
 
     qps::optimizer::OrderedClause o1 = qps::optimizer::OrderedClause::ofSuchThat(suchthat);
     REQUIRE(o1.isSuchThat());
-    std::vector<std::string> syns1 = o1.getSynonyms();
+    std::vector<SynonymId> syns1 = o1.getSynonyms();
     REQUIRE(syns1.size() == 2);
-    REQUIRE(syns1[0] == "s1");
-    REQUIRE(syns1[1] == "s2");
+    REQUIRE(synonyms.getName(syns1[0]) == "s1");
+    REQUIRE(synonyms.getName(syns1[1]) == "s2");
 
     std::shared_ptr<qps::query::RelRef> suchthatResult = o1.getSuchThat();
     REQUIRE((suchthatResult.get()->getType()) == qps::query::RelRefType::PARENT);
@@ -38,18 +44,18 @@ TEST_CASE("OrderedClause") {
     std::shared_ptr<qps::query::Parent> p2 = std::dynamic_pointer_cast<qps::query::Parent>(suchthatResult);
     REQUIRE(p2.get()->parent == 
         qps::query::StmtRef::ofDeclaration(
-            qps::query::Declaration{ "s1", qps::query::DesignEntity::STMT }
+            synonyms.declare("s1", qps::query::DesignEntity::STMT)
         )
     );
     REQUIRE(p2.get()->child ==
         qps::query::StmtRef::ofDeclaration(
-            qps::query::Declaration{ "s2", qps::query::DesignEntity::STMT }
+            synonyms.declare("s2", qps::query::DesignEntity::STMT)
         )
     );
 
     qps::query::AttrRef ar = qps::query::AttrRef(
             qps::query::AttrName::STMTNUM,
-            qps::query::Declaration{ "s3", qps::query::DesignEntity::STMT }
+            synonyms.declare("s3", qps::query::DesignEntity::STMT)
     );
     qps::query::AttrCompareRef lhs1 = qps::query::AttrCompareRef::ofAttrRef(ar);
     qps::query::AttrCompareRef rhs1 = qps::query::AttrCompareRef::ofString("x");
@@ -57,20 +63,21 @@ TEST_CASE("OrderedClause") {
 
     qps::optimizer::OrderedClause o2 = qps::optimizer::OrderedClause::ofWith(with1);
     REQUIRE(o2.isWith());
-    std::vector<std::string> syns2 = o2.getSynonyms();
+    std::vector<SynonymId> syns2 = o2.getSynonyms();
     REQUIRE(syns2.size() == 1);
-    REQUIRE(syns2[0] == "s3");
+    REQUIRE(synonyms.getName(syns2[0]) == "s3");
 
-    qps::query::Pattern pattern1 = qps::query::Pattern::ofAssignPattern("a",
-        qps::query::EntRef::ofDeclaration(qps::query::Declaration{ "v", qps::query::DesignEntity::VARIABLE }),
+    qps::query::Pattern pattern1 = qps::query::Pattern::ofAssignPattern(
+        synonyms.declare("a", qps::query::DesignEntity::ASSIGN),
+        qps::query::EntRef::ofDeclaration(synonyms.declare("v", qps::query::DesignEntity::VARIABLE)),
         qps::query::ExpSpec::ofWildcard());
 
     qps::optimizer::OrderedClause o3 = qps::optimizer::OrderedClause::ofPattern(pattern1);
     REQUIRE(o3.isPattern());
-    std::vector<std::string> syns3 = o3.getSynonyms();
+    std::vector<SynonymId> syns3 = o3.getSynonyms();
     REQUIRE(syns3.size() == 2);
-    REQUIRE(syns3[0] == "a");
-    REQUIRE(syns3[1] == "v");
+    REQUIRE(synonyms.getName(syns3[0]) == "a");
+    REQUIRE(synonyms.getName(syns3[1]) == "v");
 }
 
 
@@ -91,17 +98,17 @@ TEST_CASE("test group clauses") {
 
     std::shared_ptr<qps::query::UsesS> ptr3 = std::make_shared<qps::query::UsesS>();
     ptr3.get()->useStmt = qps::query::StmtRef::ofDeclaration( 
-        Declaration { "s1", qps::query::DesignEntity::STMT }
+        synonyms.declare("s1", qps::query::DesignEntity::STMT)
     );
     ptr3.get()->used = qps::query::EntRef::ofWildcard();
     suchthat.push_back(ptr3);
 
     std::shared_ptr<qps::query::NextT> ptr4 = std::make_shared<qps::query::NextT>();
     ptr4.get()->before = qps::query::StmtRef::ofDeclaration(
-        Declaration { "s", qps::query::DesignEntity::STMT }
+        synonyms.declare("s", qps::query::DesignEntity::STMT)
     );
     ptr4.get()->transitiveAfter = qps::query::StmtRef::ofDeclaration(
-        Declaration { "a1", qps::query::DesignEntity::ASSIGN }
+        synonyms.declare("a1", qps::query::DesignEntity::ASSIGN)
     );
     suchthat.push_back(ptr4);
 
@@ -112,7 +119,7 @@ TEST_CASE("test group clauses") {
 
     qps::query::AttrRef attr2 = qps::query::AttrRef{
         qps::query::AttrName::VARNAME,
-        Declaration { "r", qps::query::DesignEntity::READ }
+        synonyms.declare("r", qps::query::DesignEntity::READ)
     };
     qps::query::AttrCompareRef lhs2 = qps::query::AttrCompareRef::ofAttrRef(attr2);
     qps::query::AttrCompareRef rhs2 = qps::query::AttrCompareRef::ofString("variable");
@@ -121,11 +128,11 @@ TEST_CASE("test group clauses") {
 
     qps::query::AttrRef attrl3 = qps::query::AttrRef{
         qps::query::AttrName::VARNAME,
-        Declaration { "r", qps::query::DesignEntity::READ }
+        synonyms.declare("r", qps::query::DesignEntity::READ)
     };
     qps::query::AttrRef attrr3 = qps::query::AttrRef{
         qps::query::AttrName::VARNAME,
-        Declaration { "pr", qps::query::DesignEntity::PRINT }
+        synonyms.declare("pr", qps::query::DesignEntity::PRINT)
     };
     qps::query::AttrCompareRef lhs3 = qps::query::AttrCompareRef::ofAttrRef(attrl3);
     qps::query::AttrCompareRef rhs3 = qps::query::AttrCompareRef::ofAttrRef(attrr3);
@@ -134,11 +141,11 @@ TEST_CASE("test group clauses") {
 
     qps::query::AttrRef attrl4 = qps::query::AttrRef{
         qps::query::AttrName::STMTNUM, 
-        Declaration { "a", qps::query::DesignEntity::ASSIGN }
+        synonyms.declare("a", qps::query::DesignEntity::ASSIGN)
     };
     qps::query::AttrRef attrr4 = qps::query::AttrRef{
         qps::query::AttrName::VALUE,
-        Declaration { "c", qps::query::DesignEntity::CONSTANT }
+        synonyms.declare("c", qps::query::DesignEntity::CONSTANT)
     };
     qps::query::AttrCompareRef lhs4 = qps::query::AttrCompareRef::ofAttrRef(attrl4);
     qps::query::AttrCompareRef rhs4 = qps::query::AttrCompareRef::ofAttrRef(attrr4);
@@ -146,15 +153,15 @@ TEST_CASE("test group clauses") {
     with.push_back(with4);
 
     qps::query::Pattern pattern1 = qps::query::Pattern::ofAssignPattern(
-        "a",
+        synonyms.declare("a", qps::query::DesignEntity::ASSIGN),
         qps::query::EntRef::ofVarName("sum"),
         qps::query::ExpSpec::ofWildcard()
     );
     pattern.push_back(pattern1);
 
     qps::query::Pattern pattern2 = qps::query::Pattern::ofAssignPattern(
-        "a1",
-        qps::query::EntRef::ofDeclaration(Declaration{"v", qps::query::DesignEntity::VARIABLE}),
+        synonyms.declare("a1", qps::query::DesignEntity::ASSIGN),
+        qps::query::EntRef::ofDeclaration(synonyms.declare("v", qps::query::DesignEntity::VARIABLE)),
         qps::query::ExpSpec::ofWildcard()
     );
     pattern.push_back(pattern2);
@@ -171,7 +178,7 @@ TEST_CASE("test group clauses") {
     for (int i = 0; i < orderedGroups.size() - 1; i++) {
         REQUIRE(orderedGroups[i].syns.size() <= orderedGroups[i + 1].syns.size());
     }
-    REQUIRE(orderedGroups[0].syns.find("") != orderedGroups[0].syns.end());
+    REQUIRE(orderedGroups[0].syns.find(SynonymTable::NO_SYNONYM) != orderedGroups[0].syns.end());
     printGroupSyns(orderedGroups);
 
     TEST_LOG << "Test clause order";
@@ -196,3 +203,28 @@ TEST_CASE("test group clauses") {
         }
     }
 }
+
+TEST_CASE("Plan cyclic groups") {
+    auto follows = [](std::string_view first, std::string_view second) {
+        std::shared_ptr<qps::query::FollowsT> ptr = std::make_shared<qps::query::FollowsT>();
+        ptr->follower = qps::query::StmtRef::ofDeclaration(synonyms.declare(first, qps::query::DesignEntity::STMT));
+        ptr->transitiveFollowed =
+            qps::query::StmtRef::ofDeclaration(synonyms.declare(second, qps::query::DesignEntity::STMT));
+        return std::shared_ptr<qps::query::RelRef>(ptr);
+    };
+    std::vector<qps::query::AttrCompare> with;
+    std::vector<qps::query::Pattern> pattern;
+
+    std::vector<std::shared_ptr<qps::query::RelRef>> triangle { follows("s1", "s2"), follows("s2", "s3"),
+                                                                follows("s1", "s3") };
+    std::vector<qps::optimizer::PlannedGroup> plan = qps::optimizer::Optimizer(triangle, with, pattern).plan();
+    REQUIRE(plan.size() == 1);
+    REQUIRE(plan[0].isCyclic);
+    REQUIRE(plan[0].bind({}).isCyclic);
+
+    std::vector<std::shared_ptr<qps::query::RelRef>> path { follows("s1", "s2"), follows("s2", "s3"),
+                                                            follows("s2", "s1") };
+    plan = qps::optimizer::Optimizer(path, with, pattern).plan();
+    REQUIRE(plan.size() == 1);
+    REQUIRE_FALSE(plan[0].isCyclic);
+}
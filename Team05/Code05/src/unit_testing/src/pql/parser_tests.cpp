@@ -119,7 +119,7 @@ TEST_CASE("Parser parseAttrName") {
 
     parser.addInput("stmt#");
     query.addDeclaration("a", DesignEntity::ASSIGN);
-    Declaration d = Declaration { "a", DesignEntity::ASSIGN };
+    Declaration d = query.getDeclaration("a");
     AttrName attrName = parser.parseAttrName(query, d);
 
     REQUIRE(attrName == AttrName::STMTNUM);
@@ -135,7 +135,7 @@ TEST_CASE("Parser parseElem") {
         Elem e = parser.parseElem(query);
 
         REQUIRE(e.isDeclaration());
-        REQUIRE(e.getDeclaration() == Declaration { "a", DesignEntity::ASSIGN });
+        REQUIRE(e.getDeclaration() == query.getDeclaration("a"));
     }
 
     SECTION("Elem is AttrRef") {
@@ -147,7 +147,7 @@ TEST_CASE("Parser parseElem") {
         Elem e = parser.parseElem(query);
 
         REQUIRE(e.isAttrRef());
-        REQUIRE(e.getAttrRef() == AttrRef { AttrName::STMTNUM, Declaration { "a", DesignEntity::ASSIGN }});
+        REQUIRE(e.getAttrRef() == AttrRef { AttrName::STMTNUM, query.getDeclaration("a")});
     }
 }
 
@@ -164,7 +164,7 @@ TEST_CASE("Parser parseTuple") {
         Elem e = selectFields[0];
 
         REQUIRE(e.isDeclaration());
-        REQUIRE(e.getDeclaration() ==  Declaration { "a", DesignEntity::ASSIGN });
+        REQUIRE(e.getDeclaration() ==  query.getDeclaration("a"));
     }
 
     SECTION("select field is single elem with brackets") {
@@ -179,7 +179,7 @@ TEST_CASE("Parser parseTuple") {
         Elem e = selectFields[0];
 
         REQUIRE(e.isAttrRef());
-        REQUIRE(e.getAttrRef() == AttrRef { AttrName::STMTNUM, Declaration { "a", DesignEntity::ASSIGN }});
+        REQUIRE(e.getAttrRef() == AttrRef { AttrName::STMTNUM, query.getDeclaration("a")});
     }
 
     SECTION("select field is multiple elem with brackets") {
@@ -195,17 +195,17 @@ TEST_CASE("Parser parseTuple") {
 
         REQUIRE(selectFields[0].isAttrRef());
         REQUIRE(selectFields[0].getAttrRef() == AttrRef { AttrName::STMTNUM,
-                                                          Declaration { "a", DesignEntity::ASSIGN }});
+                                                          query.getDeclaration("a")});
 
         REQUIRE(selectFields[1].isDeclaration());
-        REQUIRE(selectFields[1].getDeclaration() ==  Declaration { "a", DesignEntity::ASSIGN });
+        REQUIRE(selectFields[1].getDeclaration() ==  query.getDeclaration("a"));
 
         REQUIRE(selectFields[2].isDeclaration());
-        REQUIRE(selectFields[2].getDeclaration() ==  Declaration { "cl", DesignEntity::CALL });
+        REQUIRE(selectFields[2].getDeclaration() ==  query.getDeclaration("cl"));
 
         REQUIRE(selectFields[3].isAttrRef());
         REQUIRE(selectFields[3].getAttrRef() == AttrRef { AttrName::PROCNAME,
-                                                          Declaration { "cl", DesignEntity::CALL }});
+                                                          query.getDeclaration("cl")});
     }
 }
 
@@ -1403,28 +1403,28 @@ TEST_CASE("Parser parseAttrRef") {
     SECTION("stmt#") {
         parser.lexer.text = "s.stmt#";
         ar = parser.parseAttrRef(query);
-        REQUIRE(ar.getDeclaration()  == Declaration { "s", DesignEntity::STMT} );
+        REQUIRE(ar.getDeclaration()  == query.getDeclaration("s") );
         REQUIRE(ar.getAttrName() == AttrName::STMTNUM);
     }
 
     SECTION ("varName") {
         parser.lexer.text = "v.varName";
         ar = parser.parseAttrRef(query);
-        REQUIRE(ar.getDeclaration() == Declaration { "v", DesignEntity::VARIABLE } );
+        REQUIRE(ar.getDeclaration() == query.getDeclaration("v") );
         REQUIRE(ar.getAttrName() == AttrName::VARNAME);
     }
 
     SECTION ("procName") {
         parser.lexer.text = "p.procName";
         ar = parser.parseAttrRef(query);
-        REQUIRE(ar.getDeclaration() == Declaration { "p", DesignEntity::PROCEDURE });
+        REQUIRE(ar.getDeclaration() == query.getDeclaration("p"));
         REQUIRE(ar.getAttrName() == AttrName::PROCNAME);
     }
 
     SECTION ("value") {
         parser.lexer.text = "c.value";
         ar = parser.parseAttrRef(query);
-        REQUIRE(ar.getDeclaration()  == Declaration { "c", DesignEntity::CONSTANT });
+        REQUIRE(ar.getDeclaration()  == query.getDeclaration("c"));
         REQUIRE(ar.getAttrName() == AttrName::VALUE);
     }
 
@@ -1444,12 +1444,14 @@ TEST_CASE("Parser parseAttrRef") {
 }
 
 TEST_CASE("validateComparingTypes") {
+    qps::query::SynonymTable synonyms;
+
     SECTION("Incompatible type matches") {
         Parser p;
         REQUIRE_THROWS_MATCHES(
             p.validateComparingTypes(
                 AttrCompareRef::ofAttrRef(
-                    AttrRef{ AttrName::STMTNUM, Declaration {"rd", DesignEntity::READ } }), 
+                    AttrRef{ AttrName::STMTNUM, synonyms.declare("rd", DesignEntity::READ) }), 
                     AttrCompareRef::ofString("v")
             ), 
             exceptions::PqlSemanticException,
@@ -1460,7 +1462,7 @@ TEST_CASE("validateComparingTypes") {
             p.validateComparingTypes(
                 AttrCompareRef::ofNumber(1), 
                 AttrCompareRef::ofAttrRef(
-                    AttrRef{ AttrName::VARNAME, Declaration { "v", DesignEntity::VARIABLE } }
+                    AttrRef{ AttrName::VARNAME, synonyms.declare("v", DesignEntity::VARIABLE) }
                 )
             ), 
             exceptions::PqlSemanticException,
@@ -1474,25 +1476,21 @@ TEST_CASE("validateComparingTypes") {
     SECTION("Compatible type matches") {
         Parser p;
 
-        REQUIRE_NOTHROW(p.validateComparingTypes(AttrCompareRef::ofAttrRef(AttrRef{ AttrName::PROCNAME, Declaration {
-            "p", DesignEntity::PROCEDURE } }), AttrCompareRef::ofString("v")));
+        REQUIRE_NOTHROW(p.validateComparingTypes(AttrCompareRef::ofAttrRef(AttrRef{ AttrName::PROCNAME, synonyms.declare("p", DesignEntity::PROCEDURE) }), AttrCompareRef::ofString("v")));
 
         REQUIRE_NOTHROW(p.validateComparingTypes(AttrCompareRef::ofString("v"), AttrCompareRef::ofAttrRef(
-            AttrRef{ AttrName::VARNAME, Declaration { "v", DesignEntity::VARIABLE, } })));
+            AttrRef{ AttrName::VARNAME, synonyms.declare("v", DesignEntity::VARIABLE) })));
 
-        REQUIRE_NOTHROW(p.validateComparingTypes(AttrCompareRef::ofAttrRef(AttrRef{ AttrName::STMTNUM,  Declaration {
-            "cl", DesignEntity::CALL} }), AttrCompareRef::ofNumber(200)));
+        REQUIRE_NOTHROW(p.validateComparingTypes(AttrCompareRef::ofAttrRef(AttrRef{ AttrName::STMTNUM,  synonyms.declare("cl", DesignEntity::CALL) }), AttrCompareRef::ofNumber(200)));
 
         REQUIRE_NOTHROW(p.validateComparingTypes(AttrCompareRef::ofNumber(99), AttrCompareRef::ofAttrRef(
-            AttrRef{ AttrName::VALUE, Declaration { "c", DesignEntity::CONSTANT } })));
+            AttrRef{ AttrName::VALUE, synonyms.declare("c", DesignEntity::CONSTANT) })));
 
-        REQUIRE_NOTHROW(p.validateComparingTypes(AttrCompareRef::ofAttrRef(AttrRef{ AttrName::PROCNAME, Declaration {
-            "p", DesignEntity::PROCEDURE } }), AttrCompareRef::ofAttrRef(AttrRef{
-                AttrName::VARNAME, Declaration { "v", DesignEntity::VARIABLE } })));
+        REQUIRE_NOTHROW(p.validateComparingTypes(AttrCompareRef::ofAttrRef(AttrRef{ AttrName::PROCNAME, synonyms.declare("p", DesignEntity::PROCEDURE) }), AttrCompareRef::ofAttrRef(AttrRef{
+                AttrName::VARNAME, synonyms.declare("v", DesignEntity::VARIABLE) })));
 
-        REQUIRE_NOTHROW(p.validateComparingTypes(AttrCompareRef::ofAttrRef(AttrRef{ AttrName::STMTNUM, Declaration {
-            "cl", DesignEntity::CALL } }), AttrCompareRef::ofAttrRef(AttrRef{
-                AttrName::VALUE, Declaration { "c", DesignEntity::CONSTANT } })));
+        REQUIRE_NOTHROW(p.validateComparingTypes(AttrCompareRef::ofAttrRef(AttrRef{ AttrName::STMTNUM, synonyms.declare("cl", DesignEntity::CALL) }), AttrCompareRef::ofAttrRef(AttrRef{
+                AttrName::VALUE, synonyms.declare("c", DesignEntity::CONSTANT) })));
     }
 }
 
@@ -1508,7 +1506,7 @@ TEST_CASE("Parser parseAttrCompareRef") {
         acr = parser.parseAttrCompareRef(query);
         REQUIRE(acr.isAttrRef());
         AttrRef ar = acr.getAttrRef();
-        REQUIRE(ar.getDeclaration() == Declaration { "s", DesignEntity::STMT });
+        REQUIRE(ar.getDeclaration() == query.getDeclaration("s"));
         REQUIRE(ar.getAttrName() == AttrName::STMTNUM);
     }
 
@@ -1660,7 +1658,7 @@ TEST_CASE("Parser parsePql") {
         REQUIRE(queryObj.getDeclarationDesignEntity("v") == DesignEntity::VARIABLE);
 
         // Check Select
-        Elem e = Elem::ofDeclaration( Declaration { "a", DesignEntity::ASSIGN });
+        Elem e = Elem::ofDeclaration(queryObj.getDeclaration("a"));
         REQUIRE(queryObj.hasSelectElem(e));
 
         // Check such that
@@ -1708,7 +1706,7 @@ TEST_CASE("Parser parsePql") {
         REQUIRE(queryObj.getDeclarationDesignEntity("v") == DesignEntity::VARIABLE);
 
         // Check Select
-        Elem e = Elem::ofDeclaration( Declaration { "a", DesignEntity::ASSIGN });
+        Elem e = Elem::ofDeclaration(queryObj.getDeclaration("a"));
         REQUIRE(queryObj.hasSelectElem(e));
 
         // Check pattern
@@ -30,19 +30,22 @@ using qps::query::AttrCompare;
 using qps::query::AttrCompareRef;
 using qps::query::AttrCompareRefType;
 using qps::query::Declaration;
+using qps::query::SynonymTable;
 
-
+namespace {
+SynonymTable synonyms;
+}  // namespace
 
 TEST_CASE("AttrRef") {
     SECTION("AttrRef correctness") {
-        Declaration d("p", DesignEntity::PROCEDURE);
-        AttrRef ar = AttrRef{ AttrName::PROCNAME, Declaration {"p", DesignEntity::PROCEDURE} };
+        Declaration d = synonyms.declare("p", DesignEntity::PROCEDURE);
+        AttrRef ar = AttrRef{ AttrName::PROCNAME, synonyms.declare("p", DesignEntity::PROCEDURE) };
         REQUIRE(ar.getAttrName() == AttrName::PROCNAME);
         REQUIRE(ar.getDeclaration() == d);
 
-        AttrRef ar2 = AttrRef{ AttrName::VARNAME, Declaration { "v", DesignEntity::VARIABLE } };
-        AttrRef ar3 = AttrRef{ AttrName::STMTNUM, Declaration { "s", DesignEntity::STMT} };
-        AttrRef ar4 = AttrRef{ AttrName::VALUE, Declaration {"c", DesignEntity::CONSTANT} };
+        AttrRef ar2 = AttrRef{ AttrName::VARNAME, synonyms.declare("v", DesignEntity::VARIABLE) };
+        AttrRef ar3 = AttrRef{ AttrName::STMTNUM, synonyms.declare("s", DesignEntity::STMT) };
+        AttrRef ar4 = AttrRef{ AttrName::VALUE, synonyms.declare("c", DesignEntity::CONSTANT) };
 
     REQUIRE(ar.canBeCompared(ar2));
     REQUIRE(ar3.canBeCompared(ar4));
@@ -55,8 +58,8 @@ TEST_CASE("AttrRef") {
 }
 
     SECTION("AttrRef Hash") {
-        AttrRef ar1 = AttrRef{ AttrName::PROCNAME, Declaration {"p", DesignEntity::PROCEDURE} };
-        AttrRef ar2 = AttrRef{ AttrName::PROCNAME, Declaration {"p", DesignEntity::PROCEDURE} };
+        AttrRef ar1 = AttrRef{ AttrName::PROCNAME, synonyms.declare("p", DesignEntity::PROCEDURE) };
+        AttrRef ar2 = AttrRef{ AttrName::PROCNAME, synonyms.declare("p", DesignEntity::PROCEDURE) };
         std::unordered_set<AttrRef> aSet;
         aSet.insert(ar1);
         aSet.insert(ar2);
@@ -74,7 +77,7 @@ TEST_CASE("AttrCompareRef") {
         REQUIRE(acr.isNumber());
         REQUIRE(acr.getNumber() == 1);
 
-        Declaration d("p", DesignEntity::PROCEDURE);
+        Declaration d = synonyms.declare("p", DesignEntity::PROCEDURE);
         acr = AttrCompareRef::ofAttrRef(AttrRef{ AttrName::PROCNAME, d });
         REQUIRE(acr.isAttrRef());
         AttrRef ar = acr.getAttrRef();
@@ -100,7 +103,7 @@ TEST_CASE("AttrCompareRef") {
 
         REQUIRE(aSet.size() == 2);
 
-        Declaration d("p", DesignEntity::PROCEDURE);
+        Declaration d = synonyms.declare("p", DesignEntity::PROCEDURE);
         AttrCompareRef acr5 = AttrCompareRef::ofAttrRef(AttrRef{ AttrName::PROCNAME, d });
         AttrCompareRef acr6 = AttrCompareRef::ofAttrRef(AttrRef{ AttrName::PROCNAME, d });
 
@@ -113,7 +116,7 @@ TEST_CASE("AttrCompareRef") {
 
 TEST_CASE("AttrCompare") {
     SECTION ("AttrCompare with compatible AttrCompareRef types") {
-        Declaration d ("v", DesignEntity::VARIABLE);
+        Declaration d = synonyms.declare("v", DesignEntity::VARIABLE);
         AttrCompare ac(AttrCompareRef::ofAttrRef( AttrRef { AttrName::VARNAME, d }),
                        AttrCompareRef::ofString("v"));
 
@@ -143,9 +146,9 @@ TEST_CASE("StmtRef") {
     StmtRef stmtRef2 = StmtRef::ofWildcard();
     REQUIRE(stmtRef2.isWildcard());
 
-    StmtRef stmtRef3 = StmtRef::ofDeclaration(Declaration { "a", DesignEntity::ASSIGN });
+    StmtRef stmtRef3 = StmtRef::ofDeclaration(synonyms.declare("a", DesignEntity::ASSIGN));
     REQUIRE(stmtRef3.isDeclaration());
-    REQUIRE(stmtRef3.getDeclaration() == Declaration { "a", DesignEntity::ASSIGN });
+    REQUIRE(stmtRef3.getDeclaration() == synonyms.declare("a", DesignEntity::ASSIGN));
     REQUIRE(stmtRef3.getDeclarationSynonym() == "a");
     REQUIRE(stmtRef3.getDeclarationType() == DesignEntity::ASSIGN);
 
@@ -165,9 +168,9 @@ TEST_CASE("EntRef") {
     EntRef entRef2 = EntRef::ofWildcard();
     REQUIRE(entRef2.isWildcard());
 
-    EntRef entRef3 = EntRef::ofDeclaration( Declaration { "a", DesignEntity::ASSIGN } );
+    EntRef entRef3 = EntRef::ofDeclaration( synonyms.declare("a", DesignEntity::ASSIGN) );
     REQUIRE(entRef3.isDeclaration());
-    REQUIRE(entRef3.getDeclaration() ==  Declaration { "a", DesignEntity::ASSIGN });
+    REQUIRE(entRef3.getDeclaration() ==  synonyms.declare("a", DesignEntity::ASSIGN));
     REQUIRE(entRef3.getDeclarationSynonym() == "a");
     REQUIRE(entRef3.getDeclarationType() == DesignEntity::ASSIGN);
 
@@ -233,22 +236,24 @@ TEST_CASE("ExpSpec") {
 
 TEST_CASE("Pattern") {
     SECTION("Pattern correctness") {
-        Pattern p = Pattern::ofAssignPattern("h", EntRef::ofWildcard(), ExpSpec::ofFullMatch("x"));
+        Pattern p = Pattern::ofAssignPattern(synonyms.declare("h", DesignEntity::ASSIGN),
+                EntRef::ofWildcard(), ExpSpec::ofFullMatch("x"));
         REQUIRE(p.getSynonym() == "h");
         REQUIRE(p.getSynonymType() == DesignEntity::ASSIGN);
         REQUIRE(p.getEntRef().getType() == EntRefType::WILDCARD);
         REQUIRE(p.getExpression() == ExpSpec::ofFullMatch("x"));
 
-        Pattern p2 = Pattern::ofAssignPattern("g", EntRef::ofWildcard(), ExpSpec::ofFullMatch("x"));
+        Pattern p2 = Pattern::ofAssignPattern(synonyms.declare("g", DesignEntity::ASSIGN),
+                EntRef::ofWildcard(), ExpSpec::ofFullMatch("x"));
         REQUIRE(!(p == p2));
         REQUIRE(p2 == p2);
 
-        Pattern p3 = Pattern::ofWhilePattern("x", EntRef::ofWildcard());
+        Pattern p3 = Pattern::ofWhilePattern(synonyms.declare("x", DesignEntity::WHILE), EntRef::ofWildcard());
         REQUIRE(p3.getSynonym() == "x");
         REQUIRE(p3.getSynonymType() == DesignEntity::WHILE);
         REQUIRE(p3.getEntRef().getType() == EntRefType::WILDCARD);
 
-        Pattern p4 = Pattern::ofIfPattern("y", EntRef::ofWildcard());
+        Pattern p4 = Pattern::ofIfPattern(synonyms.declare("y", DesignEntity::IF), EntRef::ofWildcard());
         REQUIRE(p4.getSynonym() == "y");
         REQUIRE(p4.getSynonymType() == DesignEntity::IF);
         REQUIRE(p4.getEntRef().getType() == EntRefType::WILDCARD);
@@ -256,8 +261,10 @@ TEST_CASE("Pattern") {
 
     SECTION("Pattern Hash") {
         std::unordered_set<Pattern> pSet;
-        Pattern p1 = Pattern::ofAssignPattern("h", EntRef::ofWildcard(), ExpSpec::ofFullMatch("x"));
-        Pattern p2 = Pattern::ofAssignPattern("h", EntRef::ofWildcard(), ExpSpec::ofFullMatch("x"));
+        Pattern p1 = Pattern::ofAssignPattern(synonyms.declare("h", DesignEntity::ASSIGN),
+                EntRef::ofWildcard(), ExpSpec::ofFullMatch("x"));
+        Pattern p2 = Pattern::ofAssignPattern(synonyms.declare("h", DesignEntity::ASSIGN),
+                EntRef::ofWildcard(), ExpSpec::ofFullMatch("x"));
 
         pSet.insert(p1);
         REQUIRE(pSet.size() == 1);
@@ -265,14 +272,15 @@ TEST_CASE("Pattern") {
         pSet.insert(p2);
         REQUIRE(pSet.size() == 1);
 
-        Pattern p3 = Pattern::ofAssignPattern("h", EntRef::ofWildcard(), ExpSpec::ofFullMatch("y"));
+        Pattern p3 = Pattern::ofAssignPattern(synonyms.declare("h", DesignEntity::ASSIGN),
+                EntRef::ofWildcard(), ExpSpec::ofFullMatch("y"));
         pSet.insert(p3);
 
         REQUIRE(pSet.size() == 2);
 
-        Pattern p4 = Pattern::ofWhilePattern("x", EntRef::ofWildcard());
-        Pattern p5 = Pattern::ofWhilePattern("x", EntRef::ofWildcard());
-        Pattern p6 = Pattern::ofWhilePattern("y", EntRef::ofWildcard());
+        Pattern p4 = Pattern::ofWhilePattern(synonyms.declare("x", DesignEntity::WHILE), EntRef::ofWildcard());
+        Pattern p5 = Pattern::ofWhilePattern(synonyms.declare("x", DesignEntity::WHILE), EntRef::ofWildcard());
+        Pattern p6 = Pattern::ofWhilePattern(synonyms.declare("y", DesignEntity::WHILE), EntRef::ofWildcard());
 
         pSet.insert(p4);
         REQUIRE(pSet.size() == 3);
@@ -283,9 +291,9 @@ TEST_CASE("Pattern") {
         pSet.insert(p6);
         REQUIRE(pSet.size() == 4);
 
-        Pattern p7 = Pattern::ofIfPattern("y", EntRef::ofWildcard());
-        Pattern p8 = Pattern::ofIfPattern("y", EntRef::ofWildcard());
-        Pattern p9 = Pattern::ofIfPattern("z", EntRef::ofWildcard());
+        Pattern p7 = Pattern::ofIfPattern(synonyms.declare("y", DesignEntity::IF), EntRef::ofWildcard());
+        Pattern p8 = Pattern::ofIfPattern(synonyms.declare("y", DesignEntity::IF), EntRef::ofWildcard());
+        Pattern p9 = Pattern::ofIfPattern(synonyms.declare("z", DesignEntity::IF), EntRef::ofWildcard());
 
         pSet.insert(p7);
         REQUIRE(pSet.size() == 5);
@@ -302,20 +310,20 @@ TEST_CASE("Query") {
     REQUIRE(query.hasDeclaration("a"));
 
     std::vector<Elem> tuple;
-    Elem e = Elem::ofDeclaration(Declaration { "a", DesignEntity::STMT });
+    Elem e = Elem::ofDeclaration(query.getDeclaration("a"));
     tuple.push_back(e);
     query.addResultCl(ResultCl::ofTuple(tuple));
     REQUIRE(query.hasSelectElem(e));
 
     std::shared_ptr<ModifiesS> ptr = std::make_shared<ModifiesS>();
     ptr->modifiesStmt = StmtRef::ofLineNo(4);
-    ptr->modified = EntRef::ofDeclaration( Declaration { "v", DesignEntity::VARIABLE });
+    ptr->modified = EntRef::ofDeclaration( synonyms.declare("v", DesignEntity::VARIABLE));
     query.addSuchthat(ptr);
     REQUIRE(!query.getSuchthat().empty());
     REQUIRE(query.getSuchthat()[0] == ptr);
 
     std::vector<std::shared_ptr<RelRef>> suchThat = query.getSuchthat();
-    REQUIRE(suchThat[0]->getDecs() == std::vector<Declaration>{Declaration{"v", DesignEntity::VARIABLE}});
+    REQUIRE(suchThat[0]->getDecs() == std::vector<Declaration>{synonyms.declare("v", DesignEntity::VARIABLE)});
 
     std::vector<PKBField> fields = suchThat[0]->getField();
     REQUIRE(fields[0].entityType == PKBEntityType::STATEMENT);
@@ -324,7 +332,8 @@ TEST_CASE("Query") {
     REQUIRE(fields[1].entityType == PKBEntityType::VARIABLE);
     REQUIRE(fields[1].fieldType == PKBFieldType::DECLARATION);
 
-    Pattern p = Pattern::ofAssignPattern("a", EntRef::ofWildcard(), ExpSpec::ofFullMatch("x"));
+    Pattern p = Pattern::ofAssignPattern(synonyms.declare("a", DesignEntity::ASSIGN),
+            EntRef::ofWildcard(), ExpSpec::ofFullMatch("x"));
     query.addPattern(p);
     REQUIRE(!query.getPattern().empty());
     REQUIRE(query.getPattern()[0] == p);
@@ -353,17 +362,40 @@ TEST_CASE("Query getDeclarationDesignEntity") {
                            Catch::Message(messages::qps::parser::declarationDoesNotExistMessage));
 }
 
+TEST_CASE("Query interns synonyms") {
+    Query query {};
+    query.addDeclaration("s", DesignEntity::STMT);
+    query.addDeclaration("v", DesignEntity::VARIABLE);
+
+    Declaration s = query.getDeclaration("s");
+    Declaration v = query.getDeclaration("v");
+    REQUIRE(s.getId() != v.getId());
+    REQUIRE(s.getId() != SynonymTable::NO_SYNONYM);
+    REQUIRE(s.getSynonym() == "s");
+    REQUIRE(query.getSynonymTable()->getName(v.getId()) == "v");
+    REQUIRE(Declaration{}.getSynonym().empty());
+    REQUIRE_THROWS_AS(query.addDeclaration("s", DesignEntity::ASSIGN), exceptions::PqlSyntaxException);
+
+    Query other {};
+    other.addDeclaration("v", DesignEntity::VARIABLE);
+    REQUIRE(other.getSynonymTable() != query.getSynonymTable());
+    REQUIRE(other.getDeclaration("v").getId() == s.getId());
+    REQUIRE(other.getDeclaration("v").getSynonym() == "v");
+}
+
 TEST_CASE("RelRef equality check") {
-    Pattern p = Pattern::ofAssignPattern("a", EntRef::ofWildcard(), ExpSpec::ofFullMatch("x"));
-    Pattern p1 = Pattern::ofAssignPattern("a", EntRef::ofWildcard(), ExpSpec::ofFullMatch("x"));
+    Pattern p = Pattern::ofAssignPattern(synonyms.declare("a", DesignEntity::ASSIGN),
+            EntRef::ofWildcard(), ExpSpec::ofFullMatch("x"));
+    Pattern p1 = Pattern::ofAssignPattern(synonyms.declare("a", DesignEntity::ASSIGN),
+            EntRef::ofWildcard(), ExpSpec::ofFullMatch("x"));
     REQUIRE(p == p1);
     std::shared_ptr<ModifiesS> ptr1 = std::make_shared<ModifiesS>();
     ptr1->modifiesStmt = StmtRef::ofLineNo(4);
-    ptr1->modified = EntRef::ofDeclaration( Declaration { "v", DesignEntity::VARIABLE });
+    ptr1->modified = EntRef::ofDeclaration( synonyms.declare("v", DesignEntity::VARIABLE));
 
     std::shared_ptr<ModifiesS> ptr2 = std::make_shared<ModifiesS>();
     ptr2->modifiesStmt = StmtRef::ofLineNo(4);
-    ptr2->modified = EntRef::ofDeclaration( Declaration { "v", DesignEntity::VARIABLE });
+    ptr2->modified = EntRef::ofDeclaration( synonyms.declare("v", DesignEntity::VARIABLE));
 
     REQUIRE(*(ptr1) == *(ptr2));
 }
@@ -0,0 +1,83 @@
+#include <memory>
+#include <stdexcept>
+
+#include "catch.hpp"
+#include "exceptions.h"
+#include "QPS/ResultCache.h"
+
+using qps::evaluator::ClauseResult;
+using qps::evaluator::ResultCache;
+using qps::optimizer::OrderedClause;
+using qps::optimizer::PlannedGroup;
+
+namespace {
+qps::query::SynonymTable synonyms;
+
+OrderedClause follows(std::string_view first, int second) {
+    qps::query::Follows f;
+    f.follower = qps::query::StmtRef::ofDeclaration(synonyms.declare(first, qps::query::DesignEntity::STMT));
+    f.followed = qps::query::StmtRef::ofLineNo(second);
+    std::shared_ptr<qps::query::RelRef> relRef = std::make_shared<qps::query::Follows>(f);
+    return OrderedClause::ofSuchThat(relRef);
+}
+}  // namespace
+
+TEST_CASE("ResultCache") {
+    ResultCache cache;
+    int computations = 0;
+    auto compute = [&]() {
+        computations++;
+        return ClauseResult{PKBResponse{}, {}};
+    };
+
+    SECTION("Equal clauses are computed once") {
+        auto first = cache.getClause(follows("s", 2), compute);
+        auto second = cache.getClause(follows("s", 2), compute);
+        REQUIRE(first == second);
+        REQUIRE(computations == 1);
+
+        cache.getClause(follows("s", 3), compute);
+        cache.getClause(follows("s1", 2), compute);
+        REQUIRE(computations == 3);
+        REQUIRE(cache.getComputedCount() == 3);
+        REQUIRE(cache.getHitCount() == 1);
+    }
+
+    SECTION("Groups and clauses without synonyms are cached separately") {
+        PlannedGroup group{false, {follows("s", 2)}};
+        int groupComputations = 0;
+        auto computeGroup = [&]() {
+            groupComputations++;
+            return qps::evaluator::GroupResult{false, qps::evaluator::ResultTable()};
+        };
+        REQUIRE_FALSE(cache.getGroup(group, computeGroup)->hasResult);
+        REQUIRE_FALSE(cache.getGroup(PlannedGroup{false, {follows("s", 2)}}, computeGroup)->hasResult);
+        cache.getGroup(PlannedGroup{true, {follows("s", 2)}}, computeGroup);
+        REQUIRE(groupComputations == 2);
+
+        REQUIRE(cache.holds(follows("s", 2), [] { return true; }));
+        REQUIRE(cache.holds(follows("s", 2), [] { return false; }));
+    }
+
+    SECTION("Exceptions are cached") {
+        auto fail = [&]() -> ClauseResult {
+            computations++;
+            throw std::runtime_error("failed");
+        };
+        REQUIRE_THROWS(cache.getClause(follows("s", 2), fail));
+        REQUIRE_THROWS(cache.getClause(follows("s", 2), fail));
+        REQUIRE(computations == 1);
+    }
+
+    SECTION("Stopped computations are not cached") {
+        auto stop = [&]() -> ClauseResult {
+            computations++;
+            throw exceptions::QueryStoppedException(exceptions::QueryStoppedException::Reason::CANCELLED);
+        };
+        REQUIRE_THROWS_AS(cache.getClause(follows("s", 2), stop), exceptions::QueryStoppedException);
+        cache.getClause(follows("s", 2), compute);
+        REQUIRE(computations == 2);
+        cache.getClause(follows("s", 2), compute);
+        REQUIRE(computations == 2);
+    }
+}
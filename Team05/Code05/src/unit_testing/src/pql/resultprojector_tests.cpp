@@ -27,7 +27,7 @@ qps::evaluator::Evaluator evaluator(ptr);
 qps::query::Query query{};
 query.addDeclaration("if", qps::query::DesignEntity::IF);
 
-qps::query::Declaration d = qps::query::Declaration { "if", qps::query::DesignEntity::IF };
+qps::query::Declaration d = query.getDeclaration("if");
 std::vector<qps::query::Elem> tuple { qps::query::Elem::ofDeclaration(d) };
 qps::query::ResultCl r = qps::query::ResultCl::ofTuple(tuple);
 query.addResultCl(r);
@@ -47,9 +47,9 @@ query2.addDeclaration("if", qps::query::DesignEntity::IF);
 query2.addDeclaration("pr", qps::query::DesignEntity::PRINT);
 query2.addDeclaration("w", qps::query::DesignEntity::WHILE);
 
-qps::query::Declaration d21 = qps::query::Declaration { "if", qps::query::DesignEntity::IF };
-qps::query::Declaration d22 = qps::query::Declaration { "pr", qps::query::DesignEntity::PRINT };
-qps::query::Declaration d23 = qps::query::Declaration { "w", qps::query::DesignEntity::WHILE };
+qps::query::Declaration d21 = query2.getDeclaration("if");
+qps::query::Declaration d22 = query2.getDeclaration("pr");
+qps::query::Declaration d23 = query2.getDeclaration("w");
 std::vector<qps::query::Elem> tuple2 { qps::query::Elem::ofDeclaration(d23),
                                        qps::query::Elem::ofDeclaration(d22),
                                        qps::query::Elem::ofDeclaration(d21) };
@@ -70,18 +70,18 @@ query3.addDeclaration("v", qps::query::DesignEntity::VARIABLE);
 query3.addDeclaration("p", qps::query::DesignEntity::PRINT);
 
 qps::query::AttrRef d31 = qps::query::AttrRef{qps::query::AttrName::STMTNUM,
-                                              Declaration{ "a", qps::query::DesignEntity::ASSIGN}};
+                                              query3.getDeclaration("a")};
 qps::query::AttrRef d32 = qps::query::AttrRef{qps::query::AttrName::VARNAME,
-                                              Declaration{"v", qps::query::DesignEntity::VARIABLE}};
+                                              query3.getDeclaration("v")};
 qps::query::AttrRef d33 = qps::query::AttrRef{qps::query::AttrName::VARNAME,
-                                              Declaration{"p", qps::query::DesignEntity::PRINT}};
+                                              query3.getDeclaration("p")};
 std::vector<qps::query::Elem> tuple3 { qps::query::Elem::ofAttrRef(d33),
                                        qps::query::Elem::ofAttrRef(d32),
                                        qps::query::Elem::ofAttrRef(d31) };
 qps::query::ResultCl r3 = qps::query::ResultCl::ofTuple(tuple3);
 query3.addResultCl(r3);
 qps::query::AttrRef attr3 = qps::query::AttrRef{qps::query::AttrName::VARNAME,
-                                                Declaration { "v", qps::query::DesignEntity::VARIABLE}};
+                                                query3.getDeclaration("v")};
 qps::query::AttrCompareRef lhs3 = qps::query::AttrCompareRef::ofAttrRef(attr3);
 qps::query::AttrCompareRef rhs3 = qps::query::AttrCompareRef::ofString("x");
 qps::query::AttrCompare with3 = qps::query::AttrCompare{lhs3, rhs3};
@@ -108,7 +108,7 @@ query5.addDeclaration("v", qps::query::DesignEntity::VARIABLE);
 qps::query::ResultCl r5 = qps::query::ResultCl::ofBoolean();
 query5.addResultCl(r5);
 qps::query::AttrRef attr5 = qps::query::AttrRef{qps::query::AttrName::VARNAME,
-                                                Declaration { "v", qps::query::DesignEntity::VARIABLE }};
+                                                query5.getDeclaration("v")};
 qps::query::AttrCompareRef lhs5 = qps::query::AttrCompareRef::ofAttrRef(attr5);
 qps::query::AttrCompareRef rhs5 = qps::query::AttrCompareRef::ofString("sum");
 qps::query::AttrCompare with5 = qps::query::AttrCompare{lhs5, rhs5};
@@ -120,8 +120,8 @@ TEST_LOG << "select <a, a>";
 qps::evaluator::Evaluator evaluator6(ptr);
 qps::query::Query query6{};
 query6.addDeclaration("a", qps::query::DesignEntity::ASSIGN);
-qps::query::Declaration d61 = qps::query::Declaration { "a", qps::query::DesignEntity::ASSIGN };
-qps::query::Declaration d62 = qps::query::Declaration { "a", qps::query::DesignEntity::ASSIGN };
+qps::query::Declaration d61 = query6.getDeclaration("a");
+qps::query::Declaration d62 = query6.getDeclaration("a");
 std::vector<qps::query::Elem> tuple6 { qps::query::Elem::ofDeclaration(d61),
                                        qps::query::Elem::ofDeclaration(d62) };
 qps::query::ResultCl r6 = qps::query::ResultCl::ofTuple(tuple6);
@@ -148,3 +148,48 @@ REQUIRE("1" == qps::evaluator::ResultProjector::PKBFieldToString(field4));
 REQUIRE("87" == qps::evaluator::ResultProjector::PKBFieldToString(field5));
 REQUIRE("maven" == qps::evaluator::ResultProjector::PKBFieldToString(field6));
 }
+
+TEST_CASE("Stream projected results") {
+using qps::query::DesignEntity;
+qps::query::SynonymTable synonyms;
+Declaration pr = synonyms.declare("pr", DesignEntity::PRINT);
+Declaration v = synonyms.declare("v", DesignEntity::VARIABLE);
+PKBField print7 = PKBField::createConcrete(STMT_LO{7, StatementType::Print, "x"});
+PKBField print8 = PKBField::createConcrete(STMT_LO{8, StatementType::Print, "x"});
+PKBField x = PKBField::createConcrete(VAR_NAME{"x"});
+PKBField y = PKBField::createConcrete(VAR_NAME{"y"});
+qps::evaluator::ResultTable table;
+table.insert(PKBResponse{true, Response{qps::evaluator::VectorResponse{{print7, x}, {print7, y}, {print8, x}}}},
+             std::vector<qps::query::SynonymId>{pr.getId(), v.getId()});
+
+std::vector<std::size_t> chunkSizes;
+std::list<std::string> results;
+auto project = [&](std::vector<qps::query::Elem> tuple) {
+    chunkSizes.clear();
+    results.clear();
+    qps::evaluator::ResultProjector::projectResult(table, qps::query::ResultCl::ofTuple(tuple),
+        [&](std::vector<std::string>& chunk) {
+            chunkSizes.push_back(chunk.size());
+            results.insert(results.end(), chunk.begin(), chunk.end());
+        }, 2);
+    results.sort();
+};
+
+SECTION("Every column is projected") {
+    project({ qps::query::Elem::ofDeclaration(pr), qps::query::Elem::ofDeclaration(v) });
+    REQUIRE(results == std::list<std::string>{"7 x", "7 y", "8 x"});
+    REQUIRE(chunkSizes == std::vector<std::size_t>{2, 1});
+}
+
+SECTION("Duplicate projected tuples are written once") {
+    project({ qps::query::Elem::ofDeclaration(pr) });
+    REQUIRE(results == std::list<std::string>{"7", "8"});
+    REQUIRE(chunkSizes == std::vector<std::size_t>{2});
+}
+
+SECTION("Attributes shared by different statements are written once") {
+    qps::query::AttrRef varName = qps::query::AttrRef{ qps::query::AttrName::VARNAME, pr };
+    project({ qps::query::Elem::ofAttrRef(varName) });
+    REQUIRE(results == std::list<std::string>{"x"});
+}
+}
@@ -1,9 +1,29 @@
+#include "Cancellation.h"
 #include "QPS/ResultTable.h"
 #include "catch.hpp"
 #include "logging.h"
 
 #define TEST_LOG Logger() << "resulttable_tests.cpp "
 
+using qps::query::SynonymId;
+using qps::query::SynonymTable;
+
+namespace {
+SynonymTable synonyms;
+
+SynonymId id(std::string_view name) {
+    return synonyms.intern(name);
+}
+
+std::vector<SynonymId> ids(std::initializer_list<std::string_view> names) {
+    std::vector<SynonymId> result;
+    for (auto name : names) {
+        result.push_back(id(name));
+    }
+    return result;
+}
+}  // namespace
+
 PKBField field1 = PKBField::createConcrete(VAR_NAME{"main"});
 PKBField field2 = PKBField::createConcrete(VAR_NAME{"a"});
 PKBField field3 = PKBField::createConcrete(VAR_NAME{"b"});
@@ -53,49 +73,49 @@ qps::evaluator::ResultTable createNonEmptyTable() {
             std::vector<PKBField>{field3, field6}};
     PKBResponse response{true, Response{r}};
 
-    table.insert(response, std::vector<std::string>{"v", "s"});
+    table.insert(response, ids({"v", "s"}));
     return table;
 }
 
 TEST_CASE("Test getSynPos") {
     qps::evaluator::ResultTable table{};
     TEST_LOG << "create result table";
-    table.insertSynLocationToLast("s");
-    table.insertSynLocationToLast("v");
-    table.insertSynLocationToLast("a");
+    table.insertSynLocationToLast(id("s"));
+    table.insertSynLocationToLast(id("v"));
+    table.insertSynLocationToLast(id("a"));
 
-    REQUIRE(table.getSynMap().size() == 3);
+    REQUIRE(table.getColumns().size() == 3);
 
-    REQUIRE(table.getSynLocation("s") == 0);
-    REQUIRE(table.getSynLocation("v") == 1);
-    REQUIRE(table.getSynLocation("a") == 2);
+    REQUIRE(table.getSynLocation(id("s")) == 0);
+    REQUIRE(table.getSynLocation(id("v")) == 1);
+    REQUIRE(table.getSynLocation(id("a")) == 2);
 }
 
 TEST_CASE("Test synExists") {
     qps::evaluator::ResultTable table{};
-    REQUIRE(table.synExists("x") == false);
+    REQUIRE(table.synExists(id("x")) == false);
     TEST_LOG << "create result table";
-    table.insertSynLocationToLast("s");
-    table.insertSynLocationToLast("v");
-    table.insertSynLocationToLast("a");
+    table.insertSynLocationToLast(id("s"));
+    table.insertSynLocationToLast(id("v"));
+    table.insertSynLocationToLast(id("a"));
 
 
-    REQUIRE(table.synExists("s"));
-    REQUIRE(table.synExists("v"));
-    REQUIRE(table.synExists("a"));
+    REQUIRE(table.synExists(id("s")));
+    REQUIRE(table.synExists(id("v")));
+    REQUIRE(table.synExists(id("a")));
 }
 
 TEST_CASE("Test insert single synonym") {
     qps::evaluator::ResultTable table{};
-    REQUIRE(table.synExists("x") == false);
+    REQUIRE(table.synExists(id("x")) == false);
     TEST_LOG << "create result table";
 
     std::unordered_set<PKBField, PKBFieldHash> r{field1, field2, field3};
     PKBResponse response{true, Response{r}};
 
-    table.insert(response, std::vector<std::string>{"v"});
+    table.insert(response, ids({"v"}));
 
-    REQUIRE(table.getSynLocation("v") == 0);
+    REQUIRE(table.getSynLocation(id("v")) == 0);
     auto result = table.getTable();
     REQUIRE(result.size() == 3);
     REQUIRE(result.find(std::vector<PKBField>{field1}) != result.end());
@@ -105,7 +125,7 @@ TEST_CASE("Test insert single synonym") {
 
 TEST_CASE("Test insert vector") {
     qps::evaluator::ResultTable table{};
-    REQUIRE(table.synExists("x") == false);
+    REQUIRE(table.synExists(id("x")) == false);
     TEST_LOG << "create result table";
 
     std::unordered_set<std::vector<PKBField>, PKBFieldVectorHash> r{
@@ -114,9 +134,9 @@ TEST_CASE("Test insert vector") {
             std::vector<PKBField>{field3, field6}};
     PKBResponse response{true, Response{r}};
 
-    table.insert(response, std::vector<std::string>{"v", "s"});
+    table.insert(response, ids({"v", "s"}));
 
-    REQUIRE(table.getSynLocation("v") == 0);
+    REQUIRE(table.getSynLocation(id("v")) == 0);
     auto result = table.getTable();
     REQUIRE(result.size() == 3);
     REQUIRE(result.find(std::vector<PKBField>{field1, field4}) != result.end());
@@ -129,11 +149,11 @@ TEST_CASE("Test Empty table cross join and empty table insert") {
     TEST_LOG << "create result table";
     std::unordered_set<PKBField, PKBFieldHash> r{field1, field2, field3};
     PKBResponse response{true, Response{r}};
-    table.insertSynLocationToLast("s");
-    table.insert(response, std::vector<std::string>{"v"});
+    table.insertSynLocationToLast(id("s"));
+    table.insert(response, ids({"v"}));
 
-    REQUIRE(table.getSynLocation("s") == 0);
-    REQUIRE(table.getSynLocation("v") == 1);
+    REQUIRE(table.getSynLocation(id("s")) == 0);
+    REQUIRE(table.getSynLocation(id("v")) == 1);
     auto result = table.getTable();
     REQUIRE(result.size() == 0);
 
@@ -144,9 +164,9 @@ TEST_CASE("Test Empty table cross join and empty table insert") {
             std::vector<PKBField>{field3, field6}};
     PKBResponse response1{true, Response{r1}};
 
-    table1.insert(response1, std::vector<std::string>{"v", "s"});
-    REQUIRE(table1.getSynLocation("v") == 0);
-    REQUIRE(table1.getSynLocation("s") == 1);
+    table1.insert(response1, ids({"v", "s"}));
+    REQUIRE(table1.getSynLocation(id("v")) == 0);
+    REQUIRE(table1.getSynLocation(id("s")) == 1);
     auto result1 = table1.getTable();
     REQUIRE(result1.size() == 3);
     REQUIRE(result1.find(std::vector<PKBField>{field1, field4}) != result1.end());
@@ -165,7 +185,7 @@ TEST_CASE("Test crossJoin with records inside") {
         std::vector<PKBField>{newField2}
     };
     PKBResponse response1{true, Response{r1}};
-    table.insert(response1, std::vector<std::string>{"a"});
+    table.insert(response1, ids({"a"}));
 
     auto result = table.getTable();
     REQUIRE(result.size() == 6);
@@ -184,9 +204,9 @@ TEST_CASE("Test crossJoin with records inside") {
             std::vector<PKBField>{newField1, newField4},
             std::vector<PKBField>{newField2, newField3}};
     PKBResponse response2{true, Response{r2}};
-    table2.insert(response2, std::vector<std::string>{"a", "c"});
-    REQUIRE(table2.getSynLocation("a") == 2);
-    REQUIRE(table2.getSynLocation("c") == 3);
+    table2.insert(response2, ids({"a", "c"}));
+    REQUIRE(table2.getSynLocation(id("a")) == 2);
+    REQUIRE(table2.getSynLocation(id("c")) == 3);
     auto result2 = table2.getTable();
     REQUIRE(result2.find(std::vector<PKBField>{field1, field4, newField1, newField3}) != result2.end());
     REQUIRE(result2.find(std::vector<PKBField>{field1, field4, newField1, newField4}) != result2.end());
@@ -205,15 +225,15 @@ TEST_CASE("Test innerJoin with empty table") {
     TEST_LOG << "create result table";
     std::unordered_set<PKBField, PKBFieldHash> r{field1, field2, field3};
     PKBResponse response{true, Response{r}};
-    table.insertSynLocationToLast("v");
-    table.insert(response, std::vector<std::string>{"v"});
+    table.insertSynLocationToLast(id("v"));
+    table.insert(response, ids({"v"}));
 
-    REQUIRE(table.getSynLocation("v") == 0);
+    REQUIRE(table.getSynLocation(id("v")) == 0);
     REQUIRE(table.getTable().size() == 0);
 
     qps::evaluator::ResultTable table1{};
-    table1.insertSynLocationToLast("v");
-    table1.insertSynLocationToLast("s");
+    table1.insertSynLocationToLast(id("v"));
+    table1.insertSynLocationToLast(id("s"));
 
     std::unordered_set<std::vector<PKBField>, PKBFieldVectorHash> r1{
             std::vector<PKBField>{field1, field4},
@@ -221,9 +241,9 @@ TEST_CASE("Test innerJoin with empty table") {
             std::vector<PKBField>{field3, field6}};
     PKBResponse response1{true, Response{r1}};
 
-    table1.insert(response1, std::vector<std::string>{"v", "s"});
-    REQUIRE(table1.getSynLocation("v") == 0);
-    REQUIRE(table1.getSynLocation("s") == 1);
+    table1.insert(response1, ids({"v", "s"}));
+    REQUIRE(table1.getSynLocation(id("v")) == 0);
+    REQUIRE(table1.getSynLocation(id("s")) == 1);
     REQUIRE(table1.getTable().size() == 0);
 }
 
@@ -234,7 +254,7 @@ TEST_CASE("Test innerJoin with records in table") {
     PKBResponse response1{true, Response{testR1}};
     TEST_LOG << "========== one synonym join s";
     qps::evaluator::ResultTable table = createNonEmptyTable();
-    table.insert(response1, std::vector<std::string>{"s"});
+    table.insert(response1, ids({"s"}));
     printTable(table);
     REQUIRE(table.getTable().size() == 2);
     //  table: main 1 / b 6
@@ -249,23 +269,23 @@ TEST_CASE("Test innerJoin with records in table") {
 
     TEST_LOG << "========== Join s and v";
     qps::evaluator::ResultTable table2 = createNonEmptyTable();
-    table2.insert(response3, std::vector<std::string>{"s", "v"});
+    table2.insert(response3, ids({"s", "v"}));
     REQUIRE(table2.getTable().size() == 1);
     printTable(table2);
     // table: main 1
 
     TEST_LOG << "========== Join s only";
     qps::evaluator::ResultTable table3 = createNonEmptyTable();
-    table3.insert(response3, std::vector<std::string>{"s", "v1"});
+    table3.insert(response3, ids({"s", "v1"}));
     REQUIRE(table3.getTable().size() == 3);
     printTable(table3);
     // table: main 1 main / main 1 cur / b 6 main
 
     TEST_LOG << "========== Join v only";
     qps::evaluator::ResultTable table4 = createNonEmptyTable();
-    table4.insert(response3, std::vector<std::string>{"s1", "v"});
+    table4.insert(response3, ids({"s1", "v"}));
     printTable(table4);
-    REQUIRE(table4.getSynLocation("s1") == 2);
+    REQUIRE(table4.getSynLocation(id("s1")) == 2);
     REQUIRE(table4.getTable().size() == 3);
     //  table: main 1 1 / main 1 6 / b 6 5
 }
@@ -282,7 +302,7 @@ TEST_CASE("Test join method") {
 
     TEST_LOG << "========== 1 syn join (cross join 1)";
     qps::evaluator::ResultTable table1{};
-    std::vector<std::string> synonyms1{"v"};
+    std::vector<SynonymId> synonyms1 = ids({"v"});
     std::unordered_set<std::vector<PKBField>, PKBFieldVectorHash> testR1{
             std::vector<PKBField>{field1},
             std::vector<PKBField>{field2},
@@ -291,13 +311,13 @@ TEST_CASE("Test join method") {
     PKBResponse response1{true, Response{testR1}};
 
     table1.insert(response1, synonyms1);
-    REQUIRE(table1.getSynLocation("v") == 0);
+    REQUIRE(table1.getSynLocation(id("v")) == 0);
     REQUIRE(table1.getTable().size() == 3);
     printTable(table1);
 
     TEST_LOG << "========== 1 syn join (cross join 2)";
     qps::evaluator::ResultTable table2 = createNonEmptyTable();
-    std::vector<std::string> synonyms2{"v1"};
+    std::vector<SynonymId> synonyms2 = ids({"v1"});
     std::unordered_set<std::vector<PKBField>, PKBFieldVectorHash> testR2{
             std::vector<PKBField>{newField4},
             std::vector<PKBField>{newField5},
@@ -305,107 +325,172 @@ TEST_CASE("Test join method") {
     };
     PKBResponse response2{true, Response{testR2}};
     table2.insert(response2, synonyms2);
-    REQUIRE(table2.getSynLocation("v1") == 2);
+    REQUIRE(table2.getSynLocation(id("v1")) == 2);
     REQUIRE(table2.getTable().size() == 9);
     printTable(table2);
 
     TEST_LOG << "========== 1 syn join (empty result cross join 3)";
     qps::evaluator::ResultTable table3 = createNonEmptyTable();
-    std::vector<std::string> synonyms3{"v1"};
+    std::vector<SynonymId> synonyms3 = ids({"v1"});
     std::unordered_set<PKBField, PKBFieldHash> testR3{};
     PKBResponse response3{true, Response{testR3}};
     table3.insert(response3, synonyms3);
-    REQUIRE(table3.getSynLocation("v1") == 2);
+    REQUIRE(table3.getSynLocation(id("v1")) == 2);
     REQUIRE(table3.getTable().size() == 0);
     printTable(table3);
 
     TEST_LOG << "========== 1 syn join (inner join 1)";
     qps::evaluator::ResultTable table4 = createNonEmptyTable();
-    std::vector<std::string> synonyms4{"s"};
+    std::vector<SynonymId> synonyms4 = ids({"s"});
     std::unordered_set<std::vector<PKBField>, PKBFieldVectorHash> testR4{std::vector<PKBField>{newField1},
                                                       std::vector<PKBField>{newField2},
                                                       std::vector<PKBField>{newField3}};
     PKBResponse response4{true, Response{testR4}};
     table4.insert(response4, synonyms4);
-    REQUIRE(table4.getSynLocation("s") == 1);
+    REQUIRE(table4.getSynLocation(id("s")) == 1);
     REQUIRE(table4.getTable().size() == 2);
     printTable(table4);
 
     TEST_LOG << "========== 2 syns join (cross join)";
     qps::evaluator::ResultTable table5 = createNonEmptyTable();
-    std::vector<std::string> synonyms5{"s1", "v1"};
+    std::vector<SynonymId> synonyms5 = ids({"s1", "v1"});
     table5.insert(responseVector, synonyms5);
-    REQUIRE(table5.getSynLocation("s1") == 2);
-    REQUIRE(table5.getSynLocation("v1") == 3);
+    REQUIRE(table5.getSynLocation(id("s1")) == 2);
+    REQUIRE(table5.getSynLocation(id("v1")) == 3);
     REQUIRE(table5.getTable().size() == 15);
     printTable(table5);
 
     TEST_LOG << "========== 2 syns join (inner join 1)";
     qps::evaluator::ResultTable table6{};
-    table6.insertSynLocationToLast("v");
-    table6.insertSynLocationToLast("s");
-    std::vector<std::string> synonyms6{"s", "v"};
+    table6.insertSynLocationToLast(id("v"));
+    table6.insertSynLocationToLast(id("s"));
+    std::vector<SynonymId> synonyms6 = ids({"s", "v"});
     table6.insert(responseVector, synonyms6);
-    REQUIRE(table6.getSynLocation("v") == 0);
-    REQUIRE(table6.getSynLocation("s") == 1);
+    REQUIRE(table6.getSynLocation(id("v")) == 0);
+    REQUIRE(table6.getSynLocation(id("s")) == 1);
     REQUIRE(table6.getTable().size() == 0);
     printTable(table6);
 
     TEST_LOG << "========== 2 syns join (inner join 2)";
     qps::evaluator::ResultTable table7 = createNonEmptyTable();
-    std::vector<std::string> synonyms7{"s", "v"};
+    std::vector<SynonymId> synonyms7 = ids({"s", "v"});
     table7.insert(responseVector, synonyms7);
-    REQUIRE(table7.getSynLocation("v") == 0);
-    REQUIRE(table7.getSynLocation("s") == 1);
+    REQUIRE(table7.getSynLocation(id("v")) == 0);
+    REQUIRE(table7.getSynLocation(id("s")) == 1);
     REQUIRE(table7.getTable().size() == 2);
     printTable(table7);
 
     TEST_LOG << "========== 2 syns join (inner join 3)";
     qps::evaluator::ResultTable table8 = createNonEmptyTable();
-    std::vector<std::string> synonyms8{"s", "v1"};
+    std::vector<SynonymId> synonyms8 = ids({"s", "v1"});
     table8.insert(responseVector, synonyms8);
-    REQUIRE(table8.getSynLocation("v1") == 2);
-    REQUIRE(table8.getSynLocation("s") == 1);
+    REQUIRE(table8.getSynLocation(id("v1")) == 2);
+    REQUIRE(table8.getSynLocation(id("s")) == 1);
     REQUIRE(table8.getTable().size() == 3);
     printTable(table8);
 
     TEST_LOG << "========== 2 syns join (inner join 4)";
     qps::evaluator::ResultTable table9 = createNonEmptyTable();
-    std::vector<std::string> synonyms9{"s1", "v"};
+    std::vector<SynonymId> synonyms9 = ids({"s1", "v"});
     table9.insert(responseVector, synonyms9);
-    REQUIRE(table9.getSynLocation("v") == 0);
-    REQUIRE(table9.getSynLocation("s1") == 2);
+    REQUIRE(table9.getSynLocation(id("v")) == 0);
+    REQUIRE(table9.getSynLocation(id("s1")) == 2);
     REQUIRE(table9.getTable().size() == 4);
     printTable(table9);
 
     TEST_LOG << "========== 1 syn join (empty response inner join 5)";
     qps::evaluator::ResultTable table10 = createNonEmptyTable();
-    std::vector<std::string> synonyms10{"v"};
+    std::vector<SynonymId> synonyms10 = ids({"v"});
     std::unordered_set<PKBField, PKBFieldHash> testR10{};
     PKBResponse response10{false, Response{testR10}};
     table10.insert(response10, synonyms10);
-    REQUIRE(table10.getSynLocation("v") == 0);
+    REQUIRE(table10.getSynLocation(id("v")) == 0);
     REQUIRE(table10.getTable().size() == 0);
     printTable(table10);
 
     TEST_LOG << "========== 2 syn join (empty response inner join 6)";
     qps::evaluator::ResultTable table11 = createNonEmptyTable();
-    std::vector<std::string> synonyms11{"v", "s"};
+    std::vector<SynonymId> synonyms11 = ids({"v", "s"});
     std::unordered_set<std::vector<PKBField>, PKBFieldVectorHash> testR11{};
     PKBResponse response11{false, Response{testR11}};
     table11.insert(response11, synonyms11);
-    REQUIRE(table11.getSynLocation("v") == 0);
+    REQUIRE(table11.getSynLocation(id("v")) == 0);
     REQUIRE(table11.getTable().size() == 0);
     printTable(table11);
 
     TEST_LOG << "========== 2 syn join (empty response cross join 2)";
     qps::evaluator::ResultTable table12 = createNonEmptyTable();
-    std::vector<std::string> synonyms12{"v1", "s1"};
+    std::vector<SynonymId> synonyms12 = ids({"v1", "s1"});
     std::unordered_set<std::vector<PKBField>, PKBFieldVectorHash> testR12{};
     PKBResponse response12{false, Response{testR12}};
     table12.insert(response12, synonyms12);
-    REQUIRE(table12.getSynLocation("v1") == 2);
-    REQUIRE(table12.getSynLocation("s1") == 3);
+    REQUIRE(table12.getSynLocation(id("v1")) == 2);
+    REQUIRE(table12.getSynLocation(id("s1")) == 3);
     REQUIRE(table12.getTable().size() == 0);
     printTable(table12);
 }
+
+TEST_CASE("Test join stops for a stopped query") {
+    qps::evaluator::ResultTable other{};
+    std::unordered_set<PKBField, PKBFieldHash> r{newField1, newField2, newField3};
+    other.insert(PKBResponse{true, Response{r}}, ids({"a"}));
+
+    SECTION("cancelled") {
+        qps::evaluator::ResultTable table = createNonEmptyTable();
+        CancellationToken token;
+        token.cancel();
+        REQUIRE_THROWS_AS(table.join(other, &token), exceptions::QueryStoppedException);
+    }
+
+    SECTION("past its deadline") {
+        qps::evaluator::ResultTable table = createNonEmptyTable();
+        CancellationToken token;
+        token.setDeadline(CancellationToken::Clock::now() - std::chrono::milliseconds(1));
+        REQUIRE_THROWS_AS(table.join(other, &token), exceptions::QueryStoppedException);
+    }
+
+    SECTION("over its memory budget") {
+        qps::evaluator::ResultTable table = createNonEmptyTable();
+        CancellationToken token;
+        token.setMemoryBudget(qps::evaluator::ResultTable::estimateBytes(8, 3));
+        try {
+            table.join(other, &token);
+            FAIL("join did not stop");
+        } catch (const exceptions::QueryStoppedException& e) {
+            REQUIRE(e.reason == exceptions::QueryStoppedException::Reason::MEMORY);
+        }
+    }
+
+    SECTION("within its memory budget") {
+        qps::evaluator::ResultTable table = createNonEmptyTable();
+        CancellationToken token;
+        token.setMemoryBudget(qps::evaluator::ResultTable::estimateBytes(9, 3));
+        table.join(other, &token);
+        REQUIRE(table.getTable().size() == 9);
+        REQUIRE(table.estimateBytes() <= token.getMemoryBudget());
+    }
+}
+
+TEST_CASE("Test join records the peak memory of a query") {
+    qps::evaluator::ResultTable other{};
+    std::unordered_set<PKBField, PKBFieldHash> r{newField1, newField2, newField3};
+    other.insert(PKBResponse{true, Response{r}}, ids({"a"}));
+
+    CancellationToken token;
+    REQUIRE(token.getPeakMemory() == 0);
+    qps::evaluator::ResultTable table = createNonEmptyTable();
+    table.join(other, &token);
+    std::size_t peak = token.getPeakMemory();
+    REQUIRE(peak >= qps::evaluator::ResultTable::estimateBytes(6, 3));
+    REQUIRE(peak <= table.estimateBytes());
+
+    // the tables that are retained count towards the tables built after them, until they are released.
+    token.retain(table.estimateBytes());
+    qps::evaluator::ResultTable next = createNonEmptyTable();
+    next.join(other, &token);
+    REQUIRE(token.getPeakMemory() >= table.estimateBytes() + peak);
+    token.release(table.estimateBytes());
+
+    token.setMemoryBudget(table.estimateBytes());
+    REQUIRE_THROWS_AS(token.retain(table.estimateBytes() + 1), exceptions::QueryStoppedException);
+}
@@ -0,0 +1,58 @@
+#include "QPS/SynonymDomains.h"
+#include "catch.hpp"
+
+using qps::evaluator::SingleResponse;
+using qps::evaluator::SynonymDomains;
+using qps::evaluator::VectorResponse;
+using qps::query::SynonymId;
+using qps::query::SynonymTable;
+
+namespace {
+SynonymTable synonyms;
+
+PKBField stmt(int statementNum) {
+    return PKBField::createConcrete(STMT_LO{statementNum, StatementType::Assignment});
+}
+
+PKBField var(const std::string& name) {
+    return PKBField::createConcrete(VAR_NAME{name});
+}
+
+PKBResponse single(std::initializer_list<PKBField> fields) {
+    SingleResponse res{fields};
+    return PKBResponse{!res.empty(), Response{res}};
+}
+}  // namespace
+
+TEST_CASE("SynonymDomains") {
+    SynonymId s = synonyms.intern("s");
+    SynonymId v = synonyms.intern("v");
+    SynonymDomains domains;
+
+    SECTION("Domains are intersected") {
+        REQUIRE(domains.restrict(single({stmt(1), stmt(2), stmt(3)}), s));
+        REQUIRE(domains.restrict(PKBResponse{true, Response{VectorResponse{{stmt(2)}, {stmt(3)}, {stmt(4)}}}}, s));
+        REQUIRE(domains.hasDomain(s));
+        REQUIRE_FALSE(domains.hasDomain(v));
+        PKBResponse domain = domains.getDomain(s);
+        REQUIRE(std::get<SingleResponse>(domain.res) == SingleResponse{stmt(2), stmt(3)});
+        REQUIRE_FALSE(domains.restrict(single({stmt(1), stmt(5)}), s));
+    }
+
+    SECTION("Rows are filtered by the domains of their synonyms") {
+        domains.restrict(single({stmt(1), stmt(2)}), s);
+        domains.restrict(single({var("x")}), v);
+        VectorResponse rows{{stmt(1), var("x")}, {stmt(1), var("y")}, {stmt(2), var("x")}, {stmt(3), var("x")}};
+        PKBResponse filtered = domains.filter(PKBResponse{true, Response{rows}}, std::vector<SynonymId>{s, v});
+        REQUIRE(filtered.hasResult);
+        REQUIRE(std::get<VectorResponse>(filtered.res) == VectorResponse{{stmt(1), var("x")}, {stmt(2), var("x")}});
+
+        SynonymId other = synonyms.intern("other");
+        PKBResponse unfiltered = domains.filter(PKBResponse{true, Response{rows}}, std::vector<SynonymId>{other, other});
+        REQUIRE(std::get<VectorResponse>(unfiltered.res).size() == 4);
+
+        PKBResponse none = domains.filter(PKBResponse{true, Response{VectorResponse{{stmt(3), var("x")}}}},
+                                          std::vector<SynonymId>{s, v});
+        REQUIRE_FALSE(none.hasResult);
+    }
+}
@@ -0,0 +1,80 @@
+#include <set>
+#include <string_view>
+#include <vector>
+
+#include "QPS/TrieJoin.h"
+#include "catch.hpp"
+
+using qps::evaluator::ResultTable;
+using qps::evaluator::SingleResponse;
+using qps::evaluator::TrieJoin;
+using qps::evaluator::VectorResponse;
+using qps::query::SynonymId;
+using qps::query::SynonymTable;
+
+namespace {
+SynonymTable synonyms;
+
+PKBField stmt(int statementNum) {
+    return PKBField::createConcrete(STMT_LO{statementNum, StatementType::Assignment});
+}
+
+PKBResponse pairs(std::initializer_list<std::pair<int, int>> rows) {
+    VectorResponse res;
+    for (auto [first, second] : rows) {
+        res.insert(std::vector<PKBField>{stmt(first), stmt(second)});
+    }
+    return PKBResponse{!res.empty(), Response{res}};
+}
+
+/**
+ * Reads the rows of the table as statement numbers, in the order of the given synonyms.
+ */
+std::set<std::vector<int>> rowsOf(const ResultTable& table, std::initializer_list<std::string_view> names) {
+    std::set<std::vector<int>> rows;
+    for (auto& row : table.getTable()) {
+        std::vector<int> values;
+        for (auto name : names) {
+            values.push_back(row[table.getSynLocation(synonyms.intern(name))].getContent<STMT_LO>()->statementNum);
+        }
+        rows.insert(values);
+    }
+    return rows;
+}
+}  // namespace
+
+TEST_CASE("TrieJoin") {
+    SynonymId a = synonyms.intern("a");
+    SynonymId b = synonyms.intern("b");
+    SynonymId c = synonyms.intern("c");
+
+    SECTION("Triangle") {
+        TrieJoin join;
+        join.addRelation(pairs({{1, 2}, {1, 3}, {2, 3}, {4, 5}}), {a, b});
+        join.addRelation(pairs({{2, 3}, {3, 4}, {3, 6}, {5, 6}}), {b, c});
+        join.addRelation(pairs({{1, 3}, {1, 4}, {2, 4}, {4, 6}}), {a, c});
+        ResultTable table = join.join();
+        REQUIRE(table.getColumns().size() == 3);
+        REQUIRE(rowsOf(table, {"a", "b", "c"}) == std::set<std::vector<int>>{{1, 2, 3}, {1, 3, 4}, {2, 3, 4},
+                                                                             {4, 5, 6}});
+    }
+
+    SECTION("Relations in different synonym orders and unary relations") {
+        TrieJoin join;
+        join.addRelation(pairs({{2, 1}, {3, 1}, {3, 2}}), {b, a});
+        join.addRelation(pairs({{3, 2}, {3, 1}}), {c, b});
+        join.addRelation(pairs({{1, 3}, {2, 3}}), {a, c});
+        join.addRelation(PKBResponse{true, Response{SingleResponse{stmt(1)}}}, {a});
+        REQUIRE(rowsOf(join.join(), {"a", "b", "c"}) == std::set<std::vector<int>>{{1, 2, 3}});
+    }
+
+    SECTION("Empty relation") {
+        TrieJoin join;
+        join.addRelation(pairs({{1, 2}}), {a, b});
+        join.addRelation(pairs({}), {b, c});
+        join.addRelation(pairs({{1, 3}}), {a, c});
+        ResultTable table = join.join();
+        REQUIRE_FALSE(table.hasResult());
+        REQUIRE(table.getColumns().size() == 3);
+    }
+}
@@ -1,9 +1,12 @@
 #include <vector>
 #include <memory>
+#include <set>
 #include <unordered_set>
 
 #include "catch.hpp"
+#include "DesignExtractor/CFG/BlockCFG.h"
 #include "DesignExtractor/CFG/CFG.h"
+#include "DesignExtractor/FusedExtractor.h"
 #include "Parser/AST.h"
 #include "Parser/Lexer.h"
 #include "Parser/Parser.h"
@@ -392,5 +395,215 @@ TEST_CASE("CFG Test") {
         REQUIRE(stmt6->uses == expectedVars4);
     }
 }
+
+TEST_CASE("Block CFG Test") {
+    auto ast = sp::parser::parse(
+        R"(
+        procedure test {
+            x = 1;
+            y = x;
+            while (x == 1) {
+                x = x + 1;
+                print y;
+            }
+            if (y == 2) then {
+                read x;
+            } else {
+                z = x;
+            }
+            print z;
+        }
+        procedure other {
+            a = b;
+            b = a;
+        }
+        )"
+    );
+    auto result = CFGExtractor().extract(ast.get());
+    REQUIRE(result.blocks);
+    auto& program = *result.blocks;
+    auto [test, first] = program.locate(1);
+    REQUIRE(test != nullptr);
+    REQUIRE(test->getName() == "test");
+
+    auto index = [test = test](int stmtNo) { return test->indexOf(stmtNo); };
+    auto toStmtNos = [test = test](const Bitset& stmts) {
+        std::set<int> stmtNos;
+        stmts.forEach([&](std::size_t i) { stmtNos.insert(test->getStmt(i).statementNum); });
+        return stmtNos;
+    };
+
+    SECTION("Straight-line statements are collapsed into blocks") {
+        // [1, 2], [3], [4, 5], [6], [7], [8], [9]
+        REQUIRE(test->getBlockCount() == 7);
+        REQUIRE(test->getEntryBlock() == test->getBlock(first));
+        REQUIRE(test->getBlock(index(1)) == test->getBlock(index(2)));
+        REQUIRE(test->getBlock(index(4)) == test->getBlock(index(5)));
+        REQUIRE(test->getBlock(index(2)) != test->getBlock(index(3)));
+        REQUIRE(test->getBlock(index(5)) != test->getBlock(index(6)));
+        REQUIRE(test->getBlockStmts(test->getBlock(index(1))).size() == 2);
+        REQUIRE(test->getSuccessors(test->getBlock(index(3))).size() == 2);
+        REQUIRE(test->getPredecessors(test->getBlock(index(9))).size() == 2);
+    }
+
+    SECTION("Next follows the edges inside and between blocks") {
+        auto next = [&](int stmtNo) {
+            std::set<int> result;
+            test->forEachNext(index(stmtNo), [&](int i) { result.insert(test->getStmt(i).statementNum); });
+            return result;
+        };
+        auto previous = [&](int stmtNo) {
+            std::set<int> result;
+            test->forEachPrevious(index(stmtNo), [&](int i) { result.insert(test->getStmt(i).statementNum); });
+            return result;
+        };
+        REQUIRE(next(1) == std::set<int>{2});
+        REQUIRE(next(3) == std::set<int>{4, 6});
+        REQUIRE(next(5) == std::set<int>{3});
+        REQUIRE(next(9).empty());
+        REQUIRE(previous(3) == std::set<int>{2, 5});
+        REQUIRE(previous(9) == std::set<int>{7, 8});
+        REQUIRE(previous(1).empty());
+    }
+
+    SECTION("Next* is answered from the blocks") {
+        REQUIRE(toStmtNos(test->getReachableFrom(index(4))) == std::set<int>{3, 4, 5, 6, 7, 8, 9});
+        REQUIRE(toStmtNos(test->getReachableFrom(index(1))) == std::set<int>{2, 3, 4, 5, 6, 7, 8, 9});
+        REQUIRE(toStmtNos(test->getReaching(index(7))) == std::set<int>{1, 2, 3, 4, 5, 6});
+        REQUIRE(toStmtNos(test->getReaching(index(1))).empty());
+        REQUIRE(test->isReachable(index(1), index(2)));
+        REQUIRE(test->isReachable(index(5), index(4)));
+        REQUIRE(test->isReachable(index(3), index(3)));
+        REQUIRE_FALSE(test->isReachable(index(2), index(1)));
+        REQUIRE_FALSE(test->isReachable(index(1), index(1)));
+        REQUIRE_FALSE(test->isReachable(index(7), index(8)));
+    }
+
+    SECTION("Modifies and Uses are bitsets over the interned variables") {
+        auto& vars = program.getVarIndex();
+        auto x = vars.find("x").value();
+        auto y = vars.find("y").value();
+        REQUIRE_FALSE(vars.find("w").has_value());
+        REQUIRE(test->getModifies(index(4)).test(x));
+        REQUIRE(test->getUses(index(4)).test(x));
+        REQUIRE(test->getModifies(index(2)).test(y));
+        REQUIRE(test->getModifies(index(2)).count() == 1);
+        REQUIRE(test->getModifies(index(7)).test(x));
+        REQUIRE(test->getUses(index(3)).none());
+    }
+
+    SECTION("Statements are located in their procedure") {
+        auto [other, local] = program.locate(11);
+        REQUIRE(other != nullptr);
+        REQUIRE(other->getName() == "other");
+        REQUIRE(other->getStmt(local).statementNum == 11);
+        REQUIRE(other->getBlockCount() == 1);
+        REQUIRE(program.locate(12).first == nullptr);
+        REQUIRE(program.locate(0).first == nullptr);
+        REQUIRE(test->indexOf(10) == -1);
+    }
+}
+
+TEST_CASE("CFG annotated with extracted Modifies and Uses") {
+    auto ast = sp::parser::parse(
+        R"(
+        procedure main {
+            read x;
+            call helper;
+            while (x > 0) {
+                y = x + z;
+                call helper;
+            }
+            print y;
+        }
+        procedure helper {
+            z = y * 2;
+            read w;
+        }
+        )"
+    );
+    auto entries = design_extractor::FusedExtractor().extract(ast.get());
+    auto modifiesMap = std::make_shared<const ContentToVarMap>(
+        design_extractor::groupStatementVariables(entries, PKBRelationship::MODIFIES));
+    auto usesMap = std::make_shared<const ContentToVarMap>(
+        design_extractor::groupStatementVariables(entries, PKBRelationship::USES));
+
+    // call statements carry the variables of the procedure they call.
+    REQUIRE(modifiesMap->at(STMT_LO(2, StatementType::Call)) == VAR_NAMES{ VAR_NAME("z"), VAR_NAME("w") });
+    REQUIRE(usesMap->at(STMT_LO(4, StatementType::Assignment)) == VAR_NAMES{ VAR_NAME("x"), VAR_NAME("z") });
+    REQUIRE(modifiesMap->count(STMT_LO(6, StatementType::Print)) == 0);
+
+    auto expected = CFGExtractor().extract(ast.get());
+    auto result = CFGExtractor().extract(ast.get(), modifiesMap, usesMap);
+    REQUIRE(*result.cfgs.at("main") == *expected.cfgs.at("main"));
+    REQUIRE(*result.cfgs.at("helper") == *expected.cfgs.at("helper"));
+    for (int stmtNo = 1; stmtNo <= 8; stmtNo++) {
+        auto [procedure, i] = result.blocks->locate(stmtNo);
+        auto [expectedProcedure, j] = expected.blocks->locate(stmtNo);
+        REQUIRE(procedure->getModifies(i) == expectedProcedure->getModifies(j));
+        REQUIRE(procedure->getUses(i) == expectedProcedure->getUses(j));
+    }
+}
+
+TEST_CASE("Procedure summaries") {
+    auto ast = sp::parser::parse(
+        R"(
+        procedure main {
+            x = 1;
+            call helper;
+            y = x + z;
+            if (y > 0) then {
+                z = 1;
+            } else {
+                w = 2;
+            }
+        }
+        procedure helper {
+            read z;
+            while (z > 0) {
+                x = v + 1;
+            }
+        }
+        )"
+    );
+    auto result = CFGExtractor().extract(ast.get());
+    auto& program = *result.blocks;
+    auto& vars = program.getVarIndex();
+    auto toNames = [&vars](const Bitset& bits) {
+        std::set<std::string> names;
+        bits.forEach([&](std::size_t id) { names.insert(vars.getName(id)); });
+        return names;
+    };
+    auto summaryOf = [&program](int stmtNo) {
+        auto procedure = program.locate(stmtNo).first;
+        return program.getSummaries().at(procedure - program.getProcedures().data());
+    };
+
+    SECTION("Callee summary") {
+        auto helper = summaryOf(7);
+        REQUIRE(toNames(helper.mayModify) == std::set<std::string>{"x", "z"});
+    }
+
+    SECTION("Caller summary applies the callee summary at the call") {
+        auto main = summaryOf(1);
+        // w and z are each modified on a single branch, which is enough for a call to main to kill them.
+        REQUIRE(toNames(main.mayModify) == std::set<std::string>{"w", "x", "y", "z"});
+
+        auto [procedure, call] = program.locate(2);
+        REQUIRE(procedure->getCallee(call) == program.locate(7).first - program.getProcedures().data());
+        REQUIRE(procedure->getCallee(procedure->indexOf(1)) == -1);
+    }
+
+    SECTION("Blocks end where control can leave the procedure") {
+        auto [helper, whileStmt] = program.locate(8);
+        REQUIRE(helper->isExitBlock(helper->getBlock(whileStmt)));
+        REQUIRE_FALSE(helper->isExitBlock(helper->getBlock(helper->indexOf(9))));
+        REQUIRE(helper->getBlock(whileStmt) != helper->getBlock(helper->indexOf(9)));
+
+        auto [main, thenStmt] = program.locate(5);
+        REQUIRE(main->isExitBlock(main->getBlock(thenStmt)));
+        REQUIRE_FALSE(main->isExitBlock(main->getEntryBlock()));
+    }
+}
 }  // namespace cfg
 }  // namespace sp
@@ -8,6 +8,7 @@
 
 #include "catch.hpp"
 #include "Parser/AST.h"
+#include "DesignExtractor/CallGraph.h"
 #include "DesignExtractor/DesignExtractor.h"
 #include "DesignExtractor/EntityExtractor/EntityExtractor.h"
 #include "DesignExtractor/RelationshipExtractor/RelationshipExtractor.h"
@@ -97,6 +98,9 @@ struct PKBStub : public PKB {
     void insertRelationship(PKBRelationship type, PKBField field1, PKBField field2) {
         relationships[type].insert(std::make_pair<>(field1.content, field2.content));
     }
+    void bulkInsertRelationships(PKBRelationship type, RelationshipRows rows) {
+        relationships[type].insert(rows.begin(), rows.end());
+    }
     void insertEntity(Content entity) {
         std::visit(overloaded{
             [&](VAR_NAME& item) { entities[PKBEntityType::VARIABLE].insert(item); },
@@ -538,6 +542,23 @@ namespace ast {
             };
 
             REQUIRE(transformRelationship(ne.extract(&cfgs)) == expected);
+
+            // a single fused pass produces exactly what the individual extractors produce.
+            std::set<Entry> individual;
+            for (auto entries : {
+                StatementExtractor().extract(program.get()),
+                VariableExtractor().extract(program.get()),
+                ConstExtractor().extract(program.get()),
+                ProcedureExtractor().extract(program.get()),
+                me.extract(program.get()),
+                ue.extract(program.get()),
+                FollowsExtractor().extract(program.get()),
+                ParentExtractor().extract(program.get()),
+                de::CallsExtractor().extract(program.get())
+            }) {
+                individual.insert(entries.begin(), entries.end());
+            }
+            REQUIRE(de::FusedExtractor().extract(program.get()) == individual);
         }
     
         /**
@@ -784,6 +805,30 @@ namespace ast {
                 p(STMT_LO{10, StatementType::Read}, VAR_NAME{"w"})
             };
             REQUIRE(transformRelationship(me.extract(program.get())) == expected);
+
+            // procedures in the same level never call each other, so they are extracted in parallel.
+            auto levels = de::CallGraph(program.get()).getReverseTopologicalLevels();
+            std::vector<std::set<std::string>> levelNames;
+            for (auto& level : levels) {
+                std::set<std::string> names;
+                for (auto proc : level) {
+                    names.insert(proc->getName());
+                }
+                levelNames.push_back(names);
+            }
+            REQUIRE(levelNames == std::vector<std::set<std::string>> {
+                {"a", "c", "e", "j"},
+                {"b", "d", "f", "g"},
+                {"h", "i"}
+            });
+
+            std::set<std::pair<Content, Content>> fusedModifies;
+            for (auto& entry : de::FusedExtractor().extract(program.get())) {
+                if (auto rel = std::get_if<de::Relationship>(&entry); rel && std::get<0>(*rel) == PKBRelationship::MODIFIES) {
+                    fusedModifies.insert(p(std::get<1>(*rel), std::get<2>(*rel)));
+                }
+            }
+            REQUIRE(fusedModifies == expected);
         }
     }
 
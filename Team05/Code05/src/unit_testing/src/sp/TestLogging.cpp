@@ -0,0 +1,68 @@
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "catch.hpp"
+#include "logging.h"
+
+namespace {
+class CaptureSink : public logging::Sink {
+public:
+    std::vector<std::string> lines;
+
+    void write(Level, std::string line) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        lines.push_back(std::move(line));
+    }
+
+private:
+    std::mutex mutex;
+};
+}  // namespace
+
+TEST_CASE("Logging Test") {
+    int previousThreshold = logging::threshold().load();
+    auto previousSink = logging::getSink();
+    auto capture = std::make_shared<CaptureSink>();
+    logging::setSink(capture);
+
+    SECTION("disabled levels do not evaluate their arguments") {
+        logging::disable();
+        int evaluated = 0;
+        auto count = [&evaluated] { return ++evaluated; };
+        LOG(Level::ERROR) << count();
+        REQUIRE(evaluated == 0);
+        REQUIRE(capture->lines.empty());
+
+        logging::setLevel(Level::ERROR);
+        LOG(Level::WARN) << count();
+        LOG(Level::ERROR) << count();
+        REQUIRE(evaluated == 1);
+        REQUIRE(capture->lines.size() == 1);
+    }
+
+    SECTION("fields are written as key=value") {
+        logging::setLevel(Level::WARN);
+        LOG(Level::WARN) << "lexed" << logging::field("tokens", 12) << logging::field("file", "a.txt");
+        REQUIRE(capture->lines.size() == 1);
+        std::string line = capture->lines.front();
+        REQUIRE(line.find("[WARN]") != std::string::npos);
+        REQUIRE(line.find("lexed tokens=12 file=a.txt") != std::string::npos);
+    }
+
+    SECTION("AsyncSink writes every line before flush returns") {
+        logging::setLevel(Level::WARN);
+        auto async = std::make_shared<logging::AsyncSink>(capture);
+        logging::setSink(async);
+        for (int i = 0; i < 100; i++) {
+            LOG(Level::ERROR) << i;
+        }
+        async->flush();
+        REQUIRE(capture->lines.size() == 100);
+        REQUIRE(capture->lines.back().find("99") != std::string::npos);
+    }
+
+    logging::setSink(previousSink);
+    logging::threshold().store(previousThreshold);
+}
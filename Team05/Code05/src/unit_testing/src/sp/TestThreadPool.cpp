@@ -0,0 +1,42 @@
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "catch.hpp"
+#include "ThreadPool.h"
+
+TEST_CASE("ThreadPool Test") {
+    ThreadPool pool(3);
+    REQUIRE(pool.size() == 3);
+
+    SECTION("submit") {
+        auto future = pool.submit([] { return 42; });
+        REQUIRE(future.get() == 42);
+    }
+
+    SECTION("parallelFor visits every index once") {
+        std::vector<int> visits(1000, 0);
+        pool.parallelFor(visits.size(), [&visits](std::size_t i) { visits[i]++; });
+        REQUIRE(visits == std::vector<int>(1000, 1));
+    }
+
+    SECTION("nested parallelFor does not deadlock") {
+        std::atomic<int> count = 0;
+        pool.parallelFor(8, [&pool, &count](std::size_t) {
+            pool.parallelFor(8, [&count](std::size_t) { count++; });
+        });
+        REQUIRE(count == 64);
+    }
+
+    SECTION("parallelFor rethrows") {
+        std::atomic<int> count = 0;
+        REQUIRE_THROWS_AS(pool.parallelFor(10, [&count](std::size_t i) {
+            count++;
+            if (i == 3) {
+                throw std::runtime_error("failed");
+            }
+        }), std::runtime_error);
+        // the remaining indices still run.
+        REQUIRE(count == 10);
+    }
+}
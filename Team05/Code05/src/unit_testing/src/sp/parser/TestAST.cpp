@@ -1,3 +1,4 @@
+#include <cstdint>
 #include <iostream>
 #include <vector>
 
@@ -346,5 +347,37 @@ TEST_CASE("AST Test") {
 
     SUCCEED("No errors thrown");
 }
+
+TEST_CASE("Arena Test") {
+    SECTION("Nodes are placed in the arena in creation order") {
+        Arena arena;
+        auto v1 = arena.make<Var>("v1");
+        auto v2 = arena.make<Var>("v2");
+        REQUIRE(v1->isArenaAllocated());
+        REQUIRE(reinterpret_cast<std::uintptr_t>(v1.get()) < reinterpret_cast<std::uintptr_t>(v2.get()));
+        REQUIRE(arena.getBytesUsed() == 2 * sizeof(Var));
+
+        // arena nodes and heap nodes can be mixed freely in a tree
+        Ptr<Statement> assign = arena.make<Assign>(1, std::move(v1), make<Var>("v3"));
+        REQUIRE(*assign == *make<Assign>(1, make<Var>("v1"), make<Var>("v3")));
+    }
+
+    SECTION("Copies are never arena allocated") {
+        Arena arena;
+        auto v1 = arena.make<Var>("v1");
+        Var copy = *v1;
+        REQUIRE_FALSE(copy.isArenaAllocated());
+        REQUIRE(copy == *v1);
+    }
+
+    SECTION("Oversized allocations get their own block") {
+        Arena arena(16);
+        auto c1 = arena.make<Const>(1);
+        auto c2 = arena.make<Const>(2);
+        REQUIRE(arena.getBytesReserved() >= 2 * sizeof(Const));
+        REQUIRE(c1->getConstValue() == 1);
+        REQUIRE(c2->getConstValue() == 2);
+    }
+}
 }  // namespace ast
 }  // namespace sp
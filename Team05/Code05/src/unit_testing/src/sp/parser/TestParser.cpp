@@ -13,11 +13,9 @@ TEST_CASE("Testing Parser") {
     SECTION("Unit testing") {
         std::deque<Token> tokens;
         using ast::make;
-        std::unique_ptr<ast::ASTNode> ast, expected;
+        ast::Ptr<ast::ASTNode> ast, expected;
         // reset state
-        lineCount = 1;
-        callStmts.clear();
-        procedures.clear();
+        currentState() = ParseState();
         
 
         SECTION("ExprParser::parse") {
@@ -255,7 +253,7 @@ TEST_CASE("Testing Parser") {
 
             // nested cond expression with &&
             tokens = Lexer("((x+1)>(y+2))&&((z+1)>(t+2))").getTokens();
-            std::unique_ptr<ast::CondExpr> ast = cond_expr_parser::parse(tokens);
+            ast::Ptr<ast::CondExpr> ast = cond_expr_parser::parse(tokens);
             std::unique_ptr<ast::CondExpr> expected = make<ast::CondBinExpr>(
                 ast::CondOp::AND,
                 relExpr1(),
@@ -491,11 +489,12 @@ TEST_CASE("Testing Parser") {
             expected = makeProgram(make<ast::Procedure>("main", std::move(genStmtlst())));
 
             REQUIRE(*ast == *expected);
+            // parsed programs own the arena their nodes live in
+            REQUIRE(static_cast<ast::Program*>(ast.get())->getArena() != nullptr);
+            REQUIRE(static_cast<ast::Program*>(expected.get())->getArena() == nullptr);
 
             // reset state.
-            lineCount = 1;
-            callStmts.clear();
-            procedures.clear();
+            currentState() = ParseState();
             // testing a program with 2 procedures
             tokens = Lexer(R"(
             procedure main {
@@ -534,9 +533,7 @@ TEST_CASE("Testing Parser") {
             REQUIRE(*ast == *expected);
 
             // reset state.
-            lineCount = 1;
-            callStmts.clear();
-            procedures.clear();
+            currentState() = ParseState();
             // testing a simple program with >2 procedures
             tokens = Lexer(R"(
             procedure main {
@@ -588,9 +585,7 @@ TEST_CASE("Testing Parser") {
             REQUIRE(*ast == *expected);
 
             // reset state.
-            lineCount = 1;
-            callStmts.clear();
-            procedures.clear();
+            currentState() = ParseState();
             // testing a heavily-nested program with >2 procedures
             tokens = Lexer(R"(
             procedure monke {
@@ -788,9 +783,7 @@ TEST_CASE("Testing Parser") {
 
         // Corrected program
         // reset state.
-        lineCount = 1;
-        callStmts.clear();
-        procedures.clear();
+        currentState() = ParseState();
         std::string correct = R"(
             procedure a {
                 while (c != b) {
@@ -819,9 +812,7 @@ TEST_CASE("Testing Parser") {
 
         // Program with incorrect parenthesis
         // reset state.
-        lineCount = 1;
-        callStmts.clear();
-        procedures.clear();
+        currentState() = ParseState();
         std::string fail2 = R"(procedure a {
             while (!(c == 1))) {
                 read c;
@@ -831,9 +822,7 @@ TEST_CASE("Testing Parser") {
         
         // corrected program
         // reset state.
-        lineCount = 1;
-        callStmts.clear();
-        procedures.clear();
+        currentState() = ParseState();
         std::string correct2 = R"(procedure a {
             while (!(c == 1)) {
                 read c;
@@ -860,18 +849,14 @@ TEST_CASE("Testing Parser") {
 
         // program with invalid variable names
         // reset state.
-        lineCount = 1;
-        callStmts.clear();
-        procedures.clear();
+        currentState() = ParseState();
         std::string fail3 = R"(procedure 1a {
             1x = 1y + 1z;
         })";
         REQUIRE(parse(fail3) == nullptr);
 
         // reset state.
-        lineCount = 1;
-        callStmts.clear();
-        procedures.clear();
+        currentState() = ParseState();
         std::string testCode = R"(procedure computeAverage {
             read num1;
             read num2;
@@ -914,9 +899,7 @@ TEST_CASE("Testing Parser") {
         REQUIRE(*parse(testCode) == *parsedTestCode);
 
         // reset state.
-        lineCount = 1;
-        callStmts.clear();
-        procedures.clear();
+        currentState() = ParseState();
         std::string testCode2 = R"(procedure printAscending {
             read num1;
             read num2;
@@ -987,9 +970,7 @@ TEST_CASE("Testing Exceptions Thrown and Source Line") {
 
     SECTION("Testing Exceptions") {
         // reset state
-        lineCount = 1;
-        callStmts.clear();
-        procedures.clear();
+        currentState() = ParseState();
 
         SECTION("Bad RelOp") {
             std::string badRelOpCode = R"(procedure a {
@@ -1091,9 +1072,7 @@ TEST_CASE("Testing Exceptions Thrown and Source Line") {
             );
 
             // reset state
-            lineCount = 1;
-            callStmts.clear();
-            procedures.clear();
+            currentState() = ParseState();
             // case where relOp is missing
             std::string badRelOpCode2 = R"(procedure bad {
                 while (1234 )";
@@ -1105,9 +1084,7 @@ TEST_CASE("Testing Exceptions Thrown and Source Line") {
             );
 
             // reset state
-            lineCount = 1;
-            callStmts.clear();
-            procedures.clear();
+            currentState() = ParseState();
             // case where relOp is not recognised
             std::string badRelOpCode3 = R"(procedure bad {
                 while (1234 ?? lol) {
@@ -1133,9 +1110,7 @@ TEST_CASE("Testing Exceptions Thrown and Source Line") {
             );
 
             // reset state
-            lineCount = 1;
-            callStmts.clear();
-            procedures.clear();
+            currentState() = ParseState();
             // Testing case where the second '|' is missing
             std::string badCondOpCode2 = R"(procedure bad {
                 while ((1234 == 1234) |)";
@@ -1147,9 +1122,7 @@ TEST_CASE("Testing Exceptions Thrown and Source Line") {
             );
 
             // reset state
-            lineCount = 1;
-            callStmts.clear();
-            procedures.clear();
+            currentState() = ParseState();
             // Testing case where the condOp is missing
             std::string badCondOpCode3 = R"(procedure bad {
                 while ((1234 == 1234) ?? (monke == monke)) {
@@ -1195,9 +1168,7 @@ TEST_CASE("Testing Exceptions Thrown and Source Line") {
     }
 
     SECTION("Additional Constraints") {
-        lineCount = 1;
-        callStmts.clear();
-        procedures.clear();
+        currentState() = ParseState();
 
         SECTION("Same name procedures should not be allowed") {
             // Same name procedures should not be allowed
@@ -1311,5 +1282,67 @@ TEST_CASE("Testing Exceptions Thrown and Source Line") {
         }
     }
 }
+
+TEST_CASE("Testing parallel parse") {
+    // procedures are parsed on their own and renumbered afterwards, which must match parsing the
+    // whole program in one go.
+    std::string source = R"(
+        procedure main {
+            read x;
+            while (x > 0) {
+                if (x == 1) then {
+                    call helper;
+                } else {
+                    x = x - 1;
+                }
+            }
+            print x;
+        }
+
+        procedure helper {
+            call leaf;
+            y = x * 2;
+        }
+        procedure leaf { read z; })";
+
+    currentState() = ParseState();
+    auto tokens = Lexer(source).getTokens();
+    auto sequential = parseProgram(tokens);
+    auto parallel = parse(source);
+    REQUIRE(parallel != nullptr);
+    REQUIRE(*parallel == *sequential);
+    REQUIRE(parallel->getArena()->getBytesUsed() == sequential->getArena()->getBytesUsed());
+
+    SECTION("state of the calling thread is left untouched") {
+        currentState() = ParseState();
+        currentState().lineCount = 42;
+        REQUIRE(parse(source) != nullptr);
+        REQUIRE(currentState().lineCount == 42);
+        REQUIRE(currentState().callStmts.empty());
+    }
+
+    SECTION("errors keep their source lines") {
+        std::string problemCode = R"(procedure a {
+                read x;
+            }
+            procedure b {
+                call c;
+            }
+            procedure a {
+                read y;
+            })";
+        REQUIRE(parse(problemCode) == nullptr);
+        currentState() = ParseState();
+        tokens = Lexer(problemCode).getTokens();
+        REQUIRE_THROWS_MATCHES(
+            parseProgram(tokens),
+            std::invalid_argument,
+            Catch::Message("Repeated procedure name: \"a\" at line: 7")
+        );
+        // junk between procedures is reported like the sequential parser does.
+        REQUIRE(parse("procedure a { read x; } junk procedure b { read y; }") == nullptr);
+        REQUIRE(parse("procedure a { read x; } } procedure b { read y; }") == nullptr);
+    }
+}
 }  // namespace parser
 }  // namespace sp